@@ -22,6 +22,9 @@
             2014.10.24 changed from LGPL license to MIT license
             2016.11.15 accretion miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.17 SIMD and galloping tid list intersection added
+            2026.10.17 cache for values of the test statistic added
+            2026.10.17 log-factorial table limited to max. item support
 ------------------------------------------------------------------------
   Reference for the Accretion algorithm:
     G.L. Gerstein, D.H. Perkel and K.N. Subramanian.
@@ -57,6 +60,11 @@
 #ifdef ACC_ABORT
 #include "sigint.h"
 #endif
+#if (defined __x86_64__ || defined __i386__) && !defined ACC_NOSIMD \
+&&  ((defined __GNUC__ && (__GNUC__ >= 5)) || defined __clang__)
+#define ACC_SIMD                /* SSE2/AVX2 kernels can be compiled */
+#include <immintrin.h>
+#endif
 #include "accretion.h"
 #ifdef ACC_MAIN
 #include "error.h"
@@ -88,6 +96,8 @@
 /* error codes -15 to -25 defined in tract.h */
 
 #define DIFFSIZE(p,q) ((size_t)((int*)(p)-(int*)(q)) *sizeof(int))
+#define GALLOP        32        /* min. length ratio for galloping */
+#define MEMOSIZE   16384        /* size of the test statistic cache */
 
 #ifndef QUIET                   /* if not quiet version, */
 #define MSG         fprintf     /* print messages */
@@ -108,9 +118,17 @@ typedef struct {                /* --- trans. identifier list --- */
   ITEM      item;               /* item identifier (last item in set) */
   SUPP      supp;               /* support of the item (or item set) */
   double    pval;               /* p-value of statistical test */
+  TID       cnt;                /* number of transaction identifiers */
   TID       tids[1];            /* transaction identifiers */
 } TIDLIST;                      /* (transaction identifier list) */
 
+typedef struct {                /* --- test statistic cache entry --- */
+  SUPP      supp;               /* support of the item set */
+  SUPP      body;               /* support of the body (set w/o item) */
+  SUPP      head;               /* support of the head (added item) */
+  double    pval;               /* p-value of the statistical test */
+} STATMEMO;                     /* (test statistic cache entry) */
+
 struct _accret {                /* --- accretion miner --- */
   int       target;             /* target type (e.g. closed/maximal) */
   double    smin;               /* minimum support of an item set */
@@ -121,6 +139,7 @@ struct _accret {                /* --- accretion miner --- */
   int       stat;               /* evaluation statistic */
   int       invbxs;             /* invalidate stat. below expectation */
   RULEVALFN *statfn;            /* function for test statistic */
+  STATMEMO  *memo;              /* cache for test statistic values */
   double    siglvl;             /* significance level */
   int       mode;               /* operation/search mode */
   ITEM      maxext;             /* maximum number of extensions */
@@ -206,40 +225,176 @@ static void show (const char *text, TIDLIST **lists, int k, int ind)
   Accretion (with an Eclat-style scheme)
 ----------------------------------------------------------------------*/
 
+static TID* merge (TID *d, const TID *s1, const TID *s2,
+                   const SUPP *muls, SUPP *supp)
+{                               /* --- merge two trans. id lists */
+  SUPP w = 0;                   /* sum of transaction weights */
+
+  while (1) {                   /* trans. id list intersection loop */
+    if      (*s1 < *s2) s2++;   /* if one transaction id is larger, */
+    else if (*s1 > *s2) s1++;   /* simply skip this transaction id */
+    else if (*s1 <   0) break;  /* check for the sentinel */
+    else { w += muls[*d++ = *s1++]; s2++; }
+  }                             /* copy equal elements to destination */
+  *supp += w;                   /* add the weight of the matches */
+  return d;                     /* return the new end of the dest. */
+}  /* merge() */
+
+/*--------------------------------------------------------------------*/
+
+static TID* gallop (TID *d, const TID *s1, const TID *s2, TID n2,
+                    const SUPP *muls, SUPP *supp)
+{                               /* --- intersect with galloping */
+  TID  t;                       /* transaction id to search for */
+  TID  lo, hi, k;               /* search range and step width */
+  SUPP w = 0;                   /* sum of transaction weights */
+
+  for (lo = 0; *s1 >= 0; s1++){ /* traverse the shorter list */
+    t = *s1;                    /* get the next transaction id */
+    if (s2[lo] > t) {           /* if it lies further in the list */
+      for (k = 1; 1; k += k) {  /* double the step width */
+        hi = (k < n2-lo) ? lo+k : n2;
+        if ((hi >= n2) || (s2[hi] <= t)) break;
+        lo = hi;                /* exponential search for a range */
+      }                         /* with s2[lo] > t >= s2[hi] */
+      while (hi -lo > 1) {      /* bisect the found range */
+        k = lo +((hi-lo) >> 1); /* (hi == n2 refers to the */
+        if (s2[k] > t) lo = k;  /* sentinel, which is smaller */
+        else           hi = k;  /* than any transaction id) */
+      }                         /* get the first transaction id */
+      lo = hi;                  /* that is not larger than the */
+    }                           /* searched transaction id */
+    if (lo >= n2) break;        /* if the list is exhausted, abort */
+    if (s2[lo] == t) { w += muls[*d++ = t]; lo++; }
+  }                             /* copy equal elements to destination */
+  *supp += w;                   /* add the weight of the matches */
+  return d;                     /* return the new end of the dest. */
+}  /* gallop() */
+
+/*--------------------------------------------------------------------*/
+#ifdef ACC_SIMD
+
+__attribute__((target("sse2")))
+static TID* mrg_sse2 (TID *d, const TID *s1, TID n1,
+                      const TID *s2, TID n2,
+                      const SUPP *muls, SUPP *supp)
+{                               /* --- merge with 4x4 blocks (SSE2) */
+  TID     i, j, t;              /* list indices, buffer */
+  int     m;                    /* match mask of a block */
+  SUPP    w = 0;                /* sum of transaction weights */
+  __m128i a, b, c;              /* blocks of the lists, comparison */
+
+  for (i = j = 0; (i+4 <= n1) && (j+4 <= n2); ) {
+    a = _mm_loadu_si128((const __m128i*)(s1+i));
+    b = _mm_loadu_si128((const __m128i*)(s2+j));
+    c =              _mm_cmpeq_epi32(a, b);
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x39)));
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x4e)));
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x93)));
+    m = _mm_movemask_ps(_mm_castsi128_ps(c));
+    if (m != 0) {               /* if there are matches in the block */
+      for (t = i; t < i+4; t++, m >>= 1) {
+        w += muls[*d = s1[t]] *(SUPP)(m & 1);
+        d += m & 1;             /* store all elements of the block, */
+      }                         /* but advance the destination only */
+    }                           /* for matches (avoids branches) */
+    t = s1[i+3] -s2[j+3];       /* advance in the list(s) with */
+    i += (t >= 0) ? 4 : 0;      /* the larger last element, since */
+    j += (t <= 0) ? 4 : 0;      /* all following elements of the */
+  }                             /* other list are smaller */
+  *supp += w;                   /* add the weight of the matches */
+  return merge(d, s1+i, s2+j, muls, supp);
+}  /* mrg_sse2() */             /* intersect the rest of the lists */
+
+/*--------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+static TID* mrg_avx2 (TID *d, const TID *s1, TID n1,
+                      const TID *s2, TID n2,
+                      const SUPP *muls, SUPP *supp)
+{                               /* --- merge with 8x8 blocks (AVX2) */
+  TID     i, j, t;              /* list indices, buffer */
+  int     k, m;                 /* loop variable, match mask */
+  SUPP    w = 0;                /* sum of transaction weights */
+  __m256i a, b, c, r;           /* blocks of the lists, comparison */
+
+  r = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  for (i = j = 0; (i+8 <= n1) && (j+8 <= n2); ) {
+    a = _mm256_loadu_si256((const __m256i*)(s1+i));
+    b = _mm256_loadu_si256((const __m256i*)(s2+j));
+    c = _mm256_cmpeq_epi32(a, b);
+    for (k = 1; k < 8; k++) {   /* rotate the second block */
+      b = _mm256_permutevar8x32_epi32(b, r);
+      c = _mm256_or_si256(c, _mm256_cmpeq_epi32(a, b));
+    }                           /* and compare all pairs */
+    m = _mm256_movemask_ps(_mm256_castsi256_ps(c));
+    if (m != 0) {               /* if there are matches in the block */
+      for (t = i; t < i+8; t++, m >>= 1) {
+        w += muls[*d = s1[t]] *(SUPP)(m & 1);
+        d += m & 1;             /* copy the matches and advance */
+      }                         /* in the list(s) with the larger */
+    }                           /* last element of the block */
+    t = s1[i+7] -s2[j+7];
+    i += (t >= 0) ? 8 : 0;
+    j += (t <= 0) ? 8 : 0;
+  }
+  *supp += w;                   /* add the weight of the matches */
+  return mrg_sse2(d, s1+i, n1-i, s2+j, n2-j, muls, supp);
+}  /* mrg_avx2() */             /* intersect the rest of the lists */
+
+/* The intersection kernels are the same as in eclat.c, where the  */
+/* block comparison and galloping search are explained in detail.  */
+
+#endif
+/*--------------------------------------------------------------------*/
+
 static TID isect (TIDLIST *dst, TIDLIST *src1, TIDLIST *src2,SUPP *muls)
 {                               /* --- intersect two tid lists */
-  TID *s1, *s2, *d;             /* to traverse sources and dest. */
+  TIDLIST *a, *b;               /* shorter and longer source list */
+  TID     *d;                   /* end of the destination list */
 
   assert(dst && src1 && src2    /* check the function arguments */
   &&    (src1->tids[0] >= 0) && (src2->tids[0] >= 0) && muls);
   dst->item = src1->item;       /* copy the first item and */
   dst->supp = 0;                /* initialize the support */
-  if (src1->supp > src2->supp) { s2 = src1->tids; s1 = src2->tids; }
-  else                         { s1 = src1->tids; s2 = src2->tids; }
-  d = dst->tids;                /* get sources and destination */
-  while (1) {                   /* tid list intersection loop */
-    if      (*s1 < *s2) s2++;   /* if one transaction id is larger, */
-    else if (*s1 > *s2) s1++;   /* simply skip this transaction id */
-    else if (*s1 < 0) break;    /* check for the sentinel */
-    else { dst->supp += muls[*d++ = *s1++]; s2++; }
-  }                             /* copy equal elements to destination */
+  if (src1->cnt > src2->cnt) { a = src2; b = src1; }
+  else                       { a = src1; b = src2; }
+  if (b->cnt /GALLOP > a->cnt)  /* if the lengths differ much, */
+    d = gallop(dst->tids, a->tids, b->tids, b->cnt, muls, &dst->supp);
+  #ifdef ACC_SIMD               /* if SIMD kernels can be used */
+  else if ((sizeof(TID) == 4) && __builtin_cpu_supports("avx2"))
+    d = mrg_avx2(dst->tids, a->tids, a->cnt, b->tids, b->cnt,
+                 muls, &dst->supp);
+  else if ((sizeof(TID) == 4) && __builtin_cpu_supports("sse2"))
+    d = mrg_sse2(dst->tids, a->tids, a->cnt, b->tids, b->cnt,
+                 muls, &dst->supp);
+  #endif                        /* otherwise use a plain merge */
+  else d = merge(dst->tids, a->tids, b->tids, muls, &dst->supp);
+  dst->cnt = (TID)(d -dst->tids);
   *d++ = (TID)-1;               /* store a sentinel at the list end */
   return (TID)(d -dst->tids);   /* return the size of the new list */
 }  /* isect() */
 
 /*--------------------------------------------------------------------*/
 
-static TID filter (TIDLIST *dst, TIDLIST *src, SUPP *muls)
+static TID filter (TIDLIST *dst, TIDLIST *src, TIDLIST *ref,
+                   SUPP *muls)
 {                               /* --- filter a tid list */
   SUPP m;                       /* multiplicity of transaction */
   TID  *s, *d;                  /* to traverse source and dest. */
 
-  assert(dst && src && muls);   /* check function arguments */
+  assert(dst && src && ref && muls); /* check function arguments */
   dst->item = src->item;        /* copy the first item and */
   dst->supp = 0;                /* initialize the support */
-  for (d = dst->tids, s = src->tids; *s >= 0; s++)
-    if ((m = muls[*s]) > 0) {   /* collect the marked trans. ids and */
-      dst->supp += m; *d++ = *s; }    /* sum the transaction weights */
+  if (src->cnt /GALLOP > ref->cnt)   /* if the marked tid list */
+    d = gallop(dst->tids, ref->tids, src->tids, src->cnt,
+               muls, &dst->supp);    /* is much shorter, search */
+  else {                        /* its ids in the source list */
+    for (d = dst->tids, s = src->tids; *s >= 0; s++)
+      if ((m = muls[*s]) > 0) { /* collect the marked trans. ids and */
+        dst->supp += m; *d++ = *s; }  /* sum the transaction weights */
+  }
+  dst->cnt = (TID)(d -dst->tids);
   *d++ = (TID)-1;               /* store a sentinel at the list end */
   return (TID)(d -dst->tids);   /* return the size of the new list */
 }  /* filter() */
@@ -257,6 +412,25 @@ static int cmp (const void *a, const void *b, void *data)
 
 /*--------------------------------------------------------------------*/
 
+static double pvalue (ACCRET *accret, SUPP supp, SUPP body, SUPP head)
+{                               /* --- compute/look up a p-value */
+  size_t   h;                   /* hash value of the support triple */
+  STATMEMO *m;                  /* cache entry for the triple */
+
+  assert(accret && accret->memo);  /* check the function arguments */
+  h = (size_t)supp *2654435761u /* compute a hash value */
+    ^ (size_t)body *2246822519u /* of the support triple */
+    ^ (size_t)head *3266489917u;
+  m = accret->memo +((h ^ (h >> 15)) & (MEMOSIZE-1));
+  if ((m->supp != supp) || (m->body != body) || (m->head != head)) {
+    m->supp = supp; m->body = body; m->head = head;
+    m->pval = accret->statfn(supp, body, head, accret->ttw);
+  }                             /* compute the test statistic */
+  return m->pval;               /* if it is not in the cache and */
+}  /* pvalue() */               /* return the (cached) p-value */
+
+/*--------------------------------------------------------------------*/
+
 static SUPP recurse (ACCRET *accret, TIDLIST **lists, ITEM k, size_t x)
 {                               /* --- eclat recursion with i.section */
   int     r;                    /* error status */
@@ -297,7 +471,7 @@ static SUPP recurse (ACCRET *accret, TIDLIST **lists, ITEM k, size_t x)
           if (d->supp < accret->supp)
             continue;           /* skip items that are infrequent */
           s = accret->lists[lists[j]->item]->supp;
-          d->pval = accret->statfn(d->supp, l->supp, s, accret->ttw);
+          d->pval = pvalue(accret, d->supp, l->supp, s);
           proj[++m] = d = (TIDLIST*)(p = d->tids +x);
         } }                     /* collect tid lists of sign. items */
       else {                    /* if there are many items left */
@@ -305,14 +479,14 @@ static SUPP recurse (ACCRET *accret, TIDLIST **lists, ITEM k, size_t x)
           accret->marks[*q] = accret->muls[*q];    /* current list */
         for (j = 0; j < k; j++){/* intersect with other tid lists */
           if (j == i) continue; /* (skip the current item) */
-          x = (size_t)filter(d, lists[j], accret->marks);
+          x = (size_t)filter(d, lists[j], l, accret->marks);
           if (d->supp < accret->supp)
             continue;           /* skip items that are infrequent */
           s = accret->lists[lists[j]->item]->supp;
           d->pval = (!accret->invbxs
                  || ((double)d->supp *(double)accret->ttw
                   >  (double)l->supp *(double)s))
-                  ? accret->statfn(d->supp, l->supp, s, accret->ttw) :1;
+                  ? pvalue(accret, d->supp, l->supp, s) : 1;
           proj[++m] = d = (TIDLIST*)(p = d->tids +x);
         }                       /* collect tid lists of sign. items */
         for (q = l->tids; *q >= 0; q++)
@@ -372,6 +546,17 @@ int accret_base (ACCRET *accret)
   x = tbg_extent(accret->tabag);/* get the number of item occurrences */
   p = tids = (TID*)malloc((size_t)k *sizeof(TIDLIST) +x *sizeof(TID));
   if (!p) { free(lists); return -1; } /* allocate tid list elements */
+  accret->memo = (STATMEMO*)malloc(MEMOSIZE *sizeof(STATMEMO));
+  if (!accret->memo) { free(tids); free(lists); return -1; }
+  for (i = 0; i < MEMOSIZE; i++)/* create a p-value cache */
+    accret->memo[i].supp = -1;  /* and mark all entries as empty */
+  if (accret->stat >= RE_FETPROB) {  /* if Fisher's exact test */
+    for (w = 0, i = 0; i < k; i++)    /* find the max. item support */
+      if (ib_getfrq(tbg_base(accret->tabag), i) > w)
+        w = ib_getfrq(tbg_base(accret->tabag), i);
+    if (re_lfinit(w) != 0) {    /* build log-factorials */
+      free(accret->memo); free(tids); free(lists); return -1; }
+  }                             /* (up to the max. item support) */
   for (i = 0; i < k; i++) {     /* traverse the items/tid lists */
     lists[i] = l = (TIDLIST*)p; /* get/create the next tid list */
     l->item  = i;               /* initialize the list item */
@@ -391,6 +576,7 @@ int accret_base (ACCRET *accret)
   for (lists += k, i = m = 0; i < k; i++) {
     l = accret->lists[i];       /* traverse the items and eliminate */
     if (l->supp < accret->supp) continue;       /* infrequent items */
+    l->cnt     = (TID)(next[i] -l->tids);  /* note the list length */
     *next[i]   = (TID)-1;       /* store a sentinel at the list end */
     lists[m++] = l;             /* collect lists for frequent items */
   }                             /* (eliminate infrequent items) */
@@ -403,6 +589,9 @@ int accret_base (ACCRET *accret)
     if (isr_reportv(accret->report, 1) < 0) w = -1; }
   free(tids);                   /* finally report empty set and */
   free(accret->lists);          /* delete the allocated arrays */
+  free(accret->memo); accret->memo = NULL;
+  if (accret->stat >= RE_FETPROB)  /* delete the p-value cache */
+    re_lfexit();                /* and the log-factorial table and */
   return (w < 0) ? (int)w : 0;  /* return the error status */
 }  /* accret_base() */
 
@@ -444,6 +633,7 @@ ACCRET* accret_create (int target, double smin, double smax,
   accret->lists  = NULL;
   accret->muls   = NULL;
   accret->marks  = NULL;
+  accret->memo   = NULL;
   return accret;                 /* return created accretion miner */
 }  /* accret_create() */
 
@@ -95,6 +95,8 @@
             2016.11.04 apriori miner object and interface introduced
             2017.05.30 optional output compression with zlib added
             2017.08.01 bug in calls to apriori_data() fixed (arg. order)
+            2026.10.16 multi-threaded (sharded) counting added (-Y#)
+            2026.10.17 optional compression of the transaction bag (-D)
 ------------------------------------------------------------------------
   Reference for the Apriori algorithm:
     R. Agrawal and R. Srikant.
@@ -365,6 +367,9 @@ int apriori_data (APRIORI *apriori, TABAG *tabag, int mode, int sort)
     if (!(mode & APR_NOREDUCE)) /* if to combine equal transactions, */
       tbg_reduce(tabag, 0);     /* reduce transactions to unique ones */
   }                             /* (need sorting for reduction) */
+  if ((mode & APR_COMPRESS)     /* if to compress the transactions */
+  &&  !(apriori->mode & APR_TATREE))   /* and to count the bag, */
+    tbg_compress(tabag);        /* encode the items as differences */
   #ifndef QUIET                 /* if to print messages */
   n = tbg_cnt(tabag);           /* get the number of transactions */
   w = tbg_wgt(tabag);           /* and the transaction weight */
@@ -412,7 +417,8 @@ int apriori_report (APRIORI *apriori, ISREPORT *report)
 
 /*--------------------------------------------------------------------*/
 
-int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
+int apriori_mine (APRIORI *apriori, ITEM prune, double filter,
+                  int order, int threads)
 {                               /* --- apriori algorithm */
   ITEM    m, i, k;              /* number of items, loop variables */
   ITEM    size;                 /* number of items in set/rule */
@@ -446,6 +452,7 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
   apriori->istree = ist_create(tbg_base(apriori->tabag), mode,
                          apriori->supp, apriori->body, apriori->conf);
   if (!apriori->istree) return cleanup(apriori);
+  ist_setthds(apriori->istree, threads);  /* set number of threads */
   xmax = ((apriori->target & (ISR_CLOSED|ISR_MAXIMAL))
       && !(apriori->target & ISR_RULES)
       &&  (apriori->zmax   < ITEM_MAX))
@@ -463,6 +470,8 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
   m = tbg_itemcnt(apriori->tabag); /* create an item map for pruning */
   apriori->map = (ITEM*)malloc((size_t)m *sizeof(ITEM));
   if (!apriori->map) return cleanup(apriori);
+  if (tbg_iscomp(apriori->tabag))
+    filter = 0;                 /* compressed bags cannot be filtered */
   for (i = m; 1; ) {            /* traverse the item set sizes */
     #ifdef APR_ABORT            /* if to check for interrupt: */
     if (sig_aborted()) break;   /* if execution was aborted, */
@@ -498,8 +507,9 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
     XMSG(stderr, " %"ITEM_FMT, size);          /* and print it */
     x = clock();                /* start the timer for counting */
     if (apriori->tatree) ist_countx(apriori->istree, apriori->tatree);
-    else                 ist_countb(apriori->istree, apriori->tabag);
-    ist_commit(apriori->istree);/* count the transaction tree/bag */
+    else if (ist_countb(apriori->istree, apriori->tabag) < 0)
+      return cleanup(apriori);  /* count the transaction tree/bag */
+    ist_commit(apriori->istree);/* and commit the counters */
     tc = clock() -x;            /* compute the new counting time */
   }
   free(apriori->map);           /* delete the filter map */
@@ -976,7 +986,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)    /* open the output file and */
     error(E_NOMEM);             /* set up the item set reporter */
-  k = apriori_mine(apriori, prune, 0.0, 0);
+  k = apriori_mine(apriori, prune, 0.0, 0, 1);
   if (k) error(k);              /* find frequent item sets */
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
@@ -1040,6 +1050,7 @@ int main (int argc, char *argv[])
   int     sort     = 2;         /* flag for item sorting and recoding */
   int     algo     = APR_BASIC; /* variant of apriori algorithm */
   int     mode     = APR_DEFAULT|APR_PREFMT;     /* search mode */
+  int     prep     = 0;         /* data preparation mode */
   ITEM    prune    = ITEM_MIN;  /* (min. size for) evaluation pruning */
   double  filter   = 0.01;      /* item usage filtering parameter */
   int     order    = 0;         /* size order item set/rule output */
@@ -1047,6 +1058,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     threads  = 1;         /* number of threads to use */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -1108,6 +1120,12 @@ int main (int argc, char *argv[])
                     "(default: prune)\n");
     printf("-y       a-posteriori pruning of infrequent item sets\n");
     printf("-T       do not organize transactions as a prefix tree\n");
+    printf("-Y#      number of threads for support counting   "
+                    "(default: %d)\n", threads);
+    printf("         (a value <= 0 means one thread per cpu)\n");
+    printf("-D       compress transactions in memory          "
+                    "(default: no)\n");
+    printf("         (only together with option -T)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -1155,7 +1173,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: l [A-Z]\[CFINPRSTZ] */
+  /* free option characters: l [A-Z]\[CFINPRSTYZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse the arguments */
@@ -1182,6 +1200,8 @@ int main (int argc, char *argv[])
           case 'x': mode  &= ~APR_PERFECT;           break;
           case 'y': mode  |=  APR_POST;              break;
           case 'T': mode  &= ~APR_TATREE;            break;
+          case 'Y': threads = (int)strtol(s, &s, 0); break;
+          case 'D': prep  |= APR_COMPRESS;           break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
@@ -1324,7 +1344,7 @@ int main (int argc, char *argv[])
   apriori = apriori_create(target, smin, smax, conf, zmin, zmax,
                            eval, agg, thresh, algo, mode);
   if (!apriori) error(E_NOMEM); /* create an Apriori miner */
-  k = apriori_data(apriori, tabag, 0, sort);
+  k = apriori_data(apriori, tabag, prep, sort);
   if (k) error(k);              /* prepare data for Apriori */
   report = isr_create(ibase);   /* create an item set reporter */
   if (!report) error(E_NOMEM);  /* and configure it */
@@ -1340,7 +1360,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)    /* open the output file and */
     error(E_NOMEM);             /* set up the item set reporter */
-  k = apriori_mine(apriori, prune, filter, order);
+  k = apriori_mine(apriori, prune, filter, order, threads);
   if (k) error(k);              /* find frequent item sets */
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
@@ -9,6 +9,8 @@
             2014.08.28 functions apr_data() and apr_report() added
             2016.11.04 apriori miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 parameter 'threads' added to apriori_mine()
+            2026.10.17 data preparation mode APR_COMPRESS added
 ----------------------------------------------------------------------*/
 #ifndef __APRIORI__
 #define __APRIORI__
@@ -32,6 +34,7 @@
 #define APR_NOFILTER  0x0002    /* do not filter transactions by size */
 #define APR_NOSORT    0x0004    /* do not sort items and transactions */
 #define APR_NOREDUCE  0x0008    /* do not reduce transactions */
+#define APR_COMPRESS  0x0020    /* compress the transaction bag */
 
 /* --- evaluation measures --- */
 /* most measure definitions in ruleval.h */
@@ -84,5 +87,5 @@ extern int      apriori_data   (APRIORI *apriori, TABAG *tabag,
                                 int mode, int sort);
 extern int      apriori_report (APRIORI *apriori, ISREPORT *report);
 extern int      apriori_mine   (APRIORI *apriori, ITEM prune,
-                                double filter, int order);
+                                double filter, int order, int threads);
 #endif
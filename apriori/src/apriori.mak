@@ -9,6 +9,7 @@
 #           2011.10.18 special program version apriacc added
 #           2013.10.19 modules tabread and patspec added
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 external module tpool added (thread pool)
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\apriori\src
 UTILDIR  = ..\..\util\src
@@ -27,7 +28,8 @@ LIBS     =
 HDRS_1   = $(UTILDIR)\fntypes.h    $(UTILDIR)\arrays.h    \
            $(UTILDIR)\symtab.h     $(MATHDIR)\gamma.h     \
            $(MATHDIR)\chi2.h       $(MATHDIR)\ruleval.h   \
-           $(TRACTDIR)\tract.h     $(TRACTDIR)\report.h
+           $(TRACTDIR)\tract.h     $(TRACTDIR)\report.h   \
+           $(UTILDIR)\tpool.h
 HDRS     = $(HDRS_1)               $(UTILDIR)\error.h     \
            $(UTILDIR)\tabread.h    $(UTILDIR)\tabwrite.h  \
            $(TRACTDIR)\patspec.h   istree.h
@@ -37,7 +39,7 @@ OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\idmap.obj   \
            $(MATHDIR)\gamma.obj    $(MATHDIR)\chi2.obj    \
            $(MATHDIR)\ruleval.obj  $(TRACTDIR)\tatree.obj \
            $(TRACTDIR)\patspec.obj $(TRACTDIR)\report.obj \
-           isttat.obj
+           $(UTILDIR)\tpool.obj   isttat.obj
 PRGS     = apriori.exe apriacc.exe
 
 #-----------------------------------------------------------------------
@@ -100,6 +102,10 @@ $(UTILDIR)\scform.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak scform.obj   ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(UTILDIR)\tpool.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak tpool.obj    ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(MATHDIR)\gamma.obj:
 	cd $(MATHDIR)
 	$(MAKE) /f math.mak gamma.obj    ADDFLAGS="$(ADDFLAGS)"
@@ -91,6 +91,14 @@
             2014.11.14 bug in function evaluate() fixed (negative index)
             2015.02.25 bug in function r4set() fixed (ITEMOF(node))
             2016.11.19 bug in function ist_filter() fixed (path length)
+            2026.10.16 sharded (multi-threaded) counting added
+            2026.10.17 candidate rules evaluated in batches
+            2026.10.17 log-factorial table for Fisher's exact test
+            2026.10.17 transaction bags traversed with cursors
+            2026.10.17 bitmap indexed compact child arrays added
+            2026.10.17 sparse nodes compacted when pruning counters
+            2026.10.17 log-factorial table limited to max. item support
+            2026.10.17 narrow (16 bit) counters with promotion added
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -101,6 +109,7 @@
 #include "istree.h"
 #include "chi2.h"
 #include "gamma.h"
+#include "tpool.h"
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -134,6 +143,10 @@
 #define IS2SKIP(n)  signbit(n)
 #define COUNT(n)    copysign((n),+1.0)
 #define INC(n,w)    ((n) += copysign((w),(n)))
+#define ISNARROW(n) 0           /* no narrow counters for doubles */
+#define WIDEN(c)    ((SUPP)(c)) /* (all nodes use wide counters) */
+#define NARROWED(s) ((NCNT)(s))
+#define NARROWOK(s) 0
 /* Double precision floating-point support requires the compiler   */
 /* and the underlying system to comply with the IEEE standard for  */
 /* floating-point arithmetic (IEEE 754), which allows for a number */
@@ -149,13 +162,49 @@
 #define IS2SKIP(n)  ((n) < 0)
 #define COUNT(n)    ((n) &  ~SKIP)
 #define INC(n,w)    ((n) += (w))
+#define ISNARROW(n) ((n)->index < 0)
+#define WIDEN(c)    (((c) & NSKIP) ? (SUPP)((c) & NMAX) | SKIP \
+                                   : (SUPP)(c))
+#define NARROWED(s) ((NCNT)(IS2SKIP(s) ? (COUNT(s) | NSKIP) : (s)))
+#define NARROWOK(s) (COUNT(s) <= NMAX)
 #endif
 #undef int                      /* remove preprocessor definitions */
 #undef long                     /* needed for the type checking */
 #undef double
+#define NARROW      ITEM_MIN    /* flag for narrow (16 bit) counters */
+#define NSKIP       0x8000      /* skip flag of a narrow counter */
+#define NMAX        0x7fff      /* maximum value of a narrow counter */
+#define SHDIDX(n)   ((n)->index & ~NARROW)
+#define NCNTS(n)    ((NCNT*)(n)->cnts)
+#define NINC(n,w)   ((n) = (NCNT)((n) +(w)))
+#define CNTSIZE(k,w) ((w) ? (size_t)(((k)+1) & ~1) *sizeof(NCNT) \
+                          : (size_t) (k)          *sizeof(SUPP))
+#define NODESIZE(k,w) (sizeof(ISTNODE) -sizeof(SUPP) +CNTSIZE(k,w))
+#define CNTEND(n)   ((void*)((char*)(n)->cnts \
+                      +CNTSIZE((n)->size, ISNARROW(n))))
+#define CNT(n,i)    (ISNARROW(n) ? WIDEN(NCNTS(n)[i]) : (n)->cnts[i])
+#define SETCNT(n,i,s) (ISNARROW(n) ? (void)(NCNTS(n)[i] = NARROWED(s)) \
+                                   : (void)((n)->cnts[i] = (s)))
+#define SETSKIPAT(n,i) (ISNARROW(n) ? (void)(NCNTS(n)[i] |= NSKIP) \
+                                    : (void)SETSKIP((n)->cnts[i]))
+#define CLRSKIPAT(n,i) (ISNARROW(n) ? (void)(NCNTS(n)[i] &= NMAX) \
+                                    : (void)CLRSKIP((n)->cnts[i]))
+#define INCAT(c,s,i,w) ((s) ? (void)NINC((s)[i], w) \
+                            : (void)INC ((c)[i], w))
+/* A node whose item set has a support of at most NMAX (as recorded */
+/* in its parent when the node is created) uses 16 bit counters,    */
+/* since the support of no extension can exceed this support. The   */
+/* highest bit serves as the skip flag, just as for wide counters.  */
+/* The narrow flag is the highest bit of the shard index, which is  */
+/* kept if the index is set. Counters are read and written with the */
+/* macros CNT(), SETCNT(), SETSKIPAT() and CLRSKIPAT(), which yield */
+/* and take wide counter values (with the skip flag as SKIP). If a  */
+/* support is set or increased above NMAX from the outside (with    */
+/* ist_setsupp() or ist_incsupp()), the node is promoted to wide    */
+/* counters. The root node always uses wide counters.               */
 #define CHILDCNT(n) ((n)->chcnt & ~ITEM_MIN)
 #define ITEMAT(n,i) (((n)->offset >= 0) ? (n)->offset +(i) \
-                      : ((ITEM*)((n)->cnts +(n)->size))[i])
+                      : ((ITEM*)CNTEND(n))[i])
 
 #ifdef ALIGN8                   /* if aligned 64 bit architecture */
 #define PAD(p)      ((((size_t)(p) -1) & 7) ^ 7)
@@ -167,9 +216,56 @@
 /* Note that not all 64 bit architectures need pointers to be aligned */
 /* to addresses divisible by 8. Use ALIGN8 only if this is the case.  */
 
+#define TASKCNT     16          /* number of counting tasks/thread */
+#define BLKSIZE     4096        /* block size for reducing the shards */
+
+#define BLKBITS     32          /* number of bits in a bitmap block */
+#define BLKCNT(n)   ((n)/BLKBITS+2)  /* number of bitmap blocks */
+#define HASCHN(b,i) ((b)[(i)/BLKBITS].bits & (1u << ((i)%BLKBITS)))
+#define CHNIDX(b,i) ((b)[(i)/BLKBITS].rank +(ITEM)bitcnt( \
+                     (b)[(i)/BLKBITS].bits & ((1u << ((i)%BLKBITS))-1)))
+#define CHNRNG(c,n) (((CHNBLK*)((c)+(n)))->rank)
+#define CHNMAP(c,n) ((CHNRNG(c,n) < (n)) ? NULL : (CHNBLK*)((c)+(n))+1)
+
+#ifdef __GNUC__                 /* if GNU C compiler (or compatible) */
+#define bitcnt(b)   __builtin_popcount(b)
+#endif                          /* use built-in population count */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef unsigned short NCNT;    /* narrow (16 bit) counter */
+
+typedef struct {                /* --- sharded counting data --- */
+  ISTREE       *ist;            /* item set tree to count into */
+  const TABAG  *bag;            /* transaction bag to count */
+  #ifdef TATREEFN               /* if transaction tree functions */
+  const TANODE *tan;            /* root of the transaction tree */
+  #endif                        /* (root children are tasks) */
+  TID          cnt;             /* number of transactions */
+  long         tasks;           /* number of tasks */
+} ISTPAR;                       /* (sharded counting data) */
+
+typedef struct {                /* --- child array bitmap block --- */
+  ITEM         rank;            /* number of children before block */
+  unsigned int bits;            /* flags for the children in block */
+} CHNBLK;                       /* (child array bitmap block) */
+
 /*----------------------------------------------------------------------
   Auxiliary Functions
 ----------------------------------------------------------------------*/
+#ifndef bitcnt
+
+static int bitcnt (unsigned int b)
+{                               /* --- count the set bits */
+  b = b -((b >> 1) & 0x55555555);
+  b = (b & 0x33333333) +((b >> 2) & 0x33333333);
+  b = (b +(b >> 4)) & 0x0f0f0f0f;
+  return (int)((b *0x01010101) >> 24);
+}  /* bitcnt() */
+
+#endif
+/*--------------------------------------------------------------------*/
 
 static ITEM search (ITEM id, ISTNODE **chn, ITEM n)
 {                               /* --- find a child node (index) */
@@ -209,6 +305,92 @@ static ITEM bisect (ITEM id, ISTNODE **chn, ITEM n)
 #endif
 /*--------------------------------------------------------------------*/
 
+static ITEM chnidx (ITEM id, ISTNODE **chn, ITEM n)
+{                               /* --- find a child node (bitmap) */
+  CHNBLK *blk;                  /* bitmap of the child node array */
+
+  assert(chn && (n > 0));       /* check the function arguments */
+  id -= ITEMOF(chn[0]);         /* compute the bitmap index */
+  if ((id < 0) || (id > CHNRNG(chn, n)))
+    return (ITEM)-1;            /* check against the item range */
+  blk = CHNMAP(chn, n);         /* get the bitmap (after pointers) */
+  if (!blk) return id;          /* if there are no gaps, no bitmap */
+  return (HASCHN(blk, id)) ? CHNIDX(blk, id) : (ITEM)-1;
+}  /* chnidx() */               /* return the child node index */
+
+/*--------------------------------------------------------------------*/
+
+static void mkbmap (ISTNODE **chn, ITEM n)
+{                               /* --- build child array bitmap */
+  ITEM   i, k, o;               /* loop variables, item offset */
+  CHNBLK *blk;                  /* bitmap of the child node array */
+
+  assert(chn && (n > 0));       /* check the function arguments */
+  o   = ITEMOF(chn[0]);         /* get the item of the first child */
+  blk = (CHNBLK*)(chn +n);      /* and the bitmap header and store */
+  blk->rank = ITEMOF(chn[n-1]) -o;   /* the range of the items */
+  blk->bits = 0;                /* (needed to find the item index) */
+  if (blk->rank < n) return;    /* if there are no gaps, abort */
+  for (k = BLKCNT(blk->rank); --k > 0; )
+    blk[k].bits = 0;            /* clear the bitmap blocks */
+  blk += 1;                     /* skip the bitmap header */
+  for (i = 0; i < n; i++) {     /* traverse the child nodes */
+    k = ITEMOF(chn[i]) -o;      /* and set their bitmap flags */
+    blk[k/BLKBITS].bits |= 1u << (k%BLKBITS);
+  }                             /* (children are sorted by item) */
+  for (i = k = 0; i < n; k++) { /* traverse the bitmap blocks */
+    blk[k].rank = i;            /* note the preceding children */
+    i += (ITEM)bitcnt(blk[k].bits);
+  }                             /* and sum the children */
+}  /* mkbmap() */
+
+/* A pure counter array is combined with a compact child node array, */
+/* that is, an array that contains only the existing children, and a */
+/* bitmap that covers the range of items from the first to the last  */
+/* child. With this bitmap the index of the child for an item can be */
+/* computed without a search, since the number of children before    */
+/* each bitmap block is stored together with the block. The bitmap   */
+/* costs 2 bits per item (in addition to the pointers), while a pure */
+/* child node array would cost a full pointer per item in the range. */
+/* The bitmap is preceded by a header block that stores the range of */
+/* the items, so that the last child need not be accessed. If there  */
+/* are no gaps in the range, the child node array is indexed directly */
+/* with the item offset and the bitmap is unused. Its space is still  */
+/* reserved, though, because pruning empty children may create gaps. */
+
+/*--------------------------------------------------------------------*/
+
+static ISTNODE** slot (ISTNODE *node)
+{                               /* --- get pointer to node in parent */
+  ISTNODE *par;                 /* parent of the node */
+  ISTNODE **chn;                /* child node array of the parent */
+  ITEM    i, n;                 /* child index, number of children */
+
+  assert(node);                 /* check the function argument */
+  par = node->parent;           /* get the parent node */
+  if (!par) return NULL;        /* (the root has no parent) */
+  n = CHILDCNT(par);            /* get the number of children */
+  if (par->offset >= 0) {       /* if a pure array is used */
+    chn = (ISTNODE**)CNTEND(par);
+    ALIGN(chn);                 /* get the child node array */
+    i = chnidx(ITEMOF(node), chn, n); }
+  else {                        /* if an identifier map is used */
+    chn = (ISTNODE**)((ITEM*)CNTEND(par) +par->size);
+    ALIGN(chn);                 /* get the child node array */
+    i = search(ITEMOF(node), chn, n);
+  }                             /* find the child node pointer */
+  assert(i >= 0);               /* in the parent node */
+  return chn +i;                /* and return a pointer to it */
+}  /* slot() */
+
+/* The location of the child pointer in the parent node must be  */
+/* retrieved before a node is reallocated, because ITEMOF(chn[0]) */
+/* may access already freed memory after the node has been moved, */
+/* since it may be that node = chn[0] (and the bitmap lookup needs */
+/* the item of the first child).                                   */
+
+/*--------------------------------------------------------------------*/
+
 static SUPP getsupp (ISTNODE *node, ITEM *items, ITEM n)
 {                               /* --- get support of an item set */
   ITEM    i, k;                 /* array indices, number of children */
@@ -220,27 +402,25 @@ static SUPP getsupp (ISTNODE *node, ITEM *items, ITEM n)
     k = CHILDCNT(node);         /* if there are no children, */
     if (k <= 0) return SKIP;    /* the support is less than minsupp */
     if (node->offset >= 0) {    /* if a pure array is used */
-      chn = (ISTNODE**)(node->cnts +node->size);
+      chn = (ISTNODE**)CNTEND(node);
       ALIGN(chn);               /* get the child array index */
-      i = *items -ITEMOF(chn[0]);  /* compute the child array index */
-      if (i >= k) return SKIP; }   /* and check whether entry exists */
+      i = chnidx(*items, chn, k); }  /* look up the child index */
     else {                      /* if an identifier map is used */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
       ALIGN(chn);               /* get the child array index */
       i = search(*items, chn, k);
     }                           /* find the child array index */
     if (i < 0) return SKIP;     /* if child does not exist, abort */
     node = chn[i];              /* go to the corresponding child */
-    if (!node) return SKIP;     /* if child does not exist, abort */
   }                             /* (support is less than minsupp) */
   k = node->size;               /* get the number of counters */
   if (node->offset >= 0) {      /* if a pure array is used, */
     i = *items -node->offset;   /* compute the counter index and */
     if (i >= k) return SKIP; }  /* check whether counter exists */
   else                          /* if an identifier map is used */
-    i = ia_bsearch(*items, (ITEM*)(node->cnts +k), (size_t)k);
+    i = ia_bsearch(*items, (ITEM*)CNTEND(node), (size_t)k);
   if (i < 0) return SKIP;       /* if no counter exists, abort */
-  return node->cnts[i];         /* return the item set support */
+  return CNT(node, i);          /* return the item set support */
 }  /* getsupp() */
 
 /*--------------------------------------------------------------------*/
@@ -257,12 +437,12 @@ static void reclvls (ISTREE *ist, ISTNODE *node, ITEM lvl)
   if (n <= 0) return;           /* if there are no children, abort */
   lvl += 1;                     /* go to the child level */
   if (node->offset >= 0)        /* if a pure array is used */
-    chn = (ISTNODE**)(node->cnts +node->size);
+    chn = (ISTNODE**)CNTEND(node);
   else                          /* if an item map is used */
-    chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+    chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
   ALIGN(chn);                   /* get the child node array */
   for (i = 0; i < n; i++)       /* recursively process the children */
-    if (chn[i]) reclvls(ist, chn[i], lvl);
+    reclvls(ist, chn[i], lvl);
 }  /* reclvls() */
 
 /*--------------------------------------------------------------------*/
@@ -289,12 +469,12 @@ static void delete (ISTNODE *node)
   n = CHILDCNT(node);           /* get the number of children */
   if (n > 0) {                  /* if there are children */
     if (node->offset >= 0)      /* if a pure array is used */
-      chn = (ISTNODE**)(node->cnts +node->size);
+      chn = (ISTNODE**)CNTEND(node);
     else                        /* if an item map is used */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
     ALIGN(chn);                 /* get the child node array */
     for (i = 0; i < n; i++)     /* recursively delete the children */
-      if (chn[i]) delete(chn[i]);
+      delete(chn[i]);
   }
   free(node);                   /* delete the node */
 }  /* delete() */
@@ -303,40 +483,52 @@ static void delete (ISTNODE *node)
   Counting Functions
 ----------------------------------------------------------------------*/
 
-static void count (ISTNODE *node,
-                   const ITEM *items, ITEM n, SUPP wgt, ITEM min)
+static void count (ISTNODE *node, const ITEM *items, ITEM n,
+                   SUPP wgt, ITEM min, SUPP *shd)
 {                               /* --- count transaction recursively */
   ITEM    i, k, o;              /* array index, offset, map size */
   ITEM    *map;                 /* item identifier map */
+  SUPP    *c;                   /* counters to update (node/shard) */
+  NCNT    *s;                   /* narrow counters to update */
   ISTNODE **chn;                /* array of child nodes */
+  CHNBLK  *blk;                 /* bitmap of the child node array */
 
   assert(node                   /* check the function arguments */
   &&    (n >= 0) && (items || (n <= 0)));
   if (node->offset >= 0) {      /* if a pure array is used */
     if (node->chcnt == 0) {     /* if this is a new node (leaf) */
+      c = (shd) ? shd +SHDIDX(node) : node->cnts;
+      s = (shd || !ISNARROW(node)) ? NULL : NCNTS(node);
       o = node->offset;         /* get the index offset */
       while ((n > 0) && (*items < o)) {
         n--; items++; }         /* skip items before first counter */
       while (--n >= 0) {        /* traverse the transaction's items */
         i = *items++ -o;        /* compute the counter array index */
         if (i >= node->size) return;
-        INC(node->cnts[i],wgt); /* if the corresp. counter exists, */
+        INCAT(c, s, i, wgt);    /* if the corresp. counter exists, */
       } }                       /* add the transaction weight to it */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)(node->cnts +node->size);
-      ALIGN(chn);               /* get the child node array and */
-      o   = ITEMOF(chn[0]);     /* the item of the first child */
+      chn = (ISTNODE**)CNTEND(node);
+      ALIGN(chn);               /* get the child node array, */
+      blk = CHNMAP(chn, node->chcnt);   /* its bitmap, */
+      k   = CHNRNG(chn, node->chcnt);   /* the range of the items, */
+      o   = ITEMOF(chn[0]);     /* and the item of the first child */
       while ((n >= min) && (*items < o)) {
         n--; items++; }         /* skip items before the first child */
       for (--min; --n >= min;){ /* traverse the transaction's items */
-        i = *items++ -o;        /* compute the child array index */
-        if (i >= node->chcnt) return;
-        if (chn[i]) count(chn[i], items, n, wgt, min);
+        i = *items++ -o;        /* compute the bitmap index */
+        if (i > k) return;      /* if beyond the last child, abort */
+        if      (!blk)          /* if there are no gaps, */
+          count(chn[i], items, n, wgt, min, shd);
+        else if (HASCHN(blk, i))/* otherwise check the bitmap */
+          count(chn[CHNIDX(blk, i)], items, n, wgt, min, shd);
       }                         /* if the corresp. child node exists, */
     } }                         /* count the transaction recursively */
   else {                        /* if an identifer map is used */
     if (node->chcnt == 0) {     /* if this is a new node (leaf) */
-      map = (ITEM*)(node->cnts +(k = node->size));
+      c   = (shd) ? shd +SHDIDX(node) : node->cnts;
+      s   = (shd || !ISNARROW(node)) ? NULL : NCNTS(node);
+      map = (ITEM*)CNTEND(node); k = node->size;
       o   = map[0];             /* get the identifier map */
       while ((n > 0) && (*items < o)) {
         n--; items++; }         /* skip items before first counter */
@@ -345,14 +537,14 @@ static void count (ISTNODE *node,
         if (*items > o) return; /* if beyond last item, abort */
         #ifdef IST_BSEARCH      /* if to use a binary search */
         i = ia_bsearch(*items, map, (size_t)k);
-        if (i >= 0)           INC(node->cnts[i], wgt);
+        if (i >= 0)           INCAT(c, s, i, wgt);
         #else                   /* if to use a linear search */
         while (map[i] < *items) i++;
-        if (map[i] == *items) INC(node->cnts[i], wgt);
+        if (map[i] == *items) INCAT(c, s, i, wgt);
         #endif                  /* if the corresp. counter exists, */
       } }                       /* add the transaction weight to it */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
       ALIGN(chn);               /* get the child node array and */
       o   = ITEMOF(chn[0]);     /* the index of the first child */
       while ((n >= min) && (*items < o)) {
@@ -367,7 +559,8 @@ static void count (ISTNODE *node,
         #else                   /* if to use a linear search */
         while (ITEMOF(*chn) < *items) chn++;
         #endif                  /* find the child node index */
-        if (ITEMOF(*chn) == *items++) count(*chn, items, n, wgt, min);
+        if (ITEMOF(*chn) == *items++)
+          count(*chn, items, n, wgt, min, shd);
       }                         /* if the corresp. child node exists, */
     }                           /* count the transaction recursively */
   }
@@ -377,12 +570,16 @@ static void count (ISTNODE *node,
 #ifdef TATREEFN
 #ifdef TATCOMPACT
 
-static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
+static void countx (ISTNODE *node, const TANODE *tan, ITEM min,
+                    SUPP *shd)
 {                               /* --- count trans. tree recursively */
   ITEM    i, k, o, n;           /* array indices, loop variables */
   ITEM    item;                 /* buffer for an item */
   ITEM    *map;                 /* item identifier map */
+  SUPP    *c;                   /* counters to update (node/shard) */
+  NCNT    *s;                   /* narrow counters to update */
   ISTNODE **chn;                /* child node array */
+  CHNBLK  *blk;                 /* bitmap of the child node array */
   TANODE  *cld;                 /* child node in transaction tree */
 
   assert(node && tan);          /* check the function arguments */
@@ -390,48 +587,58 @@ static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
   k = n & ~ITEM_MIN;            /* if the transactions are too short, */
   if (k < min) return;          /* abort the recursion */
   if (n <= 0) {                 /* if this is a leaf node */
-    if (n < 0) count(node, tan_suffix(tan), k, tan_wgt(tan), min);
+    if (n < 0) count(node, tan_suffix(tan), k, tan_wgt(tan), min, shd);
     return;                     /* count the transaction suffix */
   }                             /* and abort the function */
   for (cld = tan_children(tan); cld; cld = tan_sibling(cld))
-    countx(node, cld, min);     /* count the transactions recursively */
+    countx(node, cld, min, shd);/* count the trans. recursively */
   if (node->offset >= 0) {      /* if a pure array is used */
     if (node->chcnt == 0) {     /* if this is a new node (leaf) */
+      c = (shd) ? shd +SHDIDX(node) : node->cnts;
+      s = (shd || !ISNARROW(node)) ? NULL : NCNTS(node);
       o = node->offset;         /* get the index offset */
       for (cld = tan_children(tan); cld; cld = tan_sibling(cld)) {
         i = tan_item(cld) -o;   /* traverse the child items */
         if (i < 0) return;      /* if before first item, abort */
-        if (i < node->size) INC(node->cnts[i], tan_wgt(cld));
+        if (i < node->size) INCAT(c, s, i, tan_wgt(cld));
       } }                       /* otherwise add the trans. weight */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)(node->cnts +node->size);
-      ALIGN(chn);               /* get the child node array and */
-      o   = ITEMOF(chn[0]);     /* the item of the first child */
+      chn = (ISTNODE**)CNTEND(node);
+      ALIGN(chn);               /* get the child node array, */
+      blk = CHNMAP(chn, node->chcnt);   /* its bitmap, */
+      k   = CHNRNG(chn, node->chcnt);   /* the range of the items, */
+      o   = ITEMOF(chn[0]);     /* and the item of the first child */
       --min;                    /* traverse the child nodes */
       for (cld = tan_children(tan); cld; cld = tan_sibling(cld)) {
         i = tan_item(cld) -o;   /* traverse the child items */
         if  (i < 0) return;     /* if before first item, abort */
-        if ((i < node->chcnt) && chn[i]) countx(chn[i], cld, min);
+        if  (i > k) continue;   /* skip items after the last child */
+        if      (!blk)          /* if there are no gaps, */
+          countx(chn[i], cld, min, shd);
+        else if (HASCHN(blk, i))/* otherwise check the bitmap */
+          countx(chn[CHNIDX(blk, i)], cld, min, shd);
       }                         /* if the corresp. child node exists, */
     } }                         /* count the trans. tree recursively */
   else {                        /* if an identifer map is used */
     if (node->chcnt == 0) {     /* if this is a new node (leaf) */
-      map = (ITEM*)(node->cnts +(k = node->size));
+      c   = (shd) ? shd +SHDIDX(node) : node->cnts;
+      s   = (shd || !ISNARROW(node)) ? NULL : NCNTS(node);
+      map = (ITEM*)CNTEND(node); k = node->size;
       o   = map[0];             /* get the item identifier map */
       for (cld = tan_children(tan); cld; cld = tan_sibling(cld)) {
         item = tan_item(cld);   /* traverse the child items */
         if (item < o) return;   /* if before the first item, return */
         #ifdef IST_BSEARCH      /* if to use a binary search */
         i = ia_bsearch(item, map, (size_t)k);
-        if (i >= 0) { k = i; INC(node->cnts[k], tan_wgt(cld)); }
+        if (i >= 0) { k = i; INCAT(c, s, k, tan_wgt(cld)); }
         #else                   /* if to use a linear search */
         while (map[--k] > item);
-        if (map[k] == item)  INC(node->cnts[k], tan_wgt(cld));
+        if (map[k] == item)  INCAT(c, s, k, tan_wgt(cld));
         else k++;               /* if the corresp. counter exists, */
         #endif                  /* add the transaction weight to it, */
       } }                       /* otherwise adapt the map index */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
       ALIGN(chn);               /* get the child node array, */
       k   = node->chcnt;        /* the number of children, and */
       o   = ITEMOF(chn[0]);     /* the last item with a child */
@@ -441,10 +648,10 @@ static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
         if (item < o) return;   /* if before the first item, abort */
         #ifdef IST_BSEARCH      /* if to use a binary search */
         i = bisect(item, chn, k);
-        if (i < k)              countx(chn[k = i], cld, min);
+        if (i < k)              countx(chn[k = i], cld, min, shd);
         #else                   /* if to use a linear search */
         while (ITEMOF(chn[--k]) > item);
-        if (ITEMOF(chn[k]) == item) countx(chn[k], cld, min);
+        if (ITEMOF(chn[k]) == item) countx(chn[k], cld, min, shd);
         else k++;               /* if the corresp. counter exists, */
         #endif                  /* count the transaction recursively, */
       }                         /* otherwise adapt the child index */
@@ -455,46 +662,59 @@ static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
 /*--------------------------------------------------------------------*/
 #else  /* #ifdef TATCOMPACT */
 
-static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
+static void countx (ISTNODE *node, const TANODE *tan, ITEM min,
+                    SUPP *shd)
 {                               /* --- count trans. tree recursively */
   ITEM    i, k, o, n;           /* array indices, loop variables */
   ITEM    item;                 /* buffer for an item */
   ITEM    *map;                 /* item identifier map */
+  SUPP    *c;                   /* counters to update (node/shard) */
+  NCNT    *s;                   /* narrow counters to update */
   ISTNODE **chn;                /* child node array */
+  CHNBLK  *blk;                 /* bitmap of the child node array */
 
   assert(node && tan);          /* check the function arguments */
   if (tan_max(tan) < min)       /* if the transactions are too short, */
     return;                     /* abort the recursion */
   n = tan_size(tan);            /* get the number of children */
   if (n <= 0) {                 /* if there are no children */
-    if (n < 0) count(node, tan_items(tan), -n, tan_wgt(tan), min);
+    if (n < 0) count(node, tan_items(tan), -n, tan_wgt(tan), min, shd);
     return;                     /* count the normal transaction */
   }                             /* and abort the function */
   while (--n >= 0)              /* count the transactions recursively */
-    countx(node, tan_child(tan, n), min);
+    countx(node, tan_child(tan, n), min, shd);
   if (node->offset >= 0) {      /* if a pure array is used */
     if (node->chcnt == 0) {     /* if this is a new node (leaf) */
+      c = (shd) ? shd +SHDIDX(node) : node->cnts;
+      s = (shd || !ISNARROW(node)) ? NULL : NCNTS(node);
       o = node->offset;         /* get the index offset */
       for (n = tan_size(tan); --n >= 0; ) {
         i = tan_item(tan, n)-o; /* traverse the node's items */
         if (i < 0) return;      /* if before the first item, abort */
         if (i < node->size)     /* if the corresp. counter exists */
-          INC(node->cnts[i], tan_wgt(tan_child(tan, n)));
+          INCAT(c, s, i, tan_wgt(tan_child(tan, n)));
       } }                       /* add the transaction weight to it */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)(node->cnts +node->size);
-      ALIGN(chn);               /* get the child node array and */
-      o   = ITEMOF(chn[0]);     /* the item of the first child */
+      chn = (ISTNODE**)CNTEND(node);
+      ALIGN(chn);               /* get the child node array, */
+      blk = CHNMAP(chn, node->chcnt);   /* its bitmap, */
+      k   = CHNRNG(chn, node->chcnt);   /* the range of the items, */
+      o   = ITEMOF(chn[0]);     /* and the item of the first child */
       for (--min, n = tan_size(tan); --n >= 0; ) {
         i = tan_item(tan, n)-o; /* traverse the node's items */
         if (i < 0) return;      /* if before the first item, abort */
-        if ((i < node->chcnt) && chn[i])
-          countx(chn[i], tan_child(tan, n), min);
+        if (i > k) continue;    /* skip items after the last child */
+        if      (!blk)          /* if there are no gaps, */
+          countx(chn[i], tan_child(tan, n), min, shd);
+        else if (HASCHN(blk, i))/* otherwise check the bitmap */
+          countx(chn[CHNIDX(blk, i)], tan_child(tan, n), min, shd);
       }                         /* if the corresp. child node exists, */
     } }                         /* count the trans. tree recursively */
   else {                        /* if an identifer map is used */
     if (node->chcnt == 0) {     /* if this is a new node (leaf) */
-      map = (ITEM*)(node->cnts +(k = node->size));
+      c   = (shd) ? shd +SHDIDX(node) : node->cnts;
+      s   = (shd || !ISNARROW(node)) ? NULL : NCNTS(node);
+      map = (ITEM*)CNTEND(node); k = node->size;
       o   = map[0];             /* get the item identifier map */
       for (n = tan_size(tan); --n >= 0; ) {
         item = tan_item(tan,n); /* traverse the node's items */
@@ -502,16 +722,16 @@ static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
         #ifdef IST_BSEARCH      /* if to use a binary search */
         i = ia_bsearch(item, map, (size_t)k);
         if (i >= 0) { k = i;    /* if counter exists, add trans. wgt. */
-          INC(node->cnts[k], tan_wgt(tan_child(tan, n))); }
+          INCAT(c, s, k, tan_wgt(tan_child(tan, n))); }
         #else                   /* if to use a linear search */
         while (map[--k] > item);
         if (map[k] == item)     /* if the corresp. counter exists */
-          INC(node->cnts[k], tan_wgt(tan_child(tan, n)));
+          INCAT(c, s, k, tan_wgt(tan_child(tan, n)));
         else k++;               /* add the transaction weight to it, */
         #endif                  /* otherwise adapt the map index */
       } }
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
       ALIGN(chn);               /* get the child node array, */
       k   = node->chcnt;        /* the number of children, and */
       o   = ITEMOF(chn[0]);     /* the last item with a child */
@@ -520,11 +740,11 @@ static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
         if (item < o) return;   /* if before the first item, abort */
         #ifdef IST_BSEARCH      /* if to use a binary search */
         i = search(item, chn, k);
-        if (i >= 0) countx(chn[k = i], tan_child(tan, n), min);
+        if (i >= 0) countx(chn[k = i], tan_child(tan, n), min, shd);
         #else                   /* if to use a linear search */
         while (ITEMOF(chn[--k]) > item);
         if (ITEMOF(chn[k]) == item)
-          countx(chn[k], tan_child(tan, n), min);
+          countx(chn[k], tan_child(tan, n), min, shd);
         else k++;               /* if the corresp. counter exists, */
         #endif                  /* count the transaction recursively, */
       }                         /* otherwise adapt the child index */
@@ -534,21 +754,193 @@ static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
 
 #endif  /* #ifdef TATCOMPACT .. #else .. */
 #endif  /* #ifdef TATREEFN */
+/*----------------------------------------------------------------------
+  Sharded Counting Functions
+----------------------------------------------------------------------*/
+
+static int red_task (void *data, int thread, long task)
+{                               /* --- reduce a block of the shards */
+  int    k;                     /* loop variable for shards */
+  size_t i, e;                  /* counter index range of block */
+  SUPP   *dst, *src;            /* destination and source shard */
+  ISTREE *ist;                  /* item set tree to count into */
+
+  assert(data && (task >= 0));  /* check the function arguments */
+  ist = ((ISTPAR*)data)->ist;   /* get the item set tree */
+  i   = (size_t)task *BLKSIZE;  /* compute the block boundaries */
+  e   = i +BLKSIZE; if (e > ist->shsz) e = ist->shsz;
+  dst = ist->shards;            /* sum counters in the first shard */
+  for (k = 1; k < ist->shcnt; k++) {
+    src = ist->shards +(size_t)k *ist->shsz;
+    for (i = (size_t)task *BLKSIZE; i < e; i++) {
+      dst[i] += src[i]; src[i] = 0; }
+  }                             /* add the counters of other shards */
+  return 0;                     /* and clear them for the next level */
+}  /* red_task() */
+
+/*--------------------------------------------------------------------*/
+
+static void reduce (ISTREE *ist)
+{                               /* --- reduce the counter shards */
+  ITEM    i;                    /* loop variable for counters */
+  long    k;                    /* loop variable for blocks */
+  SUPP    *c;                   /* counters of a node in first shard */
+  NCNT    *s;                   /* narrow counters of a node */
+  ISTNODE *node;                /* to traverse the nodes */
+  ISTPAR  par;                  /* data for the reduction tasks */
+
+  assert(ist && (ist->shcnt > 0));  /* check the function argument */
+  par.ist   = ist;              /* sum the shards block by block */
+  par.tasks = (long)((ist->shsz +BLKSIZE-1) /BLKSIZE);
+  if (tp_exec(ist->shcnt, par.tasks, red_task, &par) < 0)
+    for (k = 0; k < par.tasks; k++) red_task(&par, 0, k);
+  for (node = ist->lvls[ist->height-1]; node; node = node->succ) {
+    c = ist->shards +SHDIDX(node);
+    s = (ISNARROW(node)) ? NCNTS(node) : NULL;
+    for (i = 0; i < node->size; i++) {
+      INCAT(node->cnts, s, i, c[i]); c[i] = 0; }
+  }                             /* add the sums to the node counters */
+  ist->shcnt = 0;               /* and clear the first shard */
+}  /* reduce() */
+
+/* The blocks of the shards are small enough to stay in the cache    */
+/* while the corresponding blocks of all other shards are added.      */
+/* Since the source blocks are cleared (and a block is executed only  */
+/* completely or not at all), a failed parallel reduction can simply  */
+/* be repeated in the calling thread. The shard buffer is thus always */
+/* completely cleared when no sharded counting is in progress.        */
+
+/*--------------------------------------------------------------------*/
+
+static int shards (ISTREE *ist, long tasks)
+{                               /* --- prepare counter shards */
+  int     n;                    /* number of threads/shards */
+  size_t  z;                    /* number of counters per shard */
+  SUPP    *p;                   /* (reallocated) shard buffer */
+  ISTNODE *node;                /* to traverse the nodes */
+
+  assert(ist);                  /* check the function arguments */
+  if (ist->shcnt > 0)           /* if there are uncommitted shards, */
+    reduce(ist);                /* add them to the node counters */
+  n = ist->threads;             /* get the number of threads */
+  if (n <= 0)    n = tp_cpucnt(); /* (default: number of cpus) */
+  if (n > tasks) n = (int)tasks;  /* (at most one thread per task) */
+  if (n <= 1) return 0;         /* check for a parallel counting */
+  if (!ist->valid)              /* if the levels are not valid, */
+    makelvls(ist);              /* set the successor pointers */
+  for (z = 0, node = ist->lvls[ist->height-1]; node; node = node->succ){
+    if (z > (size_t)ITEM_MAX) return 0;
+    node->index = (node->index & NARROW) | (ITEM)z;
+    z += (size_t)node->size;    /* traverse the nodes on the level */
+  }                             /* and assign consecutive counter */
+                                /* ranges (keep the narrow flags) */
+  if (z > (size_t)ITEM_MAX) return 0;
+  if ((size_t)n *z > ist->shmax) {   /* if the buffer is too small */
+    p = (SUPP*)realloc(ist->shards, (size_t)n *z *sizeof(SUPP));
+    if (!p) return 0;           /* enlarge the shard buffer */
+    memset(p +ist->shmax, 0, ((size_t)n *z -ist->shmax) *sizeof(SUPP));
+    ist->shards = p; ist->shmax = (size_t)n *z;
+  }                             /* clear the new part of the buffer */
+  ist->shsz = z;                /* note the size of the shards */
+  return ist->shcnt = n;        /* and return the number of shards */
+}  /* shards() */
+
+/*--------------------------------------------------------------------*/
+
+static int bag_task (void *data, int thread, long task)
+{                               /* --- count a range of transactions */
+  ISTPAR *par = (ISTPAR*)data;  /* type the data pointer */
+  ISTREE *ist;                  /* item set tree to count into */
+  TID    i, e;                  /* range of transaction indices */
+  ITEM   k;                     /* number of items */
+  TRACT  *t;                    /* to traverse the transactions */
+  TBGCUR *cur;                  /* cursor for the transaction bag */
+  SUPP   *shd;                  /* counter shard of the thread */
+
+  assert(data && (task >= 0));  /* check the function arguments */
+  ist = par->ist;               /* get the item set tree */
+  shd = ist->shards +(size_t)thread *ist->shsz;
+  i = (TID)(((double) task   *(double)par->cnt) /(double)par->tasks);
+  e = (TID)(((double)(task+1)*(double)par->cnt) /(double)par->tasks);
+  cur = tbc_create(par->bag);   /* create a cursor for the bag */
+  if (!cur) return -1;          /* (transactions may be compressed) */
+  for (tbc_seek(cur, e); e > i; e--) {
+    t = tbc_next(cur);          /* traverse the transaction range */
+    k = ta_size(t);             /* get the transaction size and */
+    if (k >= ist->height)       /* count the transaction recursively */
+      count(ist->lvls[0], ta_items(t), k, ta_wgt(t), ist->height, shd);
+  }
+  tbc_delete(cur);              /* delete the bag cursor */
+  return 0;                     /* return 'ok' */
+}  /* bag_task() */
+
+/*--------------------------------------------------------------------*/
+#ifdef TATREEFN
+
+static int tat_task (void *data, int thread, long task)
+{                               /* --- count a transaction subtree */
+  ISTPAR  *par = (ISTPAR*)data; /* type the data pointer */
+  ISTREE  *ist;                 /* item set tree to count into */
+  ITEM    i, item;              /* child index, item of subtree */
+  ISTNODE *root;                /* root of the item set tree */
+  ISTNODE **chn;                /* child node array of the root */
+  TANODE  *cld;                 /* child of transaction tree root */
+  SUPP    *shd;                 /* counter shard of the thread */
+
+  assert(data && (task >= 0));  /* check the function arguments */
+  ist  = par->ist;              /* get the item set tree and */
+  root = ist->lvls[0];          /* the root node of this tree */
+  shd  = ist->shards +(size_t)thread *ist->shsz;
+  #ifdef TATCOMPACT             /* if compact transaction tree */
+  cld  = tan_children(par->tan) +task;
+  item = tan_item(cld);         /* get the child node */
+  #else                         /* if standard transaction tree */
+  cld  = tan_child(par->tan, (ITEM)task);
+  item = tan_item (par->tan, (ITEM)task);
+  #endif                        /* and its item */
+  countx(root, cld, ist->height, shd);
+  assert(root->offset >= 0);    /* count the transactions w/o item */
+  chn = (ISTNODE**)CNTEND(root);
+  ALIGN(chn);                   /* get the child node array */
+  i = chnidx(item, chn, root->chcnt);  /* and look up the child */
+  if (i >= 0) countx(chn[i], cld, ist->height-1, shd);
+  return 0;                     /* count the transactions with item */
+}  /* tat_task() */
+
+/* The root node of the item set tree always uses a pure counter and */
+/* child array, since it contains counters for all items.            */
+
+#endif
 /*----------------------------------------------------------------------
   Evaluation Functions
 ----------------------------------------------------------------------*/
 
+static void evalrules (ISTREE *ist, SUPP base, ITEM n)
+{                               /* --- evaluate candidate rules */
+  ITEM   i;                     /* loop variable */
+  double inv;                   /* value for rules below expectation */
+
+  assert(ist && (n > 0));       /* check the function arguments */
+  re_vecfn(ist->eval)(ist->rvals, ist->rsupp,
+                      ist->rbody, ist->rhead, base, (size_t)n);
+  if (!ist->invbxs) return;     /* evaluate all rules in one go */
+  inv = (ist->dir < 0) ? 1 : 0; /* get the value for invalid rules */
+  for (i = 0; i < n; i++)       /* invalidate rules below expectation */
+    if ((double)ist->rsupp[i] *(double)base
+    <=  (double)ist->rhead[i] *(double)ist->rbody[i])
+      ist->rvals[i] = inv;      /* (as the measure functions are */
+}  /* evalrules() */            /* branchless, this is done after) */
+
+/*--------------------------------------------------------------------*/
+
 static double evaluate (ISTREE *ist, ISTNODE *node, ITEM index)
 {                               /* --- aggregate rule evaluations */
   ITEM      n;                  /* loop variable, buffer */
   ITEM      item;               /* current (head) item */
-  SUPP      base;               /* total transaction weight */
   SUPP      supp;               /* support of item set */
-  SUPP      body, head;         /* support of rule body and head */
   ITEM      *path;              /* path to follow for body support */
   ISTNODE   *curr;              /* to traverse the nodes on the path */
-  RULEVALFN *refn;              /* rule evaluation function */
-  double    val, agg;           /* (aggregated) value of measure */
+  double    agg;                /* aggregated value of measure */
 
   assert(ist && node);          /* check the function arguments */
   if (ist->eval <= IST_NONE)    /* if no evaluation measure is given, */
@@ -559,36 +951,39 @@ static double evaluate (ISTREE *ist, ISTNODE *node, ITEM index)
   if (!curr)                    /* if there is no parent (root node), */
     return (ist->dir < 0) ? 1 : 0;     /* there is only a single item */
   item = ITEMAT(node, index);   /* get the corresponding item */
-  supp = COUNT(node->cnts[index]);
-  base = COUNT(ist->wgt);       /* get item set and base support */
-  head = COUNT(ist->lvls[0]->cnts[item]);
+  supp = COUNT(CNT(node, index));
+  ist->rsupp[0] = supp;         /* note the item set support */
+  ist->rhead[0] = COUNT(CNT(ist->lvls[0], item));
   if (curr->offset >= 0)        /* if a pure array is used */
-    body = COUNT(curr->cnts[ITEMOF(node) -curr->offset]);
+    ist->rbody[0] = COUNT(CNT(curr, ITEMOF(node) -curr->offset));
   else {                        /* if an identifier map is used */
-    path = (ITEM*)(curr->cnts +(n = curr->size));
-    body = COUNT(curr->cnts[ia_bsearch(ITEMOF(node), path, (size_t)n)]);
+    path = (ITEM*)CNTEND(curr); n = curr->size;
+    n    = ia_bsearch(ITEMOF(node), path, (size_t)n);
+    ist->rbody[0] = COUNT(CNT(curr, n));
   }                             /* find index and get body support */
-  refn = re_function(ist->eval);/* get the evaluation function */
-  agg  = (!ist->invbxs          /* compute the first measure value */
-      || ((double)supp *(double)base > (double)head *(double)body))
-       ? refn(supp, body, head, base) : (ist->dir < 0) ? 1 : 0;
-  if (ist->agg <= IST_FIRST)    /* if to return the first value, */
-    return agg;                 /* return the computed value */
-  path = ist->buf +ist->height; /* initialize the path/item array */
-  *--path = item; n = 1;        /* for the support retrieval */
-  item = ITEMOF(node);          /* get the next head item */
-  for ( ; curr; curr = curr->parent) {
-    head = COUNT(ist->lvls[0]->cnts[item]);
-    body = COUNT(getsupp(curr, path, n));
-    val  = (!ist->invbxs        /* compute next measure value */
-        || ((double)supp *(double)base > (double)head *(double)body))
-         ? refn(supp, body, head, base) : (ist->dir < 0) ? 1 : 0;
-    if      (ist->agg == IST_MIN) { if (val < agg) agg = val; }
-    else if (ist->agg == IST_MAX) { if (val > agg) agg = val; }
-    else agg += val;            /* compute the rule evaluation */
-    *--path = item; n += 1;     /* and aggregate it by min/max/sum */
-    item = ITEMOF(curr);        /* then extend the path/item array */
-  }                             /* (store the head item) */
+  n = 1;                        /* there is at least one rule */
+  if (ist->agg > IST_FIRST) {   /* if to aggregate over all heads */
+    path = ist->buf +ist->height;  /* initialize the path/item array */
+    *--path = item;             /* for the support retrieval */
+    item = ITEMOF(node);        /* get the next head item */
+    for ( ; curr; curr = curr->parent) {
+      ist->rsupp[n] = supp;     /* collect the candidate rules */
+      ist->rhead[n] = COUNT(CNT(ist->lvls[0], item));
+      ist->rbody[n] = COUNT(getsupp(curr, path, n));
+      *--path = item; n += 1;   /* extend the path/item array */
+      item = ITEMOF(curr);      /* (store the head item) */
+    }                           /* and get the next head item */
+  }
+  evalrules(ist, COUNT(ist->wgt), n);
+  agg = ist->rvals[0];          /* evaluate the candidate rules */
+  if      (ist->agg == IST_MIN) /* and aggregate by min/max/sum */
+    for (index = 1; index < n; index++) {
+      if (ist->rvals[index] < agg) agg = ist->rvals[index]; }
+  else if (ist->agg == IST_MAX)
+    for (index = 1; index < n; index++) {
+      if (ist->rvals[index] > agg) agg = ist->rvals[index]; }
+  else                          /* (sum for the average) */
+    for (index = 1; index < n; index++) agg += ist->rvals[index];
   if (ist->agg == IST_AVG)      /* if to average the evaluations, */
     agg /= (double)n;           /* divide by the number of items */
   return agg;                   /* return the measure aggregate */
@@ -619,10 +1014,18 @@ ISTREE* ist_create (ITEMBASE *base, int mode,
   ist->map  = (ITEM*)    malloc((size_t)(n+1) *sizeof(ITEM));
   if (!ist->map)  { free(ist->buf);
                     free(ist->lvls); free(ist); return NULL; }
+  ist->rvals = (double*)malloc((size_t)(n+1) *(sizeof(double)
+                              +3*sizeof(SUPP) +sizeof(ITEM)));
+  if (!ist->rvals){ free(ist->map); free(ist->buf);
+                    free(ist->lvls); free(ist); return NULL; }
+  ist->rsupp = (SUPP*)(ist->rvals +n+1);
+  ist->rbody = ist->rsupp +n+1; /* allocate and organize */
+  ist->rhead = ist->rbody +n+1; /* the buffers for the */
+  ist->ritem = (ITEM*)(ist->rhead +n+1);  /* candidate rules */
   ist->lvls[0] = ist->curr =    /* allocate a root node */
   root = (ISTNODE*)calloc(1,            sizeof(ISTNODE)
                         +(size_t)(n-1) *sizeof(SUPP));
-  if (!root)      { free(ist->map); free(ist->buf);
+  if (!root)      { free(ist->rvals); free(ist->map); free(ist->buf);
                     free(ist->lvls); free(ist); return NULL; }
 
   /* --- initialize structures --- */
@@ -641,10 +1044,16 @@ ISTREE* ist_create (ITEMBASE *base, int mode,
   /* number, which can lead to missing rules. To prevent this, the   */
   /* confidence is made smaller by the largest possible factor < 1.  */
   ist->depth  = 1;
+  ist->threads = 1;             /* count in the calling thread */
+  ist->shcnt  = 0;              /* (no counter shards yet) */
+  ist->shsz   = ist->shmax = 0;
+  ist->shards = NULL;
+  ist->lfact  = 0;              /* (no log-factorial table yet) */
   #ifdef BENCH                  /* if benchmark version */
   ist->ndcnt  = 1; ist->ndprn = ist->mapsz = 0;
   ist->sccnt  = ist->scnec = n; ist->scprn = 0;
   ist->cpcnt  = ist->cpnec =    ist->cpprn = 0;
+  ist->bmcnt  = ist->nccnt = 0;
   #endif                        /* initialize the benchmark variables */
   ist_setsize(ist, 1, ITEM_MAX);
   ist_seteval(ist, IST_NONE, IST_NONE, 1, ITEM_MAX);
@@ -673,7 +1082,10 @@ void ist_delete (ISTREE *ist)
         t = node; node = node->succ; free(t); }
     }                           /* delete all nodes */
   }                             /* by traversing the levels */
-  free(ist->lvls);              /* delete the level array, */
+  if (ist->lfact)  re_lfexit();        /* release log-factorials, */
+  if (ist->shards) free(ist->shards);  /* delete counter shards, */
+  free(ist->lvls);              /* the level array, */
+  free(ist->rvals);             /* the candidate rule buffers, */
   free(ist->map);               /* the identifier map, */
   free(ist->buf);               /* the path buffer, */
   free(ist);                    /* and the tree body */
@@ -686,7 +1098,7 @@ void ist_count (ISTREE *ist, const ITEM *items, ITEM n, SUPP wgt)
   assert(ist                    /* check the function arguments */
   &&    (n >= 0) && (items || (n <= 0)));
   if (n >= ist->height)         /* recursively count the transaction */
-    count(ist->lvls[0], items, n, wgt, ist->height);
+    count(ist->lvls[0], items, n, wgt, ist->height, NULL);
 }  /* ist_count() */
 
 /*--------------------------------------------------------------------*/
@@ -698,26 +1110,44 @@ void ist_countt (ISTREE *ist, const TRACT *t)
   assert(ist && t);             /* check the function arguments */
   k = ta_size(t);               /* get the transaction size and */
   if (k >= ist->height)         /* count the transaction recursively */
-    count(ist->lvls[0], ta_items(t), k, ta_wgt(t), ist->height);
+    count(ist->lvls[0], ta_items(t), k, ta_wgt(t), ist->height,NULL);
 }  /* ist_countt() */
 
 /*--------------------------------------------------------------------*/
 
-void ist_countb (ISTREE *ist, const TABAG *bag)
+int ist_countb (ISTREE *ist, const TABAG *bag)
 {                               /* --- count a transaction bag */
-  TID   i;                      /* loop variable */
-  ITEM  k;                      /* number of items */
-  TRACT *t;                     /* to traverse the transactions */
+  ITEM   k;                     /* number of items */
+  TRACT  *t;                    /* to traverse the transactions */
+  TBGCUR *cur;                  /* cursor for the transaction bag */
+  ISTPAR par;                   /* data for the counting tasks */
 
   assert(ist && bag);           /* check the function arguments */
   if (tbg_max(bag) < ist->height)
-    return;                     /* check for suff. long transactions */
-  for (i = tbg_cnt(bag); --i >= 0; ) {
-    t = tbg_tract(bag, i);      /* traverse the transactions */
+    return 0;                   /* check for suff. long transactions */
+  par.cnt = tbg_cnt(bag);       /* get the number of transactions */
+  if ((ist->threads != 1) && (par.cnt > 1)) {
+    par.tasks = (ist->threads > 0) ? ist->threads : tp_cpucnt();
+    par.tasks *= TASKCNT;       /* compute the number of tasks */
+    if (par.tasks > (long)par.cnt) par.tasks = (long)par.cnt;
+    if (shards(ist, par.tasks) > 0) {
+      par.ist = ist; par.bag = bag;  /* count transaction ranges */
+      if (tp_exec(ist->shcnt, par.tasks, bag_task, &par) >= 0)
+        return 0;               /* into per-thread counter shards */
+      memset(ist->shards, 0, (size_t)ist->shcnt *ist->shsz
+                                                *sizeof(SUPP));
+      ist->shcnt = 0;           /* on failure clear the shards */
+    }                           /* and count in the calling thread */
+  }
+  cur = tbc_create(bag);        /* create a cursor for the bag */
+  if (!cur) return -1;          /* (transactions may be compressed) */
+  while ((t = tbc_next(cur))) { /* traverse the transactions */
     k = ta_size(t);             /* get the transaction size and */
     if (k >= ist->height)       /* count the transaction recursively */
-      count(ist->lvls[0], ta_items(t), k, ta_wgt(t), ist->height);
+      count(ist->lvls[0], ta_items(t), k, ta_wgt(t), ist->height,NULL);
   }
+  tbc_delete(cur);              /* delete the bag cursor */
+  return 0;                     /* return 'ok' */
 }  /* ist_countb() */
 
 /*--------------------------------------------------------------------*/
@@ -725,9 +1155,32 @@ void ist_countb (ISTREE *ist, const TABAG *bag)
 
 void ist_countx (ISTREE *ist, const TATREE *tree)
 {                               /* --- count transaction in tree */
+  #ifdef TATCOMPACT             /* if compact transaction tree */
+  const TANODE *cld;            /* to traverse the root's children */
+  #endif
+  ISTPAR par;                   /* data for the counting tasks */
+
   assert(ist && tree);          /* check the function arguments */
-  countx(ist->lvls[0], tat_root(tree), ist->height);
-}  /* ist_countx() */           /* recursively count the trans. tree */
+  par.tan = tat_root(tree);     /* get the transaction tree root */
+  par.tasks = 0;                /* and count its children */
+  if ((ist->threads != 1) && (ist->lvls[0]->chcnt > 0)
+  &&  (tan_max(par.tan) >= ist->height)) {
+    #ifdef TATCOMPACT           /* if compact transaction tree */
+    for (cld = tan_children(par.tan); cld; cld = tan_sibling(cld))
+      par.tasks++;              /* count the children of the root */
+    #else                       /* if standard transaction tree */
+    par.tasks = tan_size(par.tan);
+    #endif                      /* get the number of children */
+  }                             /* (negative for a leaf node) */
+  if ((par.tasks > 1) && (shards(ist, par.tasks) > 0)) {
+    par.ist = ist;              /* count the root's subtrees */
+    if (tp_exec(ist->shcnt, par.tasks, tat_task, &par) >= 0)
+      return;                   /* into per-thread counter shards */
+    memset(ist->shards, 0, (size_t)ist->shcnt *ist->shsz *sizeof(SUPP));
+    ist->shcnt = 0;             /* on failure clear the shards */
+  }                             /* and count in the calling thread */
+  countx(ist->lvls[0], tat_root(tree), ist->height, NULL);
+}  /* ist_countx() */
 
 #endif
 /*--------------------------------------------------------------------*/
@@ -738,6 +1191,8 @@ void ist_commit (ISTREE *ist)
   ISTNODE *node;                /* to traverse the nodes */
 
   assert(ist);                  /* check the function argument */
+  if (ist->shcnt > 0)           /* if counted into shards, */
+    reduce(ist);                /* add them to the node counters */
   if ((ist->eval   <= IST_NONE) /* if not to prune with evaluation */
   ||  (ist->height <  ist->prune))
     return;                     /* abort the function */
@@ -745,9 +1200,9 @@ void ist_commit (ISTREE *ist)
     makelvls(ist);              /* set the successor pointers */
   for (node = ist->lvls[ist->height-1]; node; node = node->succ)
     for (i = node->size; --i >= 0; )
-      if ((node->cnts[i] < ist->smin)
+      if ((CNT(node, i) < ist->smin)
       ||  (ist->dir *evaluate(ist, node, i) < ist->thresh))
-        SETSKIP(node->cnts[i]); /* mark sets that do not qualify */
+        SETSKIPAT(node, i);     /* mark sets that do not qualify */
 }  /* ist_commit() */
 
 /*--------------------------------------------------------------------*/
@@ -764,24 +1219,24 @@ static int used (ISTNODE *node, int *marks, SUPP supp)
     if (node->chcnt == 0) {     /* if this is a new node (leaf) */
       k = node->offset;         /* get the index offset */
       for (i = node->size; --i >= 0; ) {
-        if (node->cnts[i] >= supp)
+        if (CNT(node, i) >= supp)
           marks[k+i] = r = 1;   /* mark items in set that satisfy */
       } }                       /* the minimum support criterion */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)(node->cnts +node->size);
+      chn = (ISTNODE**)CNTEND(node);
       ALIGN(chn);               /* get the child node array */
       for (i = node->chcnt; --i >= 0; )
-        if (chn[i]) r |= used(chn[i], marks, supp);
+        r |= used(chn[i], marks, supp);
     } }                         /* recursively process all children */
   else {                        /* if an identifer map is used */
     if (node->chcnt == 0) {     /* if this is a new node */
-      map = (ITEM*)(node->cnts +node->size);
+      map = (ITEM*)CNTEND(node);
       for (i = node->size; --i >= 0; ) {
-        if (node->cnts[i] >= supp)
+        if (CNT(node, i) >= supp)
           marks[map[i]] = r = 1;/* mark items in set that satisfies */
       } }                       /* the minimum support criterion */
     else if (node->chcnt > 0) { /* if there are child nodes */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
       ALIGN(chn);               /* get the child node array */
       for (i = node->chcnt; --i >= 0; )
         r |= used(chn[i], marks, supp);
@@ -811,11 +1266,15 @@ ITEM ist_check (ISTREE *ist, int *marks)
 
 void ist_prune (ISTREE *ist)
 {                               /* --- prune counters and pointers */
-  ITEM    i, k, n;              /* loop variables */
-  SUPP    *c;                   /* counter array */
+  ITEM    i, k, n, m;           /* loop variables */
+  int     w;                    /* whether narrow counters are used */
+  size_t  x;                    /* size of a counter */
+  size_t  z;                    /* new size of a node */
+  char    *c;                   /* counter array */
   ITEM    *map;                 /* item identifier map */
   ISTNODE **np, *node;          /* to traverse the nodes */
   ISTNODE **chn;                /* child node array */
+  ISTNODE **pp;                 /* pointer to a node in its parent */
 
   assert(ist);                  /* check the function argument */
   if (ist->height <= 1)         /* if there is only the root node, */
@@ -824,76 +1283,88 @@ void ist_prune (ISTREE *ist)
     makelvls(ist);              /* set the successor pointers */
 
   /* -- prune counters for infrequent items -- */
-  for (node = ist->lvls[ist->height-1]; node; node = node->succ) {
-    c = node->cnts;             /* traverse the deepest level */
+  for (np = ist->lvls +ist->height-1; *np; np = &(*np)->succ) {
+    node = *np;                 /* traverse the deepest level */
+    c = (char*)node->cnts;      /* get the counter array, */
+    w = ISNARROW(node);         /* the counter width, and */
+    x = (w) ? sizeof(NCNT) : sizeof(SUPP);
+    k = node->size;             /* note the old number of counters */
     if (node->offset >= 0) {    /* if a pure array is used */
-      for (n = node->size; --n >= 0; ) /* find the last */
-        if (c[n] >= ist->smin) break;  /* frequent item */
-      for (i = 0; i < n; i++)          /* find the first */
-        if (c[i] >= ist->smin) break;  /* frequent item  */
+      for (n = node->size; --n >= 0; )    /* find the last */
+        if (CNT(node, n) >= ist->smin) break;  /* frequent item */
+      for (i = 0; i < n; i++)             /* find the first */
+        if (CNT(node, i) >= ist->smin) break;  /* frequent item */
       node->size = ++n-i;       /* set the new node size */
-      #ifdef BENCH              /* if benchmark version */
-      k = node->size -(n-i);    /* get the number of pruned counters */
-      ist->sccnt -= k;          /* update the number of counters */
-      ist->scprn += k;          /* and of pruned counters */
-      #endif                    /* update the memory usage */
       if (i > 0) {              /* if there are leading infreq. items */
         node->offset += i;      /* set the new item offset */
-        memmove(c, c+i, (size_t)n *sizeof(SUPP));
-      } }                       /* trim infrequent item from front */
+        memmove(c, c +(size_t)i *x, (size_t)node->size *x);
+      }                         /* trim infrequent item from front */
+      for (m = 0, i = node->size; --i >= 0; )
+        if (CNT(node, i) >= ist->smin) m++;  /* count frequent items */
+      if (CNTSIZE(m, w) +(size_t)m *sizeof(ITEM)
+      <   CNTSIZE(node->size, w)) {
+        for (i = n = 0; i < node->size; i++) {
+          if (CNT(node, i) < ist->smin)
+            continue;           /* collect the frequent items */
+          ist->map[n] = node->offset +i;
+          SETCNT(node, n, CNT(node, i)); n++;
+        }                       /* if an identifier map needs less */
+        node->size   = m;       /* memory, remove infrequent items */
+        node->offset = -1;      /* and switch to an identifier map */
+        memcpy(CNTEND(node), ist->map, (size_t)m *sizeof(ITEM));
+        #ifdef BENCH            /* if benchmark version, */
+        ist->mapsz += (size_t)m;/* update the total item map size */
+        #endif
+      } }
     else {                      /* if an identifier map is used */
-      map = (ITEM*)(c +node->size); /* get the item identifier map */
+      map = (ITEM*)CNTEND(node);/* get the item identifier map */
       for (i = n = 0; i < node->size; i++) {
-        if (c[i] >= ist->smin) {
-          c[n] = c[i]; map[n++] = map[i]; }
+        if (CNT(node, i) >= ist->smin) {
+          SETCNT(node, n, CNT(node, i)); map[n++] = map[i]; }
       }                         /* remove infrequent items */
-      k = node->size -n;        /* get the number of pruned counters */
-      if (k <= 0) continue;     /* if no items were pruned, continue */
+      if (n >= node->size) continue;  /* if no items were pruned, */
       #ifdef BENCH              /* if benchmark version, */
-      ist->sccnt -= k;          /* update the number of counters */
-      ist->scprn += k;          /* and of pruned counters */
-      ist->mapsz -= k;          /* update the total item map size */
+      ist->mapsz -= (size_t)(node->size-n);  /* update map size */
       #endif
       node->size = n;           /* set the new node size */
-      memmove(c+n, map, (size_t)n *sizeof(ITEM));
+      memmove(CNTEND(node), map, (size_t)n *sizeof(ITEM));
     }                           /* move the item identifier map */
-  }                             /* after the support counters */
+    #ifdef BENCH                /* if benchmark version */
+    ist->sccnt -= (size_t)(k -node->size);  /* update the number */
+    ist->scprn += (size_t)(k -node->size);  /* of (pruned) counters */
+    if (w) ist->nccnt -= (size_t)(k -node->size);
+    #endif
+    if ((node->size <= 0) || (node->size >= k))
+      continue;                 /* skip empty and unchanged nodes */
+    z = NODESIZE(node->size, w);/* compute the new node size */
+    if (node->offset < 0) z += (size_t)node->size *sizeof(ITEM);
+    pp   = slot(node);          /* get the pointer in the parent */
+    node = (ISTNODE*)realloc(node, z);
+    if (node) *np = *pp = node; /* shrink the node to its new size */
+  }                             /* (a failure is harmless) */
+  /* Since the nodes on the deepest level have no children yet, only */
+  /* the pointers to them need to be adapted if they are moved.      */
 
   /* -- prune pointers to empty children -- */
   for (node = ist->lvls[ist->height-2]; node; node = node->succ) {
     n = CHILDCNT(node);         /* traverse the parent nodes */
     if (n <= 0) continue;       /* skip childless nodes */
-    if (node->offset >= 0) {    /* if a pure array is used */
-      chn = (ISTNODE**)(node->cnts +node->size);
-      ALIGN(chn);               /* get the child node array */
-      while (--n >= 0)          /* find the last  non-empty child */
-        if (chn[n] && (chn[n]->size > 0)) break;
-      for (i = 0; i < n; i++)   /* find the first non-empty child */
-        if (chn[i] && (chn[i]->size > 0)) break;
-      node->chcnt = ++n-i;      /* set the new number of children */
-      #ifdef BENCH              /* if benchmark version, */
-      k = node->chcnt -(n-i);   /* get the number of pruned pointers */
-      ist->cpcnt -= k;          /* update the number of pointers */
-      ist->cpprn += k;          /* and of pruned pointers */
-      #endif
-      for (k = 0; i < n; i++)   /* remove all empty children */
-        chn[k++] = (chn[i] && (chn[i]->size > 0)) ? chn[i] : NULL; }
-    else {                      /* if an item identifier map is used */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
-      ALIGN(chn);               /* get the child node array */
-      for (i = k = 0; i < n; i++)
-        if (chn[i]->size > 0)   /* collect the child nodes */
-          chn[k++] = chn[i];    /* that are not empty */
-      node->chcnt = k;          /* set the new number of children */
-      #ifdef BENCH              /* if benchmark version, */
-      n -= k;                   /* get the number of pruned pointers */
-      ist->cpcnt -= n;          /* update the number of pointers */
-      ist->cpprn += n;          /* and of pruned pointers */
-      #endif
-    }
-    if (node->chcnt <= 0)       /* if all children were removed, */
+    i   = (node->offset < 0) ? node->size : 0;
+    chn = (ISTNODE**)((ITEM*)CNTEND(node) +i);
+    ALIGN(chn);                 /* get the child node array */
+    for (i = k = 0; i < n; i++)
+      if (chn[i]->size > 0)     /* collect the child nodes */
+        chn[k++] = chn[i];      /* that are not empty */
+    node->chcnt = k;            /* set the new number of children */
+    #ifdef BENCH                /* if benchmark version, */
+    ist->cpcnt -= (size_t)(n-k);/* update the number of pointers */
+    ist->cpprn += (size_t)(n-k);/* and of pruned pointers */
+    #endif
+    if (k <= 0)                 /* if all children were removed, */
       node->chcnt |= ITEM_MIN;  /* set the skip flag, so that */
-  }                             /* no recounting takes place */
+    else if (node->offset >= 0) /* no recounting takes place, */
+      mkbmap(chn, k);           /* otherwise rebuild the bitmap */
+  }                             /* (the new bitmap is not larger) */
 
   /* -- remove empty children -- */
   for (np = ist->lvls +ist->height-1; *np; ) {
@@ -917,16 +1388,18 @@ static ISTNODE* child (ISTREE *ist, ISTNODE *node, ITEM index, SUPP pex)
   int     body;                 /* enough support for a rule body */
   int     hdonly;               /* whether head only item on path */
   int     app;                  /* appearance flags of an item */
+  int     w;                    /* whether to use narrow counters */
   SUPP    supp;                 /* support of an item set */
 
   assert(ist && node            /* check the function arguments */
   &&    (index >= 0) && (index < node->size));
 
   /* --- initialize --- */
-  supp = node->cnts[index];     /* get support of item set to extend */
+  supp = CNT(node, index);      /* get support of item set to extend */
   if ((supp <  ist->smin)       /* if the support is insufficient */
   ||  (supp >= pex))            /* or item is a perfect extension, */
     return NULL;                /* abort (do not create a child) */
+  w    = NARROWOK(supp);        /* the support bounds all counters */
   item = ITEMAT(node, index);   /* get the item for the index and */
   app  = ib_getapp(ist->base, item);    /* the corresp. app. flag */
   if ((app == APP_NONE)         /* do not extend an item to ignore */
@@ -945,7 +1418,7 @@ static ISTNODE* child (ISTREE *ist, ISTNODE *node, ITEM index, SUPP pex)
     app = ib_getapp(ist->base, k);
     if ((app == APP_NONE) || (hdonly && (app == APP_HEAD)))
       continue;                 /* skip sets with two head only items */
-    supp = node->cnts[i];       /* traverse the candidate items */
+    supp = CNT(node, i);        /* traverse the candidate items */
     if ((supp <  ist->smin)     /* if set support is insufficient */
     ||  (supp >= pex))          /* or item is a perfect extension, */
       continue;                 /* ignore the corresponding candidate */
@@ -983,24 +1456,25 @@ static ISTNODE* child (ISTREE *ist, ISTNODE *node, ITEM index, SUPP pex)
   ist->sccnt += n;              /* sum the number of counters */
   ist->mapsz += k;              /* sum the size of the maps */
   ist->ndcnt += 1;              /* count the node to be created */
+  if (w) ist->nccnt += (size_t)n; /* sum the narrow counters */
   #endif
 
   /* --- create child --- */
-  curr = (ISTNODE*)malloc(sizeof(ISTNODE) +(size_t)(n-1) *sizeof(SUPP)
-                                          +(size_t) k    *sizeof(ITEM));
+  curr = (ISTNODE*)malloc(NODESIZE(n, w) +(size_t)k *sizeof(ITEM));
   if (!curr) return (ISTNODE*)-1;      /* create a child node */
   if (hdonly) item |= HDONLY;   /* set the head only flag and */
   curr->item  = item;           /* initialize the item identifier */
   curr->chcnt = 0;              /* there are no children yet */
   curr->size  = n;              /* set size of counter array */
+  curr->index = (w) ? NARROW : 0;    /* and the counter width */
   if (k <= 0) {                 /* if to use a pure array, note */
     curr->offset = k = ist->map[0];  /* first item as an offset */
-    for (i = 0; i < n; i++) curr->cnts[i] = SKIP;
-    for (i = 0; i < m; i++) curr->cnts[ist->map[i]-k] = 0; }
+    for (i = 0; i < n; i++) SETCNT(curr, i, SKIP);
+    for (i = 0; i < m; i++) SETCNT(curr, ist->map[i]-k, 0); }
   else {                        /* if to use an identifier map, */
     curr->offset = -1;          /* use negative offset as indicator */
-    memset(curr->cnts,    0,        (size_t)n *sizeof(SUPP));
-    memcpy(curr->cnts +n, ist->map, (size_t)n *sizeof(ITEM));
+    memset(curr->cnts,   0,        CNTSIZE(n, w));
+    memcpy(CNTEND(curr), ist->map, (size_t)n *sizeof(ITEM));
   }                             /* clear counters, copy item id. map */
   return curr;                  /* return pointer to created child */
 }  /* child() */
@@ -1048,10 +1522,10 @@ appearance flags of the items.
 static ISTNODE** children (ISTREE *ist, ISTNODE **np, ISTNODE **end)
 {                               /* --- create children of a node */
   ITEM    i, n;                 /* loop variable, node counter */
+  ITEM    k;                    /* number of bitmap blocks */
   size_t  z;                    /* size of counter and map arrays */
   SUPP    pex;                  /* support for a perfect extension */
   ISTNODE *node;                /* node to get children */
-  ISTNODE *par;                 /* parent of current node */
   ISTNODE *cur;                 /* current node in new level (child) */
   ISTNODE **frst;               /* first child of current node */
   ISTNODE *last;                /* last  child of current node */
@@ -1077,55 +1551,33 @@ static ISTNODE** children (ISTREE *ist, ISTNODE **np, ISTNODE **end)
   #ifdef BENCH                  /* if benchmark version, */
   ist->cpnec += n;              /* sum the number of */
   #endif                        /* necessary child pointers */
-  chn = np; par = node->parent; /* get the parent node */
-  if (par) {                    /* if there is a parent node */
-    if (par->offset >= 0) {     /* if a pure array is used */
-      chn = (ISTNODE**)(par->cnts +par->size);
-      ALIGN(chn);               /* get the child node array */
-      chn += ITEMOF(node) -ITEMOF(chn[0]); }
-    else {                      /* if an identifier map is used */
-      chn = (ISTNODE**)((ITEM*)(par->cnts +par->size) +par->size);
-      ALIGN(chn);               /* get the child node array */
-      chn += search(ITEMOF(node), chn, CHILDCNT(par));
-    }                           /* find the child node pointer */
-  }                             /* in the parent node */
-  /* The location of the child pointer in the parent node must be  */
-  /* retrieved here, because ITEMOF(chn[0]) (for a pure array) may */
-  /* access already freed memory after the node has been resized,  */
-  /* since it may be that node = chn[0] and then chn[0] may become */
-  /* by the reallocation of the node to add the child pointers.    */
-  if (node->offset >= 0) {      /* if a pure counter array is used */
-    z = (size_t)(node->size-1) *sizeof(SUPP);
-    n = ITEMOF(last) -ITEMOF(*frst) +1; } /* pure child array */
-  else {                        /* if an identifier map is used */
-    z = (size_t)(node->size-1) *sizeof(SUPP)
-      + (size_t) node->size    *sizeof(ITEM);
-  }                             /* add a compact child array */
-  z += sizeof(ISTNODE);         /* add the node size */
-  node = (ISTNODE*)realloc(node, z+PAD(z) +(size_t)n*sizeof(ISTNODE*));
+  chn = slot(node);             /* get the pointer in the parent */
+  if (!chn) chn = np;           /* (or the root node pointer) */
+  z = NODESIZE(node->size, ISNARROW(node));
+  if (node->offset >= 0) {      /* if a pure counter array is used, */
+    k = BLKCNT(ITEMOF(last) -ITEMOF(*frst));  /* add space for */
+    i = 0; }                    /* a bitmap of the child node array */
+  else {                        /* if an identifier map is used, */
+    k = 0;                      /* no bitmap is needed */
+    i = node->size;             /* (children are searched) */
+    z += (size_t)node->size *sizeof(ITEM);
+  }                             /* add the item identifier map */
+  node = (ISTNODE*)realloc(node, z+PAD(z) +(size_t)n*sizeof(ISTNODE*)
+                                          +(size_t)k*sizeof(CHNBLK));
   if (!node) return NULL;       /* add a child array to the node */
   *np = *chn = node;            /* update the node pointer and */
   node->chcnt = n;              /* note the number of children */
   #ifdef BENCH                  /* if benchmark version, */
-  ist->cpcnt += n;              /* sum the number of child pointers */
-  #endif                        /* (whether necessary or not) */
-  if (node->offset >= 0) {      /* if a pure array is used */
-    chn = (ISTNODE**)(node->cnts +node->size);
-    ALIGN(chn);                 /* get the child node array */
-    while (--n >= 0) chn[n] = NULL;
-    i = ITEMOF(*frst);          /* get the child node array */
-    for (cur = *frst; cur; cur = cur->succ) {
-      chn[ITEMOF(cur)-i] = cur; /* set the child node pointer */
-      cur->parent = node;       /* and the parent pointer */
-    } }
-  else {                        /* if an identifier map is used */
-    chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
-    ALIGN(chn);                 /* get the child node array */
-    for (i = 0, cur = *frst; cur; cur = cur->succ) {
-      chn[i++]    = cur;        /* set the child node pointer */
-      cur->parent = node;       /* and the parent pointer */
-    }                           /* in the new node */
-  }                             /* (store pointers to children) */
+  ist->cpcnt += (size_t)n;      /* sum the number of child pointers */
+  ist->bmcnt += (size_t)k;      /* and the number of bitmap blocks */
+  #endif
+  chn = (ISTNODE**)((ITEM*)CNTEND(node) +i);
+  ALIGN(chn);                   /* get the child node array */
+  for (i = 0, cur = *frst; cur; cur = cur->succ) {
+    chn[i++]    = cur;          /* set the child node pointer */
+    cur->parent = node;         /* and the parent pointer */
+  }                             /* in the new node */
+  if (k > 0) mkbmap(chn, n);    /* build the bitmap (if gaps) */
   return end;                   /* return new end of node list */
 }  /* children() */
 
@@ -1141,10 +1593,10 @@ static int needed (ISTNODE *node)
   if (node->chcnt <= 0)         /* skip already marked subtrees, */
     return (node->chcnt == 0) ? -1 : 0;    /* but not new leaves */
   i   = (node->offset < 0) ? node->size : 0;
-  chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +i);
+  chn = (ISTNODE**)((ITEM*)CNTEND(node) +i);
   ALIGN(chn);                   /* get the child node array */
   for (r = 0, i = node->chcnt; --i >= 0; )
-    if (chn[i]) r |= needed(chn[i]);
+    r |= needed(chn[i]);
   if (r) return -1;             /* recursively check all children */
   node->chcnt |= ITEM_MIN;      /* set the skip flag if possible */
   return 0;                     /* return 'subtree can be skipped' */
@@ -1219,16 +1671,15 @@ int ist_down (ISTREE *ist, ITEM item)
   cnt  = CHILDCNT(node);        /* if there are no child nodes, */
   if (cnt <= 0) return -1;      /* abort the function */
   if (node->offset >= 0) {      /* if a pure array is used */
-    chn = (ISTNODE**)(node->cnts +node->size);
+    chn = (ISTNODE**)CNTEND(node);
     ALIGN(chn);                 /* get the child node array */
-    i   = item -ITEMOF(chn[0]); /* compute index in child node array */
-    if ((i < 0) || (i >= cnt) || !chn[i]) return -1; }
+    i   = chnidx(item, chn, cnt); }    /* look up the child */
   else {                        /* if an identifier map is used */
-    chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+    chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
     ALIGN(chn);                 /* get the child node array */
     i   = search(item, chn, cnt);
-    if (i < 0) return -1;       /* search for the item in the map */
-  }                             /* and check whether child exists */
+  }                             /* search for the item in the map */
+  if (i < 0) return -1;         /* and check whether child exists */
   ist->curr   = chn[i];         /* go to the child node and */
   ist->depth += 1;              /* increase the node depth */
   return 0;                     /* return 'ok' */
@@ -1250,7 +1701,7 @@ ITEM ist_next (ISTREE *ist, ITEM item)
     if (i >= node->size) return -1;
     return item +1; }           /* return the next item identifier */
   else {                        /* if an identifier map is used */
-    map = (ITEM*)(node->cnts +(n = node->size));
+    map = (ITEM*)CNTEND(node); n = node->size;
     i = ia_bsearch(item, map, (size_t)n);
     if (i >= 0) i++;            /* try to find the item in the map */
     return (i < n) ? map[i] : -1;
@@ -1271,15 +1722,69 @@ SUPP ist_getsupp (ISTREE *ist, ITEM item)
     i = item -node->offset;     /* get index in counter array */
     if (i >= node->size) return 0; }
   else {                        /* if an identifier map is used */
-    map = (ITEM*)(node->cnts +node->size);
+    map = (ITEM*)CNTEND(node);
     i   = ia_bsearch(item, map, (size_t)node->size);
   }                             /* search the item in the map */
   if (i < 0) return 0;          /* abort if item not found */
-  return COUNT(node->cnts[i]);  /* return the item set support */
+  return COUNT(CNT(node, i));   /* return the item set support */
 }  /* ist_getsupp() */
 
 /*--------------------------------------------------------------------*/
 
+static ISTNODE* widen (ISTREE *ist, ISTNODE *node)
+{                               /* --- promote to wide counters */
+  ITEM    i, n;                 /* loop variable, number of children */
+  size_t  z, m, b;              /* node size, map size, bitmap size */
+  ISTNODE *wide;                /* node with wide counters */
+  ISTNODE **chn, **dst;         /* old and new child node array */
+  ISTNODE **pp;                 /* pointer to the node in its parent */
+
+  assert(ist && node && ISNARROW(node) && node->parent);
+  n = CHILDCNT(node);           /* get the number of children */
+  m = (node->offset < 0) ? (size_t)node->size *sizeof(ITEM) : 0;
+  z = NODESIZE(node->size, 0) +m;    /* compute the new node size */
+  chn = NULL; b = 0;            /* (counters and identifier map) */
+  if (n > 0) {                  /* if there are child nodes */
+    chn = (ISTNODE**)((char*)CNTEND(node) +m);
+    ALIGN(chn);                 /* get the child node array */
+    if (node->offset >= 0)      /* and the size of its bitmap */
+      b = (size_t)BLKCNT(CHNRNG(chn, n)) *sizeof(CHNBLK);
+    z += PAD(z) +(size_t)n *sizeof(ISTNODE*) +b;
+  }                             /* add the size of the child array */
+  wide = (ISTNODE*)malloc(z);   /* allocate a new node */
+  if (!wide) return NULL;       /* with wide counters */
+  memcpy(wide, node, sizeof(ISTNODE) -sizeof(SUPP));
+  wide->index = SHDIDX(node);   /* copy the node header */
+  for (i = 0; i < node->size; i++)
+    wide->cnts[i] = CNT(node, i);    /* widen the counters */
+  memcpy(CNTEND(wide), CNTEND(node), m);    /* copy the id. map */
+  if (n > 0) {                  /* if there are child nodes */
+    dst = (ISTNODE**)((char*)CNTEND(wide) +m);
+    ALIGN(dst);                 /* get the new child node array */
+    memcpy(dst, chn, (size_t)n *sizeof(ISTNODE*) +b);
+    for (i = 0; i < n; i++)     /* copy pointers and bitmap and */
+      dst[i]->parent = wide;    /* set the new parent pointers */
+  }
+  pp  = slot(node);             /* get the pointer in the parent */
+  *pp = wide;                   /* and replace the node */
+  if (ist->curr == node) ist->curr = wide;
+  if (ist->node == node) ist->node = wide;
+  if (ist->head == node) ist->head = wide;
+  ist->valid = 0;               /* levels/successors are not valid */
+  #ifdef BENCH                  /* if benchmark version, */
+  ist->nccnt -= (size_t)node->size;  /* update the number */
+  #endif                        /* of narrow counters */
+  free(node);                   /* delete the old node */
+  return wide;                  /* return the promoted node */
+}  /* widen() */
+
+/* A node with narrow counters is promoted only if a support that is */
+/* set from the outside exceeds NMAX. Counting cannot overflow the   */
+/* narrow counters, because they are bounded by the support of the   */
+/* item set of the node (as recorded in the parent node).            */
+
+/*--------------------------------------------------------------------*/
+
 SUPP ist_setsupp (ISTREE *ist, ITEM item, SUPP supp)
 {                               /* --- get support for an item */
   ITEM    i;                    /* array index */
@@ -1292,11 +1797,15 @@ SUPP ist_setsupp (ISTREE *ist, ITEM item, SUPP supp)
     i = item -node->offset;     /* get index in counter array */
     if (i >= node->size) return 0; }
   else {                        /* if an identifier map is used */
-    map = (ITEM*)(node->cnts +node->size);
+    map = (ITEM*)CNTEND(node);
     i   = ia_bsearch(item, map, (size_t)node->size);
   }                             /* search the item in the map */
   if (i < 0) return 0;          /* abort if item not found */
-  node->cnts[i] = supp;         /* set new item set support */
+  if (ISNARROW(node) && !NARROWOK(supp)) {
+    node = widen(ist, node);    /* if the support does not fit, */
+    if (!node) return -1;       /* promote the node to wide counters */
+  }
+  SETCNT(node, i, supp);        /* set new item set support */
   return COUNT(supp);           /* return the item set support */
 }  /* ist_setsupp() */
 
@@ -1314,12 +1823,17 @@ SUPP ist_incsupp (ISTREE *ist, ITEM item, SUPP supp)
     i = item -node->offset;     /* get index in counter array */
     if (i >= node->size) return 0; }
   else {                        /* if an identifier map is used */
-    map = (ITEM*)(node->cnts +node->size);
+    map = (ITEM*)CNTEND(node);
     i   = ia_bsearch(item, map, (size_t)node->size);
   }                             /* search the item in the map */
   if (i < 0) return 0;          /* abort if item not found */
-  node->cnts[i] += supp;        /* increase the item set support */
-  return COUNT(node->cnts[i]);  /* return the item set support */
+  supp += CNT(node, i);         /* compute the new item set support */
+  if (ISNARROW(node) && !NARROWOK(supp)) {
+    node = widen(ist, node);    /* if the support does not fit, */
+    if (!node) return -1;       /* promote the node to wide counters */
+  }
+  SETCNT(node, i, supp);        /* set the new item set support */
+  return COUNT(supp);           /* and return it */
 }  /* ist_incsupp() */
 
 /*--------------------------------------------------------------------*/
@@ -1367,7 +1881,7 @@ void ist_clear (ISTREE *ist)
   for (h = ist->height; --h >= 0; )
     for (node = ist->lvls[h]; node; node = node->succ)
       for (i = node->size; --i >= 0; )
-        CLRSKIP(node->cnts[i]); /* traverse the tree levels */
+        CLRSKIPAT(node, i);     /* traverse the tree levels */
 }  /* ist_clear() */
 
 /*--------------------------------------------------------------------*/
@@ -1384,9 +1898,9 @@ void ist_filter (ISTREE *ist, ITEM size)
   for (h = ist->height; --h > 0; ) {
     for (node = ist->lvls[h]; node; node = node->succ) {
       for (i = node->size; --i >= 0; ) {
-        if ((node->cnts[i] < ist->smin)
+        if ((CNT(node, i) < ist->smin)
         ||  (ist->dir *evaluate(ist, node, i) < ist->thresh))
-          SETSKIP(node->cnts[i]);
+          SETSKIPAT(node, i);
       }                         /* traverse all nodes of the tree */
     }                           /* and all counters in each node and */
   }                             /* mark sets that do not qualify */
@@ -1397,9 +1911,9 @@ void ist_filter (ISTREE *ist, ITEM size)
         curr = node->parent;    /* traverse the nodes on each level */
         k = ITEMOF(node);       /* and check the direkt parent */
         k = (curr->offset >= 0) ? k -curr->offset
-          : ia_bsearch(k, (ITEM*)(curr->cnts +curr->size),
+          : ia_bsearch(k, (ITEM*)CNTEND(curr),
                           (size_t)curr->size);
-        if (curr->cnts[k] >= ist->smin)
+        if (CNT(curr, k) >= ist->smin)
           continue;             /* abort search if parent qualifies */
         for (i = node->size; --i >= 0; ) {
           path = ist->buf +ist->height +1;
@@ -1410,7 +1924,7 @@ void ist_filter (ISTREE *ist, ITEM size)
             if (getsupp(curr, path+1, n) >= ist->smin) break;
             *--path = ITEMOF(curr); n += 1;
           }                     /* try to find a qualifying subset */
-          if (!curr) SETSKIP(node->cnts[i]);
+          if (!curr) SETSKIPAT(node, i);
         }                       /* if the whole path to the root */
       }                         /* was traversed, but no qualifying */
     } }                         /* subset was found, mark item set */
@@ -1421,11 +1935,11 @@ void ist_filter (ISTREE *ist, ITEM size)
         curr = node->parent;    /* traverse the nodes on each level */
         k = ITEMOF(node);       /* and check the direkt parent */
         k = (curr->offset >= 0) ? k -curr->offset
-          : ia_bsearch(k, (ITEM*)(curr->cnts +curr->size),
+          : ia_bsearch(k, (ITEM*)CNTEND(curr),
                           (size_t)curr->size);
-        if (curr->cnts[k] < ist->smin) {
+        if (CNT(curr, k) < ist->smin) {
           for (i = node->size; --i >= 0; )
-            SETSKIP(node->cnts[i]);
+            SETSKIPAT(node, i);
           continue;             /* if the direct parent is invalid, */
         }                       /* all sets in the node can be marked */
         for (i = node->size; --i >= 0; ) {
@@ -1437,7 +1951,7 @@ void ist_filter (ISTREE *ist, ITEM size)
             if (getsupp(curr, path+1, n) < ist->smin) break;
             *--path = ITEMOF(curr); n += 1;
           }                     /* try to find a qualifying subset */
-          if (curr) SETSKIP(node->cnts[i]);
+          if (curr) SETSKIPAT(node, i);
         }                       /* if on the way to the root */
       }                         /* a subset was found that does */
     }                           /* not qualify, mark the item set */
@@ -1445,7 +1959,7 @@ void ist_filter (ISTREE *ist, ITEM size)
   if (((ist->dir < 0) ? -1 : 0) < ist->thresh) {
     SETSKIP(ist->wgt);          /* if the empty set and singletons */
     node = ist->lvls[0];        /* do not reach the eval. threshold */
-    for (i = node->size; --i >= 0; ) SETSKIP(node->cnts[i]);
+    for (i = node->size; --i >= 0; ) SETSKIPAT(node, i);
   }                             /* mark them all with a skip flag */
 }  /* ist_filter() */
 
@@ -1461,11 +1975,11 @@ static void clear (ISTNODE *node, ITEM *items, ITEM n, SUPP supp)
   &&    (n >= 0) && (items || (n <= 0)));
   while (--n > 0) {             /* follow the set/path from the node */
     if (node->offset >= 0) {    /* if a pure array is used */
-      chn = (ISTNODE**)(node->cnts +node->size);
+      chn = (ISTNODE**)CNTEND(node);
       ALIGN(chn);               /* get the child node array */
-      i   = *items++ -ITEMOF(chn[0]); }
+      i   = chnidx(*items++, chn, CHILDCNT(node)); }
     else {                      /* if an identifier map is used */
-      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      chn = (ISTNODE**)((ITEM*)CNTEND(node) +node->size);
       ALIGN(chn);               /* get the child node array */
       i   = search(*items++, chn, CHILDCNT(node));
     }                           /* get the proper child array index */
@@ -1474,11 +1988,11 @@ static void clear (ISTNODE *node, ITEM *items, ITEM n, SUPP supp)
   if (node->offset >= 0)        /* if a pure array is used, */
     i   = *items -node->offset; /* compute the counter index */
   else {                        /* if an identifier map is used */
-    map = (ITEM*)(node->cnts +(k = node->size));
+    map = (ITEM*)CNTEND(node); k = node->size;
     i   = ia_bsearch(*items, map, (size_t)k);
   }                             /* search for the proper index */
-  if (node->cnts[i] <= supp)    /* if the support is low enough, */
-    CLRSKIP(node->cnts[i]);     /* clear skip flag of the item set */
+  if (CNT(node, i) <= supp)     /* if the support is low enough, */
+    CLRSKIPAT(node, i);         /* clear skip flag of the item set */
 }  /* clear() */
 
 /*--------------------------------------------------------------------*/
@@ -1503,9 +2017,9 @@ void ist_clomax (ISTREE *ist, int target)
     for (k = ist->height; --k > 0; ) { /* traverse the tree top down */
       for (node = ist->lvls[k]; node; node = node->succ) {
         for (i = node->size; --i >= 0; ) {  /* traverse all sets */
-          if (node->cnts[i] < ist->smin) {  /* of all nodes */
-            SETSKIP(node->cnts[i]); continue; }
-          if (!(target & IST_MAXIMAL)) supp = node->cnts[i];
+          if (CNT(node, i) < ist->smin) {   /* of all nodes */
+            SETSKIPAT(node, i); continue; }
+          if (!(target & IST_MAXIMAL)) supp = CNT(node, i);
           curr = node->parent;  /* get parent of the current node */
           path = ist->buf +ist->height;
           *--path = ITEMAT(node, i); /* mark item corresp. to index */
@@ -1528,23 +2042,23 @@ void ist_clomax (ISTREE *ist, int target)
   if (target & ISR_GENERAS) {   /* if to filter for generators */
     node = ist->lvls[0];        /* traverse the root node elements */
     for (i = node->size; --i >= 0; ) {
-      if ((node->cnts[i] <  ist->smin)
-      ||  (node->cnts[i] >= ist->wgt))
-        SETSKIP(node->cnts[i]); /* mark all infrequent items */
+      if ((CNT(node, i) <  ist->smin)
+      ||  (CNT(node, i) >= ist->wgt))
+        SETSKIPAT(node, i);     /* mark all infrequent items */
     }                           /* and single item generators */
     for (h = 0; ++h < ist->height; ) {  /* traverse the tree levels */
       for (node = ist->lvls[h]; node; node = node->succ) {
         for (i = node->size; --i >= 0; ) {    /* traverse the nodes */
-          supp = node->cnts[i]; /* traverse the nodes on each level */
+          supp = CNT(node, i);  /* traverse the nodes on each level */
           if (supp < ist->smin){/* check for minimum support */
-            SETSKIP(node->cnts[i]); continue; }
+            SETSKIPAT(node, i); continue; }
           curr = node->parent;  /* check the direkt parent */
           k = ITEMOF(node);     /* for equal support */
           k = (curr->offset >= 0) ? k -curr->offset
-            : ia_bsearch(k, (ITEM*)(curr->cnts +curr->size),
+            : ia_bsearch(k, (ITEM*)CNTEND(curr),
                             (size_t)curr->size);
-          if (curr->cnts[k] <= supp) {
-            SETSKIP(node->cnts[i]); continue; }
+          if (CNT(curr, k) <= supp) {
+            SETSKIPAT(node, i); continue; }
           path = ist->buf +ist->height +1;
           *--path = ITEMAT(node, i);
           *--path = ITEMOF(node);   /* initialize the path */
@@ -1553,7 +2067,7 @@ void ist_clomax (ISTREE *ist, int target)
             if (getsupp(curr, path+1, n) <= supp) break;
             *--path = ITEMOF(curr); n += 1;
           }                     /* try to find a qualifying subset */
-          if (curr) SETSKIP(node->cnts[i]);
+          if (curr) SETSKIPAT(node, i);
         }                       /* if on the path to the root */
       }                         /* a subset could be found */
     }                           /* that has the same support, */
@@ -1564,28 +2078,28 @@ void ist_clomax (ISTREE *ist, int target)
   supp = (target & IST_MAXIMAL) ? ist->smin : ist->wgt;
   node = ist->lvls[0];          /* traverse the root node elements */
   for (i = node->size; --i >= 0; )  /* mark empty set if necessary */
-    if (node->cnts[i] >= supp) { SETSKIP(ist->wgt); break; }
+    if (CNT(node, i) >= supp) { SETSKIP(ist->wgt); break; }
 
   /* --- process intermediate levels --- */
   supp = SUPP_MAX;              /* set default support filter (max.) */
   for (h = 0; h < ist->height-1; h++) {   /* traverse the tree levels */
     for (node = ist->lvls[h]; node; node = node->succ) {
       for (i = node->size; --i >= 0; ) {  /* traverse the nodes */
-        if (node->cnts[i] < ist->smin) {  /* check for min. support */
-          SETSKIP(node->cnts[i]); continue; }
+        if (CNT(node, i) < ist->smin) {   /* check for min. support */
+          SETSKIPAT(node, i); continue; }
         item = ITEMAT(node, i); /* get item and min. superset support */
-        supp = (target & IST_MAXIMAL) ? ist->smin : node->cnts[i];
+        supp = (target & IST_MAXIMAL) ? ist->smin : CNT(node, i);
 
         /* -- check supersets in child -- */
         n = CHILDCNT(node);     /* get the number of children */
         if (n > 0) {            /* if there are child nodes */
           if (node->offset >= 0) { /* if pure array is used */
-            chn  = (ISTNODE**)(node->cnts +node->size);
+            chn  = (ISTNODE**)CNTEND(node);
             ALIGN(chn);         /* get the child node array */
-            k    = item -ITEMOF(chn[0]);
-            curr = ((k < 0) || (k >= n)) ? NULL : chn[k]; }
+            k    = chnidx(item, chn, n);
+            curr = (k < 0)               ? NULL : chn[k]; }
           else {                /* if an identifier map is used */
-            chn  = (ISTNODE**)((ITEM*)(node->cnts +node->size)
+            chn  = (ISTNODE**)((ITEM*)CNTEND(node)
                                                   +node->size);
             ALIGN(chn);         /* get the child node array */
             k    = search(item, chn, n);
@@ -1593,8 +2107,8 @@ void ist_clomax (ISTREE *ist, int target)
           }                     /* get child node for current item */
           if (curr) {           /* if the child node exists */
             for (k = curr->size; --k >= 0; )
-              if (curr->cnts[k] >= supp) break;
-            if (k >= 0) { SETSKIP(node->cnts[i]); continue; }
+              if (CNT(curr, k) >= supp) break;
+            if (k >= 0) { SETSKIPAT(node, i); continue; }
           }                     /* if a superset in the tail has */
         }                       /* sufficient support, mark set */
 
@@ -1611,10 +2125,10 @@ void ist_clomax (ISTREE *ist, int target)
                 if (getsupp(curr, path-1, n+1) >= supp) break;
               } }               /* if a superset qualifies, abort */
             else {              /* if an identifier map is used */
-              map = (ITEM*)(curr->cnts +(k = curr->size));
+              map = (ITEM*)CNTEND(curr); k = curr->size;
               k   = ia_bisect(*path, map, (size_t)k);
               while (++k < curr->size) {  /* traverse succ. items */
-                path[-1] = ((ITEM*)(curr->cnts +curr->size))[k];
+                path[-1] = ((ITEM*)CNTEND(curr))[k];
                 if (getsupp(curr, path-1, n+1) >= supp) break;
               }                 /* if a superset qualifies, abort */
             }
@@ -1633,10 +2147,10 @@ void ist_clomax (ISTREE *ist, int target)
                 if (getsupp(curr, path-1, n+1) >= supp) break;
               } }               /* if a superset qualifies, abort */
             else {              /* if an identifier map is used */
-              map = (ITEM*)(curr->cnts +(k = curr->size));
+              map = (ITEM*)CNTEND(curr); k = curr->size;
               k   = ia_bisect(*path, map, (size_t)k);
               while (--k >= 0){ /* traverse the preceding items */
-                path[-1] = ((ITEM*)(curr->cnts +curr->size))[k];
+                path[-1] = ((ITEM*)CNTEND(curr))[k];
                 if (getsupp(curr, path-1, n+1) >= supp) break;
               }                 /* if a superset qualifies, abort */
             }
@@ -1646,7 +2160,7 @@ void ist_clomax (ISTREE *ist, int target)
             *--path = ITEMOF(curr); n += 1;
           }                     /* extend the item set suffix/path */
         }
-        if (curr) SETSKIP(node->cnts[i]);
+        if (curr) SETSKIPAT(node, i);
       }                         /* if frequent/equal support superset */
     }                           /* was found, the current item set */
   }                             /* is not closed/maximal, resp. */
@@ -1654,8 +2168,8 @@ void ist_clomax (ISTREE *ist, int target)
   /* --- process deepest level --- */
   for (node = ist->lvls[h]; node; node = node->succ)
     for (i = node->size; --i >= 0; )
-      if (node->cnts[i] < ist->smin)
-        SETSKIP(node->cnts[i]); /* mark infrequent item sets only */
+      if (CNT(node, i) < ist->smin)
+        SETSKIPAT(node, i);     /* mark infrequent item sets only */
   /* All frequent item sets on the deepest level tree must be closed */
   /* and maximal, because they do not have supersets (in the tree).  */
 }  /* ist_clomax() */
@@ -1674,6 +2188,9 @@ void ist_setsize (ISTREE *ist, ITEM zmin, ITEM zmax)
 void ist_seteval (ISTREE *ist, int eval, int agg,
                   double thresh, ITEM prune)
 {                               /* --- set additional evaluation */
+  ITEM i;                       /* loop variable for items */
+  SUPP s;                       /* maximum item support */
+
   assert(ist);                  /* check the function arguments */
   ist->invbxs = eval & IST_INVBXS; eval &= ~IST_INVBXS;
   ist->eval   = ((eval > RE_NONE) && (eval < RE_FNCNT))
@@ -1683,7 +2200,12 @@ void ist_seteval (ISTREE *ist, int eval, int agg,
   ist->dir    = re_dir(ist->eval);
   ist->thresh = ist->dir*thresh;/* note the evaluation parameters */
   ist->prune  = (prune <= 0) ? ITEM_MAX : (prune > 1) ? prune : 2;
-}  /* ist_seteval() */
+  if ((ist->eval < RE_FETPROB) || ist->lfact)
+    return;                     /* check for Fisher's exact test */
+  for (s = 0, i = ib_cnt(ist->base); --i >= 0; )
+    if (ib_getfrq(ist->base, i) > s) s = ib_getfrq(ist->base, i);
+  ist->lfact = (re_lfinit(s) == 0);
+}  /* ist_seteval() */          /* build log-factorials for Fisher */
 
 /*--------------------------------------------------------------------*/
 
@@ -1755,7 +2277,7 @@ ITEM ist_iset (ISTREE *ist, ITEM *set, SUPP *supp, double *eval)
     item = ITEMAT(node, ist->index);     /* get the current item */
     if (ib_getapp(ist->base, item) == APP_NONE)
       continue;                 /* skip items to ignore */
-    curr = node->cnts[ist->index];
+    curr = CNT(node, ist->index);
     if (curr < ist->smin)       /* if the item set is not frequent, */
       continue;                 /* go to the next item set */
     /* Note that this check automatically skips all item sets that */
@@ -1844,7 +2366,7 @@ ITEM ist_rule (ISTREE *ist, ITEM *rule,
     if (!(app &  APP_HEAD)      /* get head item appearance indicator */
     ||  ((app != APP_HEAD) && ist->hdonly))
       continue;                 /* if rule is not allowed, skip it */
-    supp = COUNT(node->cnts[ist->index]);
+    supp = COUNT(CNT(node, ist->index));
     if (supp < ist->smin) {     /* if the item set is not frequent, */
       ist->item = -1; continue; }        /* go to the next item set */
     parent = node->parent;      /* get the parent node */
@@ -1854,16 +2376,16 @@ ITEM ist_rule (ISTREE *ist, ITEM *rule,
     else if (!parent)           /* if there is no parent (root node), */
       body = COUNT(ist->wgt);   /* get the total transation weight */
     else if (parent->offset >= 0)   /* if a pure array is used */
-      body = COUNT(parent->cnts[ITEMOF(node) -parent->offset]);
+      body = COUNT(CNT(parent, ITEMOF(node) -parent->offset));
     else {                      /* if an identifier map is used */
-      map  = (ITEM*)(parent->cnts +(n = parent->size));
+      map  = (ITEM*)CNTEND(parent); n = parent->size;
       i    = ia_bsearch(ITEMOF(node), map, (size_t)n);
-      body = COUNT(parent->cnts[i]);
+      body = COUNT(CNT(parent, i));
     }                           /* find array index and get support */
     if ((body < ist->body)      /* check the body support */
     ||  ((double)supp < (double)body *ist->conf))
       continue;                 /* check the rule confidence */
-    head = COUNT(ist->lvls[0]->cnts[ist->item]);
+    head = COUNT(CNT(ist->lvls[0], ist->item));
     if (!refn) {                /* if no add. eval. measure given, */
       val = 0; break; }         /* abort the loop (select the rule) */
     val = (!ist->invbxs         /* compute add. evaluation measure */
@@ -1897,7 +2419,6 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
 {                               /* --- recursive item set reporting */
   ITEM    i, k, c;              /* loop variables, buffers */
   SUPP    pex;                  /* support for perfect extension */
-  ITEM    off;                  /* item offset */
   ITEM    *map;                 /* item identifier map */
   ISTNODE **chn;                /* child node array */
   double  v;                    /* value of evaluation measure */
@@ -1908,7 +2429,7 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
   else {                        /* if perfect extensions pruning */
     pex = supp;                 /* note the parent set support */
     for (k = 0; k < node->size; k++) {
-      if (COUNT(node->cnts[k]) >= pex)
+      if (COUNT(CNT(node, k)) >= pex)
         isr_addpex(rep, ITEMAT(node, k));
     }                           /* collect the perfect extensions */
   }                             /* (note that they may be redisc.) */
@@ -1918,12 +2439,11 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
     &&  (isr_reportv(rep, v) < 0)) return -1;
   }                             /* if item set qualifies, report it */
   if (node->offset >= 0) {      /* if a pure array is used */
-    chn = (ISTNODE**)(node->cnts +node->size);
+    chn = (ISTNODE**)CNTEND(node);
     ALIGN(chn);                 /* get the child node array */
     c   = CHILDCNT(node);       /* and the number of children */
-    off = (c > 0) ? ITEMOF(chn[0]) : 0;
     for (i = 0; i < node->size; i++) {
-      supp = COUNT(node->cnts[i]);
+      supp = COUNT(CNT(node, i));
       if ((supp <  ist->smin)   /* traverse the node's items and */
       ||  (supp >= pex))        /* check against minimum support */
         continue;               /* and the parent set support */
@@ -1931,11 +2451,10 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
       ist->index = i;           /* note index for evaluation */
       k = node->offset +i;      /* compute the item identifier */
       isr_add(rep, k, supp);    /* add the item to the reporter */
-      supp = node->cnts[i];     /* get the item support (with flag) */
-      k -= off;                 /* compute the child node index */
-      if ((k >= 0)              /* if the corresp. child node exists, */
-      &&  (k <  c) && chn[k])   /* recursively report the subtree */
-        isets(ist, rep, chn[k], supp);
+      supp = CNT(node, i);      /* get the item support (with flag) */
+      k = (c > 0) ? chnidx(k, chn, c) : -1;
+      if (k >= 0)               /* if the corresp. child node exists, */
+        isets(ist, rep, chn[k], supp);  /* report the subtree */
       else if (!IS2SKIP(supp)){ /* report item set if not marked */
         v = evaluate(ist, node, i);
         if ((v *ist->dir >= ist->thresh)
@@ -1944,12 +2463,13 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
       isr_remove(rep, 1);       /* remove the last item */
     } }                         /* from the current item set */
   else {                        /* if an identifier map is used */
-    map = (ITEM*)(node->cnts +(k = node->size));
+    map = (ITEM*)CNTEND(node); k = node->size;
     chn = (ISTNODE**)(map +k);  /* get the item id map */
-    c   = CHILDCNT(node);       /* and the child node array  */
+    ALIGN(chn);                 /* and the child node array */
+    c   = CHILDCNT(node);       /* (and the number of children) */
     c   = (c > 0) ? ITEMOF(chn[c-1]) : -1;
     for (i = 0; i < node->size; i++) {
-      supp = COUNT(node->cnts[i]);
+      supp = COUNT(CNT(node, i));
       if ((supp <  ist->smin)   /* traverse the node's items and */
       ||  (supp >= pex))        /* check against minimum support */
         continue;               /* and the parent set support */
@@ -1957,7 +2477,7 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
       ist->index = i;           /* in the node for evaluation */
       k = map[i];               /* retrieve the item identifier */
       isr_add(rep, k, supp);    /* add the item to the reporter */
-      supp = node->cnts[i];     /* get the item support (with flag) */
+      supp = CNT(node, i);      /* get the item support (with flag) */
       if (k <= c)               /* if there may be a child node, */
         while (ITEMOF(*chn) < k) chn++;  /* skip preceding items */
       if ((k <= c)              /* if the corresp. child node exists, */
@@ -1983,21 +2503,16 @@ static int r4set (ISTREE *ist, ISREPORT *rep, ISTNODE *node, ITEM index)
   int        app;               /* appearance flag of head item */
   ISTNODE    *parent;           /* parent of the item set node */
   ITEM       *map, n;           /* identifier map and its size */
-  SUPP       base;              /* base support (number of trans.) */
+  ITEM       m;                 /* number of candidate rules */
   SUPP       supp;              /* support of set  (body & head) */
   SUPP       body;              /* support of body (antecedent) */
-  SUPP       head;              /* support of head (consequent) */
   double     val;               /* value of evaluation measure */
-  RULEVALFN  *refn;             /* rule evaluation function */
 
   assert(ist                    /* check the function arguments */
   &&     rep && node && (index >= 0));
-  refn = ((ist->eval > RE_NONE) && (ist->eval < RE_FNCNT))
-       ? re_function(ist->eval) : (RULEVALFN*)0;
-  base = COUNT(ist->wgt);       /* get base and item set support */
-  supp = COUNT(node->cnts[index]);
+  supp = COUNT(CNT(node, index));   /* get the item set support */
   item = (node->offset >= 0) ? node->offset +index
-       : ((ITEM*)(node->cnts +node->size))[index];
+       : ((ITEM*)CNTEND(node))[index];
   app  = ib_getapp(ist->base, item);
   if ((app == APP_NONE) || ((app == APP_HEAD) && ISHDONLY(node)))
     return 0;                   /* skip sets with two head only items */
@@ -2005,29 +2520,19 @@ static int r4set (ISTREE *ist, ISREPORT *rep, ISTNODE *node, ITEM index)
   if (!parent)                  /* if there is no parent (root node), */
     body = COUNT(ist->wgt);     /* get the total transaction weight */
   else if (parent->offset >= 0) /* if a pure array is used */
-    body = COUNT(parent->cnts[ITEMOF(node) -parent->offset]);
+    body = COUNT(CNT(parent, ITEMOF(node) -parent->offset));
   else {                        /* if an identifier map is used */
-    map  = (ITEM*)(parent->cnts +(n = parent->size));
+    map  = (ITEM*)CNTEND(parent); n = parent->size;
     i    = ia_bsearch(ITEMOF(node), map, (size_t)n);
-    body = COUNT(parent->cnts[i]);
+    body = COUNT(CNT(parent, i));
   }                             /* find array index and get support */
-  do {                          /* check and report the first rule */
-    if (!(app & APP_HEAD))      /* check whether the current item */
-      break;                    /* can occur as a rule head */
-    if ((body < ist->body)      /* check the body support */
-    ||  ((double)supp < (double)body *ist->conf))
-      break;                    /* check the rule confidence */
-    head = COUNT(ist->lvls[0]->cnts[item]);
-    if (!refn) val = 0;         /* if no add. eval. measure given, */
-    else {                      /* clear the evaluation, otherwise */
-      val = (!ist->invbxs       /* compute add. evaluation measure */
-         || ((double)supp *(double)base > (double)head *(double)body))
-          ? refn(supp, body, head, base) : (ist->dir < 0) ? 1 : 0;
-      if (ist->dir *val < ist->thresh)
-        break;                  /* check whether the evaluation */
-    }                           /* reaches or exceed the threshold */
-    if (isr_reprule(rep, item, body, head, val) != 0) return -1;
-  } while (0);                  /* report the current rule */
+  m = 0;                        /* init. the candidate rule counter */
+  if ((app & APP_HEAD)          /* check whether the current item */
+  &&  (body >= ist->body)       /* can occur as a rule head, */
+  &&  ((double)supp >= (double)body *ist->conf)) {
+    ist->ritem[m] = item;       /* check the body support and */
+    ist->rbody[m] = body; m++;  /* the rule confidence and */
+  }                             /* note the first candidate rule */
   ist->path = ist->buf +ist->height;
   *--ist->path = item; n = 1;   /* store head item on the path */
   for ( ; parent; node = parent, parent = node->parent) {
@@ -2039,17 +2544,25 @@ static int r4set (ISTREE *ist, ISREPORT *rep, ISTNODE *node, ITEM index)
     if ((body < ist->body)      /* check the body support */
     ||  ((double)supp < (double)body *ist->conf))
       continue;                 /* check the rule confidence */
-    head = COUNT(ist->lvls[0]->cnts[item]);
-    if (!refn) val = 0;         /* if no add. eval. measure given, */
-    else {                      /* clear the evaluation, otherwise */
-      val = (!ist->invbxs       /* compute add. evaluation measure */
-         || ((double)supp *(double)base > (double)head *(double)body))
-          ? refn(supp, body, head, base) : (ist->dir < 0) ? 1 : 0;
+    ist->ritem[m] = item;       /* note the candidate rule */
+    ist->rbody[m] = body; m++;  /* (head item and body support) */
+  }
+  for (i = 0; i < m; i++) {     /* collect the head supports */
+    ist->rsupp[i] = supp;       /* of the candidate rules */
+    ist->rhead[i] = COUNT(CNT(ist->lvls[0], ist->ritem[i]));
+  }
+  if ((m > 0) && (ist->eval > RE_NONE))
+    evalrules(ist, COUNT(ist->wgt), m);
+  for (i = 0; i < m; i++) {     /* traverse the candidate rules */
+    if (ist->eval <= RE_NONE) val = 0;
+    else {                      /* if no add. eval. measure, clear */
+      val = ist->rvals[i];      /* the evaluation, otherwise */
       if (ist->dir *val < ist->thresh)
         continue;               /* check whether the evaluation */
     }                           /* reaches or exceed the threshold */
-    if (isr_reprule(rep, item, body, head, val) != 0) return -1;
-  }                             /* report the current rule */
+    if (isr_reprule(rep, ist->ritem[i], ist->rbody[i],
+                    ist->rhead[i], val) != 0) return -1;
+  }                             /* report the qualifying rules */
   return 0;                     /* return 'ok' */
 }  /* r4set() */
 
@@ -2058,42 +2571,40 @@ static int r4set (ISTREE *ist, ISREPORT *rep, ISTNODE *node, ITEM index)
 static int rules (ISTREE *ist, ISREPORT *rep, ISTNODE *node)
 {                               /* --- recursive rule reporting */
   ITEM    i, k, c;              /* loop variables, buffers */
-  ITEM    off;                  /* item offset */
   ITEM    *map;                 /* item identifier map */
   SUPP    supp;                 /* support of current item set */
   ISTNODE **chn;                /* child node array */
 
   assert(ist && rep);           /* check the function arguments */
   if (node->offset >= 0) {      /* if a pure array is used */
-    chn = (ISTNODE**)(node->cnts +node->size);
+    chn = (ISTNODE**)CNTEND(node);
     ALIGN(chn);                 /* get the child node array */
     c   = CHILDCNT(node);       /* and the number of children */
-    off = (c > 0) ? ITEMOF(chn[0]) : 0;
     for (i = 0; i < node->size; i++) {
-      supp = COUNT(node->cnts[i]);
+      supp = COUNT(CNT(node, i));
       if (supp < ist->smin)     /* traverse the node's items and */
         continue;               /* check against minimum support */
       k = node->offset +i;      /* compute the item identifier */
       isr_add(rep, k, supp);    /* add the item to the reporter */
-      k -= off;                 /* compute the child node index */
-      if ((k >= 0)              /* if the corresp. child node exists, */
-      &&  (k <  c) && chn[k])   /* recursively report the subtree, */
-        rules(ist, rep, chn[k]);/* then report rules for item set */
+      k = (c > 0) ? chnidx(k, chn, c) : -1;
+      if (k >= 0)               /* if the corresp. child node exists, */
+        rules(ist, rep, chn[k]);/* recursively report the subtree, */
       if (r4set(ist, rep, node, i) < 0) return -1;
       isr_remove(rep, 1);       /* remove the last item */
     } }                         /* from the current item set */
   else {                        /* if an identifier map is used */
-    map = (ITEM*)(node->cnts +(k = node->size));
+    map = (ITEM*)CNTEND(node); k = node->size;
     chn = (ISTNODE**)(map +k);  /* get the item id map */
-    c   = CHILDCNT(node);       /* and the child node array  */
+    ALIGN(chn);                 /* and the child node array */
+    c   = CHILDCNT(node);       /* (and the number of children) */
     c   = (c > 0) ? ITEMOF(chn[c-1]) : -1;
     for (i = 0; i < node->size; i++) {
-      supp = COUNT(node->cnts[i]);
+      supp = COUNT(CNT(node, i));
       if (supp < ist->smin)     /* traverse the node's items and */
         continue;               /* check against minimum support */
       k = map[i];               /* retrieve the item identifier */
       isr_add(rep, k, supp);    /* add the item to the reporter */
-      supp = node->cnts[i];     /* get the item support (with flag) */
+      supp = CNT(node, i);      /* get the item support (with flag) */
       if (k <= c) {             /* if there may be a child node, */
         while (ITEMOF(*chn) < k) chn++;  /* skip preceding items */
         if (k == ITEMOF(*chn))  /* if the corresp. child node exists, */
@@ -2176,6 +2687,8 @@ void ist_stats (ISTREE *ist)
   printf("number of child pointers   : %"SIZE_FMT"\n", ist->cpcnt);
   printf("necessary child pointers   : %"SIZE_FMT"\n", ist->cpnec);
   printf("pruned    child pointers   : %"SIZE_FMT"\n", ist->cpprn);
+  printf("number of bitmap blocks    : %"SIZE_FMT"\n", ist->bmcnt);
+  printf("number of narrow counters  : %"SIZE_FMT"\n", ist->nccnt);
 }  /* ist_stats() */
 
 #endif
@@ -2189,21 +2702,20 @@ static void showtree (ISTNODE *node, ITEMBASE *base, ITEM level)
 
   assert(node && (level >= 0)); /* check the function arguments */
   i   = (node->offset < 0) ? node->size : 0;
-  chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +i);
+  chn = (ISTNODE**)((ITEM*)CNTEND(node) +i);
   ALIGN(chn);                   /* get the child node array */
   cnt = CHILDCNT(node);         /* and the number of children */
   for (i = 0; i < node->size; i++) {
     for (k = level; --k >= 0; ) printf("   ");
     k = ITEMAT(node, i);        /* print item identifier and counter */
     printf("%s", ib_name(base, k));
-    printf("/%"ITEM_FMT": %"SUPP_FMT, k, COUNT(node->cnts[i]));
-    if (IS2SKIP(node->cnts[i])) printf("*");
+    printf("/%"ITEM_FMT": %"SUPP_FMT, k, COUNT(CNT(node, i)));
+    if (IS2SKIP(CNT(node, i))) printf("*");
     printf("\n");               /* print a skip flag indicator */
     if (cnt <= 0) continue;     /* check whether there are children */
-    if (node->offset >= 0) k -= ITEMOF(chn[0]);
-    else                   k  = (int)search(k, chn, cnt);
-    if ((k >= 0) && (k < cnt) && chn[k])
-      showtree(chn[k], base, level +1);
+    if (node->offset >= 0) k = chnidx(k, chn, cnt);
+    else                   k = search(k, chn, cnt);
+    if (k >= 0) showtree(chn[k], base, level +1);
   }                             /* show subtree recursively */
 }  /* showtree() */
 
@@ -43,6 +43,12 @@
             2014.08.01 minimum improvement of evaluation measure removed
             2014.08.14 function ist_addchn() and related functions added
             2014.08.21 parameter 'body' added to function ist_create()
+            2026.10.16 sharded (multi-threaded) counting added
+            2026.10.17 buffers for batch rule evaluation added
+            2026.10.17 log-factorial table for Fisher's exact test
+            2026.10.17 ist_countb() returns an error status
+            2026.10.17 number of child bitmap blocks added (BENCH)
+            2026.10.17 number of narrow counters added (BENCH)
 ----------------------------------------------------------------------*/
 #ifndef __ISTREE__
 #define __ISTREE__
@@ -87,6 +93,8 @@ typedef struct istnode {        /* --- item set tree node --- */
   ITEM           offset;        /* offset of counter array */
   ITEM           size;          /* size   of counter array */
   ITEM           chcnt;         /* number of child nodes */
+  ITEM           index;         /* index of counters in shards */
+                                /* (highest bit: narrow counters) */
   SUPP           cnts[1];       /* counter array (weights) */
 } ISTNODE;                      /* (item set tree node) */
 
@@ -105,6 +113,7 @@ typedef struct {                /* --- item set tree --- */
   int      invbxs;              /* invalidate eval. below expectation */
   double   dir;                 /* direction of evaluation measure */
   double   thresh;              /* evaluation measure threshold */
+  int      lfact;               /* whether log-factorial table used */
   ISTNODE  *curr;               /* current node for traversal */
   ITEM     depth;               /* depth of current node */
   ITEM     size;                /* current size of an item set */
@@ -120,6 +129,16 @@ typedef struct {                /* --- item set tree --- */
   ITEM     *path;               /* current path / (partial) item set */
   int      hdonly;              /* head only item in current set */
   ITEM     *map;                /* to create identifier maps */
+  int      threads;             /* number of threads for counting */
+  int      shcnt;               /* number of counter shards in use */
+  size_t   shsz;                /* size of each counter shard */
+  size_t   shmax;               /* size of the shard buffer */
+  SUPP     *shards;             /* counter shards (one per thread) */
+  double   *rvals;              /* values of candidate rules */
+  SUPP     *rsupp;              /* supports of candidate rules */
+  SUPP     *rbody;              /* body supports of candidate rules */
+  SUPP     *rhead;              /* head supports of candidate rules */
+  ITEM     *ritem;              /* head items of candidate rules */
 #ifdef BENCH                    /* if benchmark version */
   size_t   ndcnt;               /* number of item set tree nodes */
   size_t   ndprn;               /* number of pruned tree nodes */
@@ -130,6 +149,8 @@ typedef struct {                /* --- item set tree --- */
   size_t   cpcnt;               /* number of created child pointers */
   size_t   cpnec;               /* number of necessary child pointers */
   size_t   cpprn;               /* number of pruned child pointers */
+  size_t   bmcnt;               /* number of child bitmap blocks */
+  size_t   nccnt;               /* number of narrow (16 bit) counters */
 #endif
 } ISTREE;                       /* (item set tree) */
 
@@ -145,7 +166,8 @@ extern ITEM      ist_itemcnt (ISTREE *ist);
 extern void      ist_count   (ISTREE *ist,
                               const ITEM *items, ITEM n, SUPP wgt);
 extern void      ist_countt  (ISTREE *ist, const TRACT  *tract);
-extern void      ist_countb  (ISTREE *ist, const TABAG  *bag);
+extern int       ist_countb  (ISTREE *ist, const TABAG  *bag);
+extern void      ist_setthds (ISTREE *ist, int threads);
 #ifdef TATREEFN
 extern void      ist_countx  (ISTREE *ist, const TATREE *tree);
 #endif
@@ -205,6 +227,7 @@ extern void      ist_show    (ISTREE *ist);
 #define ist_zmin(t)       ((t)->zmin)
 #define ist_zmax(t)       ((t)->zmax)
 #define ist_height(t)     ((t)->height)
+#define ist_setthds(t,n)  ((t)->threads = (n))
 #define ist_getwgt(t)     ((t)->wgt & ~SUPP_MIN)
 #define ist_setwgt(t,n)   ((t)->wgt = (n))
 #define ist_incwgt(t,n)   ((t)->wgt = ((t)->wgt & ~SUPP_MIN) +(n))
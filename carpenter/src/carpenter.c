@@ -32,6 +32,9 @@
             2017.03.24 carpenter miner object and interface introduced
             2017.05.30 optional output compression with zlib added
             2017.06.13 bug in reporting mode fixed (ISR_NOFILTER)
+            2026.10.16 multi-threaded search on the top level added
+            2026.10.16 item set with all perfect extensions fixed (tid)
+            2026.10.17 empty intersections skipped in recursions
 ------------------------------------------------------------------------
   Reference for the Carpenter algorithm:
     F. Pan, G. Cong, A.K.H. Tung, J. Yang, and M. Zaki.
@@ -74,6 +77,7 @@
 #endif
 #include "repotree.h"
 #include "carpenter.h"
+#include "tpool.h"
 #ifdef CARP_MAIN
 #include "error.h"
 #endif
@@ -141,8 +145,22 @@ struct _carp {                  /* --- carpenter miner --- */
   SUPP     *muls;               /* multiplicity of transactions */
   ITEM     *set;                /* buffer for an item set */
   REPOTREE *rpt;                /* repository of item sets */
+  int      threads;             /* number of threads (top level) */
 };                              /* (carpenter miner) */
 
+typedef struct {                /* --- parallel search --- */
+  CARP     *carp;               /* carpenter miner of calling thread */
+  CARP     *thds;               /* copies of the miner (stripes) */
+  void     **bufs;              /* buffers of the stripes */
+  int      cnt;                 /* number of threads/stripes */
+  int      wgt;                 /* flag for transaction weights */
+  long     tcnt;                /* number of top-level tasks */
+  TID      *tids;               /* transaction ids of the tasks */
+  SUPP     *supps;              /* supports of perfect extensions */
+  size_t   *offs;               /* offsets of the intersections */
+  void     *isects;             /* top-level intersections (tasks) */
+} CARPPAR;                      /* (parallel search) */
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -261,6 +279,91 @@ static void show_tid (const char *text, TIDLIST *lists, ITEM k, int ind)
 }  /* show_tid() */
 
 #endif  /* #ifndef NDEBUG */
+/*----------------------------------------------------------------------
+  Auxiliary Functions for Multi-threaded Search
+----------------------------------------------------------------------*/
+
+static int par_exit (CARPPAR *par, int r)
+{                               /* --- finish a parallel search */
+  int  i;                       /* loop variable for stripes */
+  CARP *e;                      /* to traverse the miner copies */
+
+  assert(par);                  /* check the function argument */
+  for (i = 0; i < par->cnt; i++) {
+    e = par->thds +i;           /* traverse the miner copies */
+    if (e->rpt) {               /* merge the item set repositories */
+      if ((r >= 0) && (rpt_merge(par->carp->rpt, e->rpt) < 0))
+        r = -1;                 /* (maximum of the supports) */
+      rpt_delete(e->rpt, 1);    /* and delete the repositories */
+    }                           /* of the stripes */
+    if (par->bufs[i]) free(par->bufs[i]);
+  }                             /* delete the stripe buffers */
+  free(par->thds);              /* delete the miner copies */
+  return r;                     /* return the error status */
+}  /* par_exit() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_init (CARPPAR *par, CARP *carp, TID n,
+                     size_t x, size_t z)
+{                               /* --- prepare a parallel search */
+  int  i, t;                    /* loop variable, number of threads */
+  CARP *e;                      /* to traverse the miner copies */
+
+  assert(par && carp);          /* check the function arguments */
+  t = carp->threads;            /* get the number of threads */
+  if (t <= 0) t = tp_cpucnt();  /* (default: number of processors) */
+  if (t > n)  t = (int)n;       /* use at most one thread per trans. */
+  if ((t <= 1)                  /* check for a parallel search */
+  ||  ((carp->mode & CARP_MAXONLY)     /* (closed item sets with */
+  &&  !(carp->target & ISR_MAXIMAL)))  /* maximal only depend on */
+    return 0;                   /* the order of the search) */
+  par->carp = carp;             /* note the carpenter miner */
+  par->cnt  = 0;                /* and allocate the miner copies */
+  par->thds = (CARP*)malloc((size_t)t    *sizeof(CARP)
+                           +(size_t)t    *sizeof(void*)
+                           +(size_t)(n+1)*sizeof(size_t) +x
+                           +(size_t)n    *sizeof(TID)
+                           +(size_t)n    *sizeof(SUPP));
+  if (!par->thds) return -1;    /* create an array of miner copies */
+  par->bufs   = (void**)(par->thds +t);
+  par->offs   = (size_t*)(par->bufs +t);
+  par->isects = par->offs +n+1; /* split off the task arrays */
+  par->tids   = (TID*) ((char*)par->isects +x);
+  par->supps  = (SUPP*)(par->tids +n);
+  for (i = 0; i < t; i++) {     /* traverse the stripes */
+    e = par->thds +i; *e = *carp;   /* copy the carpenter miner */
+    e->threads = 1;             /* (no nested parallel search) */
+    par->bufs[i] = NULL;        /* clear the buffer of the stripe */
+    par->cnt   = i+1;           /* create a repository per stripe */
+    e->rpt     = rpt_create(NULL, carp->rpt->size, rpt_dir(carp->rpt));
+    if (!e->rpt) break;         /* (collects the found item sets) */
+    par->bufs[i] = malloc(z);   /* allocate a buffer for the stripe */
+    if (!par->bufs[i]) break;   /* (for intersections/tid lists) */
+  }
+  if (i < t) { par_exit(par, -1); return -1; }
+  return t;                     /* return the number of threads */
+}  /* par_init() */
+
+/* The transactions on the top level of the recursion are distributed */
+/* in an interleaved fashion over as many stripes as there are        */
+/* threads. Their intersections with the full item set are computed   */
+/* beforehand in the calling thread, because the perfect extensions   */
+/* that are found on the top level change the supports and the        */
+/* filtering of later transactions. Each stripe is processed by a     */
+/* copy of the carpenter miner with its own item set repository,      */
+/* which therefore only prunes with the item sets found in this       */
+/* stripe. Since the transactions of a stripe are processed in the    */
+/* same (descending) order as in a serial search, this is sound: a    */
+/* superset of a closed item set can only have been found with a      */
+/* transaction that contains the closed item set, so the branch of    */
+/* the largest transaction id in the cover of the closed item set is  */
+/* explored as in a serial search and yields the exact support (work  */
+/* stealing would destroy this order, hence the stripes are fixed).   */
+/* Afterwards the repositories are merged into the one of the calling */
+/* thread (maximum of supports), on which the closedness or           */
+/* maximality check is carried out by rpt_report() as usual.          */
+
 /*----------------------------------------------------------------------
   Carpenter based on an Item Occurrence Table
 ----------------------------------------------------------------------*/
@@ -286,7 +389,8 @@ static SUPP rec_tab (CARP *carp, ITEM *set, ITEM k, TID n, SUPP supp)
     row = carp->tab[n];         /* filter item set with table row */
     for (i = m = 0; i < k; i++) /* corresp. to current transaction */
       if (row[set[i]] > s) dst[m++] = set[i];
-    if (m <  carp->zmin) continue; /* skip too small intersections */
+    if ((m < carp->zmin) || (m <= 0))
+      continue;                 /* skip too small intersections */
     if (m <= 1) {               /* if there is only one item left */
       r = (SUPP)rpt_add(carp->rpt, dst, m, supp +row[*dst]);
       if (r < 0) return r; else continue;
@@ -330,7 +434,8 @@ static SUPP rec_mtb (CARP *carp, ITEM *set, ITEM k, TID n, SUPP supp)
     row = carp->tab[n];         /* filter item set with table row */
     for (i = m = 0; i < k; i++) /* corresp. to current transaction */
       if (row[set[i]] > s) dst[m++] = set[i];
-    if (m <  carp->zmin) continue; /* skip too small intersections */
+    if ((m < carp->zmin) || (m <= 0))
+      continue;                 /* skip too small intersections */
     if (m <= 1) {               /* if there is only one item left */
       r = (SUPP)rpt_add(carp->rpt, dst, m, supp +row[*dst]);
       if (r < 0) return r; else continue;
@@ -352,12 +457,100 @@ static SUPP rec_mtb (CARP *carp, ITEM *set, ITEM k, TID n, SUPP supp)
   return supp;                  /* return the item set support */
 }  /* rec_mtb() */
 
+/*--------------------------------------------------------------------*/
+
+static int tab_task (void *data, int thread, long task)
+{                               /* --- process a stripe of trans. */
+  CARPPAR *par = (CARPPAR*)data;/* type the data pointer */
+  CARP    *carp;                /* copy of the carpenter miner */
+  ITEM    *set;                 /* buffer for the intersection */
+  ITEM    m;                    /* size of the intersection */
+  TID     n;                    /* transaction id of the task */
+  SUPP    s, r;                 /* item set support, error status */
+  long    i;                    /* loop variable for top-level tasks */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  carp = par->thds +task;       /* get the miner copy of the stripe */
+  set  = (ITEM*)par->bufs[task];
+  for (i = task; i < par->tcnt; i += par->cnt) {
+    m = (ITEM)(par->offs[i+1] -par->offs[i]);
+    memcpy(set, (ITEM*)par->isects +par->offs[i],
+           (size_t)m *sizeof(ITEM));  /* copy the intersection */
+    n = par->tids[i];           /* get the transaction id */
+    s = par->supps[i];          /* and the perfect ext. support */
+    if (m <= 1) {               /* if there is only one item left */
+      r = (SUPP)rpt_add(carp->rpt, set, m, s +carp->tab[n][*set]);
+      if (r < 0) return -1; else continue;
+    }                           /* update the item set repository */
+    if ((carp->mode & CARP_MAXONLY) /* if to find maximal item sets */
+    &&  rpt_super(carp->rpt, set, m, carp->supp))
+      continue;                 /* check for a frequent superset */
+    s += (par->wgt) ? carp->muls[n] : 1;
+    r = (SUPP)rpt_add(carp->rpt, set, m, s);
+    if (r <  0) return -1;      /* add item set to the repository */
+    if (r <= 0) continue;       /* find closed item sets recursively */
+    r = (par->wgt) ? rec_mtb(carp, set, m, n, s)
+                   : rec_tab(carp, set, m, n, s);
+    if (r > s)                  /* if there are perfect extensions */
+      r = (SUPP)rpt_add(carp->rpt, set, m, r);
+    if (r < 0) return -1;       /* update the item set repository */
+  }                             /* and finally check for an error */
+  return 0;                     /* return 'ok' */
+}  /* tab_task() */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP par_tab (CARP *carp, ITEM *set, ITEM k, TID n,
+                     size_t x, int wgt)
+{                               /* --- parallel version of rec_tab() */
+  int     r;                    /* error status */
+  ITEM    i, m;                 /* loop variables, item counter */
+  SUPP    s, supp = 0;          /* needed support, perfect ext. supp. */
+  long    c = 0;                /* number of tasks */
+  SUPP    *row;                 /* to traverse the table rows */
+  ITEM    *dst;                 /* intersection destination */
+  ITEM    pex;                  /* minimum items for perfext exts. */
+  CARPPAR par;                  /* data for the parallel search */
+
+  assert(carp && set && (k > 0) && (n >= 0));
+  r = par_init(&par, carp, n, x *sizeof(ITEM),
+               ((size_t)k +x) *sizeof(ITEM));
+  if (r <= 0)                   /* if no parallel search is possible */
+    return (r < 0) ? -1 : (wgt) ? rec_mtb(carp, set, k, n, 0)
+                                : rec_tab(carp, set, k, n, 0);
+  par.wgt = wgt;                /* note the transaction weight flag */
+  dst = (ITEM*)par.isects;      /* get the intersection buffer */
+  pex = (carp->mode & CARP_PERFECT) ? k : ITEM_MAX;
+  par.offs[0] = 0;              /* collect the top-level tasks */
+  while (--n >= 0) {            /* traverse the transactions */
+    s = carp->supp -supp -1;    /* compute the minimum support -1 */
+    if (s < 0) s = 0;           /* needed in remaining transactions */
+    if (!wgt && (n < s)) break; /* (end value for trans. loop) */
+    row = carp->tab[n];         /* filter item set with table row */
+    for (i = m = 0; i < k; i++) /* corresp. to current transaction */
+      if (row[set[i]] > s) dst[m++] = set[i];
+    if ((m < carp->zmin) || (m <= 0))
+      continue;                 /* skip too small intersections */
+    if ((m > 1) && (m >= pex)) {/* collect perfect extensions */
+      supp += (wgt) ? carp->muls[n] : 1; continue; }
+    par.tids [c] = n;           /* note the transaction id and */
+    par.supps[c] = supp;        /* the perfect extension support */
+    par.offs[c+1] = par.offs[c] +(size_t)m;
+    dst += m; c++;              /* note the intersection size */
+  }                             /* and advance the buffer */
+  par.tcnt = c;                 /* note the number of tasks */
+  r = tp_exec(par.cnt, par.cnt, tab_task, &par);
+  r = par_exit(&par, r);        /* process the tasks in parallel */
+  return (r < 0) ? -1 : supp;   /* return the item set support */
+}  /* par_tab() */
+
 /*----------------------------------------------------------------------
 Note that no memory is allocated directly in the above functions; all
 processing is done in the single memory block that is allocated in the
 function below. The size of this memory block is O(n*k), where n is the
 number of items and k the number of transactions. Additional memory is
-only allocated in rpt_add() for the item set repository carp->rpt.
+only allocated in rpt_add() for the item set repository carp->rpt and,
+for a multi-threaded search, in par_init() for the stripe buffers.
 ----------------------------------------------------------------------*/
 
 int carp_tab (CARP *carp)
@@ -413,9 +606,7 @@ int carp_tab (CARP *carp)
   if (rpt_dir(carp->rpt) > 0)   /* set the initial (full) item set */
        for (i = 0; i < k; i++) set[i] = i;
   else for (i = 0; i < k; i++) set[i] = k-1-i;
-  w = (m)                       /* search for closed freq. item sets */
-    ? rec_mtb(carp, set, k, n, 0)
-    : rec_tab(carp, set, k, n, 0);
+  w = par_tab(carp, set, k, n, x, m > 0);  /* search for closed sets */
   if (w > 0)                    /* if there are perfect extensions, */
     rpt_add(carp->rpt,set,k,w); /* update the item set repository */
   free(carp->tab);              /* delete the allocated table/array */
@@ -451,7 +642,8 @@ static SUPP rec_tid (CARP *carp, TIDLIST *lists,
         if (--lists[i].supp >= s) dst[m++] = lists[i];
       }                         /* collect the frequent items in */
     }                           /* the conditional tid list array */
-    if (m <  carp->zmin) continue; /* skip too small intersections */
+    if ((m < carp->zmin) || (m <= 0))
+      continue;                 /* skip too small intersections */
     if (m <= 1) {               /* if there is only one item left */
       r = (SUPP)rpt_add(carp->rpt, &dst->item, 1, supp+1 +dst->supp);
       if (r < 0) return r; else continue;
@@ -504,7 +696,8 @@ static SUPP rec_mti (CARP *carp, TIDLIST *lists,
         if (lists[i].supp >= s) dst[m++] = lists[i];
       }                         /* collect the frequent items in */
     }                           /* the conditional tid list array */
-    if (m <  carp->zmin) continue; /* skip too small intersections */
+    if ((m < carp->zmin) || (m <= 0))
+      continue;                 /* skip too small intersections */
     if (m <= 1) {               /* if there is only one item left */
       s = supp +carp->muls[n] +dst->supp;
       r = (SUPP)rpt_add(carp->rpt, &dst->item, 1, s);
@@ -532,12 +725,112 @@ static SUPP rec_mti (CARP *carp, TIDLIST *lists,
   return supp;                  /* return the item set support */
 }  /* rec_mti() */
 
+/*--------------------------------------------------------------------*/
+
+static int tid_task (void *data, int thread, long task)
+{                               /* --- process a stripe of trans. */
+  CARPPAR *par = (CARPPAR*)data;/* type the data pointer */
+  CARP    *carp;                /* copy of the carpenter miner */
+  TIDLIST *lists;               /* tid lists of projected database */
+  ITEM    k, m;                 /* loop variable, number of lists */
+  TID     n;                    /* transaction id of the task */
+  SUPP    s, r;                 /* item set support, error status */
+  long    i;                    /* loop variable for top-level tasks */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  carp  = par->thds +task;      /* get the miner copy of the stripe */
+  lists = (TIDLIST*)par->bufs[task];
+  for (i = task; i < par->tcnt; i += par->cnt) {
+    m = (ITEM)(par->offs[i+1] -par->offs[i]);
+    memcpy(lists, (TIDLIST*)par->isects +par->offs[i],
+           (size_t)m *sizeof(TIDLIST));   /* copy the tid lists */
+    n = par->tids[i];           /* get the transaction id */
+    s = par->supps[i]           /* and compute the support */
+      + ((par->wgt) ? carp->muls[n] : 1);
+    if (m <= 1) {               /* if there is only one item left */
+      r = (SUPP)rpt_add(carp->rpt, &lists->item, 1, s +lists->supp);
+      if (r < 0) return -1; else continue;
+    }                           /* update the item set repository */
+    for (k = 0; k < m; k++)     /* collect the items */
+      carp->set[k] = lists[k].item;   /* in the current set */
+    if ((carp->mode & CARP_MAXONLY) /* if to find maximal item sets */
+    &&  rpt_super(carp->rpt, carp->set, m, carp->supp))
+      continue;                 /* check for a frequent superset */
+    r = (SUPP)rpt_add(carp->rpt, carp->set, m, s);
+    if (r <  0) return -1;      /* add item set to the repository */
+    if (r <= 0) continue;       /* check whether recursion is needed */
+    r = (par->wgt) ? rec_mti(carp, lists, m, n, s)
+                   : rec_tid(carp, lists, m, n, s);
+    if (r > s) {                /* find closed item sets recursively */
+      for (k = 0; k < m; k++)   /* if there are perfect extensions */
+        carp->set[k] = lists[k].item;
+      r = (SUPP)rpt_add(carp->rpt, carp->set, m, r);
+    }                           /* update the item set repository */
+    if (r < 0) return -1;       /* check for an error */
+  }
+  return 0;                     /* return 'ok' */
+}  /* tid_task() */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP par_tid (CARP *carp, TIDLIST *lists, ITEM k, TID n,
+                     size_t x, int wgt)
+{                               /* --- parallel version of rec_tid() */
+  int     r;                    /* error status */
+  ITEM    i, m;                 /* loop variables, item counter */
+  SUPP    s, w, supp = 0;       /* needed support, trans. weight */
+  long    c = 0;                /* number of tasks */
+  TIDLIST *dst;                 /* tid lists of projected databases */
+  ITEM    pex;                  /* minimum items for perfext exts. */
+  CARPPAR par;                  /* data for the parallel search */
+
+  assert(carp && lists && (k > 0) && (n >= 0));
+  r = par_init(&par, carp, n, x *sizeof(TIDLIST),
+               ((size_t)k +x) *sizeof(TIDLIST)
+              + (size_t)k     *sizeof(ITEM));
+  if (r <= 0)                   /* if no parallel search is possible */
+    return (r < 0) ? -1 : (wgt) ? rec_mti(carp, lists, k, n, 0)
+                                : rec_tid(carp, lists, k, n, 0);
+  for (r = 0; r < par.cnt; r++) /* set the item set buffers */
+    par.thds[r].set = (ITEM*)((TIDLIST*)par.bufs[r] +k +x);
+  par.wgt = wgt;                /* note the transaction weight flag */
+  dst = (TIDLIST*)par.isects;   /* get the tid list buffer */
+  pex = (carp->mode & CARP_PERFECT) ? k : ITEM_MAX;
+  par.offs[0] = 0;              /* collect the top-level tasks */
+  while (--n >= 0) {            /* traverse the transaction ids */
+    w = (wgt) ? carp->muls[n] : 1;
+    s = carp->supp -supp -w;    /* compute the minimum support */
+    if (s < 0) s = 0;           /* needed in remaining transactions */
+    if (!wgt && (n < s)) break; /* (end value for trans. loop) */
+    for (i = m = 0; i < k; i++) {
+      if (*lists[i].tids == n){ /* traverse items in current trans. */
+        lists[i].tids += 1;     /* remove the current transaction id */
+        lists[i].supp -= w;     /* and the corresp. support */
+        if (lists[i].supp >= s) dst[m++] = lists[i];
+      }                         /* collect the frequent items in */
+    }                           /* the conditional tid list array */
+    if ((m < carp->zmin) || (m <= 0))
+      continue;                 /* skip too small intersections */
+    if ((m > 1) && (m >= pex)) {/* collect perfect extensions */
+      supp += w; continue; }
+    par.tids [c] = n;           /* note the transaction id and */
+    par.supps[c] = supp;        /* the perfect extension support */
+    par.offs[c+1] = par.offs[c] +(size_t)m;
+    dst += m; c++;              /* note the number of tid lists */
+  }                             /* and advance the buffer */
+  par.tcnt = c;                 /* note the number of tasks */
+  r = tp_exec(par.cnt, par.cnt, tid_task, &par);
+  r = par_exit(&par, r);        /* process the tasks in parallel */
+  return (r < 0) ? -1 : supp;   /* return the item set support */
+}  /* par_tid() */
+
 /*----------------------------------------------------------------------
 Note that no memory is allocated directly in the above functions; all
 processing is done in the single memory block that is allocated in the
 function below. The size of this memory block is O(n*k), where n is the
 number of items and k the number of transactions. Additional memory is
-only allocated in rpt_add() for the item set repository carp->rpt.
+only allocated in rpt_add() for the item set repository carp->rpt and,
+for a multi-threaded search, in par_init() for the stripe buffers.
 ----------------------------------------------------------------------*/
 
 int carp_tid (CARP *carp)
@@ -595,11 +888,12 @@ int carp_tid (CARP *carp)
       *next[*s]++ = j;          /* traverse the transaction's items */
     }                           /* sum the transaction weight and */
   }                             /* collect the transaction ids */
-  w = (m)                       /* search for closed freq. item sets */
-    ? rec_mti(carp, lists, k, n, 0)
-    : rec_tid(carp, lists, k, n, 0);
-  if (w > 0)                    /* if there are perfect extensions, */
-    rpt_add(carp->rpt, carp->set, k, w);   /* update the repository */
+  w = par_tid(carp, lists, k, n, x, m > 0); /* search for closed sets */
+  if (w > 0) {                  /* if there are perfect extensions, */
+    for (i = 0; i < k; i++)     /* collect all items and */
+      carp->set[i] = lists[i].item;        /* update the repository */
+    rpt_add(carp->rpt, carp->set, k, w);
+  }
   free(lists);                  /* delete the allocated arrays */
   return (w < 0) ? (int)w : 0;  /* return the error status */
 }  /* carp_tid() */
@@ -638,6 +932,7 @@ CARP* carp_create (int target, double smin, double smax,
   carp->muls   = NULL;
   carp->set    = NULL;
   carp->rpt    = NULL;
+  carp->threads = 1;
   return carp;                  /* return the created carpenter miner */
 }  /* carp_create() */
 
@@ -761,7 +1056,7 @@ int carp_report (CARP *carp, ISREPORT *report)
 
 /*--------------------------------------------------------------------*/
 
-int carp_mine (CARP *carp)
+int carp_mine (CARP *carp, int threads)
 {                               /* --- run carpenter algorithm */
   int     r;                    /* result of carpenter algorithm */
   #ifndef QUIET                 /* if to print messages */
@@ -769,6 +1064,7 @@ int carp_mine (CARP *carp)
   #endif                        /* (only needed for messages) */
 
   assert(carp);                 /* check the function arguments */
+  carp->threads = threads;      /* note the number of threads */
 
   /* --- find closed/maximal frequent item sets --- */
   CLOCK(t);                     /* start timer, print log message */
@@ -926,6 +1222,7 @@ int main (int argc, char *argv[])
   int     sort     = -2;        /* flag for item sorting and recoding */
   int     algo     = 'a';       /* variant of carpenter algorithm */
   int     mode     = CARP_DEFAULT;  /* search mode (e.g. pruning) */
+  int     threads  = 1;         /* number of threads to use */
   int     mtar     = 0;         /* mode for transaction reading */
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
@@ -981,6 +1278,9 @@ int main (int argc, char *argv[])
                     "(default: all closed)\n");
     printf("         (options -j and -y need less memory, "
                     "but are usually slower)\n");
+    printf("-Y#      number of threads to use                 "
+                    "(default: %d)\n", threads);
+    printf("         (a value <= 0 means one thread per cpu)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -1023,7 +1323,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: acilou [A-Z]\[ACFNPRZ] */
+  /* free option characters: acilou [A-Z]\[ACFNPRYZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse arguments */
@@ -1046,6 +1346,7 @@ int main (int argc, char *argv[])
           case 'x': mode  &= ~CARP_PERFECT;          break;
           case 'j': mode  |=  CARP_FILTER;           break;
           case 'y': mode  |=  CARP_MAXONLY;          break;
+          case 'Y': threads = (int)strtol(s, &s, 0); break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
@@ -1163,7 +1464,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)    /* open the item set file and */
     error(E_NOMEM);             /* set up the item set reporter */
-  k = carp_mine(carp);          /* find frequent item sets */
+  k = carp_mine(carp, threads); /* find frequent item sets */
   if (k) error(k);              /* with the carpenter algorithm */
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
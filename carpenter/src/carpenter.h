@@ -6,6 +6,7 @@
             2014.08.23 interface of function carpenter() changed
             2014.08.28 functions carp_data() and carp_report() added
             2017.05.30 optional output compression with zlib added
+            2026.10.16 parameter 'threads' added to carp_mine()
 ----------------------------------------------------------------------*/
 #ifndef __CARPENTER__
 #define __CARPENTER__
@@ -59,5 +60,5 @@ extern CARP* carp_create (int target, double smin, double smax,
 extern void  carp_delete (CARP *carp, int deldar);
 extern int   carp_data   (CARP *carp, TABAG *tabag, int sort);
 extern int   carp_report (CARP *carp, ISREPORT *report);
-extern int   carp_mine   (CARP *carp);
+extern int   carp_mine   (CARP *carp, int threads);
 #endif
@@ -7,6 +7,7 @@
 #           2011.12.01 module clomax added (for module report)
 #           2013.10.19 modules tabread and patspec added
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 external module tpool added (thread pool)
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\carpenter\src
 UTILDIR  = ..\..\util\src
@@ -27,13 +28,15 @@ HDRS_T   = $(UTILDIR)\fntypes.h    $(UTILDIR)\arrays.h     \
            $(TRACTDIR)\report.h 
 HDRS     = $(HDRS_T)               $(UTILDIR)\error.h      \
            $(UTILDIR)\tabread.h    $(UTILDIR)\tabwrite.h   \
-           $(TRACTDIR)\patspec.h   repotree.h 
+           $(UTILDIR)\tpool.h      $(TRACTDIR)\patspec.h   \
+           repotree.h
 OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\memsys.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\escape.obj   \
            $(UTILDIR)\tabread.obj  $(UTILDIR)\tabwrite.obj \
            $(UTILDIR)\scform.obj   $(TRACTDIR)\taread.obj  \
            $(TRACTDIR)\patspec.obj $(TRACTDIR)\clomax.obj  \
-           $(TRACTDIR)\repcm.obj   repotree.obj carpenter.obj
+           $(TRACTDIR)\repcm.obj   $(UTILDIR)\tpool.obj    \
+           repotree.obj carpenter.obj
 PRGS     = carpenter.exe
 
 #-----------------------------------------------------------------------
@@ -88,6 +91,10 @@ $(UTILDIR)\scform.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak  scform.obj   ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(UTILDIR)\tpool.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak  tpool.obj    ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(TRACTDIR)\taread.obj:
 	cd $(TRACTDIR)
 	$(MAKE) /f tract.mak taread.obj   ADDFLAGS="$(ADDFLAGS)"
@@ -16,6 +16,7 @@
             2012.04.27 function rpt_prune() added (support pruning)
             2013.04.01 adapted to type changes in module tract
             2013.10.15 checks of return code of isr_report() added
+            2026.10.16 function rpt_merge() added (multi-threading)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -129,6 +130,66 @@ int rpt_add (REPOTREE *rpt, const ITEM *items, ITEM n, SUPP supp)
 
 /*--------------------------------------------------------------------*/
 
+#define MERGE(dir) \
+static int merge_##dir (REPONODE **dst, REPONODE *src, MEMSYS *mem)    \
+{                               /* --- recursively merge nodes */      \
+  REPONODE *node;               /* created node */                     \
+                                                                       \
+  assert(dst && mem);           /* check the function arguments */     \
+  for ( ; src; src = src->sibling) {  /* traverse the source nodes */  \
+    while (*dst && dir((*dst)->item, src->item))                       \
+      dst = &(*dst)->sibling;   /* find the item/insertion position */ \
+    if (*dst && ((*dst)->item == src->item)) {                         \
+      if (src->supp > (*dst)->supp) /* if the node exists, */          \
+        (*dst)->supp = src->supp; } /* adapt the item set support */   \
+    else {                      /* if there is no node for the item */ \
+      node = (REPONODE*)ms_alloc(mem);                                 \
+      if (!node) return -1;     /* create a new prefix tree node */    \
+      node->item     = src->item;     /* store the item and the */     \
+      node->supp     = src->supp;     /* support of the item set */    \
+      node->children = NULL;    /* insert the created node */          \
+      node->sibling  = *dst;    /* into the sibling list */            \
+      *dst = node;                                                     \
+    }                           /* merge the child nodes recursively */\
+    if (src->children                                                  \
+    && (merge_##dir(&(*dst)->children, src->children, mem) < 0))       \
+      return -1;                /* check for an error */               \
+    dst = &(*dst)->sibling;     /* continue with the next node */      \
+  }                             /* (source siblings are sorted) */     \
+  return 0;                     /* return 'ok' */                      \
+}  /* merge() */
+
+/*--------------------------------------------------------------------*/
+
+MERGE(pos)                      /* function for ascending  item order */
+MERGE(neg)                      /* function for descending item order */
+
+/*--------------------------------------------------------------------*/
+
+int rpt_merge (REPOTREE *dst, REPOTREE *src)
+{                               /* --- merge two repositories */
+  ITEM     i;                   /* loop variable */
+  REPONODE *d, *s;              /* to traverse the top-level nodes */
+
+  assert(dst && src             /* check the function arguments */
+  &&    (dst->size == src->size) && (dst->dir == src->dir));
+  if (src->supp > dst->supp)    /* adapt the empty set support */
+    dst->supp = src->supp;
+  for (i = 0; i < src->size; i++) {
+    d = dst->tops +i; s = src->tops +i;
+    if (s->supp > d->supp)      /* traverse the top-level nodes */
+      d->supp = s->supp;        /* and adapt the item set support */
+    if (!s->children) continue; /* merge the children recursively */
+    if (((dst->dir < 0)
+    ?    merge_neg(&d->children, s->children, dst->mem)
+    :    merge_pos(&d->children, s->children, dst->mem)) < 0)
+      return -1;                /* the support of an item set is */
+  }                             /* the maximum of the supports */
+  return 0;                     /* in the two repositories */
+}  /* rpt_merge() */
+
+/*--------------------------------------------------------------------*/
+
 SUPP rpt_get (REPOTREE *rpt, const ITEM *items, ITEM n)
 {                               /* --- get support of an item set */
   ITEM     i;                   /* buffer for an item */
@@ -11,6 +11,7 @@
             2012.04.26 special maximal item set functions added
             2012.04.27 function rpt_prune() added (support pruning)
             2013.04.01 adapted to type changes in module tract
+            2026.10.16 function rpt_merge() added (multi-threading)
 ----------------------------------------------------------------------*/
 #ifndef __REPOTREE__
 #define __REPOTREE__
@@ -57,6 +58,7 @@ int       rpt_add     (REPOTREE *rpt, const ITEM *items, ITEM n,
 SUPP      rpt_get     (REPOTREE *rpt, const ITEM *items, ITEM n);
 int       rpt_super   (REPOTREE *rpt, const ITEM *items, ITEM n,
                        SUPP min);
+int       rpt_merge   (REPOTREE *dst, REPOTREE *src);
 void      rpt_prune   (REPOTREE *rpt, SUPP supp);
 
 int       rpt_report  (REPOTREE *rpt, int max, SUPP supp,
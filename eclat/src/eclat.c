@@ -91,6 +91,15 @@
             2016.10.06 bug in function rec_tid() fixed (m++ -> ++m)
             2016.11.10 eclat miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 multi-threaded search added (option -Y#)
+            2026.10.17 item sets of threads output in serial order
+            2026.10.17 top-level tasks scheduled by item support
+            2026.10.17 bit vector intersection with PEXT/POPCNT added
+            2026.10.17 SIMD and galloping tid list intersection added
+            2026.10.17 SIMD and bit map kernels for diffsets added
+            2026.10.17 up to 31 items packed, number chosen adaptively
+            2026.10.17 transactions stored contiguously in eclat_data()
+            2026.10.17 optional compression of the transaction bag (-D)
 ------------------------------------------------------------------------
   Reference for the Eclat algorithm:
   * M.J. Zaki, S. Parthasarathy, M. Ogihara, and W. Li.
@@ -150,8 +159,19 @@
 #ifdef ECL_ABORT
 #include "sigint.h"
 #endif
+#if (defined __x86_64__ || defined __i386__) \
+&&  ((defined __GNUC__ && (__GNUC__ >= 5)) || defined __clang__)
+#ifndef ECL_NOPEXT
+#define ECL_PEXT                /* PEXT/POPCNT kernel can be compiled */
+#endif
+#ifndef ECL_NOSIMD
+#define ECL_SIMD                /* SSE2/AVX2 kernels can be compiled */
+#endif
+#include <immintrin.h>
+#endif
 #include "eclat.h"
 #include "fim16.h"
+#include "tpool.h"
 #ifdef ECL_MAIN
 #include "error.h"
 #endif
@@ -185,6 +205,9 @@
 /* error codes -15 to -25 defined in tract.h */
 
 #define DIFFSIZE(p,q) ((size_t)((int*)(p)-(int*)(q)) *sizeof(int))
+#define GALLOP        32        /* min. length ratio for galloping */
+#define BLKRATIO       2        /* max. length ratio for block diff. */
+#define DENSE          2        /* max. trans./list ratio for bit map */
 
 #ifndef QUIET                   /* if not quiet version, */
 #define MSG         fprintf     /* print messages */
@@ -204,6 +227,7 @@
 typedef struct {                /* --- trans. identifier list --- */
   ITEM     item;                /* item identifier (last item in set) */
   SUPP     supp;                /* support of the item (or item set) */
+  TID      cnt;                 /* number of transaction identifiers */
   TID      tids[1];             /* array of transaction identifiers */
 } TIDLIST;                      /* (transaction identifier list) */
 
@@ -215,6 +239,8 @@ typedef struct {                /* --- bit vector --- */
   BITBLK   bits[1];             /* bit vector over transactions */
 } BITVEC;                       /* (bit vector) */
 
+typedef void BITISFN (BITVEC *dst, BITVEC *src1, BITVEC *src2, TID n);
+
 typedef struct {                /* --- transaction id range --- */
   TID      min;                 /* minimum transaction identifier */
   TID      max;                 /* maximum transaction identifier */
@@ -248,6 +274,7 @@ struct _eclat {                 /* --- eclat miner --- */
   double   thresh;              /* threshold for evaluation measure */
   int      algo;                /* variant of eclat algorithm */
   int      mode;                /* search mode (e.g. pruning) */
+  int      threads;             /* number of threads (top level) */
   TABAG    *tabag;              /* transaction bag/multiset */
   ISREPORT *report;             /* item set reporter */
   ITEM     first;               /* start value for item loops */
@@ -257,6 +284,8 @@ struct _eclat {                 /* --- eclat miner --- */
   ITEM     *cand;               /* to collect candidates (closed()) */
   SUPP     *miss;               /* support still missing (maximal()) */
   BITTA    *btas;               /* array of bit-rep. transactions */
+  BITISFN  *isect;              /* bit vector intersection function */
+  BITBLK   *bmap;               /* bit map over transactions */
   SUPP     **tab;               /* item occurrence table */
   TRACT    **hash;              /* buffer for hash table */
   TIDLIST  **elim;              /* tra. id lists of eliminated items */
@@ -264,8 +293,25 @@ struct _eclat {                 /* --- eclat miner --- */
   ISTREE   *istree;             /* item set tree for eclat_tree() */
 };                              /* (eclat miner) */
 
-typedef TID COMBFN  (TIDLIST *d, TIDLIST *s1, TIDLIST *s2, SUPP *w);
+typedef TID COMBFN  (TIDLIST *d, TIDLIST *s1, TIDLIST *s2, ECLAT *e);
 typedef int ECLATFN (ECLAT *eclat);
+typedef int OCDFN   (ECLAT *eclat, TALIST **lists, ITEM i, ITEM m);
+
+typedef struct {                /* --- parallel search (top level) --- */
+  ECLAT    *eclat;              /* eclat miner of the calling thread */
+  ECLAT    *thds;               /* copies of the miner for threads */
+  double   *wgts;               /* task size hints (item supports) */
+  void     **bufs;              /* buffers of the worker threads */
+  ISREPORT **reps;              /* reporter clones (for merging) */
+  int      cnt;                 /* number of worker threads */
+  void     *lists;              /* top-level tid/transaction lists */
+  ITEM     beg, end;            /* range of top-level list indices */
+  ITEM     m;                   /* limit for projections (occ. dlv.) */
+  size_t   x;                   /* size of the trans. id lists */
+  COMBFN   *comb;               /* function to combine tid lists */
+  OCDFN    *item;               /* function to process an item */
+  int      copy;                /* flag for copying transactions */
+} ECLPAR;                       /* (parallel search) */
 
 /*----------------------------------------------------------------------
   Constants
@@ -397,27 +443,241 @@ static void show_trg (const char *text, ITEMBASE *base,
 }  /* show_trg() */
 
 #endif  /* #ifndef NDEBUG */
+/*----------------------------------------------------------------------
+  Auxiliary Functions for Multi-threaded Search
+----------------------------------------------------------------------*/
+
+static int par_exit (ECLPAR *par, int r)
+{                               /* --- finish a parallel search */
+  int   i, k;                   /* loop variable for threads */
+  ECLAT *e;                     /* to traverse the miner copies */
+
+  assert(par);                  /* check the function argument */
+  for (i = k = 0; i < par->cnt; i++)
+    if (par->thds[i].report) par->reps[k++] = par->thds[i].report;
+  if ((r >= 0) && (isr_mergex(par->eclat->report, par->reps, k) < 0))
+    r = -1;                     /* merge the item set reporters */
+  for (i = 0; i < par->cnt; i++) {  /* (output the recorded sets) */
+    e = par->thds +i;           /* traverse the miner copies */
+    if (e->report) isr_delete(e->report, 0);
+    if (e->fim16) m16_delete(e->fim16);
+    if (par->bufs[i]) free(par->bufs[i]);
+  }                             /* delete 16-items machines, buffers */
+  free(par->thds);              /* delete the miner copies */
+  return r;                     /* return the error status */
+}  /* par_exit() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_init (ECLPAR *par, ECLAT *eclat, ITEM k, size_t z)
+{                               /* --- prepare a parallel search */
+  int   i, n;                   /* loop variable, number of threads */
+  ECLAT *e;                     /* to traverse the miner copies */
+
+  assert(par && eclat);         /* check the function arguments */
+  n = eclat->threads;           /* get the number of threads */
+  if (n <= 0) n = tp_cpucnt();  /* (default: number of processors) */
+  if (n > k)  n = (int)k;       /* use at most one thread per item */
+  if ((n <= 1) || !isr_clonable(eclat->report))
+    return 0;                   /* check for a parallel search */
+  par->eclat = eclat;           /* note the eclat miner */
+  par->cnt   = 0;               /* and allocate the miner copies */
+  par->thds  = (ECLAT*)malloc((size_t)n *sizeof(ECLAT)
+                             +(size_t)k *sizeof(double)
+                             +(size_t)n *sizeof(void*)
+                             +(size_t)n *sizeof(ISREPORT*));
+  if (!par->thds) return -1;    /* create an array of miner copies */
+  par->wgts  = (double*)   (par->thds +n);
+  par->bufs  = (void**)    (par->wgts +k);
+  par->reps  = (ISREPORT**)(par->bufs +n);
+  for (i = 0; i < n; i++) {     /* traverse the worker threads */
+    e = par->thds +i; *e = *eclat;  /* copy the eclat miner */
+    e->threads = 1;             /* (no nested parallel search) */
+    e->fim16   = NULL;          /* clear the 16-items machine */
+    par->bufs[i] = NULL;        /* and the buffer of the thread */
+    par->cnt   = i+1;           /* clone the item set reporter */
+    e->report  = isr_clone(eclat->report);
+    if (!e->report) break;      /* (collects the found item sets) */
+    if (eclat->fim16) {         /* if to use a 16-items machine */
+      e->fim16 = m16_create(eclat->dir, eclat->supp, e->report);
+      if (!e->fim16) break;     /* create a 16-items machine */
+    }                           /* for each thread */
+    if (z > 0) {                /* if a thread buffer is needed */
+      par->bufs[i] = calloc(z, 1);
+      if (!par->bufs[i]) break; /* allocate a buffer for the thread */
+    }                           /* (cleared, e.g. for markers) */
+  }
+  if (i < n) { par_exit(par, -1); return -1; }
+  return n;                     /* return the number of threads */
+}  /* par_init() */
+
+/* The top-level items are processed as independent tasks by a thread */
+/* pool with work stealing, because the subtrees of the search tree   */
+/* that belong to the top-level items usually differ widely in size.  */
+/* Each thread works on a copy of the eclat miner with a clone of the */
+/* item set reporter (and its own 16-items machine and buffers). The  */
+/* item sets that are found by the threads are output when the clones */
+/* are merged into the item set reporter of the calling thread, task  */
+/* by task, so that they appear in the order of the serial search.    */
+
 /*----------------------------------------------------------------------
   Eclat with Transaction Id List Intersection (basic version)
 ----------------------------------------------------------------------*/
 
+static TID* merge (TID *d, const TID *s1, const TID *s2,
+                   const SUPP *muls, SUPP *supp)
+{                               /* --- merge two trans. id lists */
+  SUPP w = 0;                   /* sum of transaction weights */
+
+  while (1) {                   /* trans. id list intersection loop */
+    if      (*s1 < *s2) s2++;   /* if one transaction id is larger, */
+    else if (*s1 > *s2) s1++;   /* simply skip this transaction id */
+    else if (*s1 <   0) break;  /* check for the sentinel */
+    else { w += muls[*d++ = *s1++]; s2++; }
+  }                             /* copy equal elements to destination */
+  *supp += w;                   /* add the weight of the matches */
+  return d;                     /* return the new end of the dest. */
+}  /* merge() */
+
+/*--------------------------------------------------------------------*/
+
+static TID* gallop (TID *d, const TID *s1, const TID *s2, TID n2,
+                    const SUPP *muls, SUPP *supp)
+{                               /* --- intersect with galloping */
+  TID  t;                       /* transaction id to search for */
+  TID  lo, hi, k;               /* search range and step width */
+  SUPP w = 0;                   /* sum of transaction weights */
+
+  for (lo = 0; *s1 >= 0; s1++){ /* traverse the shorter list */
+    t = *s1;                    /* get the next transaction id */
+    if (s2[lo] > t) {           /* if it lies further in the list */
+      for (k = 1; 1; k += k) {  /* double the step width */
+        hi = (k < n2-lo) ? lo+k : n2;
+        if ((hi >= n2) || (s2[hi] <= t)) break;
+        lo = hi;                /* exponential search for a range */
+      }                         /* with s2[lo] > t >= s2[hi] */
+      while (hi -lo > 1) {      /* bisect the found range */
+        k = lo +((hi-lo) >> 1); /* (hi == n2 refers to the */
+        if (s2[k] > t) lo = k;  /* sentinel, which is smaller */
+        else           hi = k;  /* than any transaction id) */
+      }                         /* get the first transaction id */
+      lo = hi;                  /* that is not larger than the */
+    }                           /* searched transaction id */
+    if (lo >= n2) break;        /* if the list is exhausted, abort */
+    if (s2[lo] == t) { w += muls[*d++ = t]; lo++; }
+  }                             /* copy equal elements to destination */
+  *supp += w;                   /* add the weight of the matches */
+  return d;                     /* return the new end of the dest. */
+}  /* gallop() */
+
+/* If one list is much longer than the other, it is cheaper to look */
+/* up the elements of the shorter list in the longer one: searching */
+/* with doubled steps and then bisecting costs O(log(gap)) instead  */
+/* of O(gap) for each element of the shorter list.                  */
+
+/*--------------------------------------------------------------------*/
+#ifdef ECL_SIMD
+
+__attribute__((target("sse2")))
+static TID* mrg_sse2 (TID *d, const TID *s1, TID n1,
+                      const TID *s2, TID n2,
+                      const SUPP *muls, SUPP *supp)
+{                               /* --- merge with 4x4 blocks (SSE2) */
+  TID     i, j, t;              /* list indices, buffer */
+  int     m;                    /* match mask of a block */
+  SUPP    w = 0;                /* sum of transaction weights */
+  __m128i a, b, c;              /* blocks of the lists, comparison */
+
+  for (i = j = 0; (i+4 <= n1) && (j+4 <= n2); ) {
+    a = _mm_loadu_si128((const __m128i*)(s1+i));
+    b = _mm_loadu_si128((const __m128i*)(s2+j));
+    c =              _mm_cmpeq_epi32(a, b);
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x39)));
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x4e)));
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x93)));
+    m = _mm_movemask_ps(_mm_castsi128_ps(c));
+    if (m != 0) {               /* if there are matches in the block */
+      for (t = i; t < i+4; t++, m >>= 1) {
+        w += muls[*d = s1[t]] *(SUPP)(m & 1);
+        d += m & 1;             /* store all elements of the block, */
+      }                         /* but advance the destination only */
+    }                           /* for matches (avoids branches) */
+    t = s1[i+3] -s2[j+3];       /* advance in the list(s) with */
+    i += (t >= 0) ? 4 : 0;      /* the larger last element, since */
+    j += (t <= 0) ? 4 : 0;      /* all following elements of the */
+  }                             /* other list are smaller */
+  *supp += w;                   /* add the weight of the matches */
+  return merge(d, s1+i, s2+j, muls, supp);
+}  /* mrg_sse2() */             /* intersect the rest of the lists */
+
+/*--------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+static TID* mrg_avx2 (TID *d, const TID *s1, TID n1,
+                      const TID *s2, TID n2,
+                      const SUPP *muls, SUPP *supp)
+{                               /* --- merge with 8x8 blocks (AVX2) */
+  TID     i, j, t;              /* list indices, buffer */
+  int     k, m;                 /* loop variable, match mask */
+  SUPP    w = 0;                /* sum of transaction weights */
+  __m256i a, b, c, r;           /* blocks of the lists, comparison */
+
+  r = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  for (i = j = 0; (i+8 <= n1) && (j+8 <= n2); ) {
+    a = _mm256_loadu_si256((const __m256i*)(s1+i));
+    b = _mm256_loadu_si256((const __m256i*)(s2+j));
+    c = _mm256_cmpeq_epi32(a, b);
+    for (k = 1; k < 8; k++) {   /* rotate the second block */
+      b = _mm256_permutevar8x32_epi32(b, r);
+      c = _mm256_or_si256(c, _mm256_cmpeq_epi32(a, b));
+    }                           /* and compare all pairs */
+    m = _mm256_movemask_ps(_mm256_castsi256_ps(c));
+    if (m != 0) {               /* if there are matches in the block */
+      for (t = i; t < i+8; t++, m >>= 1) {
+        w += muls[*d = s1[t]] *(SUPP)(m & 1);
+        d += m & 1;             /* copy the matches and advance */
+      }                         /* in the list(s) with the larger */
+    }                           /* last element of the block */
+    t = s1[i+7] -s2[j+7];
+    i += (t >= 0) ? 8 : 0;
+    j += (t <= 0) ? 8 : 0;
+  }
+  *supp += w;                   /* add the weight of the matches */
+  return mrg_sse2(d, s1+i, n1-i, s2+j, n2-j, muls, supp);
+}  /* mrg_avx2() */             /* intersect the rest of the lists */
+
+/* The block kernels compare every element of a block of the one   */
+/* list with every element of a block of the other (by rotating the */
+/* latter), which replaces the hard to predict branches of a merge. */
+/* They load transaction ids as 32 bit integers and are therefore   */
+/* only used if TID is a 4 byte type (checked in isect()).          */
+
+#endif
+/*--------------------------------------------------------------------*/
+
 static TID isect (TIDLIST *dst, TIDLIST *src1, TIDLIST *src2,SUPP *muls)
 {                               /* --- intersect two trans. id lists */
-  TID *s1, *s2, *d;             /* to traverse sources and dest. */
+  TIDLIST *a, *b;               /* shorter and longer source list */
+  TID     *d;                   /* end of the destination list */
 
   assert(dst && src1 && src2    /* check the function arguments */
   &&    (src1->tids[0] >= 0) && (src2->tids[0] >= 0) && muls);
   dst->item = src1->item;       /* copy the first item and */
   dst->supp = 0;                /* initialize the support */
-  if (src1->supp > src2->supp) { s2 = src1->tids; s1 = src2->tids; }
-  else                         { s1 = src1->tids; s2 = src2->tids; }
-  d = dst->tids;                /* get sources and destination */
-  while (1) {                   /* trans. id list intersection loop */
-    if      (*s1 < *s2) s2++;   /* if one transaction id is larger, */
-    else if (*s1 > *s2) s1++;   /* simply skip this transaction id */
-    else if (*s1 <   0) break;  /* check for the sentinel */
-    else { dst->supp += muls[*d++ = *s1++]; s2++; }
-  }                             /* copy equal elements to destination */
+  if (src1->cnt > src2->cnt) { a = src2; b = src1; }
+  else                       { a = src1; b = src2; }
+  if (b->cnt /GALLOP > a->cnt)  /* if the lengths differ much, */
+    d = gallop(dst->tids, a->tids, b->tids, b->cnt, muls, &dst->supp);
+  #ifdef ECL_SIMD               /* if SIMD kernels can be used */
+  else if ((sizeof(TID) == 4) && __builtin_cpu_supports("avx2"))
+    d = mrg_avx2(dst->tids, a->tids, a->cnt, b->tids, b->cnt,
+                 muls, &dst->supp);
+  else if ((sizeof(TID) == 4) && __builtin_cpu_supports("sse2"))
+    d = mrg_sse2(dst->tids, a->tids, a->cnt, b->tids, b->cnt,
+                 muls, &dst->supp);
+  #endif                        /* otherwise use a plain merge */
+  else d = merge(dst->tids, a->tids, b->tids, muls, &dst->supp);
+  dst->cnt = (TID)(d -dst->tids);
   *d++ = (TID)-1;               /* store a sentinel at the list end */
   return (TID)(d -dst->tids);   /* return the size of the new list */
 }  /* isect() */
@@ -483,6 +743,7 @@ int eclat_base (ECLAT *eclat)
   SUPP       w;                 /* weight/support buffer */
   SUPP       pex;               /* minimum support for perfect exts. */
   TRACT      *t;                /* to traverse transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
   TIDLIST    **lists, *l;       /* to traverse transaction id lists */
   TID        *tids, *p, **next; /* to traverse transaction ids */
   const ITEM *s;                /* to traverse transaction items */
@@ -512,17 +773,21 @@ int eclat_base (ECLAT *eclat)
     lists[i] = l = (TIDLIST*)p; /* get next transaction id list */
     l->item  = i;               /* initialize the list item */
     l->supp  = 0;               /* and the support counter */
+    l->cnt   = c[i];            /* set the number of trans. ids */
     next[i]  = p = l->tids;     /* note position of next trans. id */
     p += c[i]; *p++ = (TID)-1;  /* skip space for transaction ids */
   }                             /* and store a sentinel at the end */
-  while (n > 0) {               /* traverse the transactions */
-    t = tbg_tract(eclat->tabag, --n);  /* get the next transaction */
+  cur = tbc_create(eclat->tabag);  /* create a cursor for the bag */
+  if (!cur) { free(tids); free(lists); return -1; }
+  while ((t = tbc_next(cur))) { /* traverse the transactions */
+    n = tbc_index(cur);         /* get the transaction index */
     eclat->muls[n] = w = ta_wgt(t);    /* and store its weight */
     for (s = ta_items(t); *s > TA_END; s++) {
       lists[*s]->supp += w;     /* traverse the transaction's items */
       *next[*s]++      = n;     /* sum the transaction weight and */
     }                           /* collect the transaction ids */
   }
+  tbc_delete(cur);              /* delete the bag cursor */
   for (i = m = 0; i < k; i++) { /* traverse the items / tid lists */
     l = lists[i];               /* eliminate all infrequent items and */
     if (l->supp <  eclat->supp) continue;  /* collect perfect exts. */
@@ -561,21 +826,32 @@ static int tid_cmpx (const void *a, const void *b, void *data)
 
 /*--------------------------------------------------------------------*/
 
-static TID filter (TIDLIST *dst, TIDLIST *src, SUPP *muls)
+static TID filter (TIDLIST *dst, TIDLIST *src, TIDLIST *ref,
+                   SUPP *muls)
 {                               /* --- filter a transaction id list */
   SUPP m;                       /* multiplicity of transaction */
   TID  *s, *d;                  /* to traverse source and dest. */
 
-  assert(dst && src && muls);   /* check the function arguments */
+  assert(dst && src && ref && muls); /* check the function arguments */
   dst->item = src->item;        /* copy first item and init. support */
   dst->supp = 0;                /* traverse the source trans. id list */
-  for (d = dst->tids, s = src->tids; *s >= 0; s++)
-    if ((m = muls[*s]) > 0) {   /* collect the marked trans. ids and */
-      dst->supp += m; *d++ = *s; }    /* sum the transaction weights */
+  if (src->cnt /GALLOP > ref->cnt)   /* if the marked list is short, */
+    d = gallop(dst->tids, ref->tids, src->tids, src->cnt,
+               muls, &dst->supp);    /* search its transaction ids */
+  else {                        /* if the lists have similar lengths */
+    for (d = dst->tids, s = src->tids; *s >= 0; s++)
+      if ((m = muls[*s]) > 0) { /* collect the marked trans. ids and */
+        dst->supp += m; *d++ = *s; }  /* sum the transaction weights */
+  }
+  dst->cnt = (TID)(d -dst->tids);
   *d++ = (TID)-1;               /* store a sentinel at the list end */
   return (TID)(d -dst->tids);   /* return the size of the new list */
 }  /* filter() */
 
+/* The marks (or occurrence table row) passed as muls are nonzero */
+/* exactly for the transaction ids in the reference list ref, so  */
+/* the result can also be computed by galloping through src.      */
+
 /*--------------------------------------------------------------------*/
 
 static int closed (ECLAT *eclat, TIDLIST *list, ITEM n)
@@ -609,7 +885,7 @@ static int closed (ECLAT *eclat, TIDLIST *list, ITEM n)
         if (!isr_uses(eclat->report, (ITEM)i))
           m |= 1 << i;          /* collect bits of unused items */
       for (s = list->tids; m && (*s >= 0); s++)
-        m &= ta_getmark(tbg_tract(eclat->tabag, *s));
+        m &= (int)ta_getmark(tbg_tract(eclat->tabag, *s));
       if (m) return 0;          /* if perf. ext found, 'not closed' */
       item = 31;                /* otherwise check remaining items */
     }                           /* (check only items 32 and above) */
@@ -731,12 +1007,12 @@ static int rec_tcm (ECLAT *eclat, TIDLIST **lists,
         for (p = l->tids; *p >= 0; p++)      /* mark transaction ids */
           eclat->marks[*p] = eclat->muls[*p]; /* in the current list */
         if (lists[i = 0]->item < 0) {   /* if there are packed items */
-          x = (size_t)filter(d, lists[i++], eclat->marks);
+          x = (size_t)filter(d, lists[i++], l, eclat->marks);
           if (d->supp >= eclat->supp) { /* if they are frequent */
             proj[++m] = d = (TIDLIST*)(d->tids +x); }
         }                       /* add a tid list for packed items */
         for ( ; i < k; i++) {   /* traverse the preceding lists */
-          x = (size_t)filter(d, lists[i], eclat->marks);
+          x = (size_t)filter(d, lists[i], l, eclat->marks);
           if (d->supp < eclat->supp)    /* intersect trans. id lists */
             continue;           /* eliminate infrequent items */
           if (d->supp >= pex) { /* collect perfect extensions */
@@ -768,15 +1044,99 @@ static int rec_tcm (ECLAT *eclat, TIDLIST **lists,
 
 /*--------------------------------------------------------------------*/
 
-static int rec_tid (ECLAT *eclat, TIDLIST **lists, ITEM k, size_t x)
-{                               /* --- eclat recursion with tid lists */
+static int rec_tid (ECLAT *eclat, TIDLIST **lists, ITEM k, size_t x);
+
+static int tid_item (ECLAT *eclat, TIDLIST **lists, ITEM k,
+                     TIDLIST **proj)
+{                               /* --- process one item (tid lists) */
   int     r;                    /* error status */
-  ITEM    i, m, z;              /* loop variables, error status */
+  ITEM    i, m;                 /* loop variables */
+  size_t  x;                    /* size of an intersected list */
   SUPP    max;                  /* maximum support of an ext. item */
   SUPP    pex;                  /* minimum support for perfect exts. */
-  TIDLIST **proj = NULL;        /* trans. id lists of proj. database */
   TIDLIST *l, *d;               /* to traverse transaction id lists */
   TID     *p;                   /* to traverse transaction ids */
+
+  assert(eclat && lists && (k >= 0)); /* check the function arguments */
+  l = lists[k];                 /* get the item / tid list to process */
+  if (l->item < 0) {            /* if this list is for packed items */
+    for (p = l->tids; *p >= 0; p++)
+      m16_add(eclat->fim16, eclat->btas[*p], eclat->muls[*p]);
+    return m16_mine(eclat->fim16);   /* add bit-rep. trans. prefixes */
+  }                             /* to the 16-items machine and mine */
+  r = isr_add(eclat->report, l->item, l->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  max = 0;                      /* init. maximal extension support */
+  if (proj && (k > 0)) {        /* if another item can be added */
+    pex = (eclat->mode & ECL_PERFECT) ? l->supp : SUPP_MAX;
+    proj[m = 0] = d = (TIDLIST*)(proj +k+1);
+    if (k < 2) {                /* if there are only few items left */
+      /* Benchmark tests showed that this version is faster only */
+      /* if there is only one other tid list to intersect with.  */
+      if (lists[i = 0]->item < 0) { /* if there are packed items */
+        x = (size_t)isect(d, lists[i++], l, eclat->muls);
+        if (d->supp >= eclat->supp) { /* if they are frequent */
+          for (d->item = TA_END, p = d->tids; *p >= 0; p++)
+            d->item |= (ITEM)eclat->btas[*p];
+          proj[++m] = d = (TIDLIST*)(d->tids +x);
+        }                       /* add a tid list for packed items */
+      }                         /* with occ. bit mask as the item */
+      for ( ; i < k; i++) {     /* traverse the preceding lists */
+        x = (size_t)isect(d, lists[i], l, eclat->muls);
+        if (d->supp < eclat->supp) /* intersect trans. id lists */
+          continue;             /* eliminate infrequent items */
+        if (d->supp >= pex) {   /* collect perfect extensions */
+          isr_addpex(eclat->report, d->item); continue; }
+        if (d->supp > max)      /* find maximal extension support */
+          max = d->supp;        /* (for later closed/maximal check) */
+        proj[++m] = d = (TIDLIST*)(d->tids +x);
+      } }                       /* collect tid lists of freq. items */
+    else {                      /* if there are many items left */
+      for (p = l->tids; *p >= 0; p++)      /* mark transaction ids */
+        eclat->marks[*p] = eclat->muls[*p]; /* in the current list */
+      if (lists[i = 0]->item < 0) {   /* if there are packed items */
+        x = (size_t)filter(d, lists[i++], l, eclat->marks);
+        if (d->supp >= eclat->supp) { /* if they are frequent */
+          for (d->item = TA_END, p = d->tids; *p >= 0; p++)
+            d->item |= (ITEM)eclat->btas[*p];
+          proj[++m] = d = (TIDLIST*)(d->tids +x);
+        }                       /* add a tid list for packed items */
+      }                         /* with occ. bit mask as the item */
+      for ( ; i < k; i++) {     /* traverse the preceding lists */
+        x = (size_t)filter(d, lists[i], l, eclat->marks);
+        if (d->supp < eclat->supp) /* intersect trans. id lists */
+          continue;             /* eliminate infrequent items */
+        if (d->supp >= pex) {   /* collect perfect extensions */
+          isr_addpex(eclat->report, d->item); continue; }
+        if (d->supp > max)      /* find maximal extension support */
+          max = d->supp;        /* (for later closed/maximal check) */
+        proj[++m] = d = (TIDLIST*)(d->tids +x);
+      }                         /* collect tid lists of freq. items */
+      for (p = l->tids; *p >= 0; p++)
+        eclat->marks[*p] = 0;   /* unmark transaction ids */
+    }                           /* in the current list */
+    if (m > 0) {                /* if the projection is not empty */
+      r = rec_tid(eclat, proj, m, DIFFSIZE(d,proj[0]));
+      if (r < 0) return r;      /* recursively find freq. item sets */
+    }                           /* in the created projection */
+  }
+  r = isr_reportx(eclat->report, l->tids, (TID)-l->supp);
+  if (r < 0) return r;          /* report the current item set */
+  isr_remove(eclat->report, 1); /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* tid_item() */
+
+/* The loop body of the function rec_tid() below is a separate     */
+/* function, so that it can also be executed by the worker threads */
+/* of the parallel version (for the items of the top level).       */
+
+/*--------------------------------------------------------------------*/
+
+static int rec_tid (ECLAT *eclat, TIDLIST **lists, ITEM k, size_t x)
+{                               /* --- eclat recursion with tid lists */
+  int     r;                    /* error status */
+  ITEM    i, m, z;              /* loop variables, error status */
+  TIDLIST **proj = NULL;        /* trans. id lists of proj. database */
   ITEM    *t;                   /* to collect the tail items */
 
   assert(eclat && lists && (k > 0)); /* check the function arguments */
@@ -790,7 +1150,7 @@ static int rec_tid (ECLAT *eclat, TIDLIST **lists, ITEM k, size_t x)
     if (lists[0]->item >= 0)    /* if there are no packed items, */
       t[m++] = lists[0]->item;  /* simply copy the last item */
     else {                      /* if there are packed items */
-      for (z = 16; --z >= 0; )  /* traverse the bits */
+      for (z = 31; --z >= 0; )  /* traverse the bits */
         if (lists[0]->item & (1 << z))
           t[m++] = z;           /* collect the packed tail items */
     }                           /* after the other tail items */
@@ -809,82 +1169,65 @@ static int rec_tid (ECLAT *eclat, TIDLIST **lists, ITEM k, size_t x)
   if (eclat->dir > 0) { z =  k; k  = 0; }
   else                { z = -1; k -= 1; }
   for (r = 0; k != z; k += eclat->dir) {
-    l = lists[k];               /* traverse the items / tid lists */
-    if (l->item < 0) {          /* if this list is for packed items */
-      for (p = l->tids; *p >= 0; p++)
-        m16_add(eclat->fim16, eclat->btas[*p], eclat->muls[*p]);
-      r = m16_mine(eclat->fim16);    /* add bit-rep. trans. prefixes */
-      if (r >= 0) continue;     /* to the 16-items machine and mine, */
-      if (proj) free(proj);     /* then go to the next trans. id list */
-      return r;                 /* otherwise free allocated memory */
-    }                           /* and abort the function */
-    r = isr_add(eclat->report, l->item, l->supp);
-    if (r <  0) break;          /* add current item to the reporter */
-    if (r <= 0) continue;       /* check if item needs processing */
-    max = 0;                    /* init. maximal extension support */
-    if (proj && (k > 0)) {      /* if another item can be added */
-      pex = (eclat->mode & ECL_PERFECT) ? l->supp : SUPP_MAX;
-      proj[m = 0] = d = (TIDLIST*)(proj +k+1);
-      if (k < 2) {              /* if there are only few items left */
-        /* Benchmark tests showed that this version is faster only */
-        /* if there is only one other tid list to intersect with.  */
-        if (lists[i = 0]->item < 0) { /* if there are packed items */
-          x = (size_t)isect(d, lists[i++], l, eclat->muls);
-          if (d->supp >= eclat->supp) { /* if they are frequent */
-            for (d->item = TA_END, p = d->tids; *p >= 0; p++)
-              d->item |= eclat->btas[*p];
-            proj[++m] = d = (TIDLIST*)(d->tids +x);
-          }                     /* add a tid list for packed items */
-        }                       /* with occ. bit mask as the item */
-        for ( ; i < k; i++) {   /* traverse the preceding lists */
-          x = (size_t)isect(d, lists[i], l, eclat->muls);
-          if (d->supp < eclat->supp) /* intersect trans. id lists */
-            continue;           /* eliminate infrequent items */
-          if (d->supp >= pex) { /* collect perfect extensions */
-            isr_addpex(eclat->report, d->item); continue; }
-          if (d->supp > max)    /* find maximal extension support */
-            max = d->supp;      /* (for later closed/maximal check) */
-          proj[++m] = d = (TIDLIST*)(d->tids +x);
-        } }                     /* collect tid lists of freq. items */
-      else {                    /* if there are many items left */
-        for (p = l->tids; *p >= 0; p++)      /* mark transaction ids */
-          eclat->marks[*p] = eclat->muls[*p]; /* in the current list */
-        if (lists[i = 0]->item < 0) {   /* if there are packed items */
-          x = (size_t)filter(d, lists[i++], eclat->marks);
-          if (d->supp >= eclat->supp) { /* if they are frequent */
-            for (d->item = TA_END, p = d->tids; *p >= 0; p++)
-              d->item |= eclat->btas[*p];
-            proj[++m] = d = (TIDLIST*)(d->tids +x);
-          }                     /* add a tid list for packed items */
-        }                       /* with occ. bit mask as the item */
-        for ( ; i < k; i++) {   /* traverse the preceding lists */
-          x = (size_t)filter(d, lists[i], eclat->marks);
-          if (d->supp < eclat->supp) /* intersect trans. id lists */
-            continue;           /* eliminate infrequent items */
-          if (d->supp >= pex) { /* collect perfect extensions */
-            isr_addpex(eclat->report, d->item); continue; }
-          if (d->supp > max)    /* find maximal extension support */
-            max = d->supp;      /* (for later closed/maximal check) */
-          proj[++m] = d = (TIDLIST*)(d->tids +x);
-        }                       /* collect tid lists of freq. items */
-        for (p = l->tids; *p >= 0; p++)
-          eclat->marks[*p] = 0; /* unmark transaction ids */
-      }                         /* in the current list */
-      if (m > 0) {              /* if the projection is not empty */
-        r = rec_tid(eclat, proj, m, DIFFSIZE(d,proj[0]));
-        if (r < 0) break;       /* recursively find freq. item sets */
-      }                         /* in the created projection */
-    }
-    r = isr_reportx(eclat->report, l->tids, (TID)-l->supp);
-    if (r < 0) break;           /* report the current item set */
-    isr_remove(eclat->report,1);/* remove the current item */
-  }                             /* from the item set reporter */
+    r = tid_item(eclat, lists, k, proj);
+    if (r < 0) break;           /* process the items / tid lists */
+  }                             /* (extend the current item set) */
   if (proj) free(proj);         /* delete the list and element arrays */
   return r;                     /* return the error status */
 }  /* rec_tid() */
 
 /*--------------------------------------------------------------------*/
 
+static int tid_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int     r;                    /* error status */
+  ECLPAR  *par = (ECLPAR*)data; /* type the data pointer */
+  ECLAT   *eclat;               /* copy of the eclat miner */
+  ITEM    k;                    /* index of the item to process */
+  TIDLIST **proj;               /* trans. id lists of proj. database */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  eclat = par->thds +thread;    /* get the miner copy of the thread */
+  k = (eclat->dir > 0) ? par->beg +(ITEM)task : par->end-1 -(ITEM)task;
+  if (isr_task(eclat->report, task) < 0) return -1;
+  proj = (TIDLIST**)malloc((size_t)par->end *sizeof(TIDLIST*) +par->x);
+  if (!proj) return -1;         /* allocate list and element arrays */
+  r = tid_item(eclat, (TIDLIST**)par->lists, k, proj);
+  free(proj);                   /* process the item / tid list and */
+  return r;                     /* delete the list and element arrays */
+}  /* tid_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_tid (ECLAT *eclat, TIDLIST **lists, ITEM k, size_t x)
+{                               /* --- parallel version of rec_tid() */
+  int    r, i;                  /* error status, loop variable */
+  ECLPAR par;                   /* data for the parallel search */
+
+  assert(eclat && lists && (k > 0)); /* check the function arguments */
+  if ((eclat->mode & ECL_TAIL)  /* tail pruning needs a repository */
+  ||  (k < 2) || !isr_xable(eclat->report, 2))
+    return rec_tid(eclat, lists, k, x);
+  r = par_init(&par, eclat, k, (size_t)tbg_cnt(eclat->tabag)
+                               *sizeof(SUPP));
+  if (r <= 0)                   /* if no parallel search is possible, */
+    return (r < 0) ? r : rec_tid(eclat, lists, k, x); /* use rec_tid */
+  for (i = 0; i < par.cnt; i++) /* set the transaction id markers */
+    par.thds[i].marks = (SUPP*)par.bufs[i];
+  if ((k > 4)                   /* if there are enough items left, */
+  &&  (eclat->mode & ECL_REORDER)) /* re-sort items w.r.t. support */
+    ptr_qsort(lists, (size_t)k, 1,
+              (eclat->fim16) ? tid_cmpx : tid_cmp, NULL);
+  par.lists = lists; par.x = x; /* note the top-level lists */
+  par.beg   = 0;     par.end = k;
+  for (i = 0; i < k; i++)       /* use supports as size hints */
+    par.wgts[(eclat->dir > 0) ? i : k-1-i] = (double)lists[i]->supp;
+  r = tp_execx(par.cnt, (long)k, tid_task, &par, par.wgts);
+  return par_exit(&par, r);     /* process the items in parallel */
+}  /* par_tid() */
+
+/*--------------------------------------------------------------------*/
+
 int eclat_tid (ECLAT *eclat)
 {                               /* --- eclat with trans. id lists */
   int        r = 0;             /* result of recursion/error status */
@@ -895,6 +1238,7 @@ int eclat_tid (ECLAT *eclat)
   SUPP       max;               /* maximum support of an item */
   SUPP       pex;               /* minimum support for perfect exts. */
   TRACT      *t;                /* to traverse transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
   TIDLIST    **lists, *l;       /* to traverse transaction id lists */
   TID        *tids, *p, **next; /* to traverse transaction ids */
   const ITEM *s;                /* to traverse transaction items */
@@ -940,20 +1284,24 @@ int eclat_tid (ECLAT *eclat)
     lists[i] = l = (TIDLIST*)p; /* get next transaction id list */
     l->item  = i;               /* initialize the list item */
     l->supp  = 0;               /* and the support counter */
+    l->cnt   = c[i];            /* set the number of trans. ids */
     next[i]  = p = l->tids;     /* note position of next trans. id */
     p += c[i]; *p++ = (TID)-1;  /* skip space for transaction ids */
   }                             /* and store a sentinel at the end */
   z = DIFFSIZE(p, tids);        /* get total size of tid lists */
-  while (n > 0) {               /* traverse the transactions */
-    t = tbg_tract(eclat->tabag, --n);  /* get the next transaction */
+  cur = tbc_create(eclat->tabag);  /* create a cursor for the bag */
+  if (!cur) { free(tids); free(lists); return -1; }
+  while ((t = tbc_next(cur))) { /* traverse the transactions */
+    n = tbc_index(cur);         /* get the transaction index */
     eclat->muls[n] = w = ta_wgt(t);    /* and store its weight */
     for (s = ta_items(t); *s > TA_END; s++) {
       if ((i = *s) < 0) {       /* traverse the transaction's items */
-        eclat->btas[n] = (BITTA)i; i = 0; }
+        eclat->btas[n] = (BITTA)(i & ~TA_END); i = 0; }
       lists[i]->supp += w;      /* traverse the transaction's items */
       *next[i]++      = n;      /* sum the transaction weight and */
     }                           /* collect the transaction ids */
   }
+  tbc_delete(cur);              /* delete the bag cursor */
   eclat->fim16 = NULL;          /* default: no 16-items machine */
   l = lists[i = 0];             /* get the list for packed items */
   if ((eclat->mode & ECL_FIM16) /* if to use a 16-items machine */
@@ -962,7 +1310,7 @@ int eclat_tid (ECLAT *eclat)
     if (!eclat->fim16) { free(tids); free(lists); return -1; }
     l->item = TA_END; i = 1;    /* mark list for the packed items */
     for (p = l->tids; *p >= 0; p++)
-      l->item |= eclat->btas[*p];     /* collect the occurring items */
+      l->item |= (ITEM)eclat->btas[*p]; /* collect the occ. items */
   }                             /* and add list to the reduced array */
   max = 0;                      /* init. the maximal item support */
   for (m = i; i < k; i++) {     /* traverse the items / tid lists */
@@ -976,7 +1324,7 @@ int eclat_tid (ECLAT *eclat)
   if (m > 0) {                  /* if there are frequent items, dep. */
     r = (eclat->mode & ECL_EXTCHK)   /* on how to filter closed/max. */
       ? rec_tcm(eclat, lists, m, z, 0)
-      : rec_tid(eclat, lists, m, z);
+      : par_tid(eclat, lists, m, z);
   }                             /* find freq. item sets recursively */
   if (r >= 0) {                 /* if no error occurred */
     i = eclat->target & (ISR_CLOSED|ISR_MAXIMAL);
@@ -1015,9 +1363,6 @@ static void bit_init (void)
   int i, k, b;                  /* loop variables, bit index */
 
   if (bitcnt[1] != 0) return;   /* check for an initialized table */
-  for (i = 0; ++i < 256; )      /* traverse all byte values */
-    for (k = i; k; k >>= 1)     /* traverse the bits in the value */
-      bitcnt[i] += k & 1;       /* store their number in the table */
   memset(bitmap[0], 0, sizeof(bitmap[0]));
   for (k = 0; k < 256; ) { bitmap[1][k++] = 0; bitmap[1][k++] = 1; }
   for (i = 1; ++i < 255; ) {    /* traverse the matrix rows (masks) */
@@ -1036,6 +1381,11 @@ static void bit_init (void)
     }                           /* that are under the mask bits */
   }                             /* for faster bit vector reduction */
   for (k = 0; k < 256; k++) bitmap[255][k] = (BITBLK)k;
+  for (i = 256; --i > 0; ) {    /* traverse all byte values */
+    for (b = 0, k = i; k; k >>= 1)
+      b += k & 1;               /* count the bits in the value */
+    bitcnt[i] = b;              /* and store their number, */
+  }                             /* with bitcnt[1] (the flag) last */
 }  /* bit_init() */
 
 /*--------------------------------------------------------------------*/
@@ -1066,7 +1416,7 @@ static void bit_isect (BITVEC *dst, BITVEC *src1, BITVEC *src2, TID n)
 /*--------------------------------------------------------------------*/
 #else
 
-#define bit_init()              /* no initialization needed */
+#define bit_init()  ((void)0)   /* no initialization needed */
 
 static void bit_isect (BITVEC *dst, BITVEC *src1, BITVEC *src2, TID n)
 {                               /* --- intersect two bit vectors */
@@ -1105,6 +1455,42 @@ static void bit_isect (BITVEC *dst, BITVEC *src1, BITVEC *src2, TID n)
   if (b > 0) *d = o;            /* store the last bit block */
 }  /* bit_isect() */
 
+#endif
+/*--------------------------------------------------------------------*/
+#ifdef ECL_PEXT
+
+__attribute__((target("bmi2,popcnt")))
+static void bit_pext (BITVEC *dst, BITVEC *src1, BITVEC *src2, TID n)
+{                               /* --- intersect two bit vectors */
+  BITBLK             *s1, *s2, *d; /* to traverse sources and dest. */
+  BITBLK             s, m;      /* source and mask block */
+  unsigned long long o;         /* output buffer (at most 63 bits) */
+  int                b;         /* number of bits in output */
+
+  assert(dst && src1 && src2);  /* check the function arguments */
+  dst->item = src1->item;       /* copy the first item and */
+  dst->supp = 0;                /* initialize the support */
+  d = dst->bits; s1 = src1->bits; s2 = src2->bits;
+  for (o = 0, b = 0; n > 0; n--) { /* traverse the bit vector blocks */
+    s = *s1++; m = *s2++;       /* get source and mask block */
+    if (m == 0) continue;       /* skip empty mask blocks */
+    dst->supp += (SUPP)__builtin_popcount(s & m);
+    o |= (unsigned long long)_pext_u32(s, m) << b;
+    b += __builtin_popcount(m); /* collect the source bits */
+    if (b < 32) continue;       /* for which a mask bit is set */
+    *d++ = (BITBLK)o;           /* if a bit block is full, store it */
+    o >>= 32; b -= 32;          /* and keep the remaining bits */
+  }
+  if (b > 0) *d = (BITBLK)o;    /* store the last bit vector block */
+}  /* bit_pext() */
+
+/* PEXT (parallel bit extract, BMI2) does the compression of a block */
+/* under the mask in one instruction and POPCNT counts the bits, so  */
+/* neither byte tables nor bit loops are needed. The kernel is only  */
+/* used if the processor supports both instructions (checked when    */
+/* eclat_bit() is called). Note that on AMD processors before Zen 3  */
+/* PEXT is microcoded and slow; compile with ECL_NOPEXT for these.   */
+
 #endif
 /*--------------------------------------------------------------------*/
 
@@ -1151,7 +1537,7 @@ static int rec_bit (ECLAT *eclat, BITVEC **vecs, ITEM k, TID n)
       pex = (eclat->mode & ECL_PERFECT) ? v->supp : SUPP_MAX;
       proj[m = 0] = d = (BITVEC*)(p = (BITBLK*)(proj +k+1));
       for (i = 0; i < k; i++) { /* traverse preceding vectors */
-        bit_isect(d, vecs[i], v, n);
+        eclat->isect(d, vecs[i], v, n);
         if (d->supp < eclat->supp) /* intersect trans. bit vectors */
           continue;             /* eliminate infrequent items */
         if (d->supp >= pex) {   /* collect perfect extensions */
@@ -1194,7 +1580,14 @@ int eclat_bit (ECLAT *eclat)
   n = tbg_cnt(eclat->tabag);    /* get the number of transactions */
   k = tbg_itemcnt(eclat->tabag);/* and check the number of items */
   if (k <= 0) return isr_report(eclat->report);
-  bit_init();                   /* initialize the bit count table */
+  eclat->isect = bit_isect;     /* get the intersection function */
+  #ifdef ECL_PEXT               /* if PEXT/POPCNT can be used */
+  if (__builtin_cpu_supports("bmi2")
+  &&  __builtin_cpu_supports("popcnt"))
+    eclat->isect = bit_pext;    /* use the kernel with PEXT/POPCNT */
+  #endif
+  if (eclat->isect == bit_isect)
+    bit_init();                 /* initialize the bit count table */
   x = (n + 31) >> 5;            /* and compute the bit vector size */
   vecs = (BITVEC**)malloc((size_t)k                *sizeof(BITVEC*)
                         + (size_t)k                *sizeof(BITVEC)
@@ -1273,7 +1666,7 @@ static int rec_tab (ECLAT *eclat, TIDLIST **lists, ITEM k, size_t x)
       pex = (eclat->mode & ECL_PERFECT) ? l->supp : SUPP_MAX;
       proj[m = 0] = d = (TIDLIST*)(proj +k+1);
       for (i = 0; i < k; i++) { /* traverse the preceding lists */
-        x = (size_t)filter(d, lists[i], eclat->tab[l->item]);
+        x = (size_t)filter(d, lists[i], l, eclat->tab[l->item]);
         if (d->supp < eclat->supp)  /* filter transaction id list */
           continue;             /* and eliminate infrequent items */
         if (d->supp >= pex) {   /* collect perfect extensions */
@@ -1342,6 +1735,7 @@ int eclat_tab (ECLAT *eclat)
     lists[i] = l = (TIDLIST*)p; /* get/create the next trans. id list */
     l->item  = i;               /* initialize the list item */
     l->supp  = 0;               /* and the support counter */
+    l->cnt   = c[i];            /* set the number of trans. ids */
     next[i]  = p = l->tids;     /* note position of next trans. id */
     p += c[i]; *p++ = (TID)-1;  /* skip space for transaction ids */
   }                             /* and store a sentinel at the end */
@@ -1515,7 +1909,7 @@ static void build_trg (TRGLIST **lists, TIDRANGE **next,
       if (i >= 0) break;        /* if it is not packed, abort loop */
       r = next[0]++;            /* get the current range in list */
       r->min = min;             /* store the transaction id and */
-      r->max = (TID)(BITTA)i;   /* the bit repr. of the items */
+      r->max = (TID)(i & ~TA_END); /* bit repr. of the items */
       l->supp += r->wgt = ta_wgt(t);
     }                           /* store and sum transaction weight */
     if (min > k) {              /* if the trans. range is not empty */
@@ -1622,7 +2016,7 @@ static int rec_trg (ECLAT *eclat, TRGLIST **lists, ITEM k, size_t x)
     if (lists[0]->item >= 0)    /* if there are no packed items, */
       t[m++] = lists[0]->item;  /* simply copy the last item */
     else {                      /* if there are packed items */
-      for (z = 16; --z >= 0; )  /* traverse the bits */
+      for (z = 31; --z >= 0; )  /* traverse the bits */
         if (lists[0]->item & (1 << z))
           t[m++] = z;           /* collect the packed tail items */
     }                           /* after the other tail items */
@@ -1729,8 +2123,11 @@ int eclat_trg (ECLAT *eclat)
     eclat->fim16 = m16_create(eclat->dir, eclat->supp, eclat->report);
     if (!eclat->fim16) { free(trgs); free(lists); return -1; }
     next[i++]->min = (TID)-1;   /* store a sentinel at the list end */
-    l->item        = -1;        /* mark list for the packed items */
-  }                             /* and store it in the reduced array */
+    l->item        = TA_END;    /* mark list for the packed items */
+    for (n = 0; l->trgs[n].min >= 0; n++)
+      l->item |= (ITEM)l->trgs[n].max;
+  }                             /* collect the occurring items and */
+                                /* store list in the reduced array */
   for (m = i; i < k; i++) {     /* traverse the trans. range lists */
     l = lists[i];               /* eliminate all infrequent items and */
     if (l->supp <  eclat->supp) continue;    /* collect perfect exts. */
@@ -1766,7 +2163,7 @@ static int odclo (ECLAT *eclat, TALIST *list, ITEM item)
       if (!isr_uses(eclat->report, (ITEM)i))
         m |= 1 << i;            /* collect bits of unused items */
     for (k = list->cnt; m && (--k >= 0); )
-      m &= ta_getmark(list->tracts[k]);
+      m &= (int)ta_getmark(list->tracts[k]);
     if (m) return 0;            /* if perf. ext found, 'not closed' */
     item = 31;                  /* otherwise check remaining items */
   }                             /* (check only items 32 and above) */
@@ -1785,7 +2182,7 @@ static int odclo (ECLAT *eclat, TALIST *list, ITEM item)
   for (k = list->cnt-1; --k > 0; ) {
     s = d = eclat->cand;        /* traverse the transactions */
     p = ta_items(list->tracts[k]);
-    while (*p <= item) p++;     /* find the item added last */
+    while ((UITEM)*p <= (UITEM)item) p++;  /* find item added last */
     while (1) {                 /* item list intersection loop */
       if      (*s < 0) break;   /* check for the list sentinel */
       else if ((UITEM)*s < (UITEM)*p) s++;
@@ -1825,6 +2222,140 @@ static int odmax (ECLAT *eclat, TALIST *list, ITEM item)
 
 /*--------------------------------------------------------------------*/
 
+static int ocd_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int        r;                 /* error status */
+  ECLPAR     *par = (ECLPAR*)data; /* type the data pointer */
+  ECLAT      *eclat;            /* copy of the eclat miner */
+  ITEM       i, j;              /* index of the item, loop variable */
+  TID        n;                 /* loop variable for transactions */
+  size_t     x, y, z;           /* numbers of item instances */
+  SUPP       *c;                /* item occurrence counters */
+  TALIST     **lists, **proj;   /* top-level and projected lists */
+  TALIST     *l, *p;            /* to traverse the transaction lists */
+  TRACT      *t, *u;            /* to traverse the transactions */
+  const ITEM *s, *b;            /* to traverse the items */
+  ITEM       *d;                /* to copy the items */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  eclat = par->thds +thread;    /* get the miner copy of the thread */
+  lists = (TALIST**)par->lists; /* and the item to process */
+  l = lists[i = par->beg +(ITEM)task];
+  if (l->supp <= 0) return 0;   /* skip eliminated items */
+  if (isr_task(eclat->report, task) < 0) return -1;
+  c = (SUPP*)memset(eclat->muls, 0, (size_t)i *sizeof(SUPP));
+  for (x = y = 0, n = 0; n < l->cnt; n++) {
+    s = ta_items(l->tracts[n]); /* traverse the transactions */
+    if (ispacked(*s)) s++;      /* skip the packed items (if any) */
+    for (b = s; (UITEM)*s < (UITEM)i; s++)
+      c[*s] += 1;               /* count the item occurrences */
+    y += (size_t)(s -b);        /* sum the number of occurrences and */
+    x += (size_t)(s -ta_items(l->tracts[n])) +2;   /* the size of */
+  }                             /* the transaction copies */
+  z = (size_t)(i+1) *sizeof(TALIST*) +(size_t)(i+1) *sizeof(TALIST)
+    + (y +(size_t)l->cnt) *sizeof(TRACT*);
+  if (par->copy) z += taa_dstsize(l->cnt, x);
+  proj = (TALIST**)malloc(z);   /* allocate the projection lists */
+  if (!proj) return -1;         /* (and the transaction copies) */
+  p = (TALIST*)(proj +i+1);     /* get the first transaction list */
+  for (j = 0; j < i; j++) {     /* traverse the preceding items */
+    proj[j] = p; p->item = lists[j]->item;
+    p->supp = 0; p->cnt  = 0;   /* initialize the transaction list */
+    p = (TALIST*)(p->tracts +(TID)c[j]);
+  }                             /* skip space for the transactions */
+  proj[i] = p; p->item = l->item; /* copy the transaction list */
+  p->supp = l->supp; p->cnt = l->cnt;   /* of the current item */
+  if (!par->copy)               /* if the transactions can be shared */
+    memcpy(p->tracts, l->tracts, (size_t)l->cnt *sizeof(TRACT*));
+  else {                        /* if to copy the transactions */
+    u = (TRACT*)(p->tracts +l->cnt);
+    for (n = 0; n < l->cnt; n++) {
+      t = l->tracts[n]; p->tracts[n] = u;
+      u->wgt = t->wgt; u->mark = t->mark;
+      s = ta_items(t); d = u->items;
+      if (ispacked(*s)) *d++ = *s++;
+      while ((UITEM)*s < (UITEM)i) *d++ = *s++;
+      *d++ = *s;                /* copy the items up to the current */
+      u->size = (ITEM)(d -u->items);            /* one and store */
+      *d++ = TA_END; u = (TRACT*)d;     /* a sentinel at the end */
+    }                           /* (collating the transactions in */
+  }                             /* the recursion changes weights) */
+  r = par->item(eclat, proj, i, par->m);
+  free(proj);                   /* process the current item and */
+  return r;                     /* delete the projection lists */
+}  /* ocd_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_ocd (ECLAT *eclat, TALIST **lists, ITEM beg, ITEM end,
+                    ITEM m, OCDFN *item, int copy)
+{                               /* --- parallel occurrence deliver */
+  int    r, i;                  /* error status, loop variable */
+  ITEM   k;                     /* number of items */
+  size_t h;                     /* size of the hash table */
+  ECLAT  *e;                    /* to traverse the miner copies */
+  ECLPAR par;                   /* data for the parallel search */
+
+  assert(eclat && lists && item);  /* check the function arguments */
+  k = tbg_itemcnt(eclat->tabag);/* get the number of items and */
+  h = (size_t)taa_tabsize(tbg_cnt(eclat->tabag)); /* table size */
+  r = par_init(&par, eclat, end-beg, h *sizeof(TRACT*)
+             + (size_t)k *sizeof(SUPP) +(size_t)(k+k+1) *sizeof(ITEM));
+  if (r <= 0) return (r < 0) ? r : 1;
+  for (i = 0; i < par.cnt; i++) {
+    e = par.thds +i;            /* traverse the miner copies */
+    e->hash = (TRACT**)par.bufs[i];    /* and set the buffers */
+    e->muls = e->miss = (SUPP*)(e->hash +h);
+    e->cand = (ITEM*)(e->muls +k);
+  }                             /* (as in function eclat_ocd()) */
+  par.lists = lists; par.beg = beg; par.end = end;
+  par.m     = m;     par.item = item; par.copy = copy;
+  for (k = beg; k < end; k++)   /* use supports as size hints */
+    par.wgts[k-beg] = (double)lists[k]->supp;
+  r = tp_execx(par.cnt, (long)(end-beg), ocd_task, &par, par.wgts);
+  for (k = beg; k < end; k++) { /* reinitialize the trans. lists */
+    lists[k]->supp = 0; lists[k]->cnt = 0; }
+  return par_exit(&par, r);     /* process the items in parallel */
+}  /* par_ocd() */
+
+/* Each task builds its own (empty) transaction lists for the items  */
+/* preceding the item to process, so that the item occurrences can be */
+/* delivered without interfering with other tasks. The function       */
+/* par_ocd() returns 1 if no parallel search is possible, so that the */
+/* calling function can process the items with its own (serial) loop. */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP rec_odcm (ECLAT *eclat, TALIST **lists, ITEM k);
+
+static int odcm_item (ECLAT *eclat, TALIST **lists, ITEM i, ITEM m)
+{                               /* --- process one item (closed/max.) */
+  int    r;                     /* error status */
+  SUPP   w;                     /* maximum support of an extension */
+  TALIST *p;                    /* transaction list of the item */
+
+  assert(eclat && lists && (i >= 0)); /* check the function arguments */
+  p = lists[i];                 /* get the transaction list */
+  if (!odclo(eclat, p, i))      /* if the current set cannot be */
+    return 0;                   /* closed, skip the item */
+  r = isr_add(eclat->report, i, p->supp);
+  if (r < 0) return r;          /* add current item to the reporter */
+  w = 0;                        /* default: no perfect extension */
+  if (i > m) {                  /* if to compute a projection */
+    w = rec_odcm(eclat, lists, i);
+    if (w < 0) return -1;       /* recursively find freq. item sets */
+  }                             /* and check for a recursion error */
+  if ((eclat->target & ISR_CLOSED) ? (w < p->supp)
+  :   ((w < eclat->supp) && odmax(eclat, p, i))) {
+    r = isr_report(eclat->report);
+    if (r < 0) return r;        /* if current set is closed/maximal, */
+  }                             /* report the current item set */
+  isr_remove(eclat->report, 1); /* remove the current item */
+  return 0;                     /* from the item set reporter */
+}  /* odcm_item() */
+
+/*--------------------------------------------------------------------*/
+
 static SUPP rec_odcm (ECLAT *eclat, TALIST **lists, ITEM k)
 {                               /* --- occ. deliver closed/maximal */
   int        r;                 /* error status */
@@ -1859,26 +2390,21 @@ static SUPP rec_odcm (ECLAT *eclat, TALIST **lists, ITEM k)
   }                             /* (to see whether loop is needed) */
   if (m <= 0) return 0;         /* if no frequent items found, abort */
   m = isr_xable(eclat->report, 2) ? 0 : ITEM_MAX;
-  for (max = w = 0, i = 0; i < k; i++) {
+  if ((eclat->threads != 1)     /* if on the top level */
+  &&  (isr_cnt(eclat->report) <= 0)) {  /* of a parallel search */
+    for (max = 0, i = 0; i < k; i++)
+      if (lists[i]->supp > max) /* find maximal extension support */
+        max = lists[i]->supp;   /* (for later closed/maximal check) */
+    r = par_ocd(eclat, lists, 0, k, m, odcm_item, 0);
+    if (r <= 0) return (r < 0) ? (SUPP)r : max;
+  }                             /* process the items in parallel */
+  for (r = 0, max = 0, i = 0; i < k; i++) {
     p = lists[i];               /* traverse the items / trans. lists, */
     if (p->supp <= 0) continue; /* but skip all eliminated items */
     if (p->supp > max)          /* find maximal extension support */
       max = p->supp;            /* (for later closed/maximal check) */
-    if (odclo(eclat, p, i)) {   /* if the current set may be closed */
-      r = isr_add(eclat->report, i, p->supp);
-      if (r < 0) break;         /* add current item to the reporter */
-      w = 0;                    /* default: no perfect extension */
-      if (i > m) {              /* if to compute a projection */
-        w = rec_odcm(eclat, lists, i);
-        if (w < 0) { r = -1; break; }
-      }                         /* recursively find freq. item sets */
-      if ((eclat->target & ISR_CLOSED) ? (w < p->supp)
-      :   ((w < eclat->supp) && odmax(eclat, p, i))) {
-        r = isr_report(eclat->report);
-        if (r < 0) break;       /* if current set is closed/maximal, */
-      }                         /* report the current item set */
-      isr_remove(eclat->report,1); /* remove the current item */
-    }                           /* from the item set reporter */
+    r = odcm_item(eclat, lists, i, m);
+    if (r < 0) break;           /* process the current item */
     p->supp = 0; p->cnt = 0;    /* reinitialize the transaction list */
   }
   return (r < 0) ? (SUPP)r : max; /* return error status/max. support */
@@ -1886,6 +2412,29 @@ static SUPP rec_odcm (ECLAT *eclat, TALIST **lists, ITEM k)
 
 /*--------------------------------------------------------------------*/
 
+static int rec_odfx (ECLAT *eclat, TALIST **lists, ITEM k);
+
+static int odfx_item (ECLAT *eclat, TALIST **lists, ITEM i, ITEM m)
+{                               /* --- process one item (w/o reorder) */
+  int    r;                     /* error status */
+  TALIST *p;                    /* transaction list of the item */
+
+  assert(eclat && lists && (i >= 0)); /* check the function arguments */
+  p = lists[i];                 /* get the transaction list */
+  r = isr_add(eclat->report, i, p->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  if (i > m) {                  /* if to compute a projection */
+    r = rec_odfx(eclat, lists, i);
+    if (r < 0) return r;        /* recursively find freq. item sets */
+  }                             /* and check for a recursion error */
+  r = isr_report(eclat->report);
+  if (r < 0) return r;          /* report the current item set */
+  isr_remove(eclat->report, 1); /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* odfx_item() */
+
+/*--------------------------------------------------------------------*/
+
 static int rec_odfx (ECLAT *eclat, TALIST **lists, ITEM k)
 {                               /* --- occ. deliver w/o reordering */
   int        r;                 /* error status */
@@ -1908,7 +2457,7 @@ static int rec_odfx (ECLAT *eclat, TALIST **lists, ITEM k)
     if ((w = ta_wgt(t)) <= 0) continue;
     s = ta_items(t);            /* if there are packed items, */
     if (ispacked(*s))           /* add them to the 16-items machine */
-      m16_add(eclat->fim16, (BITTA)*s++, w);
+      m16_add(eclat->fim16, (BITTA)(*s++ & ~TA_END), w);
     for ( ; (UITEM)*s < (UITEM)k; s++) {
       p = lists[*s]; p->supp += w; p->tracts[p->cnt++] = t; }
   }                             /* deliver the item occurrences */
@@ -1926,20 +2475,16 @@ static int rec_odfx (ECLAT *eclat, TALIST **lists, ITEM k)
   if (m <= 0) {                 /* if no frequent items found, abort */
     taa_uncoll(l->tracts, l->cnt); return r; }
   m = isr_xable(eclat->report, 2) ? 0 : ITEM_MAX;
+  if ((eclat->threads != 1)     /* if on the top level */
+  &&  (isr_cnt(eclat->report) <= 0)) {  /* of a parallel search */
+    r = par_ocd(eclat, lists, eclat->first, k, m, odfx_item, 1);
+    if (r <= 0) { taa_uncoll(l->tracts, l->cnt); return r; }
+  }                             /* process the items in parallel */
   for (i = eclat->first; i < k; i++) {
     p = lists[i];               /* traverse the items / trans. lists, */
     if (p->supp <= 0) continue; /* but skip all eliminated items */
-    r = isr_add(eclat->report, i, p->supp);
-    if (r < 0) break;           /* add current item to the reporter */
-    if (r > 0) {                /* if the item needs processing */
-      if (i > m) {              /* if to compute a projection */
-        r = rec_odfx(eclat, lists, i);
-        if (r < 0) break;       /* recursively find freq. item sets */
-      }                         /* and check for a recursion error */
-      r = isr_report(eclat->report);
-      if (r < 0) break;         /* report the current item set */
-      isr_remove(eclat->report, 1); /* remove the current item */
-    }                           /* from the item set reporter */
+    r = odfx_item(eclat, lists, i, m);
+    if (r < 0) break;           /* process the current item */
     p->supp = 0; p->cnt = 0;    /* reinitialize the transaction list */
   }
   taa_uncoll(l->tracts,l->cnt); /* uncollate the transactions */
@@ -1948,6 +2493,29 @@ static int rec_odfx (ECLAT *eclat, TALIST **lists, ITEM k)
 
 /*--------------------------------------------------------------------*/
 
+static int rec_odro (ECLAT *eclat, TALIST **lists, ITEM k);
+
+static int odro_item (ECLAT *eclat, TALIST **lists, ITEM i, ITEM m)
+{                               /* --- process one item (reordering) */
+  int    r;                     /* error status */
+  TALIST *l;                    /* transaction list of the item */
+
+  assert(eclat && lists && (i >= 0)); /* check the function arguments */
+  l = lists[i];                 /* get the transaction list */
+  r = isr_add(eclat->report, l->item, l->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  if (i > m) {                  /* if to compute a projection */
+    r = rec_odro(eclat, lists, i);
+    if (r < 0) return r;        /* recursively find freq. item sets */
+  }                             /* and check for a recursion error */
+  r = isr_report(eclat->report);
+  if (r < 0) return r;          /* report the current item set */
+  isr_remove(eclat->report, 1); /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* odro_item() */
+
+/*--------------------------------------------------------------------*/
+
 static int rec_odro (ECLAT *eclat, TALIST **lists, ITEM k)
 {                               /* --- occ. deliver with reordering */
   int        r;                 /* error status */
@@ -2047,20 +2615,17 @@ static int rec_odro (ECLAT *eclat, TALIST **lists, ITEM k)
     i = 0;                      /* to the transaction lists and */
   }                             /* get first item index to process */
   m = isr_xable(eclat->report, 2) ? 0 : ITEM_MAX;
-  for (r = 0; i < k; i++) {     /* traverse the items/trans. lists, */
+  r = 0;                        /* default: serial processing */
+  if ((eclat->threads != 1)     /* if on the top level */
+  &&  (isr_cnt(eclat->report) <= 0)) {  /* of a parallel search */
+    r = par_ocd(eclat, dst, i, k, m, odro_item, 0);
+    if (r > 0) r = 0; else i = k;
+  }                             /* process the items in parallel */
+  for ( ; i < k; i++) {         /* traverse the items/trans. lists, */
     l = dst[i];                 /* but skip all eliminated items */
     if (l->supp <= 0) { l->cnt = 0; continue; }
-    r = isr_add(eclat->report, l->item, l->supp);
-    if (r < 0) break;           /* add current item to the reporter */
-    if (r > 0) {                /* if the item needs processing */
-      if (i > m) {              /* if to compute a projection */
-        r = rec_odro(eclat, dst, i);
-        if (r < 0) break;       /* recursively find freq. item sets */
-      }                         /* and check for a recursion error */
-      r = isr_report(eclat->report);
-      if (r < 0) break;         /* report the current item set */
-      isr_remove(eclat->report,1); /* remove the current item */
-    }                           /* from the item set reporter */
+    r = odro_item(eclat, dst, i, m);
+    if (r < 0) break;           /* process the current item */
     l->supp = 0; l->cnt = 0;    /* reinitialize the transaction list */
   }
   if (mem) {                    /* delete projection lists */
@@ -2145,54 +2710,257 @@ int eclat_ocd (ECLAT *eclat)
   Eclat with Diffsets
 ----------------------------------------------------------------------*/
 
-static TID cmpl (TIDLIST *dst, TIDLIST *src1, TIDLIST *src2, SUPP *muls)
+static TID* dif_mrg (TID *d, const TID *s1, const TID *s2,
+                     const SUPP *muls, SUPP *supp)
+{                               /* --- subtract two trans. id lists */
+  SUPP w = 0;                   /* sum of transaction weights */
+
+  while (1) {                   /* trans. id list difference loop */
+    if      (*s1 > *s2) *d++ = *s1++;
+    else if (*s1 < *s2) w += muls[*s2++];
+    else if (*s1 <   0) break;  /* copy the elements of the first */
+    else { s1++; s2++; }        /* source that are not in the second */
+  }                             /* and sum the weights of the others */
+  *supp -= w;                   /* subtract the weight of elements */
+  return d;                     /* of the second source that are not */
+}  /* dif_mrg() */              /* in the first, return the new end */
+
+/*--------------------------------------------------------------------*/
+
+static TID* dif_bmp (TID *d, const TID *s1, const TID *s2,
+                     const SUPP *muls, SUPP *supp, BITBLK *map)
+{                               /* --- subtract with a bit map */
+  const TID *s;                 /* to traverse the second source */
+  BITBLK    b;                  /* bit of a transaction id */
+  SUPP      w = 0;              /* sum of transaction weights */
+
+  for (s = s2; *s >= 0; s++)    /* mark the elements of the second */
+    map[*s >> 5] |= (BITBLK)1 << (*s & 0x1f);     /* source */
+  for ( ; *s1 >= 0; s1++) {     /* traverse the first source */
+    b = (BITBLK)1 << (*s1 & 0x1f);
+    *d = *s1; d += ((map[*s1 >> 5] & b) == 0);
+    map[*s1 >> 5] &= ~b;        /* copy unmarked elements and */
+  }                             /* unmark all marked elements */
+  for ( ; *s2 >= 0; s2++) {     /* traverse the second source */
+    b = (BITBLK)1 << (*s2 & 0x1f);
+    w += muls[*s2] *(SUPP)((map[*s2 >> 5] & b) != 0);
+    map[*s2 >> 5] &= ~b;        /* sum the weights of elements that */
+  }                             /* are still marked and unmark them */
+  *supp -= w;                   /* subtract the weight of elements */
+  return d;                     /* not in the first source and */
+}  /* dif_bmp() */              /* return the new end of the dest. */
+
+/* If the lists are long compared to the number of transactions, it */
+/* is cheaper to mark the elements of the second list in a bit map  */
+/* over all transactions than to merge the lists: each element is   */
+/* then handled with a few bit operations and without any branches. */
+/* The bit map is cleared again while the result is collected.      */
+
+/*--------------------------------------------------------------------*/
+#ifdef ECL_SIMD
+
+__attribute__((target("sse2")))
+static TID* dif_sse2 (TID *d, const TID *s1, TID n1,
+                      const TID *s2, TID n2,
+                      const SUPP *muls, SUPP *supp)
+{                               /* --- subtract with 4x4 blocks */
+  TID     i, j, t;              /* list indices, buffer */
+  int     k, x;                 /* loop variable, mask buffer */
+  int     m1 = 0, m2 = 0;       /* match masks of current blocks */
+  SUPP    w = 0;                /* sum of transaction weights */
+  __m128i a, b, c, e;           /* blocks of the lists, comparisons */
+
+  for (i = j = 0; (i+4 <= n1) && (j+4 <= n2); ) {
+    a = _mm_loadu_si128((const __m128i*)(s1+i));
+    b = _mm_loadu_si128((const __m128i*)(s2+j));
+    c = e =          _mm_cmpeq_epi32(a, b);
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x39)));
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x4e)));
+    c = _mm_or_si128(c, _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b,0x93)));
+    e = _mm_or_si128(e, _mm_cmpeq_epi32(b, _mm_shuffle_epi32(a,0x39)));
+    e = _mm_or_si128(e, _mm_cmpeq_epi32(b, _mm_shuffle_epi32(a,0x4e)));
+    e = _mm_or_si128(e, _mm_cmpeq_epi32(b, _mm_shuffle_epi32(a,0x93)));
+    m1 |= _mm_movemask_ps(_mm_castsi128_ps(c));
+    m2 |= _mm_movemask_ps(_mm_castsi128_ps(e));
+    t = s1[i+3] -s2[j+3];       /* collect the matches of the blocks */
+    if (t >= 0) {               /* if the first block is finished, */
+      for (x = ~m1, k = 0; k < 4; k++) {    /* copy its unmatched */
+        *d = s1[i+k]; d += (x >> k) & 1; }  /* elements */
+      i += 4; m1 = 0;           /* advance in the first list */
+    }                           /* and clear the match mask */
+    if (t <= 0) {               /* if the second block is finished, */
+      for (x = ~m2, k = 0; k < 4; k++)  /* sum the weights */
+        w += muls[s2[j+k]] *(SUPP)((x >> k) & 1);
+      j += 4; m2 = 0;           /* of its unmatched elements and */
+    }                           /* advance in the second list */
+  }
+  for (k = 0; (k < 4) && (s1[i] > s2[j]); k++, i++) {
+    *d = s1[i]; d += (~m1 >> k) & 1; }
+  for (k = 0; (k < 4) && (s2[j] > s1[i]); k++, j++)
+    w += muls[s2[j]] *(SUPP)((~m2 >> k) & 1);
+  *supp -= w;                   /* finish the current blocks */
+  return dif_mrg(d, s1+i, s2+j, muls, supp);
+}  /* dif_sse2() */             /* subtract the rest of the lists */
+
+/*--------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+static TID* dif_avx2 (TID *d, const TID *s1, TID n1,
+                      const TID *s2, TID n2,
+                      const SUPP *muls, SUPP *supp)
+{                               /* --- subtract with 8x8 blocks */
+  TID     i, j, t;              /* list indices, buffer */
+  int     k, x;                 /* loop variable, mask buffer */
+  int     m1 = 0, m2 = 0;       /* match masks of current blocks */
+  SUPP    w = 0;                /* sum of transaction weights */
+  __m256i a, b, c, e, p, q, r;  /* blocks of the lists, comparisons */
+
+  r = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  for (i = j = 0; (i+8 <= n1) && (j+8 <= n2); ) {
+    p = a = _mm256_loadu_si256((const __m256i*)(s1+i));
+    q = b = _mm256_loadu_si256((const __m256i*)(s2+j));
+    c = e = _mm256_cmpeq_epi32(a, b);
+    for (k = 1; k < 8; k++) {   /* rotate both blocks and */
+      p = _mm256_permutevar8x32_epi32(p, r);
+      q = _mm256_permutevar8x32_epi32(q, r);
+      c = _mm256_or_si256(c, _mm256_cmpeq_epi32(a, q));
+      e = _mm256_or_si256(e, _mm256_cmpeq_epi32(b, p));
+    }                           /* compare all pairs */
+    m1 |= _mm256_movemask_ps(_mm256_castsi256_ps(c));
+    m2 |= _mm256_movemask_ps(_mm256_castsi256_ps(e));
+    t = s1[i+7] -s2[j+7];       /* process finished blocks */
+    if (t >= 0) {
+      for (x = ~m1, k = 0; k < 8; k++) {
+        *d = s1[i+k]; d += (x >> k) & 1; }
+      i += 8; m1 = 0;           /* copy the unmatched elements */
+    }                           /* of the first block */
+    if (t <= 0) {
+      for (x = ~m2, k = 0; k < 8; k++)
+        w += muls[s2[j+k]] *(SUPP)((x >> k) & 1);
+      j += 8; m2 = 0;           /* sum the weights of the unmatched */
+    }                           /* elements of the second block */
+  }
+  for (k = 0; (k < 8) && (s1[i] > s2[j]); k++, i++) {
+    *d = s1[i]; d += (~m1 >> k) & 1; }
+  for (k = 0; (k < 8) && (s2[j] > s1[i]); k++, j++)
+    w += muls[s2[j]] *(SUPP)((~m2 >> k) & 1);
+  *supp -= w;                   /* finish the current blocks */
+  return dif_sse2(d, s1+i, n1-i, s2+j, n2-j, muls, supp);
+}  /* dif_avx2() */             /* subtract the rest of the lists */
+
+/* Contrary to an intersection, a difference needs to know for each */
+/* element whether it has a match at all, also in blocks compared   */
+/* earlier. Hence the match masks of the current blocks are kept    */
+/* until a block is finished (that is, until the list is advanced). */
+/* Any elements of an unfinished block that are larger than the     */
+/* head of the other list have already been compared with all      */
+/* candidates and are finished before the rest is merged.           */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static TID* subtr (TID *d, TIDLIST *src1, TIDLIST *src2, ECLAT *eclat,
+                   SUPP *supp)
+{                               /* --- subtract two trans. id lists */
+  assert(d && src1 && src2 && eclat && supp);
+  if (eclat->bmap               /* if the lists are long, use a map */
+  && ((src1->cnt +src2->cnt) > tbg_cnt(eclat->tabag) /DENSE))
+    return dif_bmp(d, src1->tids, src2->tids, eclat->muls, supp,
+                   eclat->bmap);
+  #ifdef ECL_SIMD               /* if SIMD kernels can be used */
+  if ((src1->cnt /BLKRATIO > src2->cnt)  /* if the lengths differ */
+  ||  (src2->cnt /BLKRATIO > src1->cnt)) /* much, a merge is faster */
+    return dif_mrg(d, src1->tids, src2->tids, eclat->muls, supp);
+  if ((sizeof(TID) == 4) && __builtin_cpu_supports("avx2"))
+    return dif_avx2(d, src1->tids, src1->cnt, src2->tids, src2->cnt,
+                    eclat->muls, supp);
+  if ((sizeof(TID) == 4) && __builtin_cpu_supports("sse2"))
+    return dif_sse2(d, src1->tids, src1->cnt, src2->tids, src2->cnt,
+                    eclat->muls, supp);
+  #endif                        /* otherwise use a plain merge */
+  return dif_mrg(d, src1->tids, src2->tids, eclat->muls, supp);
+}  /* subtr() */
+
+/*--------------------------------------------------------------------*/
+
+static TID cmpl (TIDLIST *dst, TIDLIST *src1, TIDLIST *src2,
+                 ECLAT *eclat)
 {                               /* --- complement two trans. id lists */
-  TID *s1, *s2, *d;             /* to traverse sources and dest. */
+  TID *d;                       /* end of the destination list */
 
-  assert(dst && src1 && src2 && muls); /* check function arguments */
+  assert(dst && src1 && src2 && eclat); /* check function arguments */
   dst->item = src1->item;       /* copy the first item and */
   dst->supp = src1->supp;       /* initialize the support */
-  d = dst->tids; s1 = src1->tids; s2 = src2->tids;
-  while (1) {                   /* trans. id list difference loop */
-    if      (*s1 > *s2) dst->supp -= muls[*s1++];
-    else if (*s1 < *s2) *d++ = *s2++;
-    else if (*s1 < 0) break;    /* collect elements of second source */
-    else { s1++; s2++; }        /* that are not in the first source */
-  }                             /* (form complement of first source) */
-  *d++ = -1;                    /* store a sentinel at the list end */
-  return (TID)(d -dst->tids);   /* return the size of the new lists */
+  d = subtr(dst->tids, src2, src1, eclat, &dst->supp);
+  dst->cnt = (TID)(d -dst->tids);   /* collect elements of second */
+  *d++ = -1;                    /* source that are not in the first */
+  return (TID)(d -dst->tids);   /* (form complement of first source) */
 }  /* cmpl() */
 
 /*--------------------------------------------------------------------*/
 
-static TID diff (TIDLIST *dst, TIDLIST *src1, TIDLIST *src2, SUPP *muls)
+static TID diff (TIDLIST *dst, TIDLIST *src1, TIDLIST *src2,
+                 ECLAT *eclat)
 {                               /* --- subtract two trans. id lists */
-  TID *s1, *s2, *d;             /* to traverse sources and dest. */
+  TID *d;                       /* end of the destination list */
 
-  assert(dst && src1 && src2 && muls); /* check function arguments */
+  assert(dst && src1 && src2 && eclat); /* check function arguments */
   dst->item = src1->item;       /* copy the first item and */
   dst->supp = src1->supp;       /* initialize the support */
-  d = dst->tids; s1 = src1->tids; s2 = src2->tids;
-  while (1) {                   /* trans. id list difference loop */
-    if      (*s1 > *s2) *d++ = *s1++;
-    else if (*s1 < *s2) dst->supp -= muls[*s2++];
-    else if (*s1 < 0) break;    /* remove all elements of the second */
-    else { s1++; s2++; }        /* source from the first source */
-  }                             /* (form difference of tid lists) */
-  *d++ = -1;                    /* store a sentinel at the list end */
-  return (TID)(d -dst->tids);   /* return the size of the new lists */
+  d = subtr(dst->tids, src1, src2, eclat, &dst->supp);
+  dst->cnt = (TID)(d -dst->tids);   /* remove all elements of the */
+  *d++ = -1;                    /* second source from the first */
+  return (TID)(d -dst->tids);   /* (form difference of tid lists) */
 }  /* diff() */
 
 /*--------------------------------------------------------------------*/
 
+static int rec_diff (ECLAT *eclat, TIDLIST **lists, ITEM k, TID x,
+                     COMBFN comb);
+
+static int diff_item (ECLAT *eclat, TIDLIST **lists, ITEM k,
+                      TIDLIST **proj, COMBFN comb)
+{                               /* --- process one item (diffsets) */
+  int     r;                    /* error status */
+  ITEM    i, m;                 /* loop variables */
+  TID     c, x;                 /* size of combined lists */
+  SUPP    pex;                  /* minimum support for perfect exts. */
+  TIDLIST *l, *d;               /* to traverse transaction id lists */
+
+  assert(eclat && lists && (k >= 0)); /* check the function arguments */
+  l = lists[k];                 /* get the item / tid list to process */
+  r = isr_add(eclat->report, l->item, l->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  if (proj && (k > 0)) {        /* if another item can be added */
+    pex = (eclat->mode & ECL_PERFECT) ? l->supp : SUPP_MAX;
+    proj[m = 0] = d = (TIDLIST*)(proj +k+1); x = 0;
+    for (i = 0; i < k; i++) {   /* traverse the preceding lists */
+      c = comb(d, lists[i], l, eclat);
+      if (d->supp < eclat->supp)/* combine transaction id lists */
+        continue;               /* and eliminate infrequent items */
+      if (d->supp >= pex) {     /* collect perfect extensions */
+        isr_addpex(eclat->report, d->item); continue; }
+      proj[++m] = d = (TIDLIST*)(d->tids +c);
+      if (c > x) x = c;         /* collect the trans. id lists and */
+    }                           /* determine their maximum length */
+    if (m > 0) {                /* if the projection is not empty */
+      r = rec_diff(eclat, proj, m, x, diff);
+      if (r < 0) return r;      /* recursively find freq. item sets */
+    }                           /* in the created projection */
+  }
+  r = isr_report(eclat->report);
+  if (r < 0) return r;          /* report the current item set */
+  isr_remove(eclat->report, 1); /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* diff_item() */
+
+/*--------------------------------------------------------------------*/
+
 static int rec_diff (ECLAT *eclat, TIDLIST **lists, ITEM k, TID x,
                      COMBFN comb)
 {                               /* --- eclat recursion with diffsets */
   int     r;                    /* error status */
   ITEM    i, m, z;              /* loop variables */
-  TID     c;                    /* size of combined lists */
-  SUPP    pex;                  /* minimum support for perfect exts. */
-  TIDLIST *l, *d;               /* to traverse transaction id lists */
   TIDLIST **proj = NULL;        /* trans. id lists of proj. database */
   ITEM    *t;                   /* to collect the tail items */
 
@@ -2219,37 +2987,70 @@ static int rec_diff (ECLAT *eclat, TIDLIST **lists, ITEM k, TID x,
   if (eclat->dir > 0) { z =  k; k  = 0; }
   else                { z = -1; k -= 1; }
   for (r = 0; k != z; k += eclat->dir) {
-    l = lists[k];               /* traverse the items / tid lists */
-    r = isr_add(eclat->report, l->item, l->supp);
-    if (r <  0) break;          /* add current item to the reporter */
-    if (r <= 0) continue;       /* check if item needs processing */
-    if (proj && (k > 0)) {      /* if another item can be added */
-      pex = (eclat->mode & ECL_PERFECT) ? l->supp : SUPP_MAX;
-      proj[m = 0] = d = (TIDLIST*)(proj +k+1); x = 0;
-      for (i = 0; i < k; i++) { /* traverse the preceding lists */
-        c = comb(d, lists[i], l, eclat->muls);
-        if (d->supp < eclat->supp)/* combine transaction id lists */
-          continue;             /* and eliminate infrequent items */
-        if (d->supp >= pex) {   /* collect perfect extensions */
-          isr_addpex(eclat->report, d->item); continue; }
-        proj[++m] = d = (TIDLIST*)(d->tids +c);
-        if (c > x) x = c;       /* collect the trans. id lists and */
-      }                         /* determine their maximum length */
-      if (m > 0) {              /* if the projection is not empty */
-        r = rec_diff(eclat, proj, m, x, diff);
-        if (r < 0) break;       /* recursively find freq. item sets */
-      }                         /* in the created projection */
-    }
-    r = isr_report(eclat->report);
-    if (r < 0) break;           /* report the current item set */
-    isr_remove(eclat->report,1);/* remove the current item */
-  }                             /* from the item set reporter */
+    r = diff_item(eclat, lists, k, proj, comb);
+    if (r < 0) break;           /* process the items / tid lists */
+  }                             /* (extend the current item set) */
   if (proj) free(proj);         /* delete the list and element arrays */
   return r;                     /* return the error status */
 }  /* rec_diff() */
 
 /*--------------------------------------------------------------------*/
 
+static int diff_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int     r;                    /* error status */
+  ECLPAR  *par = (ECLPAR*)data; /* type the data pointer */
+  ECLAT   *eclat;               /* copy of the eclat miner */
+  ITEM    k;                    /* index of the item to process */
+  TIDLIST **proj;               /* trans. id lists of proj. database */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  eclat = par->thds +thread;    /* get the miner copy of the thread */
+  k = (eclat->dir > 0) ? par->beg +(ITEM)task : par->end-1 -(ITEM)task;
+  if (isr_task(eclat->report, task) < 0) return -1;
+  proj = (TIDLIST**)malloc((size_t)par->end        *sizeof(TIDLIST*)
+                          +(size_t)par->end        *sizeof(TIDLIST)
+                          +(size_t)par->end*par->x *sizeof(TID));
+  if (!proj) return -1;         /* allocate list and element arrays */
+  r = diff_item(eclat, (TIDLIST**)par->lists, k, proj, par->comb);
+  free(proj);                   /* process the item / tid list and */
+  return r;                     /* delete the list and element arrays */
+}  /* diff_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_diff (ECLAT *eclat, TIDLIST **lists, ITEM k, TID x,
+                     COMBFN comb)
+{                               /* --- parallel version of rec_diff() */
+  int    r;                     /* error status */
+  ITEM   i;                     /* loop variable */
+  size_t z;                     /* size of the bit map */
+  ECLPAR par;                   /* data for the parallel search */
+
+  assert(eclat && lists && (k > 0)); /* check the function arguments */
+  if ((eclat->mode & ECL_TAIL)  /* tail pruning needs a repository */
+  ||  (k < 2) || !isr_xable(eclat->report, 2))
+    return rec_diff(eclat, lists, k, x, comb);
+  z = (eclat->bmap) ? (size_t)((tbg_cnt(eclat->tabag)+31) >> 5) : 0;
+  r = par_init(&par, eclat, k, z *sizeof(BITBLK));
+  if (r <= 0)                   /* if no parallel search is possible, */
+    return (r < 0) ? r : rec_diff(eclat, lists, k, x, comb);
+  for (i = 0; i < par.cnt; i++) /* set the bit maps of the threads */
+    par.thds[i].bmap = (BITBLK*)par.bufs[i];
+  if ((k > 4)                   /* if there are enough items left, */
+  &&  (eclat->mode & ECL_REORDER)) /* re-sort items w.r.t. support */
+    ptr_qsort(lists, (size_t)k, +1, tid_cmp, NULL);
+  par.lists = lists; par.x = (size_t)x;
+  par.beg   = 0;     par.end = k;    /* note the top-level lists */
+  par.comb  = comb;             /* and the combination function */
+  for (i = 0; i < k; i++)       /* use supports as size hints */
+    par.wgts[(eclat->dir > 0) ? i : k-1-i] = (double)lists[i]->supp;
+  r = tp_execx(par.cnt, (long)k, diff_task, &par, par.wgts);
+  return par_exit(&par, r);     /* process the items in parallel */
+}  /* par_diff() */
+
+/*--------------------------------------------------------------------*/
+
 int eclat_diff (ECLAT *eclat)
 {                               /* --- eclat with difference sets */
   int        r = 0;             /* result of recursion/error status */
@@ -2275,19 +3076,23 @@ int eclat_diff (ECLAT *eclat)
   if (k <= 0) return isr_report(eclat->report);
   c = tbg_icnts(eclat->tabag,0);/* get the number of containing */
   if (!c) return -1;            /* transactions per item */
-  lists = (TIDLIST**)malloc((size_t)k *sizeof(TIDLIST*)
-                           +(size_t)k *sizeof(TID*)
-                           +(size_t)n *sizeof(SUPP));
+  x = (size_t)((n+31) >> 5);   /* compute the size of the bit map */
+  lists = (TIDLIST**)calloc(1, (size_t)k *sizeof(TIDLIST*)
+                              +(size_t)k *sizeof(TID*)
+                              +(size_t)n *sizeof(SUPP)
+                              +         x*sizeof(BITBLK));
   if (!lists) return -1;        /* create initial tid list array */
   next        = (TID**)(lists+k);  /* split off next position array, */
   eclat->muls = (SUPP*)(next +k);  /* transaction multiplicity array */
+  eclat->bmap = (BITBLK*)(eclat->muls +n);     /* and the bit map */
   x = tbg_extent(eclat->tabag); /* get the number of item occurrences */
   p = tids = (TID*)malloc((size_t)k *sizeof(TIDLIST) +x *sizeof(TID));
-  if (!p) { free(lists); return -1; }  /* allocate tid list elements */
+  if (!p) { free(lists); eclat->bmap = NULL; return -1; }
   for (i = 0; i < k; i++) {     /* traverse the items / tid lists */
     lists[i] = l = (TIDLIST*)p; /* get/create the next trans. id list */
     l->item  = i;               /* initialize the list item */
     l->supp  = 0;               /* and the support counter */
+    l->cnt   = c[i];            /* set the number of trans. ids */
     next[i]  = p = l->tids;     /* note position of next trans. id */
     p += c[i]; *p++ = (TID)-1;  /* skip space for transaction ids */
   }                             /* and store a sentinel at the end */
@@ -2309,10 +3114,11 @@ int eclat_diff (ECLAT *eclat)
     lists[m++] = l;             /* collect lists for frequent items */
   }                             /* (eliminate infrequent items) */
   if (m > 0)                    /* find freq. items sets recursively */
-    r = rec_diff(eclat, lists, m, z, cmpl);
+    r = par_diff(eclat, lists, m, z, cmpl);
   if (r >= 0)                   /* finally report the empty item set */
     r = isr_report(eclat->report);
   free(tids); free(lists);      /* delete the allocated arrays */
+  eclat->bmap = NULL;           /* (including the bit map) */
   return r;                     /* return the error status */
 }  /* eclat_diff() */
 
@@ -2498,6 +3304,7 @@ ECLAT* eclat_create (int target, double smin, double smax,
   eclat->thresh = thresh/100.0;
   eclat->algo   = algo;
   eclat->mode   = mode;
+  eclat->threads = 1;
   eclat->tabag  = NULL;
   eclat->report = NULL;
   eclat->first  = 0;
@@ -2510,6 +3317,8 @@ ECLAT* eclat_create (int target, double smin, double smax,
   eclat->elim   = NULL;
   eclat->fim16  = NULL;
   eclat->istree = NULL;
+  eclat->isect  = NULL;
+  eclat->bmap   = NULL;
   return eclat;                 /* return the created eclat miner */
 }  /* eclat_create() */
 
@@ -2577,7 +3386,6 @@ int eclat_data (ECLAT *eclat, TABAG *tabag, int mode, int sort)
 
   /* --- make parameters consistent --- */
   pack = eclat->mode & ECL_FIM16;
-  if (pack > 16) pack = 16;     /* pack at most 16 items */
   if ((eclat->algo == ECL_OCCDLV) && (eclat->mode & ECL_REORDER))
     pack = 0;                   /* delayed packing if reordering */
   if (mode & ECL_NOPACK)        /* if excluded by processing mode, */
@@ -2619,7 +3427,8 @@ int eclat_data (ECLAT *eclat, TABAG *tabag, int mode, int sort)
     tbg_bitmark(tabag); }       /* set item bits in markers */
   else if ((eclat->algo == ECL_RANGES)/* if to use transaction ranges */
   &&       (pack > 0)) {        /* together with a 16-items machine */
-    tbg_pack(tabag, pack);      /* pack the most frequent items */
+    tbg_pack(tabag, m16_width(tabag, pack));
+                                /* pack the most frequent items */
     if (!(mode & ECL_NOSORT)) { /* sort trans. lexicographically */
       tbg_sort(tabag, 1, TA_EQPACK);
       if (!(mode & ECL_NOREDUCE))
@@ -2632,9 +3441,16 @@ int eclat_data (ECLAT *eclat, TABAG *tabag, int mode, int sort)
       if (!(mode & ECL_NOREDUCE))
         tbg_reduce(tabag, 0);   /* reduce transactions to unique ones */
     }                           /* (need sorting for reduction) */
-    if (pack > 0)               /* if to use a 16-items machine, */
-      tbg_pack(tabag, pack);    /* pack the most frequent items */
-  }                             /* (bit-represented transactions) */
+    if (pack > 0)               /* if to use a k-items machine, */
+      tbg_pack(tabag, m16_width(tabag, pack));
+  }                             /* pack the most frequent items */
+  if (!(mode & ECL_COMPRESS)    /* if not to compress the bag */
+  ||  (eclat->algo   > ECL_LISTS)  /* or the variant does not */
+  ||  (eclat->mode   & ECL_EXTCHK) /* only build tid lists */
+  ||  (eclat->target & ISR_RULES)  /* from the transactions */
+  ||  ((e > RE_NONE) && (e < RE_FNCNT))
+  ||  (tbg_compress(tabag) != 0))  /* or compression failed, */
+    tbg_flatten(tabag);         /* store the transactions in order */
   #ifndef QUIET                 /* if to print messages */
   n = tbg_cnt(tabag);           /* get the number of transactions */
   w = tbg_wgt(tabag);           /* and the new transaction weight */
@@ -2689,7 +3505,7 @@ int eclat_report (ECLAT *eclat, ISREPORT *report)
 
 /*--------------------------------------------------------------------*/
 
-int eclat_mine (ECLAT *eclat, ITEM prune, int order)
+int eclat_mine (ECLAT *eclat, ITEM prune, int order, int threads)
 {                               /* --- eclat algorithm */
   int     r;                    /* result of function call */
   ITEM    m, x;                 /* number of items */
@@ -2704,6 +3520,7 @@ int eclat_mine (ECLAT *eclat, ITEM prune, int order)
   e = eclat->eval & ~ECL_INVBXS;/* remove flags from measure code */
   if (e <= RE_NONE)             /* if there is no evaluation, */
     prune = ITEM_MIN;           /* do not prune with evaluation */
+  eclat->threads = threads;     /* note the number of threads */
 
   /* --- find frequent item sets --- */
   if (!(eclat->target & ISR_RULES)  /* if to find plain item sets */
@@ -2946,12 +3763,14 @@ int main (int argc, char *argv[])
   int     sort     = 2;         /* flag for item sorting and recoding */
   int     algo     = 'a';       /* variant of eclat algorithm */
   int     mode     = ECL_DEFAULT|ECL_PREFMT;   /* search mode */
+  int     prep     = 0;         /* data preparation mode */
   int     pack     = 16;        /* number of bit-packed items */
   int     cmfilt   = -1;        /* mode for closed/maximal filtering */
   int     mtar     = 0;         /* mode for transaction reading */
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     threads  = 1;         /* number of threads to use */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -3025,6 +3844,14 @@ int main (int argc, char *argv[])
                     "(default: use hut)\n");
     printf("         (only for maximal item sets, option -tm, "
                     "not with option -Ab)\n");
+    printf("-Y#      number of threads to use                 "
+                    "(default: %d)\n", threads);
+    printf("         (a value <= 0 means one thread per cpu,\n"
+           "          not with transaction identifier output)\n");
+    printf("-D       compress transactions in memory          "
+                    "(default: no)\n");
+    printf("         (only for tid list variants b,i, "
+                    "options -Ab/-Ai, not with -y)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -3071,7 +3898,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: [A-Z]\[ACFINPRSTZ] */
+  /* free option characters: [A-Z]\[ACFINPRSTYZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse the arguments */
@@ -3100,6 +3927,8 @@ int main (int argc, char *argv[])
           case 'j': mode  &= ~ECL_REORDER;           break;
           case 'y': cmfilt = (int) strtol(s, &s, 0); break;
           case 'u': mode  &= ~ECL_TAIL;              break;
+          case 'Y': threads = (int)strtol(s, &s, 0); break;
+          case 'D': prep  |= ECL_COMPRESS;           break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
@@ -3204,7 +4033,7 @@ int main (int argc, char *argv[])
     mode |= ECL_TIDS;           /* turn "-" into "" for consistency */
   }                             /* set transaction identifier flag */
   mode = (mode & ~ECL_FIM16)    /* add packed items to search mode */
-       | ((pack <= 0) ? 0 : (pack < 16) ? pack : 16);
+       | ((pack <= 0) ? 0 : (pack < 31) ? pack : 31);
   if (target & ISR_RULES)       /* if to find association rules, */
     fn_psp = NULL;              /* no pattern spectrum possible */
   if (info == dflt) {           /* if default info. format is used, */
@@ -3260,7 +4089,7 @@ int main (int argc, char *argv[])
   eclat = eclat_create(target, smin, smax, conf, zmin, zmax,
                        eval, agg, thresh, algo, mode);
   if (!eclat) error(E_NOMEM);   /* create an eclat miner */
-  k = eclat_data(eclat, tabag, 0, sort);
+  k = eclat_data(eclat, tabag, prep, sort);
   if (k) error(k);              /* prepare data for eclat */
   report = isr_create(ibase);   /* create an item set reporter */
   if (!report) error(E_NOMEM);  /* and configure it */
@@ -3278,7 +4107,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)    /* open the item set file and */
     error(E_NOMEM);             /* set up the item set reporter */
-  k = eclat_mine(eclat, prune, 0);
+  k = eclat_mine(eclat, prune, 0, threads);
   if (k) error(k);              /* find frequent item sets */
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
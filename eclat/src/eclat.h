@@ -10,6 +10,8 @@
             2014.08.28 functions ecl_data() and ecl_report() added
             2016.11.10 eclat miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 parameter 'threads' added to eclat_mine()
+            2026.10.17 data preparation mode ECL_COMPRESS added
 ----------------------------------------------------------------------*/
 #ifndef __ECLAT__
 #define __ECLAT__
@@ -34,6 +36,7 @@
 #define ECL_NOSORT    0x0004    /* do not sort items and transactions */
 #define ECL_NOREDUCE  0x0008    /* do not reduce transactions */
 #define ECL_NOPACK    0x0010    /* do not pack most frequent items */
+#define ECL_COMPRESS  0x0020    /* compress the transaction bag */
 
 /* --- evaluation measures --- */
 /* most definitions in ruleval.h */
@@ -97,5 +100,6 @@ extern void   eclat_delete (ECLAT *eclat, int deldar);
 extern int    eclat_data   (ECLAT *eclat, TABAG *tabag,
                             int mode, int sort);
 extern int    eclat_report (ECLAT *eclat, ISREPORT *report);
-extern int    eclat_mine   (ECLAT *eclat, ITEM prune, int order);
+extern int    eclat_mine   (ECLAT *eclat, ITEM prune, int order,
+                            int threads);
 #endif
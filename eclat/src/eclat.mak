@@ -10,6 +10,7 @@
 #           2011.08.31 external module fim16 added (16 items machine)
 #           2014.08.21 extended by module istree from apriori source
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 external module tpool added (thread pool)
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\eclat\src
 UTILDIR  = ..\..\util\src
@@ -33,7 +34,7 @@ HDRS     = $(UTILDIR)\fntypes.h    $(UTILDIR)\arrays.h     \
            $(TRACTDIR)\tract.h     $(TRACTDIR)\patspec.h   \
            $(TRACTDIR)\clomax.h    $(TRACTDIR)\report.h    \
            $(TRACTDIR)\fim16.h     $(APRIDIR)\istree.h     \
-           eclat.h
+           $(UTILDIR)\tpool.h     eclat.h
 OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\memsys.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\escape.obj   \
            $(UTILDIR)\tabread.obj  $(UTILDIR)\tabwrite.obj \
@@ -42,7 +43,7 @@ OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\memsys.obj   \
            $(TRACTDIR)\taread.obj  $(TRACTDIR)\patspec.obj \
            $(TRACTDIR)\clomax.obj  $(TRACTDIR)\repcm.obj   \
            $(TRACTDIR)\fim16.obj   $(APRIDIR)\istree.obj   \
-           eclat.obj
+           $(UTILDIR)\tpool.obj   eclat.obj
 PRGS     = eclat.exe
 
 #-----------------------------------------------------------------------
@@ -90,6 +91,10 @@ $(UTILDIR)\scform.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak scform.obj   ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(UTILDIR)\tpool.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak tpool.obj    ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(MATHDIR)\ruleval.obj:
 	cd $(MATHDIR)
         $(MAKE) /f math.mak ruleval.obj  ADDFLAGS="$(ADDFLAGS)"
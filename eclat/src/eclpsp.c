@@ -0,0 +1,83 @@
+/*----------------------------------------------------------------------
+  File    : eclpsp.c
+  Contents: generate a pattern spectrum (Eclat)
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created (from fim4r.c)
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <assert.h>
+#ifndef TA_SURR
+#define TA_SURR
+#endif
+#include "tract.h"
+#ifndef ISR_PATSPEC
+#define ISR_PATSPEC
+#endif
+#include "patspec.h"
+#include "eclpsp.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- eclat miner parameters --- */
+  int       target;             /* target type (e.g. closed/maximal) */
+  double    supp;               /* minimum support of an item set */
+  ITEM      zmin;               /* minimum size of an item set */
+  ITEM      zmax;               /* maximum size of an item set */
+  int       algo;               /* eclat algorithm variant */
+  int       mode;               /* search mode (e.g. pruning) */
+} ECLMPAR;                      /* (eclat miner parameters) */
+
+/*----------------------------------------------------------------------
+  Eclat Miner Interface
+----------------------------------------------------------------------*/
+
+static void* ecl_mcreate (void *data)
+{                               /* --- create an eclat miner */
+  ECLMPAR *p = (ECLMPAR*)data;  /* type the parameter pointer */
+  return eclat_create(p->target, p->supp, 100.0, 100.0,
+                      p->zmin, p->zmax, RE_NONE, ECL_NONE, 0.0,
+                      p->algo, p->mode);
+}  /* ecl_mcreate() */
+
+/*--------------------------------------------------------------------*/
+
+static void ecl_mdelete (void *miner)
+{ eclat_delete((ECLAT*)miner, 0); }
+
+static int ecl_mdata (void *miner, TABAG *tabag, int mode, int sort)
+{ return eclat_data((ECLAT*)miner, tabag, mode, sort); }
+
+static int ecl_mreport (void *miner, ISREPORT *report)
+{ return eclat_report((ECLAT*)miner, report); }
+
+static int ecl_mmine (void *miner)
+{ return eclat_mine((ECLAT*)miner, ITEM_MIN, 0, 1); }
+
+/*----------------------------------------------------------------------
+  Pattern Spectrum Generation
+----------------------------------------------------------------------*/
+
+PATSPEC* ecl_genpsp (TABAG *tabag, int target, double supp,
+                     ITEM zmin, ITEM zmax, int algo, int mode,
+                     size_t cnt, int surr, long seed,
+                     int cpus, PRGREPFN *rep, void *data)
+{                               /* --- generate a pattern spectrum */
+  ECLMPAR  par;                 /* eclat miner parameters */
+  SURMINER miner;               /* eclat miner interface */
+
+  assert(tabag);                /* check the function arguments */
+  par.target = target; par.supp = supp;
+  par.zmin   = zmin;   par.zmax = zmax;
+  par.algo   = algo;   par.mode = mode;
+  miner.create = ecl_mcreate;   /* collect the miner parameters */
+  miner.delete = ecl_mdelete;   /* and set up the miner interface */
+  miner.data   = ecl_mdata;
+  miner.report = ecl_mreport;
+  miner.mine   = ecl_mmine;
+  miner.cdata  = &par;
+  return fpg_genpspx(tabag, &miner, cnt, surr, seed, cpus, rep, data);
+}  /* ecl_genpsp() */
@@ -0,0 +1,19 @@
+/*----------------------------------------------------------------------
+  File    : eclpsp.h
+  Contents: generate a pattern spectrum (Eclat)
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created (from fim4r.c)
+----------------------------------------------------------------------*/
+#ifndef __ECLPSP__
+#define __ECLPSP__
+#include "eclat.h"
+#include "fpgpsp.h"
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern PATSPEC* ecl_genpsp (TABAG *tabag, int target, double supp,
+                            ITEM zmin, ITEM zmax, int algo, int mode,
+                            size_t cnt, int surr, long seed,
+                            int cpus, PRGREPFN *rep, void *data);
+#endif
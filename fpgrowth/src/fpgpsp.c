@@ -4,6 +4,14 @@
   Author  : Christian Borgelt
   History : 2015.08.28 file created
             2016.11.20 fpgrowth miner object and interface introduced
+            2026.10.16 adapted to modified function fpg_mine()
+            2026.10.17 surrogates distributed dynamically (thread pool)
+            2026.10.17 miner interface added (function fpg_genpspx())
+            2026.10.17 parameter 'cpus' added to function fpg_estpsp()
+            2026.10.17 workers update one shared pattern spectrum
+            2026.10.17 one counter-based random stream per surrogate
+            2026.10.17 up to 31 items packed (k-items machine)
+            2026.10.17 algorithm variant 'r' (array-based tree) added
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,16 +21,11 @@
 #include <float.h>
 #include <time.h>
 #include <assert.h>
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#include <pthread.h>
-#endif
 #ifdef FPG_ABORT
 #include "sigint.h"
 #endif
 #include "random.h"
+#include "tpool.h"
 #ifndef TA_SURR
 #define TA_SURR
 #endif
@@ -61,16 +64,7 @@
 #define VERSION     "version 1.2 (2016.11.21)         " \
                     "(c) 2015-2016   Christian Borgelt"
 
-/* --- thread definitions --- */
-#ifdef _WIN32                   /* if Microsoft Windows system */
-#define THREAD       HANDLE     /* threads identified by handles */
-#define THREAD_OK    0          /* return value is DWORD */
-#define WORKERDEF(n,p)  DWORD WINAPI n (LPVOID p)
-#else                           /* if Linux/Unix system */
-#define THREAD       pthread_t  /* use the POSIX thread type */
-#define THREAD_OK    NULL       /* return value is void* */
-#define WORKERDEF(n,p)  void*        n (void* p)
-#endif                          /* definition of a worker function */
+#define CONCMAX     (1 << 24)   /* max. counters of shared spectrum */
 
 /* --- error codes --- */
 /* error codes   0 to  -4 defined in tract.h */
@@ -133,20 +127,33 @@ static const char *errmsgs[] = {
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
-typedef struct {                /* --- thread worker data --- */
-  int       id;                 /* id of corresponding thread */
-  FPGROWTH  *fpgrowth;          /* fpgrowth miner */
-  TABAG     *tabag;             /* transaction bag to analyze */
+typedef struct {                /* --- fpgrowth miner parameters --- */
+  int       target;             /* target type (e.g. closed/maximal) */
+  double    supp;               /* minimum support of an item set */
+  ITEM      zmin;               /* minimum size of an item set */
+  ITEM      zmax;               /* maximum size of an item set */
+  int       algo;               /* fpgrowth algorithm variant */
+  int       mode;               /* search mode (e.g. pruning) */
+} FPGPAR;                       /* (fpgrowth miner parameters) */
+
+typedef struct {                /* --- surrogate worker --- */
+  void      *miner;             /* miner for surrogate data sets */
   TABAG     *tasur;             /* buffer for surrogate data set */
-  TBGSURRFN *surrfn;            /* surrogate data generator function */
-  long      cnt;                /* number of surrogate data sets */
   RNG       *rng;               /* random number generator */
-  ISREPORT  *report;            /* item set reporter (one per thread) */
-  int       err;                /* error indicator */
-  volatile long *done;          /* number of completed data sets */
+  ISREPORT  *report;            /* item set reporter */
+  volatile long cnt;            /* number of completed data sets */
+} SURWRK;                       /* (surrogate worker) */
+
+typedef struct {                /* --- surrogate generation data --- */
+  SURMINER  *miner;             /* miner interface */
+  TABAG     *tabag;             /* transaction bag to analyze */
+  TBGSURRFN *surrfn;            /* surrogate data generator function */
+  unsigned int seed;            /* seed for random number generator */
+  int       cnt;                /* number of workers */
+  SURWRK    *wrks;              /* surrogate workers */
   PRGREPFN  *repfn;             /* progress reporting function */
   void      *data;              /* progress reporting function data */
-} WORKDATA;                     /* (thread worker data) */
+} SURDATA;                      /* (surrogate generation data) */
 
 /*----------------------------------------------------------------------
   Global Variables
@@ -174,205 +181,216 @@ static RSUPP    *border = NULL; /* decision border */
 #endif
 
 /*----------------------------------------------------------------------
-  CPUinfo Function
+  FP-growth Miner Interface
 ----------------------------------------------------------------------*/
 
-static int cpucnt (void)
-{                               /* --- get the number of processors */
-  #ifdef _WIN32                 /* if Microsoft Windows system */
-  SYSTEM_INFO sysinfo;          /* system information structure */
-  GetSystemInfo(&sysinfo);      /* get system information */
-  return (int)sysinfo.dwNumberOfProcessors;
-  #elif defined _SC_NPROCESSORS_ONLN
-  return (int)sysconf(_SC_NPROCESSORS_ONLN);
-  #else                         /* if no direct function available */
-  static int cpuinfo[5] = { 0, 0, 0, 0, 0 };
-  if (!cpuinfo[4]) {            /* if cpu info. not yet retrieved */
-    __asm__ __volatile__ (      /* execute cpuid instruction */
-      "cpuid": "=a" (cpuinfo[0]), "=b" (cpuinfo[1]),
-               "=c" (cpuinfo[2]), "=d" (cpuinfo[3]) : "a" (1) );
-    cpuinfo[4] = -1;            /* execute cpuid instruction */
-  }                             /* and set initialization flag */
-  return (cpuinfo[1] >> 16) & 0xff;  /* get the number of */
-  #endif                        /* addressable processors */
-}  /* cpucnt() */
+static void* fpg_mcreate (void *data)
+{                               /* --- create an fpgrowth miner */
+  FPGPAR *p = (FPGPAR*)data;    /* type the parameter pointer */
+  return fpg_create(p->target, p->supp, 100.0, 100.0, p->zmin, p->zmax,
+                    RE_NONE, FPG_NONE, 0.0, p->algo, p->mode);
+}  /* fpg_mcreate() */
+
+/*--------------------------------------------------------------------*/
+
+static void fpg_mdelete (void *miner)
+{ fpg_delete((FPGROWTH*)miner, 0); }
+
+static int fpg_mdata (void *miner, TABAG *tabag, int mode, int sort)
+{ return fpg_data((FPGROWTH*)miner, tabag, mode, sort); }
+
+static int fpg_mreport (void *miner, ISREPORT *report)
+{ return fpg_report((FPGROWTH*)miner, report); }
+
+static int fpg_mmine (void *miner)
+{ return fpg_mine((FPGROWTH*)miner, ITEM_MIN, 0, 1); }
 
 /*----------------------------------------------------------------------
   Pattern Spectrum Generation
 ----------------------------------------------------------------------*/
 
-static WORKERDEF(worker, p)
-{                               /* --- worker function for a thread */
-  WORKDATA *w = p;              /* type the argument pointer */
-  long     i;                   /* loop variable for data sets */
-
-  assert(p);                    /* check the function argument */
-  for (i = 1; i <= w->cnt; i++){/* generate cnt surrogate data sets */
-    w->tasur = w->surrfn(w->tabag, w->rng, w->tasur);
-    #ifdef FPG_ABORT            /* if a signal handler is present */
-    if (sig_aborted()) break;   /* check for an abort interrupt */
-    #endif
-    w->err |= fpg_data(w->fpgrowth, w->tasur, FPG_SURR, 0);
-    if (w->err < 0)    break;   /* prepare the transactions */
-    #ifdef FPG_ABORT            /* if a signal handler is present */
-    if (sig_aborted()) break;   /* check for an abort interrupt */
-    #endif
-    w->err |= fpg_mine(w->fpgrowth, ITEM_MIN, 0);
-    if (w->err < 0)    break;   /* execute the fpgrowth algorithm */
-    #ifdef FPG_ABORT            /* if a signal handler is present */
-    if (sig_aborted()) break;   /* check for an abort interrupt */
-    #endif
-    w->done[0]++;               /* count the surrogate data set */
-    if (w->repfn) w->repfn(w->done[0], w->data);
-  }                             /* report the progress */
-  return THREAD_OK;             /* return a dummy result */
-}  /* worker() */
+static int gensur (void *data, int thread, long task)
+{                               /* --- mine one surrogate data set */
+  SURDATA *sd = (SURDATA*)data; /* type the data pointer */
+  SURWRK  *w;                   /* surrogate worker of the thread */
+  TABAG   *s;                   /* generated surrogate data set */
+  long    i, n;                 /* loop variable, number of data sets */
+  int     r;                    /* result of function call */
+
+  w = sd->wrks +thread;         /* get the worker of the thread */
+  rng_stream(w->rng, sd->seed, (size_t)task);
+  s = sd->surrfn(sd->tabag, w->rng, NULL);
+  if (!s) return -1;            /* generate a surrogate data set */
+  tbg_delete(w->tasur, 0);      /* from its own random stream */
+  w->tasur = s;                 /* and replace the previous one */
+  #ifdef FPG_ABORT              /* if a signal handler is present */
+  if (sig_aborted()) return -1; /* check for an abort interrupt */
+  #endif
+  r = sd->miner->data(w->miner, s, FPG_SURR, 0);
+  if (r < 0) return r;          /* prepare the transactions */
+  r = sd->miner->mine(w->miner);
+  if (r < 0) return r;          /* mine the surrogate data set */
+  #ifdef FPG_ABORT              /* if a signal handler is present */
+  if (sig_aborted()) return -1; /* check for an abort interrupt */
+  #endif
+  w->cnt += 1;                  /* count the surrogate data set */
+  if (sd->repfn && (thread == 0)) {
+    for (n = i = 0; i < sd->cnt; i++)
+      n += sd->wrks[i].cnt;     /* sum the completed data sets */
+    sd->repfn(n, sd->data);     /* of all workers and report */
+  }                             /* the progress (only one thread) */
+  return 0;                     /* return 'ok' */
+}  /* gensur() */
+
+/* Each surrogate data set is generated from the original data with */
+/* the counter-based random number stream that is selected by the   */
+/* seed and the index of the data set (rather than by continuing the*/
+/* stream of the previous surrogate of the same thread). Hence the  */
+/* pattern spectrum depends neither on the number of threads nor on */
+/* which thread mines which data set (nor on the platform), and the */
+/* thread pool can hand out the data sets dynamically.              */
 
 /*--------------------------------------------------------------------*/
 
-PATSPEC* fpg_genpsp (TABAG *tabag, int target, double supp,
-                     ITEM zmin, ITEM zmax, int algo, int mode,
-                     size_t cnt, int surr, long seed,
-                     int cpus, PRGREPFN *rep, void* data)
-{                               /* --- generate a pattern spectrum */
-  PATSPEC   *psp = NULL;        /* created pattern spectrum */
-  int       r;                  /* result of function call */
-  TABAG     *tasur, *s;         /* surrogate data set */
-  TBGSURRFN *surrfn;            /* surrogate data generation function */
-  RNG       *rng;               /* random number generator */
-  ISREPORT  *report;            /* item set reporter */
-  FPGROWTH  *fpgrowth;          /* fpgrowth miner */
-  THREAD    *threads;           /* thread handles */
-  WORKDATA  *w;                 /* data for worker thread */
-  long      c, x;               /* number of data sets per thread */
-  long      i;                  /* loop variable for data sets */
-  int       k, n;               /* loop variables for threads */
-  #ifdef _WIN32                 /* if Microsoft Windows system */
-  DWORD     thid;               /* dummy for storing the thread id */
-  #endif                        /* (not really needed here) */
-  volatile long done = 0;       /* number of completed surrogates */
+static PATSPEC* sharedpsp (ISREPORT *rep, TABAG *tabag)
+{                               /* --- create a shared spectrum */
+  PATSPEC *psp;                 /* created pattern spectrum */
+  ITEM    zmin, zmax;           /* range of pattern sizes */
+  RSUPP   smin, smax;           /* range of pattern supports */
+
+  assert(rep && tabag);         /* check the function arguments */
+  zmin = isr_zmin(rep); zmax = isr_zmax(rep);
+  if (zmax > tbg_max(tabag)) zmax = tbg_max(tabag);
+  smin = isr_smin(rep); smax = isr_smax(rep);
+  if (smax > (RSUPP)tbg_wgt(tabag)) smax = (RSUPP)tbg_wgt(tabag);
+  if ((zmax < zmin) || (smax < smin)
+  ||  ((double)(zmax-zmin+1) *(double)(smax-smin+1) > CONCMAX))
+    return NULL;                /* check the size of the spectrum */
+  psp = psp_create(zmin, zmax, smin, smax);
+  if (!psp) return NULL;        /* create a pattern spectrum */
+  if (psp_concur(psp, 1) == 0)  /* and allocate all counters */
+    return psp;                 /* for concurrent updates */
+  psp_delete(psp); return NULL; /* on failure delete the spectrum */
+}  /* sharedpsp() */
 
-  assert(tabag                  /* check the function arguments */
-  &&    (algo >= FPG_SIMPLE) && (algo <= FPG_TOPDOWN));
+/* All surrogate data sets have the same transaction sizes and the  */
+/* same total weight as the original data, which therefore bound    */
+/* the sizes and supports of the found patterns. If the resulting   */
+/* dense counter table is too large (or cannot be allocated), the   */
+/* workers count into their own (sparse) spectra, which are summed. */
+
+/*--------------------------------------------------------------------*/
+
+PATSPEC* fpg_genpspx (TABAG *tabag, SURMINER *miner,
+                      size_t cnt, int surr, long seed,
+                      int cpus, PRGREPFN *rep, void *data)
+{                               /* --- generate a pattern spectrum */
+  PATSPEC *psp = NULL;          /* created pattern spectrum */
+  SURDATA sd;                   /* surrogate generation data */
+  SURWRK  *w;                   /* to traverse the workers */
+  void    *m;                   /* miner for the original data */
+  int     r;                    /* result of function call */
+  int     i;                    /* loop variable for workers */
+  int     shared = 0;           /* whether spectrum is shared */
+
+  assert(tabag && miner         /* check the function arguments */
+  &&    (surr >= FPG_IDENTITY) && (surr <= FPG_SHUFFLE));
   if (seed == 0) seed = (long)time(NULL);
 
   /* --- prepare data --- */
-  fpgrowth = fpg_create(target, supp, 100.0, 100.0, zmin, zmax,
-                        RE_NONE, FPG_NONE, 0.0, algo, mode);
-  if (!fpgrowth) return NULL;   /* create an fpgrowth miner */
+  m = miner->create(miner->cdata);
+  if (!m) return NULL;          /* create a miner */
   r = (surr == FPG_SHUFFLE) ? FPG_NORECODE|FPG_NOSORT : 0;
-  r = fpg_data(fpgrowth, tabag, r|FPG_NOPACK, +2);  /* prepare the */
-  if (r) { fpg_delete(fpgrowth, 0); return NULL; }  /* transactions */
+  r = miner->data(m, tabag, r|FPG_NOPACK, +2);
+  if (r) { miner->delete(m); return NULL; }
+
+  /* --- create workers --- */
+  if (cpus <= 0) cpus = tp_cpucnt();
+  if (cpus <= 0) cpus = 1;      /* get the number of threads */
+  if ((size_t)cpus > cnt) cpus = (cnt > 0) ? (int)cnt : 1;
+  sd.miner  = miner;            /* note the miner interface, */
+  sd.tabag  = tabag;            /* the transaction bag and */
+  sd.surrfn = sur_tab[surr];    /* the surrogate data function */
+  sd.seed   = (unsigned int)seed;
+  sd.repfn  = rep; sd.data = data;
+  sd.cnt    = cpus;             /* create the workers */
+  sd.wrks   = (SURWRK*)calloc((size_t)cpus, sizeof(SURWRK));
+  if (!sd.wrks) { miner->delete(m); return NULL; }
+  for (r = i = 0; i < cpus; i++) {
+    w = sd.wrks +i;             /* traverse the workers */
+    w->miner  = (i > 0) ? miner->create(miner->cdata) : m;
+    w->tasur  = tbg_clone(tabag);
+    w->rng    = rng_create((unsigned int)seed);
+    w->report = isr_create(tbg_base(tabag));
+    if (!w->miner || !w->tasur || !w->rng || !w->report) {
+      r = -1; break; }          /* check for successful creation */
+    if ((miner->data  (w->miner, w->tasur,
+                       FPG_NORECODE|FPG_NOREDUCE, 0) != 0)
+    ||  (miner->report(w->miner, w->report) != 0)) {
+      r = -1; break; }          /* set up the item set reporter */
+    if ((i <= 0) && (cpus > 1)) /* try to create a spectrum */
+      shared = ((psp = sharedpsp(w->report, tabag)) != NULL);
+    if ((isr_addpsp(w->report, psp) < 0)
+    ||  (isr_setup (w->report) != 0)) {
+      r = -1; break; }          /* add the (shared) pattern spectrum */
+  }                             /* (one reporter per worker) */
 
   /* --- generate pattern spectrum --- */
-  if (cpus <= 0) cpus = cpucnt();
-  if ((cpus > 1) && (cnt > 1)){ /* if to use multi-threading */
-    threads = calloc((size_t)cpus, sizeof(THREAD));
-    if (!threads) return NULL;  /* create array of thread handles */
-    w = calloc((size_t)cpus, sizeof(WORKDATA));
-    if (!w) { free(threads); return NULL; }
-    c = ((long)cnt+cpus-1)/cpus;/* number of data sets per thread */
-    for (n = 0; n < cpus; n++){ /* traverse the cpus/threads */
-      x = (long)cnt -n*c;       /* get the number of data sets and */
-      if (x <= 0) break;        /* check whether thread is needed */
-      if (!fpgrowth) {          /* if no miner for this thread */
-        fpgrowth = fpg_create(target, supp, 100.0, 100.0, zmin, zmax,
-                              RE_NONE, FPG_NONE, 0.0, algo, mode);
-      }                         /* create an fpgrowth miner */
-      w[n].id       = n;        /* note the thread identifier */
-      w[n].fpgrowth = fpgrowth; /* create an fpgrowth miner and */
-      w[n].tabag    = tabag;    /* note transactions and a clone */
-      w[n].tasur    = tbg_clone(tabag);
-      w[n].surrfn   = sur_tab[surr];
-      w[n].cnt      = (x < c) ? x : c;
-      w[n].rng      = rng_create((unsigned int)(seed+n));
-      w[n].report   = isr_create(tbg_base(tabag));
-      w[n].err      = 0;        /* create random number generator */
-      w[n].done     = &done;    /* and an item set reporter */
-      w[n].repfn    = rep;
-      w[n].data     = data;
-      if (!w[n].fpgrowth || !w[n].tasur || !w[n].rng || !w[n].report) {
-        w[n].err = -1; break; } /* check for successful creation */
-      if ((fpg_data  (w[n].fpgrowth, w[n].tasur,
-                      FPG_NORECODE|FPG_NOREDUCE, 0) != 0)
-      ||  (fpg_report(w[n].fpgrowth, w[n].report) != 0)
-      ||  (isr_addpsp(w[n].report, NULL) < 0)
-      ||  (isr_setup (w[n].report) != 0)) {
-        w[n].err = -1; break; } /* set up the item set reporter */
-      #ifdef _WIN32             /* if Microsoft Windows system */
-      threads[n] = CreateThread(NULL, 0, worker, w+n, 0, &thid);
-      if (!threads[n]) { w[n].err = -1; break; }
-      #else                     /* if Linux/Unix system */
-      if (pthread_create(threads+n, NULL, worker, w+n) != 0) {
-        w[n].err = -1; break; } /* create a thread for each data set */
-      #endif                    /* to compute surrogates in parallel */
-      fpgrowth = NULL;          /* fpgrowth miner has been used */
-    }
-    #ifdef _WIN32               /* if Microsoft Windows system */
-    WaitForMultipleObjects((DWORD)n, threads, TRUE, INFINITE);
-    for (k = n; --k >= 0; )     /* wait for threads to finish, */
-      CloseHandle(threads[k]);  /* then close all thread handles */
-    #else                       /* if Linux/Unix system */
-    for (k = n; --k >= 0; )     /* wait for threads to finish */
-      pthread_join(threads[k], NULL);
-    #endif                      /* (join threads with this one) */
-    for (k = r = 0; k < n; k++)
-      r |= w[k].err;            /* join the error indicators */
-    if (r >= 0) {               /* if processing was successful */
-      psp = isr_rempsp(w[0].report, 0);
-      for (k = 1; k < n; k++) { /* traverse the threads */
-        r = psp_addpsp(psp, isr_getpsp(w[k].report));
-        if (r < 0) break;       /* traverse and sum pattern spectrums */
-      }                         /* in the one of the first thread */
-    }
-    for (k = n; --k >= 0; ) {   /* traverse the worker data */
-      if (w[k].fpgrowth) fpg_delete(w[k].fpgrowth, 0);
-      if (w[k].tasur)    tbg_delete(w[k].tasur, 0);
-      if (w[k].rng)      rng_delete(w[k].rng);
-      if (w[k].report)   isr_delete(w[k].report, 0);
-    }                           /* delete the data structures */
-    free(w);                    /* delete array of worker data */
-    free(threads); }            /* and array of thread handles */
-  else {                        /* if to use only one thread */
-    report = isr_create(tbg_base(tabag));
-    if (!report) return NULL;   /* create an item set reporter */
-    if ((fpg_report(fpgrowth, report) < 0)
-    ||  (isr_addpsp(report, NULL)     < 0)
-    ||  (isr_setup (report) != 0)) {
-      isr_delete(report, 0); fpg_delete(fpgrowth, 0); return NULL; }
-    rng = rng_create((unsigned int)seed);
-    if (!rng) {                 /* create a random number generator */
-      isr_delete(report, 0); return NULL; }
-    surrfn = sur_tab[surr];     /* get the surrogate data function */
-    tasur  = NULL; r = 0;       /* init. surrogate and return code */
-    for (i = 1; i <= (long)cnt; i++) {
-      s = surrfn(tabag, rng, tasur);
-      if (!s) { r = -1; break;} /* generate a surrogate data set */
-      r = fpg_data(fpgrowth, tasur = s, FPG_SURR, 0);
-      if (r < 0) break;         /* prepare the data set */
-      r = fpg_mine(fpgrowth, 0, 0);
-      if (r < 0) break;         /* execute the FP-growth algorithm */
-      if (rep) rep(i, data);    /* report the progress and */
-      #ifdef CCN_ABORT          /* if a signal handler is present */
-      if (sig_aborted()) break; /* check for an interrupt */
-      #endif
-    }
-    psp = isr_rempsp(report,0); /* get the created pattern spectrum */
-    if (tasur) tbg_delete(tasur, 0);
-    fpg_delete(fpgrowth, 0);    /* delete the data objects */
-    rng_delete(rng);            /* (fpgrowth miner, */
-    isr_delete(report, 0);      /* random number generator, */
-  }                             /* and item set reporter) */
+  if (r >= 0)                   /* mine the surrogate data sets */
+    r = tp_exec(cpus, (long)cnt, gensur, &sd);
+  if (shared)                   /* if the spectrum is shared, */
+    psp_concur(psp, 0);         /* end the concurrent updates */
+  else if (r >= 0) {            /* if processing was successful */
+    psp = isr_rempsp(sd.wrks[0].report, 0);
+    for (i = 1; i < cpus; i++){ /* traverse the other workers */
+      r = psp_addpsp(psp, isr_getpsp(sd.wrks[i].report));
+      if (r < 0) break;         /* sum the pattern spectra */
+    }                           /* in the one of the first worker */
+  }
+  for (i = cpus; --i >= 0; ) {  /* traverse the workers */
+    w = sd.wrks +i;             /* and delete their data */
+    if (w->report && shared) isr_rempsp(w->report, 0);
+    if (w->report) isr_delete(w->report, 0);
+    if (w->rng)    rng_delete(w->rng);
+    if (w->tasur)  tbg_delete(w->tasur, 0);
+    if (w->miner)  miner->delete(w->miner);
+  }                             /* (the first worker holds the miner */
+  free(sd.wrks);                /* for the original data) */
 
   /* --- clean up --- */
   #ifdef FPG_ABORT              /* if a signal handler is present */
-  if (sig_aborted()) { sig_remove(); return NULL; }
+  if (sig_aborted()) { sig_remove(); if (psp) psp_delete(psp);
+                       return NULL; }
   #endif
   if (r < 0) { if (psp) psp_delete(psp); return NULL; }
   #ifdef FPG_ABORT              /* if a signal handler is present */
   sig_remove();                 /* remove the signal handler */
   #endif
-  return psp;                   /* return the created Java object */
+  return psp;                   /* return the pattern spectrum */
+}  /* fpg_genpspx() */
+
+/*--------------------------------------------------------------------*/
+
+PATSPEC* fpg_genpsp (TABAG *tabag, int target, double supp,
+                     ITEM zmin, ITEM zmax, int algo, int mode,
+                     size_t cnt, int surr, long seed,
+                     int cpus, PRGREPFN *rep, void* data)
+{                               /* --- generate a pattern spectrum */
+  FPGPAR   par;                 /* fpgrowth miner parameters */
+  SURMINER miner;               /* fpgrowth miner interface */
+
+  assert(tabag                  /* check the function arguments */
+  &&    (algo >= FPG_SIMPLE) && (algo <= FPG_ARRAY));
+  par.target = target; par.supp = supp;
+  par.zmin   = zmin;   par.zmax = zmax;
+  par.algo   = algo;   par.mode = mode;
+  miner.create = fpg_mcreate;   /* collect the miner parameters */
+  miner.delete = fpg_mdelete;   /* and set up the miner interface */
+  miner.data   = fpg_mdata;
+  miner.report = fpg_mreport;
+  miner.mine   = fpg_mmine;
+  miner.cdata  = &par;
+  return fpg_genpspx(tabag, &miner, cnt, surr, seed, cpus, rep, data);
 }  /* fpg_genpsp() */
 
 /*----------------------------------------------------------------------
@@ -381,7 +399,8 @@ PATSPEC* fpg_genpsp (TABAG *tabag, int target, double supp,
 
 PATSPEC* fpg_estpsp (TABAG *tabag, int target, double supp,
                      ITEM zmin, ITEM zmax, size_t equiv,
-                     double alpha, size_t smpls, long seed)
+                     double alpha, size_t smpls, long seed,
+                     int cpus)
 {                               /* --- estimate a pattern spectrum */
   PATSPEC  *psp;                /* created pattern spectrum */
   FPGROWTH *fpgrowth;           /* fpgrowth miner */
@@ -389,7 +408,6 @@ PATSPEC* fpg_estpsp (TABAG *tabag, int target, double supp,
 
   assert(tabag);                /* check the function arguments */
   if (seed <= 0) seed = (long)time(NULL);
-  rseed((unsigned)seed);        /* seed random number generator */
   fpgrowth = fpg_create(target, supp, 100.0, 100.0, zmin, zmax,
                         RE_NONE, FPG_NONE, 0.0, FPG_AUTO, FPG_DEFAULT);
   if (!fpgrowth) return NULL;   /* create an fpgrowth miner */
@@ -400,7 +418,8 @@ PATSPEC* fpg_estpsp (TABAG *tabag, int target, double supp,
        : (supp/100.0) *(double)tbg_wgt(tabag) *(1-DBL_EPSILON);
   psp = psp_create(zmin, zmax, (SUPP)ceilsupp(supp), tbg_cnt(tabag));
   if (!psp) return NULL;        /* create a pattern spectrum */
-  if (psp_tbgest(tabag, psp, (size_t)equiv, alpha, (size_t)smpls) == 0)
+  if (psp_tbgest(tabag, psp, (size_t)equiv, alpha, (size_t)smpls,
+                 (unsigned int)seed, cpus) == 0)
     return psp;                 /* estimate pattern spectrum */
   psp_delete(psp); return NULL; /* on failure delete pattern spectrum */
 }  /* fpg_estpsp() */
@@ -420,11 +439,13 @@ static void help (void)
                "(default)\n");
   printf("  d   top-down processing on a single prefix tree\n");
   printf("  t   top-down processing of the prefix trees\n");
+  printf("  r   simple tree nodes stored in arrays by item\n");
   printf("Variant 'd' does not support mining closed/maximal item ");
-  printf("sets,\nvariant 't' does not support the use of a k-items ");
-  printf("machine, and\nonly variant 'c' supports item reordering ");
-  printf("w.r.t. conditional support,\nbut closed/maximal item sets ");
-  printf("can only be mined without reordering.\nThese restrictions ");
+  printf("sets,\nvariants 't' and 'r' do not support the use of a ");
+  printf("k-items machine, and\nonly variant 'c' supports item ");
+  printf("reordering w.r.t. conditional support,\nbut closed/maximal ");
+  printf("item sets can only be mined without reordering.\n");
+  printf("These restrictions ");
   printf("may be removed in future versions of this program.\n");
   printf("surrogate data generation methods "
          "(option -g#, default: -ge)\n");
@@ -628,10 +649,11 @@ int main (int argc, char *argv[])
     case 'c': algo = FPG_COMPLEX;            break;
     case 'd': algo = FPG_SINGLE;             break;
     case 't': algo = FPG_TOPDOWN;            break;
+    case 'r': algo = FPG_ARRAY;              break;
     default : error(E_VARIANT, (char)algo);  break;
   }                             /* (get fpgrowth algorithm code) */
   mode = (mode & ~FPG_FIM16)    /* add packed items to search mode */
-       | ((pack <= 0) ? 0 : (pack < 16) ? pack : 16);
+       | ((pack <= 0) ? 0 : (pack < 31) ? pack : 31);
   switch (surr) {               /* check and translate surrogate */
     case 'e': surr = -1;                     break;
     case 'i': surr = FPG_IDENTITY;           break;
@@ -691,7 +713,7 @@ int main (int argc, char *argv[])
   if (surr < 0) {               /* if to estimate a pattern spectrum */
     MSG(stderr, "estimating pattern spectrum ... ");
     psp = fpg_estpsp(tabag, target, supp, zmin, zmax,
-                     (size_t)cnt, alpha, (size_t)smpls, seed); }
+                     (size_t)cnt, alpha, (size_t)smpls, seed, cpus); }
   else {                        /* if to generate a pattern spectrum */
     MSG(stderr, "generating pattern spectrum ... ");
     psp = fpg_genpsp(tabag, target, supp, zmin, zmax,
@@ -3,6 +3,7 @@
   Contents: generate or estimate a pattern spectrum (FP-growth)
   Author  : Christian Borgelt
   History : 2015.08.28 file created
+            2026.10.17 miner interface and function fpg_genpspx() added
 ----------------------------------------------------------------------*/
 #ifndef __FPGPSP__
 #define __FPGPSP__
@@ -23,6 +24,22 @@
 typedef void PRGREPFN (long cnt, void *data);
                                 /* progress reporting function */
 
+typedef void* SURCREATEFN (void *data);
+typedef void  SURDELFN    (void *miner);
+typedef int   SURDATAFN   (void *miner, TABAG *tabag,
+                           int mode, int sort);
+typedef int   SURREPFN    (void *miner, ISREPORT *report);
+typedef int   SURMINEFN   (void *miner);
+
+typedef struct {                /* --- miner for surrogate data --- */
+  SURCREATEFN *create;          /* create a miner (from cdata) */
+  SURDELFN    *delete;          /* delete a miner */
+  SURDATAFN   *data;            /* prepare a data set (FPG_NO* modes) */
+  SURREPFN    *report;          /* set the item set reporter */
+  SURMINEFN   *mine;            /* mine the prepared data set */
+  void        *cdata;           /* data for the create function */
+} SURMINER;                     /* (miner for surrogate data) */
+
 /*----------------------------------------------------------------------
   Functions
 ----------------------------------------------------------------------*/
@@ -30,8 +47,12 @@ extern PATSPEC* fpg_genpsp (TABAG *tabag, int target, double supp,
                             ITEM zmin, ITEM zmax, int algo, int mode,
                             size_t cnt, int surr, long seed,
                             int cpus, PRGREPFN *rep, void* data);
+extern PATSPEC* fpg_genpspx(TABAG *tabag, SURMINER *miner,
+                            size_t cnt, int surr, long seed,
+                            int cpus, PRGREPFN *rep, void *data);
 
 extern PATSPEC* fpg_estpsp (TABAG *tabag, int target, double supp,
                             ITEM zmin, ITEM zmax, size_t equiv,
-                            double alpha, size_t smpls, long seed);
+                            double alpha, size_t smpls, long seed,
+                            int cpus);
 #endif
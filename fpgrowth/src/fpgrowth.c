@@ -66,6 +66,13 @@
             2016.09.26 head union tail (HUT) pruning fixed (bug, fim16)
             2016.11.20 fpgrowth miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 multi-threaded search added (option -Y#)
+            2026.10.17 item sets of threads output in serial order
+            2026.10.17 top-level tasks scheduled by item support
+            2026.10.17 up to 31 items packed, number chosen adaptively
+            2026.10.17 transactions stored contiguously in fpg_data()
+            2026.10.17 optional compression of the transaction bag (-D)
+            2026.10.17 variant with array-based tree (nodes by item)
 ------------------------------------------------------------------------
   Reference for the FP-growth algorithm:
     J. Han, H. Pei, and Y. Yin.
@@ -109,6 +116,7 @@
 #endif
 #include "fpgrowth.h"
 #include "fim16.h"
+#include "tpool.h"
 #ifdef FPG_MAIN
 #include "error.h"
 #endif
@@ -215,6 +223,32 @@ typedef struct {                /* --- top-down freq. pat. tree --- */
   ITEM     items[1];            /* item identifier map */
 } TDTREE;                       /* (top-down tree) */
 
+typedef int AFREF;              /* index of a node in an array tree */
+
+typedef struct {                /* --- array-based tree node --- */
+  ITEM     id;                  /* item/head identifier */
+  AFREF    parent;              /* index of parent node (-1: root) */
+  SUPP     supp;                /* support (weight of transactions) */
+} AFNODE;                       /* (array-based tree node) */
+
+typedef struct {                /* --- array-based tree head --- */
+  ITEM     item;                /* associated item (item base code) */
+  SUPP     supp;                /* support (weight of transactions) */
+  AFREF    beg;                 /* index of first node with the item */
+  AFREF    cnt;                 /* number of nodes with the item */
+  AFREF    last;                /* last node created for the item */
+  AFREF    par;                 /* parent of the last created node */
+} AFHEAD;                       /* (array-based tree head) */
+
+typedef struct {                /* --- array-based fp-tree --- */
+  ITEM     cnt;                 /* number of items / heads */
+  int      dir;                 /* processing direction */
+  AFREF    size;                /* number of nodes of the tree */
+  AFREF    max;                 /* size of the node array */
+  AFNODE   *nodes;              /* tree nodes (grouped by item) */
+  AFHEAD   heads[1];            /* header table (node ranges) */
+} AFTREE;                       /* (array-based tree) */
+
 struct _fpgrowth {              /* --- fpgrowth miner --- */
   int      target;              /* target type (e.g. closed/maximal) */
   double   smin;                /* minimum support of an item set */
@@ -229,6 +263,7 @@ struct _fpgrowth {              /* --- fpgrowth miner --- */
   double   thresh;              /* threshold for evaluation measure */
   int      algo;                /* variant of fpgrowth algorithm */
   int      mode;                /* search mode (e.g. pruning) */
+  int      threads;             /* number of threads (top level) */
   TABAG    *tabag;              /* transaction bag/multiset */
   ISREPORT *report;             /* item set reporter */
   int      dir;                 /* direction for item loops */
@@ -244,6 +279,19 @@ struct _fpgrowth {              /* --- fpgrowth miner --- */
 
 typedef int FPGFN (FPGROWTH *fpg);
 
+typedef struct {                /* --- parallel search (top level) --- */
+  FPGROWTH *fpg;                /* fpgrowth miner of calling thread */
+  FPGROWTH *thds;               /* copies of the miner for threads */
+  double   *wgts;               /* task size hints (item supports) */
+  void     **projs;             /* projection buffers of the threads */
+  MEMSYS   **mems;              /* memory systems of the threads */
+  ISREPORT **reps;              /* reporter clones (for merging) */
+  int      cnt;                 /* number of worker threads */
+  void     *tree;               /* top-level frequent pattern tree */
+  ITEM     beg, end;            /* range of top-level item indices */
+  ITEM     mask;                /* mask for packed items to keep */
+} FPGPAR;                       /* (parallel search) */
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -386,6 +434,106 @@ static void tdt_show (TDTREE *tree, ITEMBASE *base, int ind)
 }  /* tdt_show() */
 
 #endif  /* #ifndef NDEBUG */
+/*----------------------------------------------------------------------
+  Auxiliary Functions for Multi-threaded Search
+----------------------------------------------------------------------*/
+
+static int par_exit (FPGPAR *par, int r)
+{                               /* --- finish a parallel search */
+  int      i, k;                /* loop variable for threads */
+  FPGROWTH *f;                  /* to traverse the miner copies */
+
+  assert(par);                  /* check the function argument */
+  for (i = k = 0; i < par->cnt; i++)
+    if (par->thds[i].report) par->reps[k++] = par->thds[i].report;
+  if ((r >= 0) && (isr_mergex(par->fpg->report, par->reps, k) < 0))
+    r = -1;                     /* merge the item set reporters */
+  for (i = 0; i < par->cnt; i++) {  /* (output the recorded sets) */
+    f = par->thds +i;           /* traverse the miner copies */
+    if (f->report) isr_delete(f->report, 0);
+    #ifdef VISITED              /* if to report visited search nodes */
+    par->fpg->visited += f->visited;
+    #endif                      /* sum the visited nodes */
+    if (f->fim16)     m16_delete(f->fim16);
+    if (f->set)       free(f->set);
+    if (par->projs[i]) free(par->projs[i]);
+    if (par->mems[i])  ms_delete(par->mems[i]);
+  }                             /* delete 16-items machines, buffers */
+  free(par->thds);              /* delete the miner copies */
+  return r;                     /* return the error status */
+}  /* par_exit() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_init (FPGPAR *par, FPGROWTH *fpg, ITEM k,
+                     size_t proj, size_t node)
+{                               /* --- prepare a parallel search */
+  int      i, n;                /* loop variable, number of threads */
+  ITEM     m;                   /* number of items */
+  FPGROWTH *f;                  /* to traverse the miner copies */
+
+  assert(par && fpg);           /* check the function arguments */
+  n = fpg->threads;             /* get the number of threads */
+  if (n <= 0) n = tp_cpucnt();  /* (default: number of processors) */
+  if (n > k)  n = (int)k;       /* use at most one thread per item */
+  if ((n <= 1) || !isr_clonable(fpg->report))
+    return 0;                   /* check for a parallel search */
+  par->fpg  = fpg;              /* note the fpgrowth miner */
+  par->cnt  = 0;                /* and allocate the miner copies */
+  par->thds = (FPGROWTH*)malloc((size_t)n *sizeof(FPGROWTH)
+                               +(size_t)k *sizeof(double)
+                               +(size_t)n *sizeof(void*)
+                               +(size_t)n *sizeof(MEMSYS*)
+                               +(size_t)n *sizeof(ISREPORT*));
+  if (!par->thds) return -1;    /* create an array of miner copies */
+  par->wgts  = (double*)   (par->thds +n);
+  par->projs = (void**)    (par->wgts +k);
+  par->mems  = (MEMSYS**)  (par->projs +n);
+  par->reps  = (ISREPORT**)(par->mems  +n);
+  m = tbg_itemcnt(fpg->tabag);  /* get the size of the item buffers */
+  for (i = 0; i < n; i++) {     /* traverse the worker threads */
+    f = par->thds +i; *f = *fpg;/* copy the fpgrowth miner */
+    f->threads = 1;             /* (no nested parallel search) */
+    f->set     = NULL;          /* clear the item buffers, */
+    f->fim16   = NULL;          /* the 16-items machine, */
+    par->projs[i] = NULL;       /* the projection buffer and */
+    par->mems[i]  = NULL;       /* the memory system of the thread */
+    #ifdef VISITED              /* if to report visited search nodes */
+    f->visited = 0;             /* initialize the search node counter */
+    #endif                      /* of the thread */
+    par->cnt   = i+1;           /* clone the item set reporter */
+    f->report  = isr_clone(fpg->report);
+    if (!f->report) break;      /* (collects the found item sets) */
+    f->set = (ITEM*)malloc((size_t)(m+m) *sizeof(ITEM)
+                          +(size_t) m    *sizeof(SUPP));
+    if (!f->set) break;         /* create item and support arrays */
+    f->map = f->set +m;         /* note item map and set buffer */
+    f->cis = (SUPP*)(f->map +m);/* and the item support array */
+    if (fpg->mode & FPG_FIM16) {/* if to use a 16-items machine */
+      f->fim16 = m16_create(fpg->dir, fpg->supp, f->report);
+      if (!f->fim16) break;     /* create a 16-items machine */
+    }                           /* for each thread */
+    par->projs[i] = malloc(proj);
+    if (!par->projs[i]) break;  /* allocate a projection buffer */
+    if (node <= 0) continue;    /* (array trees need no mem. system) */
+    par->mems[i] = ms_create(node, 65535);
+    if (!par->mems[i]) break;   /* create a memory system */
+  }                             /* for the tree nodes */
+  if (i < n) { par_exit(par, -1); return -1; }
+  return n;                     /* return the number of threads */
+}  /* par_init() */
+
+/* The items of the top-level frequent pattern tree are processed as  */
+/* independent tasks by a thread pool with work stealing. Since the   */
+/* top-level tree is only read while projections are computed, it can */
+/* be shared by all threads. Each thread works on a copy of the miner */
+/* with its own item buffers, 16-items machine, memory system for the */
+/* nodes of the projections and a clone of the item set reporter. The */
+/* item sets found by the threads are output when the clones are      */
+/* merged into the item set reporter of the calling thread. Since the */
+/* clones record the item sets per task, they are output in the same  */
+/* order as in the serial search.                                     */
+
 /*----------------------------------------------------------------------
   Frequent Pattern Growth (simple nodes with only successor/parent)
 ----------------------------------------------------------------------*/
@@ -467,12 +615,44 @@ static int proj_simple (FPGROWTH *fpg,
 
 /*--------------------------------------------------------------------*/
 
+static int rec_simple (FPGROWTH *fpg, FPTREE *tree);
+
+static int smp_item (FPGROWTH *fpg, FPTREE *tree, FPTREE *proj, ITEM i)
+{                               /* --- process an item of a tree */
+  int    r;                     /* error status */
+  FPHEAD *h;                    /* node list for current item */
+  FPNODE *node, *anc;           /* to traverse the tree nodes */
+
+  assert(fpg && tree && (i >= 0)); /* check the function arguments */
+  h = tree->heads +i;           /* get the item list to process */
+  r = isr_add(fpg->report, h->item, h->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  node = h->list;               /* get the head of the item list */
+  if (!node->succ) {            /* if projection would be a chain */
+    for (anc = node->parent; anc->id > TA_END; anc = anc->parent) {
+      isr_addpex(fpg->report, tree->heads[anc->id].item);
+    } }                         /* add items as perfect extensions */
+  else if (proj) {              /* if another item can be added */
+    r = proj_simple(fpg, proj, tree, i);
+    if (r > 0) r = rec_simple(fpg, proj);
+    if (r < 0) return r;        /* project frequent pattern tree and */
+  }                             /* find freq. item sets recursively */
+  r = isr_report(fpg->report);  /* report the current item set */
+  if (r < 0) return r;          /* and check for an error */
+  isr_remove(fpg->report, 1);   /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* smp_item() */
+
+/* The loop body of the function rec_simple() below is a separate   */
+/* function, so that it can also be executed by the worker threads  */
+/* of the parallel version (for the items of the top-level tree).   */
+
+/*--------------------------------------------------------------------*/
+
 static int rec_simple (FPGROWTH *fpg, FPTREE *tree)
 {                               /* --- find item sets recursively */
   int    r;                     /* error status */
   ITEM   i, z;                  /* loop variables */
-  FPHEAD *h;                    /* node list for current item */
-  FPNODE *node, *anc;           /* to traverse the tree nodes */
   FPTREE *proj = NULL;          /* projected frequent pattern tree */
   ITEM   *s;                    /* to collect the tail items */
 
@@ -500,7 +680,6 @@ static int rec_simple (FPGROWTH *fpg, FPTREE *tree)
   if (tree->dir > 0) { z = tree->cnt; i = 0; }
   else               { z = -1;        i = tree->cnt-1; }
   for (r = 0; i != z; i += tree->dir) {
-    h = tree->heads +i;         /* traverse the (frequent) items */
     #ifdef VISITED              /* if to report visited search nodes */
     fpg->visited += 1;          /* count current node as visited */
     if ((fpg->visited % 10000) == 0) {
@@ -508,23 +687,9 @@ static int rec_simple (FPGROWTH *fpg, FPTREE *tree)
       fprintf(stderr, "  %24"SIZE_FMT, isr_repcnt(fpg->report));
     }                           /* print numbers every 10000 nodes */
     #endif                      /* (visited nodes and reported sets) */
-    r = isr_add(fpg->report, h->item, h->supp);
-    if (r <  0) break;          /* add current item to the reporter */
-    if (r <= 0) continue;       /* check if item needs processing */
-    node = h->list;             /* get the head of the item list */
-    if (!node->succ) {          /* if projection would be a chain */
-      for (anc = node->parent; anc->id > TA_END; anc = anc->parent) {
-        isr_addpex(fpg->report, tree->heads[anc->id].item);
-      } }                       /* add items as perfect extensions */
-    else if (proj) {            /* if another item can be added */
-      r = proj_simple(fpg, proj, tree, i);
-      if (r > 0) r = rec_simple(fpg, proj);
-      if (r < 0) break;         /* project frequent pattern tree and */
-    }                           /* find freq. item sets recursively */
-    r = isr_report(fpg->report);/* report the current item set */
-    if (r < 0) break;           /* and check for an error */
-    isr_remove(fpg->report, 1); /* remove the current item */
-  }                             /* from the item set reporter */
+    r = smp_item(fpg, tree, proj, i);
+    if (r < 0) break;           /* process the (frequent) items */
+  }                             /* (extend the current item set) */
   if (proj) {                   /* delete the created projection */
     free(proj); ms_pop(tree->mem); }
   return r;                     /* return the error status */
@@ -532,6 +697,60 @@ static int rec_simple (FPGROWTH *fpg, FPTREE *tree)
 
 /*--------------------------------------------------------------------*/
 
+static int smp_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int      r;                   /* error status */
+  FPGPAR   *par = (FPGPAR*)data;/* type the data pointer */
+  FPGROWTH *fpg;                /* copy of the fpgrowth miner */
+  FPTREE   *tree, *proj;        /* top-level tree and projection */
+  ITEM     i;                   /* index of the item to process */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  fpg  = par->thds +thread;     /* get the miner copy of the thread */
+  tree = (FPTREE*)par->tree;    /* and the top-level tree */
+  proj = (FPTREE*)par->projs[thread];
+  i = (tree->dir > 0) ? par->beg +(ITEM)task : par->end-1 -(ITEM)task;
+  if (isr_task(fpg->report, task) < 0) return -1;
+  if (ms_push(proj->mem) < 0) return -1;
+  r = smp_item(fpg, tree, proj, i);
+  ms_pop(proj->mem);            /* process the item / node list */
+  return r;                     /* and free the projection nodes */
+}  /* smp_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_simple (FPGROWTH *fpg, FPTREE *tree)
+{                               /* --- parallel version of rec_simple */
+  int    r, i;                  /* error status, loop variable */
+  FPGPAR par;                   /* data for the parallel search */
+  FPTREE *proj;                 /* to traverse the projections */
+
+  assert(fpg && tree);          /* check the function arguments */
+  if ((fpg->mode & FPG_TAIL)    /* tail pruning needs a repository */
+  ||  (tree->cnt < 2) || !isr_xable(fpg->report, 2))
+    return rec_simple(fpg, tree);
+  r = par_init(&par, fpg, tree->cnt, sizeof(FPTREE)
+              +(size_t)(tree->cnt-2) *sizeof(FPHEAD), sizeof(FPNODE));
+  if (r <= 0)                   /* if no parallel search is possible, */
+    return (r < 0) ? r : rec_simple(fpg, tree); /* use rec_simple */
+  for (i = 0; i < par.cnt; i++) {
+    proj = (FPTREE*)par.projs[i];  /* traverse the projections */
+    proj->root.id   = TA_END;   /* initialize the root node */
+    proj->root.succ = proj->root.parent = NULL;
+    proj->dir = tree->dir;      /* copy the processing direction */
+    proj->mem = par.mems[i];    /* and set the memory system */
+  }                             /* of the thread */
+  par.tree = tree;              /* note the top-level tree */
+  par.beg  = 0; par.end = tree->cnt;
+  for (i = 0; i < tree->cnt; i++) /* use supports as size hints */
+    par.wgts[(tree->dir > 0) ? i : tree->cnt-1-i] =
+      (double)tree->heads[i].supp;
+  r = tp_execx(par.cnt, (long)tree->cnt, smp_task, &par, par.wgts);
+  return par_exit(&par, r);     /* process the items in parallel */
+}  /* par_simple() */
+
+/*--------------------------------------------------------------------*/
+
 static int add_smp16 (FPTREE *tree, const ITEM *ids, ITEM n, SUPP supp)
 {                               /* --- add an item set to the tree */
   ITEM   i;                     /* buffer for an item */
@@ -635,13 +854,47 @@ static int proj_smp16 (FPGROWTH *fpg, FPTREE *dst, FPTREE *src,
 
 /*--------------------------------------------------------------------*/
 
+static int rec_smp16 (FPGROWTH *fpg, FPTREE *tree);
+
+static int s16_item (FPGROWTH *fpg, FPTREE *tree, FPTREE *proj,
+                     ITEM i, ITEM mask)
+{                               /* --- process an item of a tree */
+  int    r;                     /* error status */
+  ITEM   k;                     /* buffer for an ancestor item */
+  FPHEAD *h;                    /* node list for current item */
+  FPNODE *node, *anc;           /* to traverse the tree nodes */
+
+  assert(fpg && tree && (i >= 0)); /* check the function arguments */
+  h = tree->heads +i;           /* get the item list to process */
+  r = isr_add(fpg->report, h->item, h->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  node = h->list;               /* get the head of the item list */
+  if (!node->succ) {            /* if projection would be a chain */
+    for (anc = node->parent; anc->id > TA_END; anc = anc->parent) {
+      k = anc->id;              /* traverse the list of ancestors */
+      if (k >= 0) isr_addpex  (fpg->report, tree->heads[k].item);
+      else        isr_addpexpk(fpg->report, k);
+    } }                         /* add items as perfect extensions */
+  else if (proj) {              /* if another item can be added */
+    r = proj_smp16(fpg, proj, tree, i, mask);
+    if (r > 0) r = rec_smp16(fpg, proj);
+    if (r < 0) return r;        /* project frequent pattern tree and */
+  }                             /* find freq. item sets recursively */
+  r = isr_report(fpg->report);  /* report the current item set */
+  if (r < 0) return r;          /* and check for an error */
+  isr_remove(fpg->report, 1);   /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* s16_item() */
+
+/*--------------------------------------------------------------------*/
+
 static int rec_smp16 (FPGROWTH *fpg, FPTREE *tree)
 {                               /* --- find item sets recursively */
   int    r;                     /* error status */
   ITEM   i, k, z;               /* loop variables */
   ITEM   mask;                  /* mask for packed items to keep */
   FPHEAD *h;                    /* node list for current item */
-  FPNODE *node, *anc;           /* to traverse the tree nodes */
+  FPNODE *node;                 /* to traverse the tree nodes */
   FPTREE *proj = NULL;          /* projected frequent pattern tree */
   ITEM   *s;                    /* to collect the tail items */
 
@@ -652,7 +905,7 @@ static int rec_smp16 (FPGROWTH *fpg, FPTREE *tree)
   if (fpg->mode & FPG_TAIL) {   /* if to use head union tail pruning */
     s = fpg->map; i = k = 0;    /* get the item set buffer */
     if (tree->heads[0].item < 0) {
-      for (i++, z = 0; z < 16; z++)
+      for (i++, z = 0; z < 31; z++)
         if (tree->heads[0].item & (1 << z))
           *--s = z;             /* if there are packed items, */
     }                           /* first collect these tail items */
@@ -693,25 +946,9 @@ static int rec_smp16 (FPGROWTH *fpg, FPTREE *tree)
       if (r < 0) break;         /* to the 16-items machine and mine */
       mask = r; continue;       /* get the packed items mask */
     }                           /* and go to the next item list */
-    r = isr_add(fpg->report, h->item, h->supp);
-    if (r <  0) break;          /* add current item to the reporter */
-    if (r <= 0) continue;       /* check if item needs processing */
-    node = h->list;             /* get the head of the item list */
-    if (!node->succ) {          /* if projection would be a chain */
-      for (anc = node->parent; anc->id > TA_END; anc = anc->parent) {
-        k = anc->id;            /* traverse the list of ancestors */
-        if (k >= 0) isr_addpex  (fpg->report, tree->heads[k].item);
-        else        isr_addpexpk(fpg->report, k);
-      } }                       /* add items as perfect extensions */
-    else if (proj) {            /* if another item can be added */
-      r = proj_smp16(fpg, proj, tree, i, mask);
-      if (r > 0) r = rec_smp16(fpg, proj);
-      if (r < 0) break;         /* project frequent pattern tree and */
-    }                           /* find freq. item sets recursively */
-    r = isr_report(fpg->report);/* report the current item set */
-    if (r < 0) break;           /* and check for an error */
-    isr_remove(fpg->report, 1); /* remove the current item */
-  }                             /* from the item set reporter */
+    r = s16_item(fpg, tree, proj, i, mask);
+    if (r < 0) break;           /* process the (frequent) items */
+  }                             /* (extend the current item set) */
   if (proj) {                   /* delete the created projection */
     free(proj); ms_pop(tree->mem); }
   return r;                     /* return the error status */
@@ -719,13 +956,81 @@ static int rec_smp16 (FPGROWTH *fpg, FPTREE *tree)
 
 /*--------------------------------------------------------------------*/
 
+static int s16_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int      r;                   /* error status */
+  FPGPAR   *par = (FPGPAR*)data;/* type the data pointer */
+  FPGROWTH *fpg;                /* copy of the fpgrowth miner */
+  FPTREE   *tree, *proj;        /* top-level tree and projection */
+  ITEM     i;                   /* index of the item to process */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  fpg  = par->thds +thread;     /* get the miner copy of the thread */
+  tree = (FPTREE*)par->tree;    /* and the top-level tree */
+  proj = (FPTREE*)par->projs[thread];
+  i = (tree->dir > 0) ? par->beg +(ITEM)task : par->end-1 -(ITEM)task;
+  if (isr_task(fpg->report, task) < 0) return -1;
+  if (ms_push(proj->mem) < 0) return -1;
+  r = s16_item(fpg, tree, proj, i, par->mask);
+  ms_pop(proj->mem);            /* process the item / node list */
+  return r;                     /* and free the projection nodes */
+}  /* s16_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_smp16 (FPGROWTH *fpg, FPTREE *tree)
+{                               /* --- parallel version of rec_smp16 */
+  int    r, i;                  /* error status, loop variable */
+  FPGPAR par;                   /* data for the parallel search */
+  FPTREE *proj;                 /* to traverse the projections */
+  FPNODE *node;                 /* to traverse the packed items */
+
+  assert(fpg && tree);          /* check the function arguments */
+  if ((fpg->mode & FPG_TAIL)    /* tail pruning needs a repository */
+  ||  (tree->cnt < 3) || !isr_xable(fpg->report, 2))
+    return rec_smp16(fpg, tree);
+  r = par_init(&par, fpg, tree->cnt-1, sizeof(FPTREE)
+              +(size_t)(tree->cnt-2) *sizeof(FPHEAD), sizeof(FPNODE));
+  if (r <= 0)                   /* if no parallel search is possible, */
+    return (r < 0) ? r : rec_smp16(fpg, tree);  /* use rec_smp16 */
+  for (i = 0; i < par.cnt; i++) {
+    proj = (FPTREE*)par.projs[i];  /* traverse the projections */
+    proj->root.id   = TA_END;   /* initialize the root node */
+    proj->root.succ = proj->root.parent = NULL;
+    proj->dir   = tree->dir;    /* copy the processing direction, */
+    proj->fim16 = par.thds[i].fim16; /* the 16-items machine */
+    proj->mem   = par.mems[i];  /* and set the memory system */
+  }                             /* of the thread */
+  par.tree = tree;              /* note the top-level tree */
+  par.beg  = 1; par.end = tree->cnt;
+  for (i = 1; i < tree->cnt; i++) /* use supports as size hints */
+    par.wgts[(tree->dir > 0) ? i-1 : tree->cnt-1-i] =
+      (double)tree->heads[i].supp;
+  par.mask = ITEM_MAX;          /* init. the packed item mask */
+  if (tree->dir > 0) {          /* if upward processing direction, */
+    r = m16_mine(tree->fim16);  /* mine the packed items first */
+    if (r < 0) return par_exit(&par, r);
+    par.mask = r;               /* get the packed items mask */
+  }                             /* (is needed for the projections) */
+  r = tp_execx(par.cnt, (long)(tree->cnt-1), s16_task, &par, par.wgts);
+  r = par_exit(&par, r);        /* process the items in parallel */
+  if ((r >= 0) && (tree->dir < 0)) {
+    for (node = tree->heads[0].list; node; node = node->succ)
+      m16_add(tree->fim16, (BITTA)(node->id & ~TA_END), node->supp);
+    r = m16_mine(tree->fim16);  /* if downward processing direction, */
+  }                             /* mine the packed items last */
+  return (r < 0) ? r : 0;       /* return the error status */
+}  /* par_smp16() */
+
+/*--------------------------------------------------------------------*/
+
 int fpg_simple (FPGROWTH *fpg)
 {                               /* --- search for frequent item sets */
   int        r = 0;             /* result of recursion/functions */
   ITEM       i, k, m;           /* loop variable, number of items */
-  TID        j, n;              /* loop variable, number of trans. */
   SUPP       pex;               /* minimum support for perf. exts. */
   TRACT      *t;                /* to traverse the transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
   ITEM       *s, *d;            /* to build the item maps */
   const ITEM *p;                /* to traverse transaction items */
   const SUPP *f;                /* item frequencies in trans. bag */
@@ -740,8 +1045,7 @@ int fpg_simple (FPGROWTH *fpg)
   pex = tbg_wgt(fpg->tabag);    /* check against the minimum support */
   if (fpg->supp > pex) return 0;/* and get minimum for perfect exts. */
   if (!(fpg->mode & FPG_PERFECT)) pex = SUPP_MAX;
-  n = tbg_cnt(fpg->tabag);      /* get the number of transactions */
-  k = tbg_itemcnt(fpg->tabag);  /* and check the number of items */
+  k = tbg_itemcnt(fpg->tabag);  /* get and check the number of items */
   if (k <= 0) return isr_report(fpg->report);
   f = tbg_ifrqs(fpg->tabag, 0); /* get the item frequencies */
   if (!f) return -1;            /* in the transaction bag */
@@ -777,8 +1081,9 @@ int fpg_simple (FPGROWTH *fpg)
     if (!tree->fim16) { ms_delete(tree->mem);
       free(tree); free(fpg->set); return -1; }
     tree->heads[0].item = TA_END;   /* create a 16-items machine */
-    for (j = n; --j >= 0; ) {   /* traverse the transactions and */
-      t = tbg_tract(fpg->tabag, j);   /* collect non-elim. items */
+    cur = tbc_create(fpg->tabag);/* create a cursor for the bag */
+    r   = (cur) ? 0 : -1;       /* (transactions may be compressed) */
+    while (cur && (t = tbc_next(cur))) { /* traverse the trans. */
       for (k = 0, p = ta_items(t); *p > TA_END; p++) {
         if      ((m = *p)   <  0) s[k++] = m;
         else if ((m = d[m]) >= 0) s[k++] = m;
@@ -786,21 +1091,24 @@ int fpg_simple (FPGROWTH *fpg)
       r = add_smp16(tree, s, k, ta_wgt(t));
       if (r < 0) break;         /* add the reduced transaction */
     }                           /* to the frequent pattern tree */
+    if (cur) tbc_delete(cur);   /* delete the bag cursor */
     if (r >= 0) {               /* if freq. pattern tree was built, */
-      r = rec_smp16(fpg, tree); /* find freq. item sets recursively */
+      r = par_smp16(fpg, tree); /* find freq. item sets recursively */
       if (r >= 0) r = isr_report(fpg->report);
     }                           /* finally report the empty item set */
     m16_delete(tree->fim16); }  /* delete the 16-items machine */
   else {                        /* if not to use a 16-items machine */
-    for (j = n; --j >= 0; ) {   /* traverse the transactions and */
-      t = tbg_tract(fpg->tabag, j);   /* collect non-elim. items */
+    cur = tbc_create(fpg->tabag);/* create a cursor for the bag */
+    r   = (cur) ? 0 : -1;       /* (transactions may be compressed) */
+    while (cur && (t = tbc_next(cur))) { /* traverse the trans. */
       for (k = 0, p = ta_items(t); *p > TA_END; p++)
         if ((m = d[*p]) >= 0) s[k++] = m;
       r = add_simple(tree, s, k, ta_wgt(t));
       if (r < 0) break;         /* add the reduced transaction */
     }                           /* to the frequent pattern tree */
+    if (cur) tbc_delete(cur);   /* delete the bag cursor */
     if (r >= 0) {               /* if freq. pattern tree was built, */
-      r = rec_simple(fpg,tree); /* find freq. item sets recursively */
+      r = par_simple(fpg,tree); /* find freq. item sets recursively */
       if (r >= 0) r = isr_report(fpg->report);
     }                           /* report the empty item set */
   }
@@ -1108,12 +1416,42 @@ static int proj_reord (FPGROWTH *fpg, CSTREE *dst, CSTREE *src, ITEM id)
 
 /*--------------------------------------------------------------------*/
 
+static int rec_cmplx (FPGROWTH *fpg, CSTREE *tree);
+
+static int cmp_item (FPGROWTH *fpg, CSTREE *tree, CSTREE *proj, ITEM i)
+{                               /* --- process an item of a tree */
+  int    r;                     /* error status */
+  CSHEAD *h;                    /* node list for current item */
+  CSNODE *node;                 /* to traverse the tree nodes */
+
+  assert(fpg && tree && (i >= 0)); /* check the function arguments */
+  h = tree->heads +i;           /* get the item list to process */
+  r = isr_add(fpg->report, h->item, h->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  if (!h->list->succ) {         /* if projection would be a chain */
+    for (node = h->list->parent; node->id >= 0; ) {
+      isr_addpex(fpg->report, tree->heads[node->id].item);
+      node = node->parent;      /* traverse the list of ancestors */
+    } }                         /* and add them as perfect exts. */
+  else if (proj) {              /* if another item can be added */
+    r = (fpg->mode & FPG_REORDER)
+      ? proj_reord(fpg, proj, tree, i)
+      : proj_cmplx(fpg, proj, tree, i);
+    if (r > 0) r = rec_cmplx(fpg, proj);
+    if (r < 0) return r;        /* project frequent pattern tree and */
+  }                             /* find freq. item sets recursively */
+  r = isr_report(fpg->report);  /* report the current item set */
+  if (r < 0) return r;          /* and check for an error */
+  isr_remove(fpg->report, 1);   /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* cmp_item() */
+
+/*--------------------------------------------------------------------*/
+
 static int rec_cmplx (FPGROWTH *fpg, CSTREE *tree)
 {                               /* --- find item sets recursively */
   int    r;                     /* error status */
   ITEM   i, z;                  /* loop variables */
-  CSHEAD *h;                    /* node list for current item */
-  CSNODE *node;                 /* to traverse the tree nodes */
   CSTREE *proj = NULL;          /* projected frequent pattern tree */
   ITEM   *s;                    /* to collect the tail items */
 
@@ -1146,7 +1484,6 @@ static int rec_cmplx (FPGROWTH *fpg, CSTREE *tree)
   else              { z = -1;        i = tree->cnt-1; }
   #endif                        /* (except all processing fits) */
   for (r = 0; i != z; i += fpg->dir) {
-    h = tree->heads +i;         /* traverse the frequent items */
     #ifdef VISITED              /* if to report visited search nodes */
     fpg->visited += 1;          /* count current node as visited */
     if ((fpg->visited % 10000) == 0) {
@@ -1154,25 +1491,9 @@ static int rec_cmplx (FPGROWTH *fpg, CSTREE *tree)
       fprintf(stderr, "  %24"SIZE_FMT, isr_repcnt(fpg->report));
     }                           /* print numbers every 10000 nodes */
     #endif                      /* (visited nodes and reported sets) */
-    r = isr_add(fpg->report, h->item, h->supp);
-    if (r <  0) break;          /* add current item to the reporter */
-    if (r <= 0) continue;       /* check if item needs processing */
-    if (!h->list->succ) {       /* if projection would be a chain */
-      for (node = h->list->parent; node->id >= 0; ) {
-        isr_addpex(fpg->report, tree->heads[node->id].item);
-        node = node->parent;    /* traverse the list of ancestors */
-      } }                       /* and add them as perfect exts. */
-    else if (proj) {            /* if another item can be added */
-      r = (fpg->mode & FPG_REORDER)
-        ? proj_reord(fpg, proj, tree, i)
-        : proj_cmplx(fpg, proj, tree, i);
-      if (r > 0) r = rec_cmplx(fpg, proj);
-      if (r < 0) break;         /* project frequent pattern tree and */
-    }                           /* find freq. item sets recursively */
-    r = isr_report(fpg->report);/* report the current item set */
-    if (r < 0) break;           /* and check for an error */
-    isr_remove(fpg->report, 1); /* remove the current item */
-  }                             /* from the item set reporter */
+    r = cmp_item(fpg, tree, proj, i);
+    if (r < 0) break;           /* process the (frequent) items */
+  }                             /* (extend the current item set) */
   if (proj) {                   /* delete the created projection */
     free(proj); ms_pop(tree->mem); }
   return r;                     /* return the error status */
@@ -1180,16 +1501,69 @@ static int rec_cmplx (FPGROWTH *fpg, CSTREE *tree)
 
 /*--------------------------------------------------------------------*/
 
+static int cmp_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int      r;                   /* error status */
+  FPGPAR   *par = (FPGPAR*)data;/* type the data pointer */
+  FPGROWTH *fpg;                /* copy of the fpgrowth miner */
+  CSTREE   *tree, *proj;        /* top-level tree and projection */
+  ITEM     i;                   /* index of the item to process */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  fpg  = par->thds +thread;     /* get the miner copy of the thread */
+  tree = (CSTREE*)par->tree;    /* and the top-level tree */
+  proj = (CSTREE*)par->projs[thread];
+  i = (fpg->dir > 0) ? par->beg +(ITEM)task : par->end-1 -(ITEM)task;
+  if (isr_task(fpg->report, task) < 0) return -1;
+  if (ms_push(proj->mem) < 0) return -1;
+  r = cmp_item(fpg, tree, proj, i);
+  ms_pop(proj->mem);            /* process the item / node list */
+  return r;                     /* and free the projection nodes */
+}  /* cmp_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_cmplx (FPGROWTH *fpg, CSTREE *tree)
+{                               /* --- parallel version of rec_cmplx */
+  int    r, i;                  /* error status, loop variable */
+  FPGPAR par;                   /* data for the parallel search */
+  CSTREE *proj;                 /* to traverse the projections */
+
+  assert(fpg && tree);          /* check the function arguments */
+  if ((fpg->mode & FPG_TAIL)    /* tail pruning needs a repository */
+  ||  (tree->cnt < 2) || !isr_xable(fpg->report, 2))
+    return rec_cmplx(fpg, tree);
+  r = par_init(&par, fpg, tree->cnt, sizeof(CSTREE)
+              +(size_t)(tree->cnt-2) *sizeof(CSHEAD), sizeof(CSNODE));
+  if (r <= 0)                   /* if no parallel search is possible, */
+    return (r < 0) ? r : rec_cmplx(fpg, tree);  /* use rec_cmplx */
+  for (i = 0; i < par.cnt; i++) {
+    proj = (CSTREE*)par.projs[i];  /* traverse the projections */
+    proj->root.id   = TA_END;   /* initialize the root node */
+    proj->root.succ = proj->root.parent = proj->root.sibling = NULL;
+    proj->mem = par.mems[i];    /* set the memory system */
+  }                             /* of the thread */
+  par.tree = tree;              /* note the top-level tree */
+  par.beg  = 0; par.end = tree->cnt;
+  for (i = 0; i < tree->cnt; i++) /* use supports as size hints */
+    par.wgts[(fpg->dir > 0) ? i : tree->cnt-1-i] =
+      (double)tree->heads[i].supp;
+  r = tp_execx(par.cnt, (long)tree->cnt, cmp_task, &par, par.wgts);
+  return par_exit(&par, r);     /* process the items in parallel */
+}  /* par_cmplx() */
+
+/*--------------------------------------------------------------------*/
+
 int fpg_cmplx (FPGROWTH *fpg)
 {                               /* --- search for frequent item sets */
   int        r = 0;             /* result of recursion/functions */
   ITEM       i, k, m;           /* loop variable, number of items */
-  TID        j, n;              /* loop variable, number of trans. */
   SUPP       pex;               /* minimum support for perfect exts. */
   ITEM       *s, *d;            /* to build the item maps */
   const ITEM *p;                /* to traverse transaction items */
   const SUPP *f;                /* item frequencies in trans. bag */
   TRACT      *t;                /* to traverse the transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
   CSTREE     *tree;             /* created frequent pattern tree */
   CSHEAD     *h;                /* to traverse the item heads */
 
@@ -1201,8 +1575,7 @@ int fpg_cmplx (FPGROWTH *fpg)
   pex = tbg_wgt(fpg->tabag);    /* check against the minimum support */
   if (fpg->supp > pex) return 0;/* and get minimum for perfect exts. */
   if (!(fpg->mode & FPG_PERFECT)) pex = SUPP_MAX;
-  n = tbg_cnt(fpg->tabag);      /* get the number of transactions */
-  k = tbg_itemcnt(fpg->tabag);  /* and check the number of items */
+  k = tbg_itemcnt(fpg->tabag);  /* get and check the number of items */
   if (k <= 0) return isr_report(fpg->report);
   f = tbg_ifrqs(fpg->tabag, 0); /* get the item frequencies */
   if (!f) return -1;            /* in the transaction bag */
@@ -1237,15 +1610,17 @@ int fpg_cmplx (FPGROWTH *fpg)
     if (!fpg->fim16) { ms_delete(tree->mem);
       free(tree); free(fpg->set); return -1; }
   }                             /* create a 16-items machine */
-  for (j = n; --j >= 0; ) {     /* traverse the transactions and */
-    t = tbg_tract(fpg->tabag,j);/* collect the non-eliminated items */
+  cur = tbc_create(fpg->tabag); /* create a cursor for the bag */
+  r   = (cur) ? 0 : -1;         /* (transactions may be compressed) */
+  while (cur && (t = tbc_next(cur))) { /* traverse the trans. */
     for (k = 0, p = ta_items(t); *p > TA_END; p++)
       if ((m = d[*p]) >= 0) s[k++] = m;
     r = add_cmplx(tree, s, k, ta_wgt(t));
     if (r < 0) break;           /* add the reduced transaction */
   }                             /* to the frequent pattern tree */
+  if (cur) tbc_delete(cur);     /* delete the bag cursor */
   if (r >= 0) {                 /* if freq. pattern tree was built */
-    r = rec_cmplx(fpg, tree);   /* find freq. item sets recursively */
+    r = par_cmplx(fpg, tree);   /* find freq. item sets recursively */
     if (r >= 0) r = isr_report(fpg->report);
   }                             /* report the empty item set */
   if (fpg->fim16)               /* if a 16-items machine was used, */
@@ -1352,12 +1727,12 @@ int fpg_single (FPGROWTH *fpg)
 {                               /* --- search for frequent item sets */
   int        r = 0;             /* result of recursion/functions */
   ITEM       i, k, m;           /* loop variable, number of items */
-  TID        j, n;              /* loop variable, number of trans. */
   SUPP       pex;               /* minimum support for perfect exts. */
   ITEM       *s, *d;            /* to build the item maps */
   const ITEM *p;                /* to traverse transaction items */
   const SUPP *f;                /* item frequencies in trans. bag */
   TRACT      *t;                /* to traverse the transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
   FPTREE     *tree;             /* created frequent pattern tree */
   FPHEAD     *h;                /* to traverse the item heads */
 
@@ -1369,8 +1744,7 @@ int fpg_single (FPGROWTH *fpg)
   pex = tbg_wgt(fpg->tabag);    /* check against the minimum support */
   if (fpg->supp > pex) return 0;/* and get minimum for perfect exts. */
   if (!(fpg->mode & FPG_PERFECT)) pex = SUPP_MAX;
-  n = tbg_cnt(fpg->tabag);      /* get the number of transactions */
-  k = tbg_itemcnt(fpg->tabag);  /* and check the number of items */
+  k = tbg_itemcnt(fpg->tabag);  /* get and check the number of items */
   if (k <= 0) return isr_report(fpg->report);
   f = tbg_ifrqs(fpg->tabag, 0); /* get the item frequencies */
   if (!f) return -1;            /* in the transaction bag */
@@ -1405,8 +1779,9 @@ int fpg_single (FPGROWTH *fpg)
   }                             /* create a 16-items machine */
   for (i = 0; i < k; i++) {     /* initialize the item heads */
     h = tree->heads+i; h->supp = f[h->item = s[i]]; h->list = NULL; }
-  for (j = n; --j >= 0; ) {     /* traverse the transactions and */
-    t = tbg_tract(fpg->tabag,j);/* collect the non-eliminated items */
+  cur = tbc_create(fpg->tabag); /* create a cursor for the bag */
+  r   = (cur) ? 0 : -1;         /* (transactions may be compressed) */
+  while (cur && (t = tbc_next(cur))) { /* traverse the trans. */
     for (k = 0, p = ta_items(t); *p > TA_END; p++) {
       if      ((m = *p)   <  0) s[k++] = m;
       else if ((m = d[m]) >= 0) s[k++] = m;
@@ -1414,6 +1789,7 @@ int fpg_single (FPGROWTH *fpg)
     r = add_smp16(tree, s, k, ta_wgt(t));
     if (r < 0) break;           /* add the reduced transaction */
   }                             /* to the frequent pattern tree */
+  if (cur) tbc_delete(cur);     /* delete the bag cursor */
   if ((r >= 0) && tree->fim16)  /* if there is a 16-items machine, */
     r = m16_mine(tree->fim16);  /* mine frequent item sets with it */
   if (r >= 0) {                 /* if freq. pattern tree was built */
@@ -1614,9 +1990,9 @@ int fpg_topdn (FPGROWTH *fpg)
 {                               /* --- search for frequent item sets */
   int        r = 0;             /* result of recursion/functions */
   ITEM       i, k, m;           /* loop variable, number of items */
-  TID        j, n;              /* loop variable, number of trans. */
   SUPP       pex;               /* minimum support for perfect exts. */
   TRACT      *t;                /* to traverse the transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
   ITEM       *s, *d;            /* to traverse flags / items */
   const ITEM *p;                /* to traverse transaction items */
   const SUPP *f;                /* item frequencies in trans. bag */
@@ -1630,8 +2006,7 @@ int fpg_topdn (FPGROWTH *fpg)
   pex = tbg_wgt(fpg->tabag);    /* check against the minimum support */
   if (fpg->supp > pex) return 0;/* and get minimum for perfect exts. */
   if (!(fpg->mode & FPG_PERFECT)) pex = SUPP_MAX;
-  n = tbg_cnt(fpg->tabag);      /* get the number of transactions */
-  k = tbg_itemcnt(fpg->tabag);  /* and check the number of items */
+  k = tbg_itemcnt(fpg->tabag);  /* get and check the number of items */
   if (k <= 0) return isr_report(fpg->report);
   f = tbg_ifrqs(fpg->tabag, 0); /* get the item frequencies */
   if (!f) return -1;            /* in the transaction bag */
@@ -1656,13 +2031,15 @@ int fpg_topdn (FPGROWTH *fpg)
   tree->mem  = ms_create(sizeof(TDNODE), 65535);
   if (!tree->mem) { free(tree); free(fpg->set); return -1; }
   memcpy(tree->items, d, (size_t)k *sizeof(ITEM));
-  for (j = n; --j >= 0; ) {     /* traverse the transactions and */
-    t = tbg_tract(fpg->tabag,j);/* collect the non-eliminated items */
+  cur = tbc_create(fpg->tabag); /* create a cursor for the bag */
+  r   = (cur) ? 0 : -1;         /* (transactions may be compressed) */
+  while (cur && (t = tbc_next(cur))) { /* traverse the trans. */
     for (k = 0, p = ta_items(t); *p > TA_END; p++)
       if ((m = d[*p]) >= 0) s[k++] = m;
     r = add_topdn(tree, s, k, ta_wgt(t));
     if (r < 0) break;           /* add the reduced transaction */
   }                             /* to the frequent pattern tree */
+  if (cur) tbc_delete(cur);     /* delete the bag cursor */
   if (r >= 0) {                 /* if freq. pattern tree was built, */
     r = rec_topdn(fpg, tree);   /* find freq. item sets recursively */
     if (r >= 0) r = isr_report(fpg->report);
@@ -1678,6 +2055,348 @@ int fpg_topdn (FPGROWTH *fpg)
   return r;                     /* return the error status */
 }  /* fpg_topdn() */
 
+/*----------------------------------------------------------------------
+  Frequent Pattern Growth (simple nodes stored in arrays)
+----------------------------------------------------------------------*/
+/* The nodes of an array-based tree are stored in a single array, in */
+/* which the nodes for the same item form a contiguous section (in   */
+/* the order of the header table) and refer to their parents with   */
+/* indices instead of pointers. Traversing the nodes for an item is */
+/* thus a linear scan. Since the size of each section must be known */
+/* before the nodes are placed, a tree is built in two passes over  */
+/* the item sets: the first pass only counts the nodes per item     */
+/* (afs_count()), the second stores them (afs_add()). Both passes   */
+/* use the same rule as add_simple() to match a node (the node last */
+/* created for an item is reused if it has the same parent), so the */
+/* node counts of the first pass fit the nodes of the second pass.  */
+
+static void afs_init (AFTREE *tree)
+{                               /* --- prepare counting of nodes */
+  ITEM   i;                     /* loop variable */
+  AFHEAD *h;                    /* to traverse the item heads */
+
+  assert(tree);                 /* check the function argument */
+  for (i = 0; i < tree->cnt; i++) {
+    h = tree->heads +i; h->cnt = 0; h->last = -1; }
+  tree->size = 0;               /* clear the node counters */
+}  /* afs_init() */
+
+/*--------------------------------------------------------------------*/
+
+static void afs_count (AFTREE *tree, const ITEM *ids, ITEM n)
+{                               /* --- count nodes for an item set */
+  AFREF  node = -1;             /* current node (start at root) */
+  AFHEAD *h;                    /* head of the current item */
+
+  assert(tree && (ids || (n <= 0))); /* check the function arguments */
+  while (--n >= 0) {            /* traverse the items of the set */
+    h = tree->heads +*ids++;    /* get the head of the next item */
+    if ((h->last < 0) || (h->par != node)) {
+      h->par  = node;           /* if the last node does not match, */
+      h->last = tree->size++;   /* create a new node (only number it) */
+      h->cnt += 1;              /* and count it for the item */
+    }
+    node = h->last;             /* go to the (new) node */
+  }
+}  /* afs_count() */
+
+/*--------------------------------------------------------------------*/
+
+static int afs_alloc (AFTREE *tree)
+{                               /* --- allocate the counted nodes */
+  ITEM   i;                     /* loop variable */
+  AFREF  n;                     /* number of nodes */
+  AFHEAD *h;                    /* to traverse the item heads */
+  AFNODE *p;                    /* reallocated node array */
+
+  assert(tree);                 /* check the function argument */
+  if (tree->size > tree->max) { /* if the node array is too small */
+    p = (AFNODE*)realloc(tree->nodes,
+                         (size_t)tree->size *sizeof(AFNODE));
+    if (!p) return -1;          /* enlarge the node array */
+    tree->nodes = p; tree->max = tree->size;
+  }                             /* set the new array and its size */
+  for (n = i = 0; i < tree->cnt; i++) {
+    h = tree->heads +i; h->beg = n; n += h->cnt;
+    h->cnt = 0; h->last = -1;   /* compute the start of the section */
+  }                             /* for each item and clear counters */
+  return 0;                     /* return 'ok' */
+}  /* afs_alloc() */
+
+/*--------------------------------------------------------------------*/
+
+static void afs_add (AFTREE *tree, const ITEM *ids, ITEM n, SUPP supp)
+{                               /* --- add an item set to the tree */
+  AFREF  node = -1;             /* current node (start at root) */
+  AFHEAD *h;                    /* head of the current item */
+  AFNODE *c;                    /* to create a new node */
+
+  assert(tree                   /* check the function arguments */
+  &&    (ids || (n <= 0)) && (supp >= 0));
+  while (--n >= 0) {            /* traverse the items of the set */
+    h = tree->heads +*ids;      /* get the head of the next item */
+    if ((h->last < 0) || (h->par != node)) {
+      h->par  = node;           /* if the last node does not match, */
+      h->last = h->beg +h->cnt++;    /* get the next node */
+      c = tree->nodes +h->last; /* in the section of the item */
+      c->id     = *ids;         /* store the item/head identifier */
+      c->parent = node;         /* and connect to the parent node */
+      c->supp   = 0;            /* clear the support */
+    }
+    tree->nodes[node = h->last].supp += supp;
+    ids++;                      /* go to the (new) node, update */
+  }                             /* the support, and the next item */
+}  /* afs_add() */
+
+/*--------------------------------------------------------------------*/
+
+static int proj_array (FPGROWTH *fpg,
+                       AFTREE *dst, AFTREE *src, ITEM id)
+{                               /* --- project an array-based tree */
+  ITEM   i, n;                  /* loop variables, item buffer */
+  AFREF  k, e, a;               /* node indices */
+  SUPP   pex;                   /* minimum support for perf. exts. */
+  SUPP   *s;                    /* to sum the support values */
+  ITEM   *map, *d;              /* to build the item map */
+  AFHEAD *h;                    /* to access the node heads */
+  AFNODE *nodes;                /* nodes of the source tree */
+
+  assert(fpg                    /* check the function arguments */
+  &&     dst && src && (id >= 0));
+  nodes = src->nodes;           /* get the nodes of the source tree */
+  k = src->heads[id].beg;       /* and the section of the item */
+  e = k +src->heads[id].cnt;
+  memset(s = fpg->cis, 0, (size_t)id *sizeof(SUPP));
+  for ( ; k < e; k++)           /* traverse the nodes of the item */
+    for (a = nodes[k].parent; a >= 0; a = nodes[a].parent)
+      s[nodes[a].id] += nodes[k].supp;
+  pex = (fpg->mode & FPG_PERFECT) ? src->heads[id].supp : SUPP_MAX;
+  map = fpg->map;               /* get perfect extension support */
+  for (i = n = 0; i < id; i++){ /* traverse the items that */
+    if (s[i] <  fpg->supp) {    /* precede the projection item, */
+      map[i] = -1; continue; }  /* eliminate infrequent items and */
+    if (s[i] >= pex) {          /* collect perfect extension items */
+      map[i] = -1; isr_addpex(fpg->report,src->heads[i].item);continue;}
+    map[i] = n;                 /* build the item identifier map */
+    h = dst->heads +n++;        /* init. the destination header */
+    h->item = src->heads[i].item;
+    h->supp = s[i];             /* note the conditional item support */
+  }
+  if (n <= 0) return 0;         /* if the projection is empty, abort */
+  dst->cnt = n;                 /* note the number of items */
+  afs_init(dst);                /* and clear the node counters */
+  for (k = src->heads[id].beg; k < e; k++) {
+    d = map;                    /* traverse the nodes of the item */
+    for (a = nodes[k].parent; a >= 0; a = nodes[a].parent)
+      if ((i = map[nodes[a].id]) >= 0) *--d = i;
+    afs_count(dst, d, (ITEM)(map-d));
+  }                             /* count the nodes of the projection */
+  if (afs_alloc(dst) < 0) return -1;
+  for (k = src->heads[id].beg; k < e; k++) {
+    d = map;                    /* traverse the nodes of the item */
+    for (a = nodes[k].parent; a >= 0; a = nodes[a].parent)
+      if ((i = map[nodes[a].id]) >= 0) *--d = i;
+    afs_add(dst, d, (ITEM)(map-d), nodes[k].supp);
+  }                             /* add reduced trans. to the tree */
+  return 1;                     /* return that result is not empty */
+}  /* proj_array() */
+
+/*--------------------------------------------------------------------*/
+
+static int rec_array (FPGROWTH *fpg, AFTREE *tree);
+
+static int arr_item (FPGROWTH *fpg, AFTREE *tree, AFTREE *proj, ITEM i)
+{                               /* --- process an item of a tree */
+  int    r;                     /* error status */
+  AFREF  a;                     /* to traverse the ancestors */
+  AFHEAD *h;                    /* node section for current item */
+
+  assert(fpg && tree && (i >= 0)); /* check the function arguments */
+  h = tree->heads +i;           /* get the node section to process */
+  r = isr_add(fpg->report, h->item, h->supp);
+  if (r <= 0) return r;         /* add current item to the reporter */
+  if (h->cnt <= 1) {            /* if projection would be a chain */
+    for (a = tree->nodes[h->beg].parent; a >= 0;
+         a = tree->nodes[a].parent)
+      isr_addpex(fpg->report, tree->heads[tree->nodes[a].id].item);
+  }                             /* add items as perfect extensions */
+  else if (proj) {              /* if another item can be added */
+    r = proj_array(fpg, proj, tree, i);
+    if (r > 0) r = rec_array(fpg, proj);
+    if (r < 0) return r;        /* project array-based tree and */
+  }                             /* find freq. item sets recursively */
+  r = isr_report(fpg->report);  /* report the current item set */
+  if (r < 0) return r;          /* and check for an error */
+  isr_remove(fpg->report, 1);   /* remove the current item */
+  return r;                     /* from the item set reporter */
+}  /* arr_item() */
+
+/*--------------------------------------------------------------------*/
+
+static int rec_array (FPGROWTH *fpg, AFTREE *tree)
+{                               /* --- find item sets recursively */
+  int    r;                     /* error status */
+  ITEM   i, z;                  /* loop variables */
+  AFTREE *proj = NULL;          /* projected array-based tree */
+  ITEM   *s;                    /* to collect the tail items */
+
+  assert(fpg && tree);          /* check the function arguments */
+  #ifdef FPG_ABORT              /* if to check for interrupt */
+  if (sig_aborted()) return -1; /* if execution was aborted, */
+  #endif                        /* abort the recursion */
+  if (fpg->mode & FPG_TAIL) {   /* if to use head union tail pruning */
+    for (s = fpg->map, i = 0; i < tree->cnt; i++)
+      *--s = tree->heads[i].item;/* collect the tail items */
+    r = isr_tail(fpg->report, s, (ITEM)(fpg->map-s));
+    if (r) return r;            /* if tail needs no processing, */
+  }                             /* abort the recursion */
+  if ((tree->cnt > 1)           /* if there is more than one item */
+  &&  isr_xable(fpg->report,2)){/* and another item can be added */
+    proj = (AFTREE*)malloc(sizeof(AFTREE)
+                         +(size_t)(tree->cnt-2) *sizeof(AFHEAD));
+    if (!proj) return -1;       /* create an array-based tree */
+    proj->dir   = tree->dir;    /* of the maximally possible size */
+    proj->max   = 0;            /* and copy the processing direction */
+    proj->nodes = NULL;         /* (the node array is allocated */
+  }                             /* and enlarged as needed) */
+  if (tree->dir > 0) { z = tree->cnt; i = 0; }
+  else               { z = -1;        i = tree->cnt-1; }
+  for (r = 0; i != z; i += tree->dir) {
+    #ifdef VISITED              /* if to report visited search nodes */
+    fpg->visited += 1;          /* count current node as visited */
+    #endif
+    r = arr_item(fpg, tree, proj, i);
+    if (r < 0) break;           /* process the (frequent) items */
+  }                             /* (extend the current item set) */
+  if (proj) {                   /* delete the created projection */
+    if (proj->nodes) free(proj->nodes);
+    free(proj);                 /* (node array and tree) */
+  }
+  return r;                     /* return the error status */
+}  /* rec_array() */
+
+/*--------------------------------------------------------------------*/
+
+static int arr_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  FPGPAR   *par = (FPGPAR*)data;/* type the data pointer */
+  FPGROWTH *fpg;                /* copy of the fpgrowth miner */
+  AFTREE   *tree;               /* top-level array-based tree */
+  ITEM     i;                   /* index of the item to process */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  fpg  = par->thds +thread;     /* get the miner copy of the thread */
+  tree = (AFTREE*)par->tree;    /* and the top-level tree */
+  i = (tree->dir > 0) ? par->beg +(ITEM)task : par->end-1 -(ITEM)task;
+  if (isr_task(fpg->report, task) < 0) return -1;
+  return arr_item(fpg, tree, (AFTREE*)par->projs[thread], i);
+}  /* arr_task() */              /* process the item / node section */
+
+/*--------------------------------------------------------------------*/
+
+static int par_array (FPGROWTH *fpg, AFTREE *tree)
+{                               /* --- parallel version of rec_array */
+  int    r, i;                  /* error status, loop variable */
+  FPGPAR par;                   /* data for the parallel search */
+  AFTREE *proj;                 /* to traverse the projections */
+
+  assert(fpg && tree);          /* check the function arguments */
+  if ((fpg->mode & FPG_TAIL)    /* tail pruning needs a repository */
+  ||  (tree->cnt < 2) || !isr_xable(fpg->report, 2))
+    return rec_array(fpg, tree);
+  r = par_init(&par, fpg, tree->cnt, sizeof(AFTREE)
+              +(size_t)(tree->cnt-2) *sizeof(AFHEAD), 0);
+  if (r <= 0)                   /* if no parallel search is possible, */
+    return (r < 0) ? r : rec_array(fpg, tree); /* use rec_array */
+  for (i = 0; i < par.cnt; i++) {
+    proj = (AFTREE*)par.projs[i];  /* traverse the projections */
+    proj->dir   = tree->dir;    /* copy the processing direction */
+    proj->max   = 0;            /* and clear the node array */
+    proj->nodes = NULL;         /* (is allocated by the thread) */
+  }
+  par.tree = tree;              /* note the top-level tree */
+  par.beg  = 0; par.end = tree->cnt;
+  for (i = 0; i < tree->cnt; i++) /* use supports as size hints */
+    par.wgts[(tree->dir > 0) ? i : tree->cnt-1-i] =
+      (double)tree->heads[i].supp;
+  r = tp_execx(par.cnt, (long)tree->cnt, arr_task, &par, par.wgts);
+  for (i = 0; i < par.cnt; i++) {
+    proj = (AFTREE*)par.projs[i];  /* delete the node arrays */
+    if (proj->nodes) free(proj->nodes);
+  }                             /* of the projections */
+  return par_exit(&par, r);     /* process the items in parallel */
+}  /* par_array() */
+
+/*--------------------------------------------------------------------*/
+
+int fpg_array (FPGROWTH *fpg)
+{                               /* --- search for frequent item sets */
+  int        r = 0;             /* result of recursion/functions */
+  int        pass;              /* pass over the transactions */
+  ITEM       i, k, m;           /* loop variable, number of items */
+  SUPP       pex;               /* minimum support for perf. exts. */
+  TRACT      *t;                /* to traverse the transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
+  ITEM       *s, *d;            /* to build the item maps */
+  const ITEM *p;                /* to traverse transaction items */
+  const SUPP *f;                /* item frequencies in trans. bag */
+  AFTREE     *tree;             /* created array-based tree */
+  AFHEAD     *h;                /* to traverse the item heads */
+
+  assert(fpg);                  /* check the function arguments */
+  if (tbg_extent(fpg->tabag) > (size_t)INT_MAX)
+    return fpg_simple(fpg);     /* node indices must fit into int */
+  pex = tbg_wgt(fpg->tabag);    /* check against the minimum support */
+  if (fpg->supp > pex) return 0;/* and get minimum for perfect exts. */
+  if (!(fpg->mode & FPG_PERFECT)) pex = SUPP_MAX;
+  k = tbg_itemcnt(fpg->tabag);  /* get and check the number of items */
+  if (k <= 0) return isr_report(fpg->report);
+  f = tbg_ifrqs(fpg->tabag, 0); /* get the item frequencies */
+  if (!f) return -1;            /* in the transaction bag */
+  s = fpg->set = (ITEM*)malloc((size_t)(k+k) *sizeof(ITEM)
+                              +(size_t) k    *sizeof(SUPP));
+  if (!s) return -1;            /* create item and support arrays */
+  fpg->map = d = s+k;           /* note item map and set buffer */
+  fpg->cis = (SUPP*)(d+k);      /* and the item support array */
+  for (i = m = 0; i < k; i++) { /* build the item identifier map */
+    if (f[i] <  fpg->supp) { d[i] = -1; continue; }
+    if (f[i] >= pex)       { isr_addpex(fpg->report, i);
+                             d[i] = -1; continue; }
+    d[i] = m; s[m++] = i;       /* eliminate infrequent items and */
+  }                             /* collect perfect extension items */
+  if (m <= 0) {                 /* check whether there are items left */
+    r = isr_report(fpg->report); free(fpg->set); return r; }
+  fpg->dir = (fpg->target & (ISR_CLOSED|ISR_MAXIMAL)) ? -1 : +1;
+  tree = (AFTREE*)malloc(sizeof(AFTREE) +(size_t)(m-1) *sizeof(AFHEAD));
+  if (!tree) { free(fpg->set); return -1; }
+  tree->cnt   = k = m;          /* allocate the base tree structure */
+  tree->dir   = fpg->dir;       /* and initialize its fields */
+  tree->max   = 0;
+  tree->nodes = NULL;
+  for (i = 0; i < k; i++) {     /* initialize the header table */
+    h = tree->heads+i; h->supp = f[h->item = s[i]]; }
+  afs_init(tree);               /* clear the node counters */
+  for (pass = 0; (pass < 2) && (r >= 0); pass++) {
+    if ((pass > 0) && (afs_alloc(tree) < 0)) { r = -1; break; }
+    cur = tbc_create(fpg->tabag);/* create a cursor for the bag */
+    if (!cur) { r = -1; break; }/* (transactions may be compressed) */
+    while ((t = tbc_next(cur))) {   /* traverse the transactions */
+      for (k = 0, p = ta_items(t); *p > TA_END; p++)
+        if ((m = d[*p]) >= 0) s[k++] = m;
+      if (pass <= 0) afs_count(tree, s, k);
+      else           afs_add  (tree, s, k, ta_wgt(t));
+    }                           /* count the nodes in a first pass, */
+    tbc_delete(cur);            /* store them in a second pass */
+  }                             /* and delete the bag cursor */
+  if (r >= 0) {                 /* if the tree was built, */
+    r = par_array(fpg, tree);   /* find freq. item sets recursively */
+    if (r >= 0) r = isr_report(fpg->report);
+  }                             /* report the empty item set */
+  if (tree->nodes) free(tree->nodes);
+  free(tree); free(fpg->set);   /* delete the array-based tree */
+  return r;                     /* return the error status */
+}  /* fpg_array() */
+
 /*----------------------------------------------------------------------
   Frequent Pattern Growth (on single tree, for rules)
 ----------------------------------------------------------------------*/
@@ -1743,11 +2462,11 @@ int fpg_tree (FPGROWTH *fpg)
 {                               /* --- search for frequent item sets */
   int        r = 0;             /* result of recursion/functions */
   ITEM       i, k, m;           /* loop variable, number of items */
-  TID        j, n;              /* loop variable, number of trans. */
   ITEM       *s, *d;            /* to build the item maps */
   const ITEM *p;                /* to traverse transaction items */
   const SUPP *f;                /* item frequencies in trans. bag */
   TRACT      *t;                /* to traverse the transactions */
+  TBGCUR     *cur;              /* cursor for the transaction bag */
   FPTREE     *tree;             /* created frequent pattern tree */
   FPHEAD     *h;                /* to traverse the item heads */
 
@@ -1775,9 +2494,9 @@ int fpg_tree (FPGROWTH *fpg)
   tree->root.succ = tree->root.parent = NULL;
   for (i = 0; i < k; i++) {     /* initialize the item heads */
     h = tree->heads+i; h->supp = f[h->item = s[i]]; h->list = NULL; }
-  n = tbg_cnt(fpg->tabag);      /* get the number of transactions */
-  for (j = n; --j >= 0; ) {     /* traverse the transactions and */
-    t = tbg_tract(fpg->tabag,j);/* collect the non-eliminated items */
+  cur = tbc_create(fpg->tabag); /* create a cursor for the bag */
+  r   = (cur) ? 0 : -1;         /* (transactions may be compressed) */
+  while (cur && (t = tbc_next(cur))) { /* traverse the trans. */
     for (k = 0, p = ta_items(t); *p > TA_END; p++) {
       if      ((m = *p)   <  0) s[k++] = m;
       else if ((m = d[m]) >= 0) s[k++] = m;
@@ -1785,6 +2504,7 @@ int fpg_tree (FPGROWTH *fpg)
     r = add_simple(tree, s, k, ta_wgt(t));
     if (r < 0) break;           /* add the reduced transaction */
   }                             /* to the frequent pattern tree */
+  if (cur) tbc_delete(cur);     /* delete the bag cursor */
   if (r >= 0)                   /* find freq. item sets recursively */
     r = rec_tree(fpg, tree, tree->cnt);
   ms_delete(tree->mem);         /* delete the memory mgmt. system */
@@ -1801,6 +2521,7 @@ static FPGFN* fpgvars[] = {     /* --- table of fp-growth variants */
   fpg_cmplx,                    /* complex nodes (children/sibling) */
   fpg_single,                   /* top-down processing w/ single tree */
   fpg_topdn,                    /* top-down processing of the tree */
+  fpg_array,                    /* nodes in arrays (parent indices) */
 };
 
 /*--------------------------------------------------------------------*/
@@ -1857,6 +2578,7 @@ FPGROWTH* fpg_create (int target, double smin, double smax,
   fpg->thresh = thresh/100.0;
   fpg->algo   = algo;
   fpg->mode   = mode;
+  fpg->threads = 1;
   fpg->tabag  = NULL;
   fpg->report = NULL;
   fpg->dir    = 1;
@@ -1919,7 +2641,6 @@ int fpg_data (FPGROWTH *fpg, TABAG *tabag, int mode, int sort)
 
   /* --- make parameters consistent --- */
   pack = fpg->mode & FPG_FIM16; /* get number of items to pack */
-  if (pack > 16) pack = 16;     /* pack at most 16 items */
   if (fpg->algo == FPG_COMPLEX) /* for complex fp-trees, if needed, */
     pack = 0;                   /* items are packed in the recursion */
   if (mode & FPG_NOPACK)        /* if excluded by processing mode, */
@@ -1951,8 +2672,14 @@ int fpg_data (FPGROWTH *fpg, TABAG *tabag, int mode, int sort)
     if (!(mode & FPG_NOREDUCE)) /* if to combine equal transactions, */
       tbg_reduce(tabag, 0);     /* reduce transactions to unique ones */
   }                             /* (need sorting for reduction) */
-  if (pack > 0)                 /* if to use a 16-items machine, */
-    tbg_pack(tabag, pack);      /* pack the most frequent items */
+  if (pack > 0)                 /* if to use a k-items machine, */
+    tbg_pack(tabag, m16_width(tabag, pack));
+                                /* pack the most frequent items */
+  if (!(mode & FPG_COMPRESS)    /* if not to compress the bag */
+  ||  (tbg_compress(tabag) != 0))  /* or compression failed, */
+    tbg_flatten(tabag);         /* store the transactions in order */
+  /* If there is not enough memory for the contiguous storage, the */
+  /* transactions are simply kept where they are (no error).        */
   #ifndef QUIET                 /* if to print messages */
   n = tbg_cnt(tabag);           /* get the number of transactions */
   w = tbg_wgt(tabag);           /* and the transaction weight */
@@ -2007,7 +2734,7 @@ int fpg_report (FPGROWTH *fpg, ISREPORT *report)
 
 /*--------------------------------------------------------------------*/
 
-int fpg_mine (FPGROWTH *fpg, ITEM prune, int order)
+int fpg_mine (FPGROWTH *fpg, ITEM prune, int order, int threads)
 {                               /* --- fpgrowth algorithm */
   int      r;                   /* result of function call */
   ITEM     m, x;                /* number of items */
@@ -2022,6 +2749,7 @@ int fpg_mine (FPGROWTH *fpg, ITEM prune, int order)
   e = fpg->eval & ~FPG_INVBXS;  /* remove flags from measure code */
   if (e <= RE_NONE)             /* if there is no evaluation, */
     prune = ITEM_MIN;           /* do not prune with evaluation */
+  fpg->threads = threads;       /* note the number of threads */
 
   /* --- find frequent item sets/association rules --- */
   if (!(fpg->target & ISR_RULES)/* if to find plain item sets */
@@ -2135,11 +2863,13 @@ static void help (void)
                "(default)\n");
   printf("  d   top-down processing on a single prefix tree\n");
   printf("  t   top-down processing of the prefix trees\n");
+  printf("  r   simple tree nodes stored in arrays by item\n");
   printf("Variant 'd' does not support mining closed/maximal item ");
-  printf("sets,\nvariant 't' does not support the use of a k-items ");
-  printf("machine, and\nonly variant 'c' supports item reordering ");
-  printf("w.r.t. conditional support,\nbut closed/maximal item sets ");
-  printf("can only be mined without reordering.\nThese restrictions ");
+  printf("sets,\nvariants 't' and 'r' do not support the use of a ");
+  printf("k-items machine, and\nonly variant 'c' supports item ");
+  printf("reordering w.r.t. conditional support,\nbut closed/maximal ");
+  printf("item sets can only be mined without reordering.\n");
+  printf("These restrictions ");
   printf("may be removed in future versions of this program.\n");
   printf("Rules as the target type or using a rule-based evaluation ");
   printf("measure\nenforces algorithm variant 'd'.\n");
@@ -2259,11 +2989,13 @@ int main (int argc, char *argv[])
   int     sort     = 2;         /* flag for item sorting and recoding */
   int     algo     = 'c';       /* variant of fpgrowth algorithm */
   int     mode     = FPG_DEFAULT|FPG_PREFMT;   /* search mode */
+  int     prep     = 0;         /* data preparation mode */
   int     pack     = 16;        /* number of bit-packed items */
   int     mtar     = 0;         /* mode for transaction reading */
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     threads  = 1;         /* number of threads to use */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -2330,6 +3062,12 @@ int main (int argc, char *argv[])
     printf("-u       do not use head union tail (hut) pruning "
                     "(default: use hut)\n");
     printf("         (only for maximal item sets, option -tm)\n");
+    printf("-Y#      number of threads to use                 "
+                    "(default: %d)\n", threads);
+    printf("         (a value <= 0 means one thread per cpu, "
+                    "only for variants s, c, r)\n");
+    printf("-D       compress transactions in memory          "
+                    "(default: no)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -2374,7 +3112,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: y [A-Z]\[ACFINPRSZ] */
+  /* free option characters: y [A-Z]\[ACFINPRSYZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse the arguments */
@@ -2402,6 +3140,8 @@ int main (int argc, char *argv[])
           case 'l': pack   = (int) strtol(s, &s, 0); break;
           case 'j': mode  &= ~FPG_REORDER;           break;
           case 'u': mode  &= ~FPG_TAIL;              break;
+          case 'Y': threads = (int)strtol(s, &s, 0); break;
+          case 'D': prep  |= FPG_COMPRESS;           break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
@@ -2491,10 +3231,11 @@ int main (int argc, char *argv[])
     case 'c': algo = FPG_COMPLEX;            break;
     case 'd': algo = FPG_SINGLE;             break;
     case 't': algo = FPG_TOPDOWN;            break;
+    case 'r': algo = FPG_ARRAY;              break;
     default : error(E_VARIANT, (char)algo);  break;
   }                             /* (get fpgrowth algorithm code) */
   mode = (mode & ~FPG_FIM16)    /* add packed items to search mode */
-       | ((pack <= 0) ? 0 : (pack < 16) ? pack : 16);
+       | ((pack <= 0) ? 0 : (pack < 31) ? pack : 31);
   if (target & ISR_RULES)       /* if to find association rules, */
     fn_psp = NULL;              /* no pattern spectrum possible */
   if (info == dflt) {           /* if default info. format is used, */
@@ -2550,7 +3291,7 @@ int main (int argc, char *argv[])
   fpgrowth = fpg_create(target, smin, smax, conf, zmin, zmax,
                         eval, agg, thresh, algo, mode);
   if (!fpgrowth) error(E_NOMEM);/* create an fpgrowth miner */
-  k = fpg_data(fpgrowth, tabag, 0, sort);
+  k = fpg_data(fpgrowth, tabag, prep, sort);
   if (k) error(k);              /* prepare data for fpgrowth */
   report = isr_create(ibase);   /* create an item set reporter */
   if (!report) error(E_NOMEM);  /* and configure it */
@@ -2566,7 +3307,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)    /* open the item set file and */
     error(E_NOMEM);             /* set up the item set reporter */
-  k = fpg_mine(fpgrowth, prune, 0);
+  k = fpg_mine(fpgrowth, prune, 0, threads);
   if (k) error(k);              /* find frequent item sets */
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
@@ -10,6 +10,9 @@
             2014.08.28 functions fpg_data() and fpg_report() added
             2016.11.20 fpgrowth miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 parameter 'threads' added to fpg_mine()
+            2026.10.17 data preparation mode FPG_COMPRESS added
+            2026.10.17 algorithm variant FPG_ARRAY added
 ----------------------------------------------------------------------*/
 #ifndef __FPGROWTH__
 #define __FPGROWTH__
@@ -34,6 +37,7 @@
 #define FPG_NOSORT    0x0004    /* do not sort items and transactions */
 #define FPG_NOREDUCE  0x0008    /* do not reduce transactions */
 #define FPG_NOPACK    0x0010    /* do not pack most frequent items */
+#define FPG_COMPRESS  0x0020    /* compress the transaction bag */
 #define FPG_SURR      (FPG_NORECODE|FPG_NOFILTER|FPG_NOREDUCE)
 
 /* --- evaluation measures --- */
@@ -53,7 +57,8 @@
 #define FPG_COMPLEX   1         /* complex nodes (children/sibling) */
 #define FPG_SINGLE    2         /* top-down processing on single tree */
 #define FPG_TOPDOWN   3         /* top-down processing of the tree */
-#define FPG_AUTO      4         /* automatic choice */
+#define FPG_ARRAY     4         /* nodes in arrays (parent indices) */
+#define FPG_AUTO      5         /* automatic choice */
 
 /* --- operation modes --- */
 #define FPG_FIM16     0x001f    /* use 16 items machine (bit rep.) */
@@ -90,5 +95,6 @@ extern void      fpg_delete (FPGROWTH *fpg, int deldar);
 extern int       fpg_data   (FPGROWTH *fpg, TABAG *tabag,
                              int mode, int sort);
 extern int       fpg_report (FPGROWTH *fpg, ISREPORT *report);
-extern int       fpg_mine   (FPGROWTH *fpg, ITEM prune, int order);
+extern int       fpg_mine   (FPGROWTH *fpg, ITEM prune, int order,
+                             int threads);
 #endif
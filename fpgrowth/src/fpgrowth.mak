@@ -8,6 +8,7 @@
 #           2011.09.20 external module fim16 added (16 items machine)
 #           2014.08.21 extended by module istree from apriori source
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 external module tpool added (thread pool)
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\fpgrowth\src
 UTILDIR  = ..\..\util\src
@@ -29,14 +30,16 @@ HDRS     = $(UTILDIR)\fntypes.h    $(UTILDIR)\arrays.h     \
            $(UTILDIR)\error.h      $(MATHDIR)\ruleval.h    \
            $(TRACTDIR)\tract.h     $(TRACTDIR)\patspec.h   \
            $(TRACTDIR)\clomax.h    $(TRACTDIR)\report.h    \
-           $(APRIDIR)\istree.h     fpgrowth.h
+           $(APRIDIR)\istree.h     $(UTILDIR)\tpool.h      \
+           fpgrowth.h
 OBJS     = $(UTILDIR)\memsys.obj   $(UTILDIR)\arrays.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\escape.obj   \
            $(UTILDIR)\tabread.obj  $(UTILDIR)\tabwrite.obj \
            $(UTILDIR)\scform.obj   $(MATHDIR)\gamma.obj    \
            $(MATHDIR)\chi2.obj     $(MATHDIR)\ruleval.obj  \
            $(TRACTDIR)\clomax.obj  $(TRACTDIR)\repcm.obj   \
-           $(TRACTDIR)\fim16.obj   $(APRIDIR)\istree.obj
+           $(TRACTDIR)\fim16.obj   $(APRIDIR)\istree.obj   \
+           $(UTILDIR)\tpool.obj
 
 FPGOBJS  = $(OBJS)                 $(TRACTDIR)\taread.obj  \
            $(TRACTDIR)\patspec.obj fpgmain.obj
@@ -112,6 +115,10 @@ $(UTILDIR)\random.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak    random.obj   ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(UTILDIR)\tpool.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak    tpool.obj    ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(MATHDIR)\ruleval.obj:
 	cd $(MATHDIR)
         $(MAKE) /f math.mak    ruleval.obj  ADDFLAGS="$(ADDFLAGS)"
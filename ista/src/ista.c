@@ -35,6 +35,8 @@
             2017.03.24 ista miner object and interface introduced
             2017.05.30 optional output compression with zlib added
             2017.06.13 bug in reporting mode fixed (ISR_NOFILTER)
+            2026.10.16 multi-threaded intersection of partitions added
+            2026.10.17 partitions replaced by parallel pxt_isect()
 ------------------------------------------------------------------------
   Reference for the IsTa algorithm:
     C. Borgelt, X. Yang, R. Nogales-Cadenas,
@@ -335,7 +337,7 @@ int ista_report (ISTA *ista, ISREPORT *report)
 
 /*--------------------------------------------------------------------*/
 
-int ista_mine (ISTA *ista)
+int ista_mine (ISTA *ista, int threads)
 {                               /* --- intersecting transactions */
   int      r;                   /* result of function call, buffer */
   ITEM     m, k, z;             /* number of items, buffers */
@@ -366,7 +368,9 @@ int ista_mine (ISTA *ista)
   else {                        /* if to use a prefix tree */
     ista->pxt = pxt_create(m, -1, NULL);
     if (!ista->pxt) return cleanup(ista);
-  }                             /* create a prefix tree */
+    if ((threads != 1) && (pxt_threads(ista->pxt, threads) < 0))
+      return cleanup(ista);     /* create a prefix tree and */
+  }                             /* prepare parallel intersections */
   n = tbg_cnt(ista->tabag);     /* get the number of transactions */
   for (k = 0; --n >= 0; ) {     /* traverse the transactions */
     #ifdef ISTA_ABORT           /* if to check for interrupt */
@@ -554,6 +558,7 @@ int main (int argc, char *argv[])
   int     sort     = -2;        /* flag for item sorting and recoding */
   int     algo     = ISTA_PREFIX;  /* variant of IsTa algorithm */
   int     mode     = ISTA_DEFAULT|ISTA_PREFMT;   /* search mode */
+  int     threads  = 1;         /* number of threads to use */
   int     mtar     = 0;         /* mode for transaction reading */
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
@@ -606,6 +611,10 @@ int main (int argc, char *argv[])
     printf("-j       filter maximal item sets with repository "
                     "(default: extra)\n");
     printf("         (needs less memory, but is usually slower)\n");
+    printf("-Y#      number of threads to use                 "
+                    "(default: %d)\n", threads);
+    printf("         (a value <= 0 means one thread per cpu,\n"
+           "          only with a prefix tree)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -669,6 +678,7 @@ int main (int argc, char *argv[])
           case 'i': algo   =  ISTA_PATRICIA;         break;
           case 'p': mode  &= ~ISTA_PRUNE;            break;
           case 'j': mode  |=  ISTA_FILTER;           break;
+          case 'Y': threads = (int)strtol(s, &s, 0); break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
@@ -778,7 +788,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)    /* open the item set file and */
     error(E_NOMEM);             /* set up the item set reporter */
-  k = ista_mine(ista);          /* find frequent item sets */
+  k = ista_mine(ista, threads); /* find frequent item sets */
   if (k) error(k);              /* with the IsTa algorithm */
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
@@ -6,6 +6,7 @@
             2014.08.28 functions ista_data() and ista_report() added
             2017.03.24 ista miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 parameter 'threads' added to ista_mine()
 ----------------------------------------------------------------------*/
 #ifndef __ISTA__
 #define __ISTA__
@@ -58,5 +59,5 @@ extern ISTA* ista_create (int target, double smin, double smax,
 extern void  ista_delete (ISTA *ista, int deldar);
 extern int   ista_data   (ISTA *ista, TABAG *tabag, int sort);
 extern int   ista_report (ISTA *ista, ISREPORT *report);
-extern int   ista_mine   (ISTA *ista);
+extern int   ista_mine   (ISTA *ista, int threads);
 #endif
@@ -6,6 +6,7 @@
 #           2010.08.22 module escape added (for module tabread)
 #           2011.12.01 module clomax added (for module report)
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 external module tpool added (thread pool)
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\ista\src
 UTILDIR  = ..\..\util\src
@@ -26,13 +27,15 @@ HDRS_T   = $(UTILDIR)\fntypes.h    $(UTILDIR)\arrays.h     \
            $(TRACTDIR)\report.h
 HDRS     = $(HDRS_T)               $(UTILDIR)\error.h      \
            $(UTILDIR)\tabread.h    $(UTILDIR)\tabwrite.h   \
-           $(TRACTDIR)\patspec.h   pfxtree.h pattree.h ista.h
+           $(UTILDIR)\tpool.h      $(TRACTDIR)\patspec.h   \
+           pfxtree.h pattree.h ista.h
 OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\memsys.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\escape.obj   \
            $(UTILDIR)\tabread.obj  $(UTILDIR)\tabwrite.obj \
            $(UTILDIR)\scform.obj   $(TRACTDIR)\taread.obj  \
            $(TRACTDIR)\patspec.obj $(TRACTDIR)\clomax.obj  \
-           $(TRACTDIR)\repcm.obj   pfxtree.obj pattree.obj ista.obj
+           $(TRACTDIR)\repcm.obj   $(UTILDIR)\tpool.obj    \
+           pfxtree.obj pattree.obj ista.obj
 PRGS     = ista.exe
 
 #-----------------------------------------------------------------------
@@ -94,6 +97,10 @@ $(UTILDIR)\scform.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak scform.obj   ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(UTILDIR)\tpool.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak tpool.obj    ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(TRACTDIR)\taread.obj:
 	cd $(TRACTDIR)
 	$(MAKE) /f tract.mak taread.obj  ADDFLAGS="$(ADDFLAGS)"
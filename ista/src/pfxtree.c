@@ -22,6 +22,8 @@
             2012.04.29 special maximal item set functions added
             2013.04.01 adapted to type changes in module tract
             2013.10.15 checks of return code of isr_report() added
+            2026.10.16 functions pxt_join() and pxt_merge() added
+            2026.10.17 pxt_join()/pxt_merge() replaced by pxt_threads()
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -30,6 +32,7 @@
 #include <assert.h>
 #include "arrays.h"
 #include "pfxtree.h"
+#include "tpool.h"
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -39,6 +42,26 @@
 ----------------------------------------------------------------------*/
 #define pos(x,y)  ((x) < (y))   /* macros for item comparison */
 #define neg(x,y)  ((x) > (y))   /* (ascending and descending) */
+#ifndef PAR_MIN                 /* minimum number of nodes */
+#define PAR_MIN   65536         /* for a parallel intersection */
+#endif
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- thread data --- */
+  MEMSYS         *mem;          /* memory system for new tree nodes */
+  MEMSYS         *buf;          /* memory system for buffer nodes */
+  PFXNODE        root;          /* root node of the buffer tree */
+} PFXTHD;                       /* (thread data) */
+
+typedef struct pfxpar {         /* --- parallel intersection --- */
+  PFXTREE        *pxt;          /* prefix tree to work on */
+  int            cnt;           /* number of threads */
+  PFXNODE        **nodes;       /* root children to process */
+  PFXNODE        **srcs;        /* collected nodes per item/thread */
+  PFXTHD         thds[1];       /* data of the threads */
+} PFXPAR;                       /* (parallel intersection) */
 
 /*----------------------------------------------------------------------
   Main Functions
@@ -59,6 +82,7 @@ PFXTREE* pxt_create (ITEM size, int dir, MEMSYS *mem)
   pxt->last = 0;                /* and initialize the other fields */
   pxt->min  = pxt->supp = 0;
   pxt->rep  = NULL;
+  pxt->par  = NULL;
   pxt->root.item     = -1;      /* initialize the root node */
   pxt->root.supp     = 0; pxt->root.step = 0;
   pxt->root.children = pxt->root.sibling = NULL;
@@ -80,6 +104,21 @@ static void delete (PFXNODE *node, MEMSYS *mem)
 
 /*--------------------------------------------------------------------*/
 
+static void par_delete (PFXPAR *par)
+{                               /* --- delete parallel data */
+  int k;                        /* loop variable for threads */
+
+  assert(par);                  /* check the function argument */
+  for (k = 0; k < par->cnt; k++) {
+    if (par->thds[k].mem) ms_delete(par->thds[k].mem);
+    if (par->thds[k].buf) ms_delete(par->thds[k].buf);
+  }                             /* delete the memory systems */
+  if (par->nodes) free(par->nodes);
+  free(par);                    /* delete the node arrays */
+}  /* par_delete() */            /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
 void pxt_delete (PFXTREE *pxt, int delms)
 {                               /* --- delete a prefix tree */
   assert(pxt);                  /* check the function arguments */
@@ -87,11 +126,48 @@ void pxt_delete (PFXTREE *pxt, int delms)
     ms_delete(pxt->mem);        /* delete the memory system */
   else                          /* otherwise delete the nodes */
     delete(pxt->root.children, pxt->mem);
+  if (pxt->par) par_delete(pxt->par);
   free(pxt);                    /* delete the base structure */
 }  /* pxt_delete() */
 
 /*--------------------------------------------------------------------*/
 
+int pxt_threads (PFXTREE *pxt, int threads)
+{                               /* --- set the number of threads */
+  int    k;                     /* loop variable for threads */
+  PFXPAR *par;                  /* data for parallel intersection */
+
+  assert(pxt && !pxt->root.children);  /* check function arguments */
+  if (pxt->par) { par_delete(pxt->par); pxt->par = NULL; }
+  if (threads <= 0) threads = tp_cpucnt();
+  if (threads <= 1) return 1;   /* check for multiple threads */
+  par = (PFXPAR*)calloc(1, sizeof(PFXPAR)
+                          +(size_t)(threads-1) *sizeof(PFXTHD));
+  if (!par) return -1;          /* create the parallel data */
+  par->pxt   = pxt;             /* note the prefix tree */
+  par->cnt   = threads;         /* and the number of threads */
+  par->nodes = (PFXNODE**)calloc((size_t)pxt->size
+                                *(size_t)(threads+1), sizeof(PFXNODE*));
+  if (!par->nodes) { free(par); return -1; }
+  par->srcs  = par->nodes +pxt->size;
+  for (k = 0; k < threads; k++) {
+    par->thds[k].mem = ms_create(sizeof(PFXNODE), 65535);
+    par->thds[k].buf = ms_create(sizeof(PFXNODE), 65535);
+    if (!par->thds[k].mem || !par->thds[k].buf) {
+      par_delete(par); return -1; }
+  }                             /* create the memory systems */
+  pxt->par = par;               /* of the threads */
+  return threads;               /* return the number of threads */
+}  /* pxt_threads() */
+
+/* This function must be called while the tree is still empty. Since  */
+/* nodes that are allocated from the memory systems of the threads    */
+/* may be freed into the memory system of the tree, the tree must     */
+/* have its own memory system and must be deleted with pxt_delete()   */
+/* with a nonzero second argument if pxt_threads() has been used.     */
+
+/*--------------------------------------------------------------------*/
+
 int pxt_add (PFXTREE *pxt, const ITEM *items, ITEM n, SUPP supp)
 {                               /* --- add item set to prefix tree */
   ITEM    i;                    /* buffer for an item */
@@ -135,23 +211,24 @@ int pxt_add (PFXTREE *pxt, const ITEM *items, ITEM n, SUPP supp)
 /*--------------------------------------------------------------------*/
 
 #define ISECT(dir) \
-static int isect_##dir (PFXNODE *node, PFXNODE **ins, PFXTREE *pxt)    \
+static int isect_##dir (PFXNODE *node, PFXNODE **ins, PFXTREE *pxt,    \
+                        MEMSYS *mem)                                   \
 {                               /* --- intersect with an item set */   \
   ITEM    i;                    /* buffer for current item */          \
   PFXNODE *d;                   /* to allocate new nodes */            \
                                                                        \
-  assert(node && ins && pxt);   /* check the function arguments */     \
+  assert(node && ins && pxt && mem);   /* check function arguments */  \
   for ( ; node; node = node->sibling) {                                \
     i = node->item;             /* traverse the node list */           \
     if (node->step >= pxt->step) { /* if the node has been visited */  \
       if (!dir(i, pxt->last)) break;                                   \
       if (node->children        /* if the node has child nodes */      \
-      && (isect_##dir(node->children, &node->children, pxt) < 0))      \
+      && (isect_##dir(node->children, &node->children, pxt,mem) < 0))  \
         return -1; }            /* intersect subtree with item set */  \
     else if (!pxt->mins[i]) {   /* if item is not in intersection */   \
       if (!dir(i, pxt->last)) break;                                   \
       if (node->children        /* if there are child nodes */         \
-      && (isect_##dir(node->children, ins,             pxt) < 0))      \
+      && (isect_##dir(node->children, ins,             pxt,mem) < 0))  \
         return -1; }            /* intersect subtree with item set */  \
     else if (node->supp < pxt->mins[i]) { /* if not enough support */  \
       if (!dir(i, pxt->last)) break; }    /* skip the item */          \
@@ -159,7 +236,7 @@ static int isect_##dir (PFXNODE *node, PFXNODE **ins, PFXTREE *pxt)    \
       while ((d = *ins) && dir(d->item, i))                            \
         ins = &d->sibling;      /* find the insertion position */      \
       if (!d || (d->item != i)){/* if node does not exist */           \
-        d = (PFXNODE*)ms_alloc(pxt->mem);                              \
+        d = (PFXNODE*)ms_alloc(mem);                                   \
         if (!d) return -1;      /* allocate a new node and */          \
         d->item = i;            /* store the matched item */           \
         d->step = pxt->step;    /* set update step and support */      \
@@ -174,7 +251,7 @@ static int isect_##dir (PFXNODE *node, PFXNODE **ins, PFXTREE *pxt)    \
       }                         /* (update current intersection) */    \
       if (!dir(i, pxt->last)) break;                                   \
       if (node->children        /* if there are child nodes */         \
-      && (isect_##dir(node->children, &d->children, pxt) < 0))         \
+      && (isect_##dir(node->children, &d->children,    pxt,mem) < 0))  \
         return -1;              /* recursively intersect subtree */    \
     }                           /* with the rest of the item set */    \
   }                                                                    \
@@ -188,6 +265,219 @@ ISECT(neg)                      /* function for descending item order */
 
 /*--------------------------------------------------------------------*/
 
+#define COLLECT(dir) \
+static int collect_##dir (PFXNODE *node, PFXNODE **ins, PFXTREE *pxt,  \
+                          MEMSYS *mem)                                 \
+{                               /* --- collect intersections */        \
+  ITEM    i;                    /* buffer for current item */          \
+  PFXNODE *d;                   /* to allocate new nodes */            \
+                                                                       \
+  assert(node && ins && pxt && mem);   /* check function arguments */  \
+  for ( ; node; node = node->sibling) {                                \
+    i = node->item;             /* traverse the node list */           \
+    if      (!pxt->mins[i]) {   /* if item is not in intersection */   \
+      if (!dir(i, pxt->last)) break;                                   \
+      if (node->children        /* if there are child nodes */         \
+      && (collect_##dir(node->children, ins,          pxt, mem) < 0))  \
+        return -1; }            /* intersect subtree with item set */  \
+    else if (node->supp < pxt->mins[i]) { /* if not enough support */  \
+      if (!dir(i, pxt->last)) break; }    /* skip the item */          \
+    else {                      /* if item is in the intersection */   \
+      while ((d = *ins) && dir(d->item, i))                            \
+        ins = &d->sibling;      /* find the insertion position */      \
+      if (!d || (d->item != i)){/* if node does not exist */           \
+        d = (PFXNODE*)ms_alloc(mem);                                   \
+        if (!d) return -1;      /* allocate a new node and */          \
+        d->item = i;            /* store the matched item */           \
+        d->step = 0;            /* and the support of the subset */    \
+        d->supp = node->supp;   /* (trans. weight added later) */      \
+        d->sibling  = *ins; *ins = d;                                  \
+        d->children = NULL; }   /* insert node into sibling list */    \
+      else if (d->supp < node->supp) /* if a node already exists, */   \
+        d->supp = node->supp;   /* keep the maximum support */         \
+      if (!dir(i, pxt->last)) break;                                   \
+      if (node->children        /* if there are child nodes */         \
+      && (collect_##dir(node->children, &d->children, pxt, mem) < 0))  \
+        return -1;              /* recursively intersect subtree */    \
+    }                           /* with the rest of the item set */    \
+  }                                                                    \
+  return 0;                     /* return 'ok' */                      \
+}  /* collect() */
+
+/*--------------------------------------------------------------------*/
+
+COLLECT(pos)                    /* function for ascending  item order */
+COLLECT(neg)                    /* function for descending item order */
+
+/*--------------------------------------------------------------------*/
+
+#define ABSORB(dir) \
+static int absorb_##dir (PFXNODE *src, PFXNODE **ins, PFXTREE *pxt,    \
+                         MEMSYS *mem, int rec)                         \
+{                               /* --- absorb collected nodes */       \
+  PFXNODE *d;                   /* to allocate new nodes */            \
+                                                                       \
+  assert(ins && pxt && mem);    /* check the function arguments */     \
+  for ( ; src; src = src->sibling) {                                   \
+    while ((d = *ins) && dir(d->item, src->item))                      \
+      ins = &d->sibling;        /* find the insertion position */      \
+    if (!d || (d->item != src->item)) {                                \
+      d = (PFXNODE*)ms_alloc(mem);                                     \
+      if (!d) return -1;        /* if node does not exist, */          \
+      d->item = src->item;      /* allocate a new node and */          \
+      d->step = pxt->step;      /* set update step and support */      \
+      d->supp = pxt->supp +src->supp;                                  \
+      d->sibling  = *ins; *ins = d;                                    \
+      d->children = NULL; }     /* insert node into sibling list */    \
+    else {                      /* if a node already exists */         \
+      if (d->step >= pxt->step) d->supp -= pxt->supp;                  \
+      if (d->supp < src->supp)  d->supp  = src->supp;                  \
+      d->supp += pxt->supp;     /* update the intersection support */  \
+      d->step  = pxt->step;     /* and set the current update step */  \
+    }                           /* (same as in function isect()) */    \
+    if (rec && src->children    /* recursively absorb the children */  \
+    && (absorb_##dir(src->children, &d->children, pxt, mem, 1) < 0))   \
+      return -1;                /* (merge with existing children) */   \
+    ins = &d->sibling;          /* continue after the absorbed node */ \
+  }                                                                    \
+  return 0;                     /* return 'ok' */                      \
+}  /* absorb() */
+
+/*--------------------------------------------------------------------*/
+
+ABSORB(pos)                     /* function for ascending  item order */
+ABSORB(neg)                     /* function for descending item order */
+
+/*--------------------------------------------------------------------*/
+
+static int coll_task (void *data, int thread, long task)
+{                               /* --- collect from a root subtree */
+  PFXPAR  *par = (PFXPAR*)data; /* type the data pointer */
+  PFXTHD  *thd;                 /* data of the executing thread */
+  PFXNODE *node;                /* root child to process */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  thd  = par->thds +thread;     /* get the thread data */
+  node = par->nodes[task];      /* and the root child to process */
+  if (!node->children) return 0;
+  return (par->pxt->dir < 0)    /* collect the intersections */
+    ? collect_neg(node->children, &thd->root.children, par->pxt,
+                  thd->buf)     /* in the buffer tree of the thread */
+    : collect_pos(node->children, &thd->root.children, par->pxt,
+                  thd->buf);
+}  /* coll_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int isect_task (void *data, int thread, long task)
+{                               /* --- intersect a root subtree */
+  PFXPAR  *par = (PFXPAR*)data; /* type the data pointer */
+  PFXTREE *pxt;                 /* prefix tree to work on */
+  MEMSYS  *mem;                 /* memory system for new nodes */
+  PFXNODE *node, *src;          /* root child to process, source */
+  PFXNODE **srcs;               /* collected nodes per thread */
+  ITEM    i;                    /* item of the root child */
+  int     k;                    /* loop variable for threads */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  pxt  = par->pxt;              /* get the prefix tree, */
+  mem  = par->thds[thread].mem; /* the memory system of the thread */
+  node = par->nodes[task];      /* and the root child to process */
+  i    = node->item;            /* get the collected nodes */
+  srcs = par->srcs +(size_t)i *(size_t)par->cnt;
+  for (k = 0; k < par->cnt; k++) {
+    if (!(src = srcs[k])) continue;
+    srcs[k] = NULL;             /* traverse the collected nodes */
+    if (!src->children) continue;
+    if (((pxt->dir < 0)         /* absorb the collected subtrees */
+    ?    absorb_neg(src->children, &node->children, pxt, mem, 1)
+    :    absorb_pos(src->children, &node->children, pxt, mem, 1)) < 0)
+      return -1;                /* (these are intersections of */
+  }                             /* preceding root subtrees) */
+  if (node->step < pxt->step) { /* if the node has not been visited */
+    if (node->supp < pxt->mins[i])
+      return 0;                 /* skip nodes with too low support */
+    node->supp += pxt->supp;    /* update the intersection support */
+    node->step  = pxt->step;    /* and set the current update step */
+  }
+  if (!node->children || (i == pxt->last))
+    return 0;                   /* check for child nodes */
+  return (pxt->dir < 0)         /* intersect the subtree in place */
+    ? isect_neg(node->children, &node->children, pxt, mem)
+    : isect_pos(node->children, &node->children, pxt, mem);
+}  /* isect_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_isect (PFXTREE *pxt)
+{                               /* --- parallel intersection */
+  int     r, k;                 /* error status, loop variable */
+  long    n;                    /* number of tasks */
+  ITEM    i;                    /* item of a root child */
+  PFXPAR  *par;                 /* data for parallel intersection */
+  PFXNODE *node;                /* to traverse the root children */
+
+  assert(pxt && pxt->par);      /* check the function argument */
+  par = pxt->par;               /* get the parallel data */
+  for (k = 0; k < par->cnt; k++) {
+    ms_clear(par->thds[k].buf, 1);
+    par->thds[k].root.children = NULL;
+  }                             /* clear the buffer trees */
+  n = 0;                        /* collect root children */
+  for (node = pxt->root.children; node; node = node->sibling) {
+    i = node->item;             /* with items not in transaction */
+    if ((pxt->dir < 0) ? !neg(i, pxt->last) : !pos(i, pxt->last))
+      break;                    /* (only these can be sources */
+    if (!pxt->mins[i]) par->nodes[n++] = node;
+  }                             /* for other root subtrees) */
+  if (tp_exec(par->cnt, n, coll_task, par) < 0)
+    return -1;                  /* collect their intersections */
+  for (k = 0; k < par->cnt; k++) {
+    if (((pxt->dir < 0)         /* absorb the collected root nodes */
+    ?    absorb_neg(par->thds[k].root.children, &pxt->root.children,
+                    pxt, pxt->mem, 0)
+    :    absorb_pos(par->thds[k].root.children, &pxt->root.children,
+                    pxt, pxt->mem, 0)) < 0)
+      return -1;                /* and note them with their items */
+    for (node = par->thds[k].root.children; node; node = node->sibling)
+      par->srcs[(size_t)node->item *(size_t)par->cnt +(size_t)k] = node;
+  }
+  n = 0;                        /* collect root children */
+  for (node = pxt->root.children; node; node = node->sibling) {
+    i = node->item;             /* with items in the transaction */
+    if (pxt->mins[i]) par->nodes[n++] = node;
+    if ((pxt->dir < 0) ? !neg(i, pxt->last) : !pos(i, pxt->last))
+      break;                    /* (these are the destinations */
+  }                             /* of the collected intersections) */
+  r = tp_exec(par->cnt, n, isect_task, par);
+  for (k = 0; k < par->cnt; k++) {
+    pxt->mem->used += par->thds[k].mem->used;
+    par->thds[k].mem->used = 0; /* transfer the node counts */
+  }                             /* to the memory system of the tree */
+  if (pxt->mem->used > pxt->mem->umax)
+    pxt->mem->umax = pxt->mem->used;
+  return r;                     /* return the error status */
+}  /* par_isect() */
+
+/* Root subtrees with items that are not in the transaction are only  */
+/* sources of intersections, and these intersections can only end up  */
+/* in root subtrees with smaller items (larger items, if the item     */
+/* order is ascending). Hence, in a first phase, these root subtrees  */
+/* are intersected in parallel into buffer trees (one per thread),    */
+/* which record the maximum support of the subsets. After the roots   */
+/* of the buffer trees have been absorbed into the root node list,    */
+/* each root subtree with an item in the transaction absorbs the      */
+/* collected subtrees and is then intersected in place, which again   */
+/* is independent of the other subtrees. This performs the same       */
+/* updates as the serial version (only in a different order), and     */
+/* since the support update takes the maximum of all subsets, the     */
+/* resulting tree is the same. New tree nodes are allocated from      */
+/* memory systems of the threads, the node counts of which are        */
+/* transferred to the memory system of the tree, so that the nodes    */
+/* can be freed into the latter.                                      */
+
+/*--------------------------------------------------------------------*/
+
 int pxt_isect (PFXTREE *pxt, const ITEM *items, ITEM n, SUPP supp,
                SUPP min, const SUPP *frqs)
 {                               /* --- intersect with an item set */
@@ -215,9 +505,11 @@ int pxt_isect (PFXTREE *pxt, const ITEM *items, ITEM n, SUPP supp,
   /* subtrees rooted at nodes with the item, which could still become */
   /* become frequent, may not be processed, thus losing results.      */
   pxt->step++;                  /* increment the update step */
+  if (pxt->par && (pxt_nodecnt(pxt) >= PAR_MIN))
+    return par_isect(pxt);      /* intersect large trees in parallel */
   return (pxt->dir < 0)         /* intersect tree with item set */
-    ? isect_neg(pxt->root.children, &pxt->root.children, pxt)
-    : isect_pos(pxt->root.children, &pxt->root.children, pxt);
+    ? isect_neg(pxt->root.children, &pxt->root.children, pxt, pxt->mem)
+    : isect_pos(pxt->root.children, &pxt->root.children, pxt, pxt->mem);
 }  /* pxt_isect() */
 
 /*--------------------------------------------------------------------*/
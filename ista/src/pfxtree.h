@@ -13,6 +13,8 @@
             2010.08.18 function pxt_nodecnt() added (number of nodes)
             2012.04.29 function pxt_super() added (check for superset)
             2013.04.01 adapted to type changes in module tract
+            2026.10.16 functions pxt_join() and pxt_merge() added
+            2026.10.17 pxt_join()/pxt_merge() replaced by pxt_threads()
 ----------------------------------------------------------------------*/
 #ifndef __PFXTREE__
 #define __PFXTREE__
@@ -34,6 +36,8 @@ typedef struct pfxnode {        /* --- a prefix tree node --- */
   struct pfxnode *children;     /* list of child nodes */
 } PFXNODE;                      /* (prefix tree node) */
 
+struct pfxpar;                  /* (parallel intersection data) */
+
 typedef struct {                /* --- a prefix tree --- */
   MEMSYS         *mem;          /* memory management system */
   ITEM           size;          /* number of items / array size */
@@ -43,6 +47,7 @@ typedef struct {                /* --- a prefix tree --- */
   SUPP           supp;          /* current support  (for pxt_isect) */
   SUPP           min;           /* minimum support   for reporting */
   ISREPORT       *rep;          /* item set reporter for reporting */
+  struct pfxpar  *par;          /* data for parallel intersection */
   PFXNODE        root;          /* root node of the prefix tree */
   SUPP           mins[1];       /* minimum support values */
 } PFXTREE;                      /* (prefix tree) */
@@ -52,6 +57,7 @@ typedef struct {                /* --- a prefix tree --- */
 ----------------------------------------------------------------------*/
 extern PFXTREE* pxt_create  (ITEM size, int dir, MEMSYS  *mem);
 extern void     pxt_delete  (PFXTREE *pxt, int delms);
+extern int      pxt_threads (PFXTREE *pxt, int threads);
 extern MEMSYS*  pxt_memsys  (PFXTREE *pxt);
 extern size_t   pxt_nodecnt (PFXTREE *pxt);
 extern size_t   pxt_nodemax (PFXTREE *pxt);
@@ -6,6 +6,9 @@
             2011.08.03 bug in re_fetprob fixed (roundoff error corr.)
             2012.02.15 function re_supp() added (rule support)
             2013.03.29 adapted to type changes in module tract (SUPP)
+            2026.10.17 batch versions of the measures added
+            2026.10.17 table of log-factorials for Fisher's exact test
+            2026.10.17 log-factorial table limited to max. item support
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -24,15 +27,35 @@
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
 #define LN_2        0.69314718055994530942  /* ln(2) */
+#define LF_MAX      (1 << 24)   /* max. size of log-factorial table */
+#define LF_KEEP     (1 << 16)   /* max. size of table kept w/o users */
 
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
 typedef struct {                /* --- rule evaluation info. --- */
   RULEVALFN *fn;                /* evaluation function */
+  RULEVECFN *vfn;               /* batch evaluation function */
   int       dir;                /* evaluation direction */
 } REINFO;                       /* (rule evaluation information) */
 
+/*----------------------------------------------------------------------
+  Global Variables
+----------------------------------------------------------------------*/
+static double *lftab = NULL;    /* table of log-factorials ln(n!) */
+static SUPP   lfcnt  = 0;       /* number of entries in the table */
+static int    lfref  = 0;       /* number of users of the table */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static double logfact (SUPP n)
+{                               /* --- logarithm of n factorial */
+  assert(n >= 0);               /* check the function argument */
+  return (n < lfcnt) ? lftab[(size_t)n] : logGamma((double)(n+1));
+}  /* logfact() */              /* use the table if possible */
+
 /*----------------------------------------------------------------------
   Rule Evaluation Measures
 ----------------------------------------------------------------------*/
@@ -251,25 +274,25 @@ double re_fetprob (SUPP supp, SUPP body, SUPP head, SUPP base)
   }                             /* complement/exchange the marginals */
   if (head < body) {            /* ensure that body <= head */
     n = head; head = body; body = n; }
-  com = logGamma((double)(     head+1))
-      + logGamma((double)(     body+1))
-      + logGamma((double)(base-head+1))
-      + logGamma((double)(base-body+1))
-      - logGamma((double)(base+1));/* compute common probability term */
+  com = logfact(     head)
+      + logfact(     body)
+      + logfact(base-head)
+      + logfact(base-body)
+      - logfact(     base);     /* compute common probability term */
   cut = com                     /* and log of the cutoff probability */
-      - logGamma((double)(body-supp+1))
-      - logGamma((double)(head-supp+1))
-      - logGamma((double)(     supp+1))
-      - logGamma((double)(rest+supp+1));
+      - logfact(body-supp)
+      - logfact(head-supp)
+      - logfact(     supp)
+      - logfact(rest+supp);
   cut *= 1.0-DBL_EPSILON;       /* adapt for roundoff errors */
   /* cut must be multiplied with a value < 1 in order to increase it, */
   /* because it is the logarithm of a probability and hence negative. */
   for (sum = 0, supp = 0; supp <= body; supp++) {
     p = com                     /* traverse the contingency tables */
-      - logGamma((double)(body-supp+1))
-      - logGamma((double)(head-supp+1))
-      - logGamma((double)(     supp+1))
-      - logGamma((double)(rest+supp+1));
+      - logfact(body-supp)
+      - logfact(head-supp)
+      - logfact(     supp)
+      - logfact(rest+supp);
     if (p <= cut) sum += exp(p);/* sum probabilities greater */
   }                             /* than the cutoff probability */
   return sum;                   /* return computed probability */
@@ -294,11 +317,11 @@ double re_fetchi2 (SUPP supp, SUPP body, SUPP head, SUPP base)
   }                             /* complement/exchange the marginals */
   if (head < body) {            /* ensure that body <= head */
     n = head; head = body; body = n; }
-  com = logGamma((double)(     head+1))
-      + logGamma((double)(     body+1))
-      + logGamma((double)(base-head+1))
-      + logGamma((double)(base-body+1))
-      - logGamma((double)(base+1));/* compute common probability term */
+  com = logfact(     head)
+      + logfact(     body)
+      + logfact(base-head)
+      + logfact(base-body)
+      - logfact(     base);     /* compute common probability term */
   exs = (double)head *(double)body /(double)base;
   if ((double)supp < exs)
        { n =              (SUPP)ceil (exs+(exs-(double)supp)); }
@@ -307,23 +330,23 @@ double re_fetchi2 (SUPP supp, SUPP body, SUPP head, SUPP base)
   if (supp < 0) supp = -1;      /* clamp it to the possible maximum */
   if (n-supp-4 < supp+body-n) { /* if fewer less extreme tables */
     for (sum = 1; ++supp < n;){ /* traverse the less extreme tables */
-      sum -= exp(com -logGamma((double)(body-supp+1))
-                     -logGamma((double)(head-supp+1))
-                     -logGamma((double)(     supp+1))
-                     -logGamma((double)(rest+supp+1)));
+      sum -= exp(com -logfact(body-supp)
+                     -logfact(head-supp)
+                     -logfact(     supp)
+                     -logfact(rest+supp));
     } }                         /* sum the probability of the tables */
   else {                        /* if fewer more extreme tables */
     for (sum = 0; supp >= 0; supp--) {
-      sum += exp(com -logGamma((double)(body-supp+1))
-                     -logGamma((double)(head-supp+1))
-                     -logGamma((double)(     supp+1))
-                     -logGamma((double)(rest+supp+1)));
+      sum += exp(com -logfact(body-supp)
+                     -logfact(head-supp)
+                     -logfact(     supp)
+                     -logfact(rest+supp));
     }                           /* traverse the more extreme tables */
     for (supp = n; supp <= body; supp++) {
-      sum += exp(com -logGamma((double)(body-supp+1))
-                     -logGamma((double)(head-supp+1))
-                     -logGamma((double)(     supp+1))
-                     -logGamma((double)(rest+supp+1)));
+      sum += exp(com -logfact(body-supp)
+                     -logfact(head-supp)
+                     -logfact(     supp)
+                     -logfact(rest+supp));
     }                           /* sum the probability of the tables */
   }                             /* (upper and lower table ranges) */
   return sum;                   /* return computed probability */
@@ -348,18 +371,18 @@ double re_fetinfo (SUPP supp, SUPP body, SUPP head, SUPP base)
   }                             /* complement/exchange the marginals */
   if (head < body) {            /* ensure that body <= head */
     n = head; head = body; body = n; }
-  com = logGamma((double)(     head+1))
-      + logGamma((double)(     body+1))
-      + logGamma((double)(base-head+1))
-      + logGamma((double)(base-body+1))
-      - logGamma((double)(base+1));/* compute common probability term */
+  com = logfact(     head)
+      + logfact(     body)
+      + logfact(base-head)
+      + logfact(base-body)
+      - logfact(     base);     /* compute common probability term */
   cut = re_info(supp, body, head, base) *(1.0-DBL_EPSILON);
   for (sum = 0, supp = 0; supp <= body; supp++) {
     if (re_info(supp, body, head, base) >= cut)
-      sum += exp(com -logGamma((double)(body-supp+1))
-                     -logGamma((double)(head-supp+1))
-                     -logGamma((double)     (supp+1))
-                     -logGamma((double)(rest+supp+1)));
+      sum += exp(com -logfact(body-supp)
+                     -logfact(head-supp)
+                     -logfact(     supp)
+                     -logfact(rest+supp));
   }                             /* sum probs. of less extreme tables */
   return sum;                   /* return computed probability */
 }  /* re_fetinfo() */
@@ -382,53 +405,351 @@ double re_fetsupp (SUPP supp, SUPP body, SUPP head, SUPP base)
   }                             /* complement/exchange the marginals */
   if (head < body) {            /* ensure that body <= head */
     n = head; head = body; body = n; }
-  com = logGamma((double)(     head+1))
-      + logGamma((double)(     body+1))
-      + logGamma((double)(base-head+1))
-      + logGamma((double)(base-body+1))
-      - logGamma((double)(base+1));/* compute common probability term */
+  com = logfact(     head)
+      + logfact(     body)
+      + logfact(base-head)
+      + logfact(base-body)
+      - logfact(     base);     /* compute common probability term */
   if (supp <= body -supp) {     /* if fewer lesser support values */
     for (sum = 1.0; --supp >= 0; )
-      sum -= exp(com -logGamma((double)(body-supp+1))
-                     -logGamma((double)(head-supp+1))
-                     -logGamma((double)(     supp+1))
-                     -logGamma((double)(rest+supp+1))); }
+      sum -= exp(com -logfact(body-supp)
+                     -logfact(head-supp)
+                     -logfact(     supp)
+                     -logfact(rest+supp)); }
   else {                        /* if fewer greater support values */
     for (sum = 0.0; supp <= body; supp++)
-      sum += exp(com -logGamma((double)(body-supp+1))
-                     -logGamma((double)(head-supp+1))
-                     -logGamma((double)(     supp+1))
-                     -logGamma((double)(rest+supp+1)));
+      sum += exp(com -logfact(body-supp)
+                     -logfact(head-supp)
+                     -logfact(     supp)
+                     -logfact(rest+supp));
   }                             /* sum the table probabilities */
   return sum;                   /* return computed probability */
 }  /* re_fetsupp() */
 
 /*--------------------------------------------------------------------*/
 
+/*----------------------------------------------------------------------
+  Rule Evaluation Measures (batch versions)
+----------------------------------------------------------------------*/
+
+static void vnone (double *res, const SUPP *supp, const SUPP *body,
+                   const SUPP *head, SUPP base, size_t n)
+{                               /* --- no measure / constant zero */
+  size_t i;                     /* loop variable */
+  for (i = 0; i < n; i++) res[i] = 0;
+}  /* vnone() */
+
+/*--------------------------------------------------------------------*/
+
+static void vsupp (double *res, const SUPP *supp, const SUPP *body,
+                   const SUPP *head, SUPP base, size_t n)
+{                               /* --- rule support (body and head) */
+  size_t i;                     /* loop variable */
+  for (i = 0; i < n; i++) res[i] = (double)supp[i];
+}  /* vsupp() */
+
+/*--------------------------------------------------------------------*/
+
+static void vconf (double *res, const SUPP *supp, const SUPP *body,
+                   const SUPP *head, SUPP base, size_t n)
+{                               /* --- rule confidence */
+  size_t i;                     /* loop variable */
+  double b, t;                  /* body support, temporary buffer */
+
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    b = (double)body[i];        /* (a valid divisor is used for all */
+    t = (double)supp[i] /((b > 0) ? b : 1);  /* rules, so that the */
+    res[i] = (b > 0) ? t : 0;   /* loop needs no branches and can */
+  }                             /* be vectorized by the compiler) */
+}  /* vconf() */
+
+/*--------------------------------------------------------------------*/
+
+static void vconfdiff (double *res, const SUPP *supp, const SUPP *body,
+                       const SUPP *head, SUPP base, size_t n)
+{                               /* --- absolute confidence difference */
+  size_t i;                     /* loop variable */
+  double b, t;                  /* body support, temporary buffer */
+
+  if (base <= 0) { vnone(res, supp, body, head, base, n); return; }
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    b = (double)body[i];
+    t = fabs((double)supp[i]/((b > 0) ? b : 1)
+            -(double)head[i]/(double)base);
+    res[i] = (b > 0) ? t : 0;   /* compute the confidence difference */
+  }
+}  /* vconfdiff() */
+
+/*--------------------------------------------------------------------*/
+
+static void vlift (double *res, const SUPP *supp, const SUPP *body,
+                   const SUPP *head, SUPP base, size_t n)
+{                               /* --- lift value */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for a valid rule */
+  double t;                     /* temporary buffer */
+
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (body[i] > 0) && (head[i] > 0);
+    t = (v) ? (double)body[i]*(double)head[i] : 1;
+    t = ((double)supp[i]*(double)base) /t;
+    res[i] = (v) ? t : 0;       /* compute the lift value */
+  }
+}  /* vlift() */
+
+/*--------------------------------------------------------------------*/
+
+static void vliftdiff (double *res, const SUPP *supp, const SUPP *body,
+                       const SUPP *head, SUPP base, size_t n)
+{                               /* --- abs. difference of lift to 1 */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for a valid rule */
+  double t;                     /* temporary buffer */
+
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (body[i] > 0) && (head[i] > 0);
+    t = (v) ? (double)body[i]*(double)head[i] : 1;
+    t = fabs(((double)supp[i]*(double)base) /t -1);
+    res[i] = (v) ? t : 0;       /* compute the lift difference */
+  }
+}  /* vliftdiff() */
+
+/*--------------------------------------------------------------------*/
+
+static void vliftquot (double *res, const SUPP *supp, const SUPP *body,
+                       const SUPP *head, SUPP base, size_t n)
+{                               /* --- diff. of lift quotient to 1 */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for a valid rule */
+  double t;                     /* temporary buffer */
+
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (body[i] > 0) && (head[i] > 0);
+    t = (v) ? (double)body[i]*(double)head[i] : 1;
+    t = ((double)supp[i]*(double)base) /t;
+    t = 1 -((t > 1) ? 1/t : t); /* compute the lift quotient */
+    res[i] = (v) ? t : 0;       /* and its difference to 1 */
+  }
+}  /* vliftquot() */
+
+/*--------------------------------------------------------------------*/
+
+static void vcvct (double *res, const SUPP *supp, const SUPP *body,
+                   const SUPP *head, SUPP base, size_t n)
+{                               /* --- conviction */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for a valid rule */
+  double t;                     /* temporary buffer */
+
+  if (base <= 0) { vnone(res, supp, body, head, base, n); return; }
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (body[i] > supp[i]);    /* check for a valid rule */
+    t = (v) ? (double)(body[i]-supp[i])*(double)base : 1;
+    t = ((double)body[i]*(double)(base-head[i])) /t;
+    res[i] = (v) ? t : 0;       /* compute the conviction */
+  }
+}  /* vcvct() */
+
+/*--------------------------------------------------------------------*/
+
+static void vcvctdiff (double *res, const SUPP *supp, const SUPP *body,
+                       const SUPP *head, SUPP base, size_t n)
+{                               /* --- abs. diff. of conviction to 1 */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for a finite value */
+  double t;                     /* temporary buffer */
+
+  if (base <= 0) { vnone(res, supp, body, head, base, n); return; }
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (body[i] > supp[i]);    /* check for a finite conviction */
+    t = (v) ? (double)(body[i]-supp[i])*(double)base : 1;
+    t = fabs(((double)body[i]*(double)(base-head[i])) /t -1);
+    res[i] = (v) ? t : INFINITY;
+  }                             /* compute the conviction difference */
+}  /* vcvctdiff() */
+
+/*--------------------------------------------------------------------*/
+
+static void vcvctquot (double *res, const SUPP *supp, const SUPP *body,
+                       const SUPP *head, SUPP base, size_t n)
+{                               /* --- diff. of conviction quot. to 1 */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for a finite value */
+  double t;                     /* temporary buffer */
+
+  if (base <= 0) { vnone(res, supp, body, head, base, n); return; }
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (body[i] > supp[i]);    /* check for a finite conviction */
+    t = (v) ? (double)(body[i]-supp[i])*(double)base : 1;
+    t = ((double)body[i]*(double)(base-head[i])) /t;
+    t = 1 -((t > 1) ? 1/t : t); /* compute the conviction quotient */
+    res[i] = (v) ? t : INFINITY;/* and its difference to 1 */
+  }
+}  /* vcvctquot() */
+
+/*--------------------------------------------------------------------*/
+
+static void vcprob (double *res, const SUPP *supp, const SUPP *body,
+                    const SUPP *head, SUPP base, size_t n)
+{                               /* --- conditional probability ratio */
+  size_t i;                     /* loop variable */
+  int    v, f;                  /* flags for a valid/finite value */
+  double t;                     /* temporary buffer */
+
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (supp[i] > 0) && (body[i] > 0) && (base > body[i]);
+    f = (head[i] > supp[i]);    /* check for a valid/finite ratio */
+    t = (f) ? (double)body[i]*(double)(head[i]-supp[i]) : 1;
+    t = ((double)supp[i]*(double)(base-body[i])) /t;
+    res[i] = (!v) ? 0 : (f) ? t : INFINITY;
+  }                             /* compute the probability ratio */
+}  /* vcprob() */
+
+/*--------------------------------------------------------------------*/
+
+static void vimport (double *res, const SUPP *supp, const SUPP *body,
+                     const SUPP *head, SUPP base, size_t n)
+{                               /* --- importance */
+  size_t i;                     /* loop variable */
+
+  vcprob(res, supp, body, head, base, n);
+  for (i = 0; i < n; i++)       /* compute the probability ratios */
+    if ((res[i] > 0) && (res[i] < INFINITY))
+      res[i] = log(res[i])/LN_2;/* and their binary logarithms */
+}  /* vimport() */
+
+/*--------------------------------------------------------------------*/
+
+static void vcert (double *res, const SUPP *supp, const SUPP *body,
+                   const SUPP *head, SUPP base, size_t n)
+{                               /* --- certainty factor */
+  size_t i;                     /* loop variable */
+  double b, d, p;               /* body support, temporary buffers */
+
+  if (base <= 0) { vnone(res, supp, body, head, base, n); return; }
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    b = (double)body[i];
+    p = (double)head[i]/(double)base;
+    d = (double)supp[i]/((b > 0) ? b : 1) -p;
+    d = d / ((d >= 0) ? 1-p : p);
+    res[i] = (b > 0) ? d : 0;   /* compute the certainty factor */
+  }
+}  /* vcert() */
+
+/*--------------------------------------------------------------------*/
+
+static void vchi2 (double *res, const SUPP *supp, const SUPP *body,
+                   const SUPP *head, SUPP base, size_t n)
+{                               /* --- normalized chi^2 measure */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for non-vanishing marginals */
+  double t, d;                  /* temporary buffers */
+
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (head[i] > 0) && (head[i] < base)
+     && (body[i] > 0) && (body[i] < base);
+    t = (double)head[i] *(double)body[i] -(double)supp[i] *(double)base;
+    d = ((double)head[i])*(double)(base-head[i])
+       *((double)body[i])*(double)(base-body[i]);
+    t = (t*t) /((v) ? d : 1);   /* compute the chi^2 measure */
+    res[i] = (v) ? t : 0;       /* for valid marginals */
+  }
+}  /* vchi2() */
+
+/*--------------------------------------------------------------------*/
+
+static void vchi2pval (double *res, const SUPP *supp, const SUPP *body,
+                       const SUPP *head, SUPP base, size_t n)
+{                               /* --- p-value from chi^2 measure */
+  size_t i;                     /* loop variable */
+
+  vchi2(res, supp, body, head, base, n);
+  for (i = 0; i < n; i++)       /* compute the chi^2 measures */
+    res[i] = chi2cdfQ((double)base *res[i], 1);
+}  /* vchi2pval() */            /* and the corresponding p-values */
+
+/*--------------------------------------------------------------------*/
+
+static void vyates (double *res, const SUPP *supp, const SUPP *body,
+                    const SUPP *head, SUPP base, size_t n)
+{                               /* --- Yates corrected chi^2 measure */
+  size_t i;                     /* loop variable */
+  int    v;                     /* flag for non-vanishing marginals */
+  double t, d;                  /* temporary buffers */
+
+  for (i = 0; i < n; i++) {     /* traverse the rules */
+    v = (head[i] > 0) && (head[i] < base)
+     && (body[i] > 0) && (body[i] < base);
+    t = fabs((double)head[i] *(double)body[i]
+            -(double)supp[i] *(double)base) -0.5*(double)base;
+    d = ((double)head[i])*(double)(base-head[i])
+       *((double)body[i])*(double)(base-body[i]);
+    t = (t*t) /((v) ? d : 1);   /* compute the chi^2 measure */
+    res[i] = (v) ? t : 0;       /* for valid marginals */
+  }
+}  /* vyates() */
+
+/*--------------------------------------------------------------------*/
+
+static void vyatespval (double *res, const SUPP *supp, const SUPP *body,
+                        const SUPP *head, SUPP base, size_t n)
+{                               /* --- p-value from chi^2 measure */
+  size_t i;                     /* loop variable */
+
+  vyates(res, supp, body, head, base, n);
+  for (i = 0; i < n; i++)       /* compute the chi^2 measures */
+    res[i] = chi2cdfQ((double)base *res[i], 1);
+}  /* vyatespval() */           /* and the corresponding p-values */
+
+/*--------------------------------------------------------------------*/
+
+#define VECFN(vfn,fn) \
+static void vfn (double *res, const SUPP *supp, const SUPP *body,    \
+                 const SUPP *head, SUPP base, size_t n)              \
+{ size_t i;                                                          \
+  for (i = 0; i < n; i++)                                            \
+    res[i] = fn(supp[i], body[i], head[i], base); }
+
+VECFN(vinfo,     re_info)       /* information diff. to prior */
+VECFN(vinfopval, re_infopval)   /* p-value from G statistic */
+VECFN(vfetprob,  re_fetprob)    /* Fisher's exact test (prob.) */
+VECFN(vfetchi2,  re_fetchi2)    /* Fisher's exact test (chi^2) */
+VECFN(vfetinfo,  re_fetinfo)    /* Fisher's exact test (info.) */
+VECFN(vfetsupp,  re_fetsupp)    /* Fisher's exact test (supp.) */
+
+/* The batch versions of the simpler measures use the same divisions */
+/* as the functions above, but with a valid divisor for all rules and */
+/* a final selection instead of early returns. Hence they yield the   */
+/* same values and the compiler can vectorize their loops. For the    */
+/* measures that need a loop over contingency tables, the batch       */
+/* versions only save the call through a function pointer per rule.   */
+
+/*--------------------------------------------------------------------*/
+
 static const REINFO reinfo[] ={ /* --- rule evaluation functions */
-  /* RE_NONE       0 */  { re_none,       0 },
-  /* RE_SUPP       1 */  { re_supp,      +1 },
-  /* RE_CONF       2 */  { re_conf,      +1 },
-  /* RE_CONFDIFF   3 */  { re_confdiff,  +1 },
-  /* RE_LIFT       4 */  { re_lift,      +1 },
-  /* RE_LIFTDIFF   5 */  { re_liftdiff,  +1 },
-  /* RE_LIFTQUOT   6 */  { re_liftquot,  +1 },
-  /* RE_CVCT       7 */  { re_cvct,      +1 },
-  /* RE_CVCTDIFF   8 */  { re_cvctdiff,  +1 },
-  /* RE_CVCTQUOT   9 */  { re_cvctquot,  +1 },
-  /* RE_CPROB     10 */  { re_cprob,     +1 },
-  /* RE_IMPORT    11 */  { re_import,    +1 },
-  /* RE_CERT      12 */  { re_cert,      +1 },
-  /* RE_CHI2      13 */  { re_chi2,      +1 },
-  /* RE_CHI2PVAL  14 */  { re_chi2pval,  -1 },
-  /* RE_YATES     15 */  { re_yates,     +1 },
-  /* RE_YATESPVAL 16 */  { re_yatespval, -1 },
-  /* RE_INFO      17 */  { re_info,      +1 },
-  /* RE_INFOPVAL  18 */  { re_infopval,  -1 },
-  /* RE_FETPROB   19 */  { re_fetprob,   -1 },
-  /* RE_FETCHI2   20 */  { re_fetchi2,   -1 },
-  /* RE_FETINFO   21 */  { re_fetinfo,   -1 },
-  /* RE_FETSUPP   21 */  { re_fetsupp,   -1 },
+  /* RE_NONE       0 */  { re_none,      vnone,       0 },
+  /* RE_SUPP       1 */  { re_supp,      vsupp,      +1 },
+  /* RE_CONF       2 */  { re_conf,      vconf,      +1 },
+  /* RE_CONFDIFF   3 */  { re_confdiff,  vconfdiff,  +1 },
+  /* RE_LIFT       4 */  { re_lift,      vlift,      +1 },
+  /* RE_LIFTDIFF   5 */  { re_liftdiff,  vliftdiff,  +1 },
+  /* RE_LIFTQUOT   6 */  { re_liftquot,  vliftquot,  +1 },
+  /* RE_CVCT       7 */  { re_cvct,      vcvct,      +1 },
+  /* RE_CVCTDIFF   8 */  { re_cvctdiff,  vcvctdiff,  +1 },
+  /* RE_CVCTQUOT   9 */  { re_cvctquot,  vcvctquot,  +1 },
+  /* RE_CPROB     10 */  { re_cprob,     vcprob,     +1 },
+  /* RE_IMPORT    11 */  { re_import,    vimport,    +1 },
+  /* RE_CERT      12 */  { re_cert,      vcert,      +1 },
+  /* RE_CHI2      13 */  { re_chi2,      vchi2,      +1 },
+  /* RE_CHI2PVAL  14 */  { re_chi2pval,  vchi2pval,  -1 },
+  /* RE_YATES     15 */  { re_yates,     vyates,     +1 },
+  /* RE_YATESPVAL 16 */  { re_yatespval, vyatespval, -1 },
+  /* RE_INFO      17 */  { re_info,      vinfo,      +1 },
+  /* RE_INFOPVAL  18 */  { re_infopval,  vinfopval,  -1 },
+  /* RE_FETPROB   19 */  { re_fetprob,   vfetprob,   -1 },
+  /* RE_FETCHI2   20 */  { re_fetchi2,   vfetchi2,   -1 },
+  /* RE_FETINFO   21 */  { re_fetinfo,   vfetinfo,   -1 },
+  /* RE_FETSUPP   21 */  { re_fetsupp,   vfetsupp,   -1 },
 };                              /* table of evaluation functions */
 
 /*--------------------------------------------------------------------*/
@@ -441,8 +762,56 @@ RULEVALFN* re_function (int id)
 
 /*--------------------------------------------------------------------*/
 
+RULEVECFN* re_vecfn (int id)
+{                               /* --- get a batch evaluation func. */
+  assert((id >= 0) && (id <= RE_FNCNT));
+  return reinfo[id].vfn;        /* retrieve function from table */
+}  /* re_vecfn() */
+
+/*--------------------------------------------------------------------*/
+
 int re_dir (int id)
 {                               /* --- get a rule evalution direction */
   assert((id >= 0) && (id <= RE_FNCNT));
   return reinfo[id].dir;        /* retrieve direction from table */
 }  /* re_dir() */
+
+/*--------------------------------------------------------------------*/
+
+int re_lfinit (SUPP max)
+{                               /* --- build log-factorial table */
+  SUPP   n;                     /* number of table entries */
+  double *p;                    /* (re)allocated table */
+
+  n = ((SUPP)1/(SUPP)2 != 0) ? 0 /* if support is real-valued, */
+    : (max  < LF_MAX) ? max+1  : LF_MAX; /* no table can be used */
+  if (n > lfcnt) {              /* if the table is too small */
+    p = (double*)realloc(lftab, (size_t)n *sizeof(double));
+    if (!p) return -1;          /* enlarge the table */
+    for (lftab = p; lfcnt < n; lfcnt++)
+      p[lfcnt] = logGamma((double)(lfcnt+1));
+  }                             /* fill the new table entries */
+  lfref += 1;                   /* register a user of the table */
+  return 0;                     /* return 'ok' */
+}  /* re_lfinit() */
+
+/* The table covers only the arguments up to the largest support    */
+/* that is passed by the caller (usually the largest item support), */
+/* since the supports of body, head and rule are bounded by it. The */
+/* remaining terms (those involving the total weight) are computed  */
+/* with logGamma(), which yields the same values. Hence the table   */
+/* needs (max+1)*sizeof(double) bytes, at most 128 MiB (2^24 items), */
+/* and is filled with max+1 calls of logGamma(). A small table is   */
+/* kept after its last user released it, so that repeated runs do   */
+/* not need to rebuild it.                                          */
+
+/*--------------------------------------------------------------------*/
+
+void re_lfexit (void)
+{                               /* --- delete log-factorial table */
+  if ((lfref <= 0) || (--lfref > 0))
+    return;                     /* check for other users */
+  if (lfcnt <= LF_KEEP) return; /* keep a small table for reuse */
+  if (lftab) free(lftab);       /* delete the table and */
+  lftab = NULL; lfcnt = 0;      /* clear the table variables */
+}  /* re_lfexit() */
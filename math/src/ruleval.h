@@ -6,6 +6,8 @@
             2012.02.15 function re_supp() added (rule support)
             2013.03.29 adapted to type changes in module tract (SUPP)
             2014.05.15 functions re_cprob() and re_import() added
+            2026.10.17 batch evaluation functions added (re_vecfn())
+            2026.10.17 functions re_lfinit() and re_lfexit() added
 ----------------------------------------------------------------------*/
 #ifndef __RULEVAL__
 #define __RULEVAL__
@@ -48,6 +50,9 @@
   Type Definitions
 ----------------------------------------------------------------------*/
 typedef double RULEVALFN (SUPP supp, SUPP body, SUPP head, SUPP base);
+typedef void   RULEVECFN (double *res, const SUPP *supp,
+                          const SUPP *body, const SUPP *head,
+                          SUPP base, size_t n);
 
 /*----------------------------------------------------------------------
   Rule Evaluation Functions
@@ -77,6 +82,9 @@ extern double re_fetinfo   (SUPP supp, SUPP body, SUPP head, SUPP base);
 extern double re_fetsupp   (SUPP supp, SUPP body, SUPP head, SUPP base);
 
 extern RULEVALFN* re_function (int id);
+extern RULEVECFN* re_vecfn    (int id);
 extern int        re_dir      (int id);
+extern int        re_lfinit   (SUPP max);
+extern void       re_lfexit   (void);
 
 #endif
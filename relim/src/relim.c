@@ -55,6 +55,12 @@
             2017.05.30 optional output compression with zlib added
             2017.07.04 tree-based algorithm variant added
             2017.07.06 use of 16-items machine in tree-based algorithm
+            2026.10.16 projection cleared for perfect ext. (insertions)
+            2026.10.16 invalid reallocation of lists removed (relim_lim)
+            2026.10.16 multi-threaded search on the top level added
+            2026.10.17 item sets of threads output in serial order
+            2026.10.17 top-level tasks scheduled by item support
+            2026.10.17 up to 31 items packed, number chosen adaptively
 ------------------------------------------------------------------------
   Reference for the RElim algorithm:
     C. Borgelt.
@@ -67,6 +73,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include <limits.h>
 #include <float.h>
 #include <math.h>
@@ -92,6 +99,7 @@
 #include "memsys.h"
 #include "relim.h"
 #include "fim16.h"
+#include "tpool.h"
 #ifdef RELIM_MAIN
 #include "error.h"
 #endif
@@ -189,6 +197,31 @@ typedef struct renode {         /* --- recursive elimination node --- */
   struct renode *children;      /* list of child nodes */
 } RENODE;                       /* (recursive elimination node) */
 
+typedef struct {                /* --- top-level task --- */
+  ITEM          item;           /* item to add to the item set */
+  SUPP          supp;           /* support of the item */
+  double        wgt;            /* weight of the item (insertions) */
+  TID           n;              /* number of list elements */
+  void          *proj;          /* projected transaction database */
+} RELTASK;                      /* (top-level task) */
+
+typedef struct {                /* --- parallel search data --- */
+  RELIM         *relim;         /* relim miner of the caller */
+  RELIM         *thds;          /* copies of the miner for threads */
+  ISREPORT      **reps;         /* reporter clones (for merging) */
+  int           cnt;            /* number of worker threads */
+  int           act;            /* number of created miner copies */
+  ITEM          pexc;           /* number of perfect exts. (copies) */
+  size_t        lsize;          /* size of a transaction list */
+  size_t        esize;          /* size of a list element */
+  RELTASK       *tasks;         /* collected top-level tasks */
+  TID           tcnt;           /* number of collected tasks */
+  TID           tsize;          /* size of the task array */
+  size_t        mem;            /* memory used by the projections */
+  size_t        max;            /* memory limit for collected tasks */
+  MEMSYS        *nodes;         /* memory system for tree projections */
+} RELPAR;                       /* (parallel search) */
+
 struct _relim {                 /* --- relim miner --- */
   int           target;         /* target type (e.g. closed/maximal) */
   double        smin;           /* minimum support of an item set */
@@ -204,6 +237,8 @@ struct _relim {                 /* --- relim miner --- */
   int           algo;           /* variant of relim algorithm */
   int           mode;           /* search mode (e.g. pruning) */
   ITEM          sort;           /* threshold for list sorting */
+  int           threads;        /* number of threads (top level) */
+  RELPAR        *par;           /* data for parallel search or NULL */
   TABAG         *tabag;         /* transaction bag/multiset */
   ISREPORT      *report;        /* item set reporter */
   MEMSYS        *mem;           /* memory system for tree version */
@@ -420,6 +455,249 @@ SORT(sort_ext, TXLE)
                                 if (!a || !b) break; }
 SORT(sort_wgt, TZLE)
 
+/*----------------------------------------------------------------------
+  Auxiliary Functions for Multi-threaded Search
+----------------------------------------------------------------------*/
+
+static int recurse  (RELIM *relim, TSLIST *lists, ITEM k, TID n);
+static int rec_m16  (RELIM *relim, TSLIST *lists, ITEM k, TID n);
+static int rec_tree (RELIM *relim, RENODE *tree);
+static int rec_ins  (RELIM *relim, TXLIST *lists, ITEM k, TID n);
+static int rec_lim  (RELIM *relim, TZLIST *lists, ITEM k, TID n);
+
+/*--------------------------------------------------------------------*/
+
+static int rel_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int     r;                    /* error status */
+  RELPAR  *par = (RELPAR*)data; /* type the data pointer */
+  RELIM   *relim;               /* copy of the relim miner */
+  RELTASK *t;                   /* task to process */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  relim = par->thds  +thread;   /* get the miner copy of the thread */
+  t     = par->tasks +task;     /* and the task to process */
+  if (isr_task(relim->report, task) < 0) return -1;
+  r     = (relim->twgt >= 0)    /* add the item to the reporter */
+        ? isr_addwgt(relim->report, t->item, t->supp, t->wgt)
+        : isr_add   (relim->report, t->item, t->supp);
+  if (r <= 0) return r;         /* check if item needs processing */
+  if (t->proj) {                /* if there is a projection */
+    if      (relim->twgt >  0)  /* search it with the same function */
+      r = rec_lim (relim, (TZLIST*)t->proj, t->item, t->n);
+    else if (relim->twgt >= 0)  /* that is used by the serial search */
+      r = rec_ins (relim, (TXLIST*)t->proj, t->item, t->n);
+    else if (relim->algo == REL_TREE)
+      r = rec_tree(relim, (RENODE*)t->proj);
+    else if (relim->mode & REL_FIM16)
+      r = rec_m16 (relim, (TSLIST*)t->proj, t->item, t->n);
+    else
+      r = recurse (relim, (TSLIST*)t->proj, t->item, t->n);
+    if (r < 0) return r;        /* check for a recursion error */
+  }
+  r = isr_report(relim->report);/* report the current item set */
+  if (r < 0) return r;          /* and check for an error */
+  isr_remove(relim->report, 1); /* remove the current item */
+  return 0;                     /* return 'ok' */
+}  /* rel_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_end (RELPAR *par, int r)
+{                               /* --- finish a batch of tasks */
+  int   i, k;                   /* loop variables */
+  RELIM *e;                     /* to traverse the miner copies */
+
+  assert(par);                  /* check the function argument */
+  for (i = k = 0; i < par->act; i++)
+    if (par->thds[i].report) par->reps[k++] = par->thds[i].report;
+  if ((r >= 0) && (isr_mergex(par->relim->report, par->reps, k) < 0))
+    r = -1;                     /* merge the item set reporters */
+  for (i = 0; i < par->act; i++) {  /* (output the recorded sets) */
+    e = par->thds +i;           /* traverse the miner copies */
+    if (e->report) isr_delete(e->report, 0);
+    if (e->fim16)  m16_delete(e->fim16);
+    if (e->mem)    ms_delete(e->mem);
+  }                             /* delete the reporter clones etc. */
+  par->act = 0;                 /* there are no miner copies left */
+  if (par->nodes)               /* delete the tree projections */
+    ms_clear(par->nodes, 0);    /* or the projection arrays */
+  else { while (par->tcnt > 0) free(par->tasks[--par->tcnt].proj); }
+  par->tcnt = 0; par->mem = 0;  /* clear the task array */
+  return r;                     /* return the error status */
+}  /* par_end() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_beg (RELPAR *par)
+{                               /* --- start a batch of tasks */
+  RELIM *e;                     /* to traverse the miner copies */
+
+  assert(par && (par->act <= 0));  /* check the function argument */
+  par->pexc = isr_pexcnt(par->relim->report);
+  while (par->act < par->cnt) { /* note the perfect extensions */
+    e = par->thds +par->act++;  /* traverse the worker threads */
+    *e = *par->relim;           /* and copy the miner (caller) */
+    e->par   = NULL;            /* (no nested parallel search) */
+    e->fim16 = NULL; e->mem = NULL;
+    e->report = isr_clone(par->relim->report);
+    if (!e->report) return -1;  /* clone the item set reporter */
+    if (par->relim->fim16) {    /* if to use a 16 items machine */
+      e->fim16 = m16_create(-1, e->supp, e->report);
+      if (!e->fim16) return -1; /* create a 16 items machine */
+    }                           /* for each thread */
+    if (par->nodes) {           /* if transactions form a tree */
+      e->mem = ms_create(sizeof(RENODE), 65535);
+      if (!e->mem) return -1;   /* create a memory system */
+    }                           /* for the projections */
+  }
+  return 0;                     /* return 'ok' */
+}  /* par_beg() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_run (RELPAR *par)
+{                               /* --- process the collected tasks */
+  int    n, r;                  /* number of threads, error status */
+  TID    i;                     /* loop variable for tasks */
+  double *w;                    /* task size hints (item supports) */
+
+  assert(par);                  /* check the function argument */
+  if (par->tcnt <= 0) return par_end(par, 0);
+  n = (par->tcnt < par->cnt) ? (int)par->tcnt : par->cnt;
+  w = (double*)malloc((size_t)par->tcnt *sizeof(double));
+  if (!w) return par_end(par, -1);
+  for (i = 0; i < par->tcnt; i++)  /* use the supports of the */
+    w[i] = (double)par->tasks[i].supp;   /* items as size hints */
+  r = tp_execx(n, (long)par->tcnt, rel_task, par, w);
+  free(w);                      /* process the tasks in parallel */
+  return par_end(par, r);       /* and finish the batch of tasks */
+}  /* par_run() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_add (RELIM *relim, ITEM item, SUPP supp, double wgt,
+                    void *proj, ITEM k, void *elems, TID n)
+{                               /* --- add a top-level task */
+  RELPAR  *par;                 /* data for the parallel search */
+  RELTASK *t;                   /* new task (top-level item) */
+  TID     m;                    /* new size of the task array */
+  size_t  h, z;                 /* size of header and projection */
+  char    *p, *x, *s;           /* to traverse the copy */
+
+  assert(relim && relim->par);  /* check the function arguments */
+  par = relim->par;             /* get the parallel search data */
+  if ((par->tcnt > 0)           /* if perfect extensions were added */
+  &&  (isr_pexcnt(relim->report) != par->pexc)
+  &&  (par_run(par) < 0))       /* since the batch was started, */
+    return -1;                  /* process the collected tasks */
+  if ((par->act <= 0)           /* if there are no miner copies, */
+  &&  (par_beg(par) < 0))       /* start a new batch of tasks */
+    return par_end(par, -1);
+  if (par->tcnt >= par->tsize){ /* if the task array is full */
+    m = par->tsize +((par->tsize > 256) ? par->tsize >> 1 : 256);
+    t = (RELTASK*)realloc(par->tasks, (size_t)m *sizeof(RELTASK));
+    if (!t) return -1;          /* enlarge the task array */
+    par->tasks = t; par->tsize = m;
+  }                             /* set the new array and its size */
+  t = par->tasks +par->tcnt;    /* get the next task and */
+  t->item = item; t->supp = supp;   /* store the item */
+  t->wgt  = wgt;  t->n    = n;  /* and its support values */
+  t->proj = NULL;               /* default: empty projection */
+  if (par->nodes) {             /* if transactions form a tree, */
+    t->proj  = proj;            /* the projection is a copy */
+    par->mem = ms_used(par->nodes) *sizeof(RENODE); }
+  else if (proj) {              /* if transaction lists are used */
+    h = (size_t)k *par->lsize;  /* get the size of the list headers */
+    z = h +(size_t)n *par->esize;   /* and of the whole projection */
+    t->proj = p = (char*)malloc(z);
+    if (!p) return -1;          /* allocate memory for a copy */
+    memcpy(p, proj, h);         /* copy list headers and elements */
+    memcpy(p+h, elems, z-h);    /* and relocate the list heads */
+    for (x = p; x < p+z; x += (x < p+h) ? par->lsize : par->esize) {
+      memcpy(&s, x, sizeof(s)); /* (first fields of the headers) */
+      if (!s) continue;         /* and the successor pointers */
+      s = p +h +(s -(char*)elems); /* (first fields of the elements) */
+      memcpy(x, &s, sizeof(s)); /* to the copied elements */
+    }
+    memset(proj, 0, h);         /* clear the original list headers */
+    par->mem += z;              /* (the projection has been moved) */
+  }                             /* and sum the used memory */
+  par->tcnt++;                  /* count the new task */
+  if ((par->mem < par->max) || (par->tcnt < par->cnt))
+    return 0;                   /* if the memory limit is reached, */
+  return par_run(par);          /* process the collected tasks */
+}  /* par_add() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_init (RELPAR *par, RELIM *relim,
+                     size_t lsize, size_t esize)
+{                               /* --- prepare a parallel search */
+  int n;                        /* number of threads */
+
+  assert(par && relim);         /* check the function arguments */
+  relim->par = NULL;            /* default: serial search */
+  n = relim->threads;           /* get the number of threads */
+  if (n <= 0) n = tp_cpucnt();  /* (default: number of processors) */
+  if ((n <= 1) || !isr_clonable(relim->report))
+    return 0;                   /* check for a parallel search */
+  par->relim = relim;           /* note the relim miner */
+  par->cnt   = n;               /* and the number of threads */
+  par->act   = 0;               /* (no miner copies yet) */
+  par->lsize = lsize;           /* note the sizes of the lists */
+  par->esize = esize;           /* and of the list elements */
+  par->tasks = NULL; par->tcnt = par->tsize = 0;
+  par->mem   = 0;               /* limit the memory for projections */
+  par->max   = (size_t)(tbg_cnt(relim->tabag)+1) *sizeof(TZLE)
+             * (size_t)(4*n);   /* (relative to the database size) */
+  if (par->max < ((size_t)1 << 24)) par->max = (size_t)1 << 24;
+  par->nodes = NULL;            /* if transactions form a tree, */
+  if (lsize <= 0) {             /* create a memory system */
+    par->nodes = ms_create(sizeof(RENODE), 65535);
+    if (!par->nodes) return -1; /* for the copies of the subtrees */
+  }                             /* (projections of the top level) */
+  par->thds = (RELIM*)malloc((size_t)n *sizeof(RELIM)
+                            +(size_t)n *sizeof(ISREPORT*));
+  if (!par->thds) { if (par->nodes) ms_delete(par->nodes); return -1; }
+  par->reps = (ISREPORT**)(par->thds +n);
+  relim->par = par;             /* create the miner copies and */
+  return n;                     /* return the number of threads */
+}  /* par_init() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_exit (RELIM *relim, int r)
+{                               /* --- finish a parallel search */
+  RELPAR *par;                  /* data for the parallel search */
+
+  assert(relim);                /* check the function argument */
+  if (!(par = relim->par)) return r;  /* check for parallel search */
+  relim->par = NULL;            /* process the remaining tasks */
+  r = (r >= 0) ? par_run(par) : par_end(par, r);
+  if (par->nodes) ms_delete(par->nodes);
+  if (par->tasks) free(par->tasks);
+  free(par->thds);              /* delete the task array */
+  return r;                     /* and the miner copies */
+}  /* par_exit() */
+
+/* The top level of the recursion is executed by the calling thread.  */
+/* If a parallel search is requested, the projections of the          */
+/* top-level items are not processed directly, but moved into compact */
+/* copies (with relocated list pointers) that are collected as tasks. */
+/* These are then processed in batches (bounded by a memory limit) by */
+/* a thread pool, each worker thread using a copy of the miner with a */
+/* clone of the item set reporter. The clones are created when the    */
+/* first task of a batch is collected and a batch is processed as     */
+/* soon as a new perfect extension is found on the top level. Hence   */
+/* each task sees the same perfect extensions as in a serial search,  */
+/* which matters for item insertions, where a perfect extension of    */
+/* the top level need not be one in the projection of an item. The    */
+/* clones record the found item sets per task, so that merging them   */
+/* reproduces the output order of the serial search. For this the     */
+/* collected tasks are also processed before the 16 items machine is  */
+/* run on the top level (which reports directly).                     */
+
 /*----------------------------------------------------------------------
   Recursive Elimination: Basic Version
 ----------------------------------------------------------------------*/
@@ -452,7 +730,8 @@ static int recurse (RELIM *relim, TSLIST *lists, ITEM k, TID n)
     if      (cur->occ >= pex)   /* if item is a perfect extension, */
       isr_addpex(relim->report, k);/* add it to the item set reporter */
     else if (cur->occ >= relim->supp) {  /* if support is high enough */
-      r = isr_add(relim->report, k, cur->occ);
+      r = (relim->par) ? 1      /* (parallel: add in the task) */
+        : isr_add(relim->report, k, cur->occ);
       if (r < 0) break;         /* add current item to the reporter */
       if (r > 0) {              /* if the item needs processing */
         if (cur->head && proj){ /* if another item can be added */
@@ -469,13 +748,23 @@ static int recurse (RELIM *relim, TSLIST *lists, ITEM k, TID n)
             dst->succ  = tal->head;   /* the number of occurrences */
             tal->head  = dst++; /* add the new element at the head */
           }                     /* of the corresponding list */
-          r = recurse(relim, proj, k, (TID)(dst-elems));
-          if (r < 0) break;     /* find frequent item sets */
-        }                       /* recursively in the projection */
-        r = isr_report(relim->report);
-        if (r < 0) break;       /* report the current item set */
-        isr_remove(relim->report, 1);
-      }                         /* remove the current item */
+          if (relim->par)       /* collect a top-level task */
+            r = par_add(relim, k, cur->occ, 0, proj, k,
+                        elems, (TID)(dst-elems));
+          else                  /* or find frequent item sets */
+            r = recurse(relim, proj, k, (TID)(dst-elems));
+          if (r < 0) break;     /* recursively in the projection */
+        }
+        else if (relim->par) {  /* collect a task w/o projection */
+          r = par_add(relim, k, cur->occ, 0, NULL, 0, NULL, 0);
+          if (r < 0) break;     /* (no extensions possible) */
+        }
+        if (!relim->par) {      /* if the search is serial, */
+          r = isr_report(relim->report);
+          if (r < 0) break;     /* report the current item set */
+          isr_remove(relim->report, 1);
+        }                       /* remove the current item */
+      }
     }                           /* from the item set reporter */
     cur->occ = 0;               /* clear the number of occurrences */
     while (cur->head) {         /* while the list is not empty, */
@@ -502,6 +791,7 @@ int relim_base (RELIM *relim)
   TRACT  *t;                    /* to traverse the transactions */
   TSLIST *lists, *tal;          /* (array of) transaction list(s) */
   TSLE   *elems, *dst;          /* (array of) trans. list element(s) */
+  RELPAR par;                   /* data for parallel search */
 
   assert(relim);                /* check the function arguments */
   if (tbg_wgt(relim->tabag) < relim->supp)
@@ -525,8 +815,10 @@ int relim_base (RELIM *relim)
     dst->succ = tal->head;      /* skip one element transactions */
     tal->head = dst++;          /* add the new element to the */
   }                             /* list for the first item */
-  r = recurse(relim, lists, k, (TID)(dst-elems));
-  free(lists);                  /* execute recursive elimination */
+  r = par_init(&par, relim, sizeof(TSLIST), sizeof(TSLE));
+  if (r >= 0)                   /* execute recursive elimination */
+    r = par_exit(relim, recurse(relim, lists, k, (TID)(dst-elems)));
+  free(lists);                  /* and deallocate working memory */
   if (r >= 0)                   /* finally report the empty item set */
     r = isr_report(relim->report);
   return r;                     /* return the error status */
@@ -560,12 +852,13 @@ static int rec_m16 (RELIM *relim, TSLIST *lists, ITEM k, TID n)
   }                             /* initialize the projection header */
   pex = (relim->mode & REL_PERFECT)
       ? isr_supp(relim->report) : SUPP_MAX;
-  for (r = 0; --k >= 16; ) {    /* traverse the transaction lists */
+  for (r = 0; --k > 0; ) {      /* traverse the transaction lists */
     cur = lists +k;             /* get the next transaction list */
     if      (cur->occ >= pex)   /* if item is a perfect extension, */
       isr_addpex(relim->report, k);/* add it to the item set reporter */
     else if (cur->occ >= relim->supp) {    /* if the item is frequent */
-      r = isr_add(relim->report, k, cur->occ);
+      r = (relim->par) ? 1      /* (parallel: add in the task) */
+        : isr_add(relim->report, k, cur->occ);
       if (r < 0) break;         /* add current item to the reporter */
       if (r > 0) {              /* if the item needs processing */
         if (cur->head && proj){ /* if another item can be added */
@@ -590,13 +883,23 @@ static int rec_m16 (RELIM *relim, TSLIST *lists, ITEM k, TID n)
             dst->succ  = tal->head;   /* the number of occurrences */
             tal->head  = dst++; /* add the new element at the head */
           }                     /* of the corresponding list */
-          r = rec_m16(relim, proj, k, (TID)(dst-elems));
-          if (r < 0) break;     /* find frequent item sets */
-        }                       /* recursively in the projection */
-        r = isr_report(relim->report);
-        if (r < 0) break;       /* report the current item set */
-        isr_remove(relim->report, 1);
-      }                         /* remove the current item */
+          if (relim->par)       /* collect a top-level task */
+            r = par_add(relim, k, cur->occ, 0, proj, k,
+                        elems, (TID)(dst-elems));
+          else                  /* or find frequent item sets */
+            r = rec_m16(relim, proj, k, (TID)(dst-elems));
+          if (r < 0) break;     /* recursively in the projection */
+        }
+        else if (relim->par) {  /* collect a task w/o projection */
+          r = par_add(relim, k, cur->occ, 0, NULL, 0, NULL, 0);
+          if (r < 0) break;     /* (no extensions possible) */
+        }
+        if (!relim->par) {      /* if the search is serial, */
+          r = isr_report(relim->report);
+          if (r < 0) break;     /* report the current item set */
+          isr_remove(relim->report, 1);
+        }                       /* remove the current item */
+      }
     }                           /* from the item set reporter */
     cur->occ = 0;               /* clear the number of occurrences */
     while (cur->head) {         /* while the list is not empty, */
@@ -619,7 +922,8 @@ static int rec_m16 (RELIM *relim, TSLIST *lists, ITEM k, TID n)
   if ((r >= 0) && (lists->occ >= relim->supp)) {
     for (src = lists->head; src; src = src->succ)
       m16_add(relim->fim16, (BITTA)(src->items[0] & ~TA_END), src->occ);
-    r = m16_mine(relim->fim16); /* traverse and add packed items */
+    if (relim->par) r = par_run(relim->par); /* run tasks first */
+    if (r >= 0) r = m16_mine(relim->fim16); /* add packed items */
   }                             /* and mine with 16 items machine */
   lists->head = NULL; lists->occ = 0;
   if (proj) free(proj);         /* delete the list and element arrays */
@@ -636,6 +940,7 @@ int relim_m16 (RELIM *relim)
   TRACT  *t;                    /* to traverse the transactions */
   TSLIST *lists, *tal;          /* (array of) transaction list(s) */
   TSLE   *elems, *dst;          /* (array of) trans. list element(s) */
+  RELPAR par;                   /* data for parallel search */
 
   assert(relim);                /* check the function arguments */
   if (tbg_wgt(relim->tabag) < relim->supp)
@@ -668,8 +973,10 @@ int relim_m16 (RELIM *relim)
     dst->succ = tal->head;      /* skip one element transactions */
     tal->head = dst++;          /* add the new element to the */
   }                             /* list for the first item */
-  r = rec_m16(relim, lists, k, (TID)(dst -elems));
-  m16_delete(relim->fim16);     /* execute recursive elimination */
+  r = par_init(&par, relim, sizeof(TSLIST), sizeof(TSLE));
+  if (r >= 0)                   /* execute recursive elimination */
+    r = par_exit(relim, rec_m16(relim, lists, k, (TID)(dst -elems)));
+  m16_delete(relim->fim16);     /* delete the 16 items machine */
   free(lists);                  /* and deallocate working memory */
   if (r >= 0)                   /* finally report the empty item set */
     r = isr_report(relim->report);
@@ -768,6 +1075,7 @@ static int rec_tree (RELIM *relim, RENODE *tree)
 {                               /* --- recursive elimination (arrays) */
   int    r = 0;                 /* status/error indicator */
   RENODE *proj;                 /* tree of projected trans. database */
+  RENODE *node;                 /* copy of a projection (parallel) */
   SUPP   pex;                   /* minimum support for perfect exts. */
 
   assert(relim && tree);        /* check the function arguments */
@@ -783,6 +1091,17 @@ static int rec_tree (RELIM *relim, RENODE *tree)
     tree = merge(tree->children, tree->sibling, relim->mem);
     if (proj->wgt >= pex)       /* collect perfect extensions */
       isr_addpex(relim->report, proj->item);
+    else if ((proj->wgt >= relim->supp) && relim->par) {
+      node = NULL;              /* if parallel search, copy the */
+      if (proj->children        /* projection (if it is needed) */
+      &&  isr_xable(relim->report, 2)) {
+        node = copy(proj, relim->par->nodes);
+        if (!node) return -1;   /* copy the projection */
+        node = node->children;  /* to the task memory */
+      }                         /* and collect a top-level task */
+      r = par_add(relim, proj->item, proj->wgt, 0, node, 0, NULL, 0);
+      if (r < 0) return -1;     /* (the search is done by a thread) */
+    }
     else if (proj->wgt >= relim->supp) {  /* process frequent items */
       r = isr_add(relim->report, proj->item, proj->wgt);
       if (r < 0) return -1;     /* add current item to the reporter */
@@ -800,7 +1119,8 @@ static int rec_tree (RELIM *relim, RENODE *tree)
   if (tree) {                   /* if there are packed items left */
     for ( ; tree; tree = tree->sibling)
       m16_add(relim->fim16, (BITTA)(tree->item & ~TA_END), tree->wgt);
-    r = m16_mine(relim->fim16); /* traverse and add packed items */
+    if (relim->par) r = par_run(relim->par); /* run tasks first */
+    if (r >= 0) r = m16_mine(relim->fim16); /* add packed items */
   }                             /* and mine with 16 items machine */
   return r;                     /* return the error status */
 }  /* rec_tree() */
@@ -814,6 +1134,7 @@ int relim_tree (RELIM *relim)
   TID    n;                     /* number of transactions */
   TRACT  *t;                    /* to traverse the transactions */
   RENODE *tree;                 /* recursive elimination tree */
+  RELPAR par;                   /* data for parallel search */
 
   assert(relim);                /* check the function arguments */
   if (tbg_wgt(relim->tabag) < relim->supp)
@@ -835,8 +1156,10 @@ int relim_tree (RELIM *relim)
     r = add(tree, relim->mem, ta_items(t), ta_wgt(t));
     if (r < 0) break;           /* traverse the transactions */
   }                             /* and add them to the tree */
+  if (r >= 0)                   /* prepare a parallel search */
+    r = par_init(&par, relim, 0, 0);
   if (r >= 0)                   /* find frequent item sets */
-    r = rec_tree(relim, tree->children);
+    r = par_exit(relim, rec_tree(relim, tree->children));
   if (r >= 0)                   /* finally report the empty item set */
     r = isr_report(relim->report);
   if (relim->fim16)             /* if a 16-items machine was used, */
@@ -898,12 +1221,12 @@ static int rec_ins (RELIM *relim, TXLIST *lists, ITEM k, TID n)
       /* standard version of the algorithm apart from the fact that */
       /* empty transactions are processed in an additional list.    */
     i = -1;                     /* default: no recursion */
-    if (cur->wgt >= pex) {      /* if item is a perfect extension, */
+    if (cur->wgt >= pex)        /* if item is a perfect extension, */
       isr_addpex(relim->report, k);      /* add it to the reporter */
-      i = 0; }                  /* and clear the projection flag */
     else if ((cur->occ >= relim->supp)    /* if both support values */
     &&       (cur->wgt >= relim->isup)) { /* are large enough */
-      r = isr_addwgt(relim->report, k, cur->occ, cur->wgt);
+      r = (relim->par) ? 1      /* (parallel: add in the task) */
+        : isr_addwgt(relim->report, k, cur->occ, cur->wgt);
       if (r < 0) break;         /* add current item to the reporter */
       if (r > 0) {              /* if item needs processing */
         if ((k > 0) && proj) {  /* if another item can be added */
@@ -921,13 +1244,23 @@ static int rec_ins (RELIM *relim, TXLIST *lists, ITEM k, TID n)
             dst->succ  = tal->head;
             tal->head  = dst++; /* add a new list element to */
           }                     /* the corresp. transaction list */
-          r = rec_ins(relim, proj, k, (TID)(dst-elems));
-          if (r < 0) break;     /* find frequent item sets */
-        }                       /* recursively in the projection */
-        r = isr_report(relim->report);
-        if (r < 0) break;       /* report the current item set */
-        isr_remove(relim->report, 1);
-      }                         /* remove the current item */
+          if (relim->par)       /* collect a top-level task */
+            r = par_add(relim, k, cur->occ, cur->wgt, proj, k+1,
+                        elems, (TID)(dst-elems));
+          else                  /* or find frequent item sets */
+            r = rec_ins(relim, proj, k, (TID)(dst-elems));
+          if (r < 0) break;     /* recursively in the projection */
+        }
+        else if (relim->par) {  /* collect a task w/o projection */
+          r = par_add(relim, k, cur->occ, cur->wgt, NULL, 0, NULL, 0);
+          if (r < 0) break;     /* (no extensions possible) */
+        }
+        if (!relim->par) {      /* if the search is serial, */
+          r = isr_report(relim->report);
+          if (r < 0) break;     /* report the current item set */
+          isr_remove(relim->report, 1);
+        }                       /* remove the current item */
+      }
     }                           /* from the item set reporter */
     if ((i < 0) && proj)        /* clear the projected database */
       memset(proj, 0, (size_t)k *sizeof(TXLIST));
@@ -959,6 +1292,7 @@ int relim_ins (RELIM *relim)
   TRACT  *t;                    /* to traverse the transactions */
   TXLIST *lists, *tal;          /* (array of) transaction list(s) */
   TXLE   *elems, *dst;          /* (array of) trans. list element(s) */
+  RELPAR par;                   /* data for parallel search */
 
   assert(relim);               /* check the function arguments */
   if (tbg_wgt(relim->tabag) < relim->supp)
@@ -983,8 +1317,10 @@ int relim_ins (RELIM *relim)
     dst->succ = tal->head;      /* add the new element to the */
     tal->head = dst++;          /* list for the first item */
   }                             /* and skip this item */
-  r = rec_ins(relim, lists, k, (TID)(dst-elems));
-  free(lists);                  /* execute recursive elimination */
+  r = par_init(&par, relim, sizeof(TXLIST), sizeof(TXLE));
+  if (r >= 0)                   /* execute recursive elimination */
+    r = par_exit(relim, rec_ins(relim, lists, k, (TID)(dst-elems)));
+  free(lists);                  /* and deallocate working memory */
   if (r >= 0)                   /* finally report the empty item set */
     r = isr_report(relim->report);
   return r;                     /* return the error status */
@@ -1048,12 +1384,12 @@ static int rec_lim (RELIM *relim, TZLIST *lists, ITEM k, TID n)
       /* standard version of the algorithm apart from the fact that */
       /* empty transactions are processed in an additional list.    */
     i = -1;                     /* default: no recursion */
-    if (cur->wgt >= pex) {      /* if item is a perfect extension, */
+    if (cur->wgt >= pex)        /* if item is a perfect extension, */
       isr_addpex(relim->report, k);      /* add it to the reporter */
-      i = 0; }                  /* and clear the projection flag */
     else if ((cur->occ >= relim->supp)    /* if both support values */
     &&       (cur->wgt >= relim->isup)) { /* are large enough */
-      r = isr_addwgt(relim->report, k, cur->occ, cur->wgt);
+      r = (relim->par) ? 1      /* (parallel: add in the task) */
+        : isr_addwgt(relim->report, k, cur->occ, cur->wgt);
       if (r < 0) break;         /* add current item to the reporter */
       if (r > 0) {              /* if the item needs processing */
         if ((k > 0) && proj) {  /* if another item can be added */
@@ -1073,13 +1409,23 @@ static int rec_lim (RELIM *relim, TZLIST *lists, ITEM k, TID n)
             dst->succ  = tal->head;
             tal->head  = dst++; /* add the new list element to */
           }                     /* the corresp. transaction list */
-          r = rec_lim(relim, proj, k, (TID)(dst-elems));
-          if (r < 0) break;     /* find frequent item sets */
-        }                       /* recursively in the projection */
-        r = isr_report(relim->report);
-        if (r < 0) break;       /* report the current item set */
-        isr_remove(relim->report, 1);
-      }                         /* remove the current item */
+          if (relim->par)       /* collect a top-level task */
+            r = par_add(relim, k, cur->occ, cur->wgt, proj, k+1,
+                        elems, (TID)(dst-elems));
+          else                  /* or find frequent item sets */
+            r = rec_lim(relim, proj, k, (TID)(dst-elems));
+          if (r < 0) break;     /* recursively in the projection */
+        }
+        else if (relim->par) {  /* collect a task w/o projection */
+          r = par_add(relim, k, cur->occ, cur->wgt, NULL, 0, NULL, 0);
+          if (r < 0) break;     /* (no extensions possible) */
+        }
+        if (!relim->par) {      /* if the search is serial, */
+          r = isr_report(relim->report);
+          if (r < 0) break;     /* report the current item set */
+          isr_remove(relim->report, 1);
+        }                       /* remove the current item */
+      }
     }                           /* from the item set reporter */
     if ((i < 0) && proj)        /* clear the projected database */
       memset(proj, 0, (size_t)k *sizeof(TZLIST));
@@ -1111,6 +1457,7 @@ int relim_lim (RELIM *relim)
   TRACT  *t;                    /* to traverse the transactions */
   TZLIST *lists, *tal;          /* (array of) transaction list(s) */
   TZLE   *elems, *dst;          /* (array of) trans. list element(s) */
+  RELPAR par;                   /* data for parallel search */
 
   assert(relim);                /* check the function arguments */
   if (tbg_wgt(relim->tabag) < relim->supp)
@@ -1136,11 +1483,11 @@ int relim_lim (RELIM *relim)
     dst->succ = tal->head;      /* add the new element to the */
     tal->head = dst++;          /* list for the first item */
   }                             /* (or the list of empty trans.) */
-  n = (TID)(dst -elems);        /* shrink memory to needed size */
-  lists = (TZLIST*)realloc(lists, (size_t)(k+1) *sizeof(TZLIST)
-                                 +(size_t) n    *sizeof(TZLE));
-  r = rec_lim(relim, lists, k, n);
-  free(lists);                  /* recursively find freq. item sets */
+  n = (TID)(dst -elems);        /* get the number of elements */
+  r = par_init(&par, relim, sizeof(TZLIST), sizeof(TZLE));
+  if (r >= 0)                   /* recursively find freq. item sets */
+    r = par_exit(relim, rec_lim(relim, lists, k, n));
+  free(lists);                  /* and deallocate working memory */
   if (r >= 0)                   /* finally report the empty item set */
     r = isr_report(relim->report);
   return r;                     /* return the error status */
@@ -1180,6 +1527,8 @@ RELIM* relim_create (int target, double smin, double sins,
   relim->algo   = algo;
   relim->mode   = mode;
   relim->sort   = 32;
+  relim->threads = 1;
+  relim->par    = NULL;
   relim->tabag  = NULL;
   relim->report = NULL;
   relim->mem    = NULL;
@@ -1217,8 +1566,7 @@ int relim_data (RELIM *relim, TABAG *tabag, int sort)
   assert(tabag);                /* check the function arguments */
   relim->tabag = tabag;         /* note the transaction bag and */
   relim->base  = tbg_base(tabag);   /* the underlying item base */
-  pack = relim->mode & REL_FIM16;
-  if (pack > 16) pack = 16;     /* get number of items to pack */
+  pack = relim->mode & REL_FIM16; /* get number of items to pack */
   w = tbg_wgt(tabag);           /* compute absolute minimum support */
   smin = ceilsupp((relim->smin < 0) ? -relim->smin
                 : (relim->smin/100.0) *(double)w *(1-DBL_EPSILON));
@@ -1244,8 +1592,9 @@ int relim_data (RELIM *relim, TABAG *tabag, int sort)
   tbg_sort  (tabag, -1, 0);     /* sort the trans. lexicographically */
   tbg_reduce(tabag, 0);         /* reduce transactions to unique ones */
   if ((relim->twgt < 0)         /* if insertions are not possible */
-  &&  (pack        > 0))        /* and 16-items machine is used, */
-    tbg_pack(tabag, pack);      /* pack the most frequent items */
+  &&  (pack        > 0))        /* and k-items machine is used, */
+    tbg_pack(tabag, m16_width(tabag, pack));
+                                /* pack the most frequent items */
   #ifndef QUIET                 /* if to print messages */
   n = tbg_cnt(tabag);           /* get the number of transactions */
   w = tbg_wgt(tabag);           /* and the new transaction weight */
@@ -1288,7 +1637,7 @@ int relim_report (RELIM *relim, ISREPORT *report)
 
 /*--------------------------------------------------------------------*/
 
-int relim_mine (RELIM *relim, ITEM sort)
+int relim_mine (RELIM *relim, ITEM sort, int threads)
 {                               /* --- RElim algorithm (generic) */
   int     r;                    /* result of function call */
   #ifndef QUIET                 /* if to print messages */
@@ -1298,7 +1647,8 @@ int relim_mine (RELIM *relim, ITEM sort)
   assert(relim);                /* check the function arguments */
   CLOCK(t);                     /* start timer, print log message */
   XMSG(stderr, "writing %s ... ", isr_name(relim->report));
-  relim->sort = sort;           /* note the sorting threshold */
+  relim->sort    = sort;        /* note the sorting threshold */
+  relim->threads = threads;     /* and the number of threads */
   if      (relim->twgt >  0)
     r = relim_lim (relim);      /* limited   item insertions */
   else if (relim->twgt >= 0)
@@ -1454,6 +1804,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     threads  = 1;         /* number of threads to use */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -1507,6 +1858,9 @@ int main (int argc, char *argv[])
                     "(default: %d)\n", pack);
     printf("-y#      threshold for transaction list sorting   "
                     "(default: %"ITEM_FMT")\n", slist);
+    printf("-Y#      number of threads to use                 "
+                    "(default: %d)\n", threads);
+    printf("         (a value <= 0 means one thread per cpu)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -1549,7 +1903,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: acjop [A-Z]\[CFNPRTZ] */
+  /* free option characters: acjop [A-Z]\[CFNPRTYZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse arguments */
@@ -1573,6 +1927,7 @@ int main (int argc, char *argv[])
           case 'x': mode  &= ~REL_PERFECT;           break;
           case 'l': pack   = (int) strtol(s, &s, 0); break;
           case 'y': slist  = (ITEM)strtol(s, &s, 0); break;
+          case 'Y': threads = (int)strtol(s, &s, 0); break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
@@ -1637,7 +1992,7 @@ int main (int argc, char *argv[])
     default : error(E_VARIANT, (char)algo);  break;
   }                             /* (get fpgrowth algorithm code) */
   mode = (mode & ~REL_FIM16)    /* add packed items to search mode */
-       | ((pack <= 0) ? 0 : (pack < 16) ? pack : 16);
+       | ((pack <= 0) ? 0 : (pack < 31) ? pack : 31);
   if (slist < 0) slist = ITEM_MAX;
   if (info == dflt)             /* adapt the default info. format */
     info = (supp < 0) ? " (%a)" : " (%S)";
@@ -1705,7 +2060,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)     /* open the item set file and */
     error(E_NOMEM);              /* set up the item set reporter */
-  k = relim_mine(relim, slist);  /* find frequent item sets */
+  k = relim_mine(relim, slist, threads);  /* find freq. item sets */
   if (k) error(k);
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
@@ -6,6 +6,7 @@
             2014.08.22 interface of function relim() changed
             2014.08.28 functions rel_data() and rel_report() added
             2017.05.30 optional output compression with zlib added
+            2026.10.16 parameter 'threads' added to relim_mine()
 ----------------------------------------------------------------------*/
 #ifndef __RELIM__
 #define __RELIM__
@@ -68,5 +69,6 @@ extern RELIM* relim_create (int target, double smin, double sins,
 extern void   relim_delete (RELIM *relim, int deldar);
 extern int    relim_data   (RELIM *relim, TABAG *tabag, int sort);
 extern int    relim_report (RELIM *relim, ISREPORT *report);
-extern int    relim_mine   (RELIM *relim, ITEM sort);
+extern int    relim_mine   (RELIM *relim, ITEM sort,
+                            int threads);
 #endif
@@ -8,6 +8,7 @@
 #           2010.08.22 module escape added (for module tabread)
 #           2011.08.29 external module fim16 added (16 items machine)
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 external module tpool added (thread pool)
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\relim\src
 UTILDIR  = ..\..\util\src
@@ -27,13 +28,15 @@ HDRS     = $(UTILDIR)\arrays.h     $(UTILDIR)\memsys.h     \
            $(UTILDIR)\tabread.h    $(UTILDIR)\tabwrite.h   \
            $(UTILDIR)\scanner.h    $(TRACTDIR)\tract.h     \
            $(TRACTDIR)\patspec.h   $(TRACTDIR)\clomax.h    \
-           $(TRACTDIR)\report.h    $(TRACTDIR)\fim16.h
+           $(TRACTDIR)\report.h    $(TRACTDIR)\fim16.h     \
+           $(UTILDIR)\tpool.h
 OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\memsys.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\escape.obj   \
            $(UTILDIR)\tabread.obj  $(UTILDIR)\tabwrite.obj \
            $(UTILDIR)\scform.obj   $(TRACTDIR)\taread.obj  \
            $(TRACTDIR)\patspec.obj $(TRACTDIR)\clomax.obj  \
-           $(TRACTDIR)\repcm.obj   $(TRACTDIR)\fim16.obj relim.obj
+           $(TRACTDIR)\repcm.obj   $(TRACTDIR)\fim16.obj   \
+           $(UTILDIR)\tpool.obj    relim.obj
 PRGS     = relim.exe
 
 #-----------------------------------------------------------------------
@@ -81,6 +84,10 @@ $(UTILDIR)\scform.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak scform.obj   ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(UTILDIR)\tpool.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak tpool.obj    ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(TRACTDIR)\taread.obj:
 	cd $(TRACTDIR)
 	$(MAKE) /f tract.mak taread.obj  ADDFLAGS="$(ADDFLAGS)"
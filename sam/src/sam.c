@@ -44,6 +44,10 @@
             2016.02.19 added pre-formatting for some integer numbers
             2016.11.23 sam miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 multi-threaded search on the top level added
+            2026.10.17 item sets of threads output in serial order
+            2026.10.17 top-level tasks scheduled by item support
+            2026.10.17 up to 31 items packed, number chosen adaptively
 ------------------------------------------------------------------------
   Reference for the SaM algorithm:
     C. Borgelt and X. Wang.
@@ -56,6 +60,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include <limits.h>
 #include <float.h>
 #include <math.h>
@@ -80,6 +85,7 @@
 #endif
 #include "sam.h"
 #include "fim16.h"
+#include "tpool.h"
 #ifdef SAM_MAIN
 #include "error.h"
 #endif
@@ -159,6 +165,30 @@ typedef struct ttnode {         /* --- transaction tree node --- */
   struct ttnode *sibling;       /* successor node in sibling list */
 } TTNODE;                       /* (transaction tree node) */
 
+typedef struct {                /* --- top-level task --- */
+  ITEM     item;                /* item to add to the item set */
+  SUPP     supp;                /* support of the item */
+  double   wgt;                 /* weight of the item (insertions) */
+  TID      n;                   /* number of transactions */
+  void     *proj;               /* projected transaction database */
+} SAMTASK;                      /* (top-level task) */
+
+typedef struct {                /* --- parallel search data --- */
+  SAM      *sam;                /* split and merge miner of caller */
+  SAM      *thds;               /* copies of the miner for threads */
+  ISREPORT **reps;              /* reporter clones (for merging) */
+  int      cnt;                 /* number of worker threads */
+  int      act;                 /* number of created miner copies */
+  ITEM     pexc;                /* number of perfect exts. (copies) */
+  size_t   size;                /* size of a transaction array elem. */
+  SAMTASK  *tasks;              /* collected top-level tasks */
+  TID      tcnt;                /* number of collected tasks */
+  TID      tsize;               /* size of the task array */
+  size_t   mem;                 /* memory used by the projections */
+  size_t   max;                 /* memory limit for collected tasks */
+  MEMSYS   *nodes;              /* memory system for tree projections */
+} SAMPAR;                       /* (parallel search) */
+
 struct _sam {                   /* --- split and merge miner --- */
   int      target;              /* target type (e.g. closed/maximal) */
   double   smin;                /* minimum support of an item set */
@@ -175,6 +205,8 @@ struct _sam {                   /* --- split and merge miner --- */
   int      algo;                /* variant of sam algorithm */
   int      mode;                /* search mode (e.g. pruning) */
   TID      merge;               /* threshold for source merging */
+  int      threads;             /* number of threads (top level) */
+  SAMPAR   *par;                /* data for parallel search or NULL */
   TABAG    *tabag;              /* transaction bag/multiset */
   ISREPORT *report;             /* item set reporter */
   MEMSYS   *mem;                /* memory system for tree version */
@@ -332,6 +364,247 @@ static int cmp (const ITEM *a, const ITEM *b)
   }                             /* and abort if it is reached */
 }  /* cmp() */
 
+/*----------------------------------------------------------------------
+  Auxiliary Functions for Multi-threaded Search
+----------------------------------------------------------------------*/
+
+static int recurse  (SAM *sam, TAAE *a, TID n);
+static int rec_opt  (SAM *sam, TAAE *a, TID n);
+static int rec_dsb  (SAM *sam, TAAE *a, TID n);
+static int rec_tree (SAM *sam, TTNODE *node);
+static int rec_ins  (SAM *sam, TXAE *a, TID n, ITEM k);
+static int rec_lim  (SAM *sam, TZAE *a, TID n, ITEM k);
+
+/*--------------------------------------------------------------------*/
+
+static int sam_task (void *data, int thread, long task)
+{                               /* --- process a top-level item */
+  int     r;                    /* error status */
+  SAMPAR  *par = (SAMPAR*)data; /* type the data pointer */
+  SAM     *sam;                 /* copy of the split and merge miner */
+  SAMTASK *t;                   /* task to process */
+
+  assert(data && (thread >= 0) && (task >= 0));
+  sam = par->thds  +thread;     /* get the miner copy of the thread */
+  t   = par->tasks +task;       /* and the task to process */
+  if (isr_task(sam->report, task) < 0) return -1;
+  r   = (sam->twgt >= 0)        /* add the item to the reporter */
+      ? isr_addwgt(sam->report, t->item, t->supp, t->wgt)
+      : isr_add   (sam->report, t->item, t->supp);
+  if (r <= 0) return r;         /* check if item needs processing */
+  if (t->proj                   /* if the projection is not empty and */
+  &&  isr_xable(sam->report, 1)) {     /* another item can be added */
+    if      (sam->twgt >  0)    /* search the projection recursively */
+      r = rec_lim (sam, (TZAE*)t->proj, t->n, t->item);
+    else if (sam->twgt >= 0)    /* with the same function */
+      r = rec_ins (sam, (TXAE*)t->proj, t->n, t->item);
+    else if (sam->algo == SAM_TREE)     /* that is used by */
+      r = rec_tree(sam, (TTNODE*)t->proj);    /* the serial search */
+    else if (sam->algo == SAM_DOUBLE)
+      r = rec_dsb (sam, (TAAE*)t->proj, t->n);
+    else if (sam->algo == SAM_BSEARCH)
+      r = rec_opt (sam, (TAAE*)t->proj, t->n);
+    else
+      r = recurse (sam, (TAAE*)t->proj, t->n);
+    if (r < 0) return r;        /* check for a recursion error */
+  }
+  r = isr_report(sam->report);  /* report the current item set */
+  if (r < 0) return r;          /* and check for an error */
+  isr_remove(sam->report, 1);   /* remove the current item */
+  return 0;                     /* return 'ok' */
+}  /* sam_task() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_end (SAMPAR *par, int r)
+{                               /* --- finish a batch of tasks */
+  int i, k;                     /* loop variables */
+  SAM *e;                       /* to traverse the miner copies */
+
+  assert(par);                  /* check the function argument */
+  for (i = k = 0; i < par->act; i++)
+    if (par->thds[i].report) par->reps[k++] = par->thds[i].report;
+  if ((r >= 0) && (isr_mergex(par->sam->report, par->reps, k) < 0))
+    r = -1;                     /* merge the item set reporters */
+  for (i = 0; i < par->act; i++) {  /* (output the recorded sets) */
+    e = par->thds +i;           /* traverse the miner copies */
+    if (e->report) isr_delete(e->report, 0);
+    if (e->fim16)  m16_delete(e->fim16);
+    if (e->mem)    ms_delete(e->mem);
+    if (e->buf)    free(e->buf);/* delete the reporter clones and */
+  }                             /* the other objects of the thread */
+  par->act = 0;                 /* there are no miner copies left */
+  if (par->nodes)               /* delete the tree projections */
+    ms_clear(par->nodes, 0);    /* or the projection arrays */
+  else { while (par->tcnt > 0) free(par->tasks[--par->tcnt].proj); }
+  par->tcnt = 0; par->mem = 0;  /* clear the task array */
+  return r;                     /* return the error status */
+}  /* par_end() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_beg (SAMPAR *par)
+{                               /* --- start a batch of tasks */
+  SAM *e;                       /* to traverse the miner copies */
+  TID x;                        /* size of a thread buffer */
+
+  assert(par && (par->act <= 0));  /* check the function argument */
+  x = tbg_cnt(par->sam->tabag)+1;  /* get buffer size (insertions) */
+  par->pexc = isr_pexcnt(par->sam->report);
+  while (par->act < par->cnt) { /* note the perfect extensions */
+    e = par->thds +par->act++;  /* traverse the worker threads */
+    *e = *par->sam;             /* and copy the miner (caller) */
+    e->par   = NULL;            /* (no nested parallel search) */
+    e->fim16 = NULL; e->mem = NULL; e->buf = NULL;
+    e->report = isr_clone(par->sam->report);
+    if (!e->report) return -1;  /* clone the item set reporter */
+    if (par->sam->fim16) {      /* if to use a 16 items machine */
+      e->fim16 = m16_create(-1, e->supp, e->report);
+      if (!e->fim16) return -1; /* create a 16 items machine */
+    }                           /* for each thread */
+    if (par->nodes) {           /* if transactions form a tree */
+      e->mem = ms_create(sizeof(TTNODE), 65535);
+      if (!e->mem) return -1;   /* create a memory system */
+    }                           /* for the projections */
+    if (e->twgt >= 0) {         /* if item insertions are allowed */
+      e->buf = malloc((size_t)x *par->size);
+      if (!e->buf) return -1;   /* allocate a buffer for the */
+    }                           /* transactions with the item */
+  }
+  return 0;                     /* return 'ok' */
+}  /* par_beg() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_run (SAMPAR *par)
+{                               /* --- process the collected tasks */
+  int    n, r;                  /* number of threads, error status */
+  TID    i;                     /* loop variable for tasks */
+  double *w;                    /* task size hints (item supports) */
+
+  assert(par);                  /* check the function argument */
+  if (par->tcnt <= 0) return par_end(par, 0);
+  n = (par->tcnt < par->cnt) ? (int)par->tcnt : par->cnt;
+  w = (double*)malloc((size_t)par->tcnt *sizeof(double));
+  if (!w) return par_end(par, -1);
+  for (i = 0; i < par->tcnt; i++)  /* use the supports of the */
+    w[i] = (double)par->tasks[i].supp;   /* items as size hints */
+  r = tp_execx(n, (long)par->tcnt, sam_task, par, w);
+  free(w);                      /* process the tasks in parallel */
+  return par_end(par, r);       /* and finish the batch of tasks */
+}  /* par_run() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_add (SAM *sam, ITEM item, SUPP supp, double wgt,
+                    void *proj, TID n)
+{                               /* --- add a top-level task */
+  SAMPAR  *par;                 /* data for the parallel search */
+  SAMTASK *t;                   /* new task (top-level item) */
+  TID     k;                    /* new size of the task array */
+  size_t  z;                    /* size of the projection */
+
+  assert(sam && sam->par);      /* check the function arguments */
+  par = sam->par;               /* get the parallel search data */
+  if ((par->tcnt > 0)           /* if perfect extensions were added */
+  &&  (isr_pexcnt(sam->report) != par->pexc)
+  &&  (par_run(par) < 0))       /* since the batch was started, */
+    return -1;                  /* process the collected tasks */
+  if ((par->act <= 0)           /* if there are no miner copies, */
+  &&  (par_beg(par) < 0))       /* start a new batch of tasks */
+    return par_end(par, -1);
+  if (par->tcnt >= par->tsize){ /* if the task array is full */
+    k = par->tsize +((par->tsize > 256) ? par->tsize >> 1 : 256);
+    t = (SAMTASK*)realloc(par->tasks, (size_t)k *sizeof(SAMTASK));
+    if (!t) return -1;          /* enlarge the task array */
+    par->tasks = t; par->tsize = k;
+  }                             /* set the new array and its size */
+  t = par->tasks +par->tcnt;    /* get the next task and */
+  t->item = item; t->supp = supp;   /* store the item */
+  t->wgt  = wgt;  t->n    = n;  /* and its support values */
+  t->proj = NULL;               /* default: empty projection */
+  if (par->nodes) {             /* if transactions form a tree, */
+    t->proj  = proj;            /* the projection is a copy */
+    par->mem = ms_used(par->nodes) *sizeof(TTNODE); }
+  else if (proj && (n > 0)) {   /* if transaction arrays are used */
+    z = (size_t)(n+1) *par->size;
+    t->proj = malloc(z);        /* copy the projection */
+    if (!t->proj) return -1;    /* (including the sentinel) */
+    memcpy(t->proj, proj, z); par->mem += z;
+  }
+  par->tcnt++;                  /* count the new task */
+  if ((par->mem < par->max) || (par->tcnt < par->cnt))
+    return 0;                   /* if the memory limit is reached, */
+  return par_run(par);          /* process the collected tasks */
+}  /* par_add() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_init (SAMPAR *par, SAM *sam, size_t size)
+{                               /* --- prepare a parallel search */
+  int n;                        /* number of threads */
+
+  assert(par && sam);           /* check the function arguments */
+  sam->par = NULL;              /* default: serial search */
+  n = sam->threads;             /* get the number of threads */
+  if (n <= 0) n = tp_cpucnt();  /* (default: number of processors) */
+  if ((n <= 1) || !isr_clonable(sam->report))
+    return 0;                   /* check for a parallel search */
+  par->sam   = sam;             /* note the split and merge miner */
+  par->cnt   = n;               /* and the number of threads */
+  par->act   = 0;               /* (no miner copies yet) */
+  par->size  = size;            /* and the array element size */
+  par->tasks = NULL; par->tcnt = par->tsize = 0;
+  par->mem   = 0;               /* limit the memory for projections */
+  par->max   = (size_t)(tbg_cnt(sam->tabag)+1) *sizeof(TZAE)
+             * (size_t)(4*n);   /* (relative to the database size) */
+  if (par->max < ((size_t)1 << 24)) par->max = (size_t)1 << 24;
+  par->nodes = NULL;            /* if transactions form a tree, */
+  if (size <= 0) {              /* create a memory system */
+    par->nodes = ms_create(sizeof(TTNODE), 65535);
+    if (!par->nodes) return -1; /* for the copies of the subtrees */
+  }                             /* (projections of the top level) */
+  par->thds = (SAM*)malloc((size_t)n *sizeof(SAM)
+                          +(size_t)n *sizeof(ISREPORT*));
+  if (!par->thds) { if (par->nodes) ms_delete(par->nodes); return -1; }
+  par->reps = (ISREPORT**)(par->thds +n);
+  sam->par = par;               /* create the miner copies and */
+  return n;                     /* return the number of threads */
+}  /* par_init() */
+
+/*--------------------------------------------------------------------*/
+
+static int par_exit (SAM *sam, int r)
+{                               /* --- finish a parallel search */
+  SAMPAR *par;                  /* data for the parallel search */
+
+  assert(sam);                  /* check the function argument */
+  if (!(par = sam->par)) return r;  /* check for a parallel search */
+  sam->par = NULL;              /* process the remaining tasks */
+  r = (r >= 0) ? par_run(par) : par_end(par, r);
+  if (par->nodes) ms_delete(par->nodes);
+  if (par->tasks) free(par->tasks);
+  free(par->thds);              /* delete the task array */
+  return r;                     /* and the miner copies */
+}  /* par_exit() */
+
+/* In a parallel search the calling thread executes the top level of  */
+/* the split and merge recursion as usual, but instead of searching   */
+/* the projections (conditional databases) of the top-level items, it */
+/* copies them and collects them as tasks. Whenever the copies exceed */
+/* a memory limit (and at the end), the collected tasks are processed */
+/* by a thread pool with work stealing. Each worker thread uses a     */
+/* copy of the miner with a clone of the item set reporter and its    */
+/* own 16 items machine, transaction buffer or memory system. The     */
+/* clones are created when the first task of a batch is collected,    */
+/* and the batch is processed before a task is added after a new      */
+/* perfect extension was found on the top level. Thus every task sees */
+/* the same perfect extensions as in the serial search and the result */
+/* is the same. Since the clones record the item sets per task and    */
+/* are merged task by task, and since the collected tasks are         */
+/* processed before the 16 items machine is run on the top level,     */
+/* even the order of the item sets is kept.                           */
+
 /*----------------------------------------------------------------------
   Split and Merge: Basic Version
 ----------------------------------------------------------------------*/
@@ -357,6 +630,7 @@ static int recurse (SAM *sam, TAAE *a, TID n)
     if (i < 0) {                /* if only packed items left */
       do { m16_add(sam->fim16, (BITTA)(a->items[0] & ~TA_END), a->occ);
       } while ((++a)->items);   /* add trans. to 16 items machine */
+      if (sam->par && (par_run(sam->par) < 0)) { r = -1; break; }
       r = m16_mine(sam->fim16); /* mine with 16 items machine */
       break;                    /* and abort the search loop */
     }
@@ -385,6 +659,11 @@ static int recurse (SAM *sam, TAAE *a, TID n)
     d->items = NULL;            /* store a sentinel at the end */
     if (supp < sam->supp)       /* if the support is too low, */
       continue;                 /* skip the recursive processing */
+    if (sam->par) {             /* if on top level of parallel search */
+      r = par_add(sam, i, supp, 0, proj, n);
+      if (r < 0) break;         /* collect the projection as a task */
+      continue;                 /* (searched by a worker thread) */
+    }
     r = isr_add(sam->report, i, supp);
     if (r <  0) break;          /* add current item to the reporter */
     if (r <= 0) continue;       /* and check if it needs processing */
@@ -410,6 +689,7 @@ int sam_base (SAM *sam)
   TID   i, n;                   /* loop variable, number of trans. */
   TRACT *t;                     /* to traverse the transactions */
   TAAE  *a;                     /* initial transaction array */
+  SAMPAR par;                   /* data for parallel search */
 
   assert(sam);                  /* check the function arguments */
   if (tbg_wgt(sam->tabag) < sam->supp)
@@ -432,7 +712,9 @@ int sam_base (SAM *sam)
     sam->fim16 = m16_create(-1, sam->supp, sam->report);
     if (!sam->fim16) { free(a); return -1; }
   }                             /* create a 16 items machine */
-  r = recurse(sam, a, n);       /* execute split and merge recursion */
+  r = par_init(&par, sam, sizeof(TAAE));
+  if (r >= 0)                   /* execute split and merge recursion */
+    r = par_exit(sam, recurse(sam, a, n));
   if (sam->fim16)               /* if a 16 items machine was used, */
     m16_delete(sam->fim16);     /* delete the 16 items machine */
   free(a);                      /* deallocate the transaction array */
@@ -467,6 +749,7 @@ static int rec_opt (SAM *sam, TAAE *a, TID n)
     if (i < 0) {                /* if only packed items left */
       do { m16_add(sam->fim16, (BITTA)(a->items[0] & ~TA_END), a->occ);
       } while ((++a)->items);   /* add trans. to 16 items machine */
+      if (sam->par && (par_run(sam->par) < 0)) { r = -1; break; }
       r = m16_mine(sam->fim16); /* mine with 16 items machine */
       break;                    /* and abort the search loop */
     }
@@ -513,6 +796,11 @@ static int rec_opt (SAM *sam, TAAE *a, TID n)
     k = (TID)(d -a);            /* compute the number of elements */
     if (supp < sam->supp)       /* if the support is too low, */
       continue;                 /* skip the recursive processing */
+    if (sam->par) {             /* if on top level of parallel search */
+      r = par_add(sam, i, supp, 0, proj, n);
+      if (r < 0) break;         /* collect the projection as a task */
+      continue;                 /* (searched by a worker thread) */
+    }
     r = isr_add(sam->report, i, supp);
     if (r <  0) break;          /* add current item to the reporter */
     if (r <= 0) continue;       /* and check if it needs processing */
@@ -538,6 +826,7 @@ int sam_opt (SAM *sam)
   TID   i, n;                   /* loop variable, number of trans. */
   TRACT *t;                     /* to traverse the transactions */
   TAAE  *a;                     /* initial transaction array */
+  SAMPAR par;                   /* data for parallel search */
 
   assert(sam);                  /* check the function arguments */
   if (tbg_wgt(sam->tabag) < sam->supp)
@@ -560,7 +849,9 @@ int sam_opt (SAM *sam)
     sam->fim16 = m16_create(-1, sam->supp, sam->report);
     if (!sam->fim16) { free(a); return -1; }
   }                             /* create a 16 items machine */
-  r = rec_opt(sam, a, n);       /* execute split and merge recursion */
+  r = par_init(&par, sam, sizeof(TAAE));
+  if (r >= 0)                   /* execute split and merge recursion */
+    r = par_exit(sam, rec_opt(sam, a, n));
   if (sam->fim16)               /* if a 16 items machine was used, */
     m16_delete(sam->fim16);     /* delete the 16 items machine */
   free(a);                      /* deallocate the transaction array */
@@ -604,6 +895,7 @@ static int rec_dsb (SAM *sam, TAAE *a, TID n)
         m16_add(sam->fim16, (BITTA)(s->items[0] & ~TA_END), s->occ);
       for ( ; t->items; t++)    /* add trans. to 16 items machine */
         m16_add(sam->fim16, (BITTA)(t->items[0] & ~TA_END), t->occ);
+      if (sam->par && (par_run(sam->par) < 0)) { r = -1; break; }
       r = m16_mine(sam->fim16); /* mine with 16 items machine */
       break;                    /* and abort the search loop */
     }
@@ -686,6 +978,11 @@ static int rec_dsb (SAM *sam, TAAE *a, TID n)
     }                           /* and note the new array end */
     if (supp < sam->supp)       /* if the support is too low, */
       continue;                 /* skip the recursive processing */
+    if (sam->par) {             /* if on top level of parallel search */
+      r = par_add(sam, i, supp, 0, proj, n);
+      if (r < 0) break;         /* collect the projection as a task */
+      continue;                 /* (searched by a worker thread) */
+    }
     r = isr_add(sam->report, i, supp);
     if (r <  0) break;          /* add current item to the reporter */
     if (r <= 0) continue;       /* check if item needs processing */
@@ -711,6 +1008,7 @@ int sam_dsb (SAM *sam, TID merge)
   TID   i, n;                   /* loop variable, number of trans. */
   TRACT *t;                     /* to traverse the transactions */
   TAAE  *a;                     /* initial transaction array */
+  SAMPAR par;                   /* data for parallel search */
 
   assert(sam);                  /* check the function arguments */
   sam->merge = merge;           /* initialize the recursion data */
@@ -734,7 +1032,9 @@ int sam_dsb (SAM *sam, TID merge)
     sam->fim16 = m16_create(-1, sam->supp, sam->report);
     if (!sam->fim16) { free(a); return -1; }
   }                             /* create a 16 items machine */
-  r = rec_dsb(sam, a, n);       /* execute split and merge recursion */
+  r = par_init(&par, sam, sizeof(TAAE));
+  if (r >= 0)                   /* execute split and merge recursion */
+    r = par_exit(sam, rec_dsb(sam, a, n));
   if (sam->fim16)               /* if a 16 items machine was used, */
     m16_delete(sam->fim16);     /* delete the 16 items machine */
   free(a);                      /* deallocate the transaction array */
@@ -848,11 +1148,20 @@ static int rec_tree (SAM *sam, TTNODE *node)
       do { assert(node->item < 0);
         m16_add(sam->fim16, (BITTA)(node->item & ~TA_END), node->supp);
       } while ((node = node->sibling));    /* add transactions */
+      if (sam->par && (par_run(sam->par) < 0)) { r = -1; break; }
       r = m16_mine(sam->fim16); break;      /* to 16 items machine */
     }                           /* and mine with 16 items machine */
     if (node->supp < sam->supp) continue;/* skip infrequent items */
     if (node->supp >= pex) {    /* and collect perfect extensions */
       isr_addpex(sam->report, node->item); continue; }
+    if (sam->par) {             /* if on top level of parallel search */
+      proj = node->children;    /* copy the subtree for the item */
+      if (proj && ((proj = copy(proj, sam->par->nodes)) == COPYERR)) {
+        r = -1; break; }        /* and collect it as a task */
+      r = par_add(sam, node->item, node->supp, 0, proj, 0);
+      if (r < 0) break;         /* (the subtree is searched */
+      continue;                 /* by a worker thread) */
+    }
     r = isr_add(sam->report, node->item, node->supp);
     if (r <  0) break;          /* add current item to the reporter */
     if (r <= 0) continue;       /* check if item needs processing */
@@ -881,6 +1190,7 @@ int sam_tree (SAM *sam)
   TID    i, n;                  /* loop variable, number of trans. */
   TRACT  *t;                    /* to traverse the transactions */
   TTNODE *root;                 /* root of transaction prefix tree */
+  SAMPAR par;                   /* data for parallel search */
 
   assert(sam);                  /* check the function argument */
   if (tbg_wgt(sam->tabag) < sam->supp)
@@ -900,8 +1210,10 @@ int sam_tree (SAM *sam)
     n = add(&root, ta_items(t), ta_wgt(t), sam->mem);
     if (n < 0) break;           /* add the transaction to the tree */
   }                             /* and check for a memory error */
-  if (n >= 0) {                 /* if a tree was built, */
-    r = rec_tree(sam, root);    /* find freq. item sets recursively */
+  if (n >= 0)                   /* if a tree was built, */
+    r = par_init(&par, sam, 0); /* prepare a parallel search */
+  if ((n >= 0) && (r >= 0)) {   /* find freq. item sets recursively */
+    r = par_exit(sam, rec_tree(sam, root));
     if (r >= 0)                 /* finally report the empty item set */
       r = isr_report(sam->report);
   }
@@ -988,6 +1300,11 @@ static int rec_ins (SAM *sam, TXAE *a, TID n, ITEM k)
     if ((supp < sam->supp)      /* if the item set support */
     ||  (sum  < sam->isup))     /* or the weight are too low */
       continue;                 /* skip the recursive processing */
+    if (sam->par) {             /* if on top level of parallel search */
+      r = par_add(sam, k, supp, sum, proj, (TID)(e -proj));
+      if (r < 0) break;         /* collect the projection as a task */
+      continue;                 /* (searched by a worker thread) */
+    }
     r = isr_addwgt(sam->report, k, supp, sum);
     if (r <  0) break;          /* add current item to the reporter */
     if (r <= 0) continue;       /* and check if it needs processing */
@@ -1014,6 +1331,7 @@ int sam_ins (SAM *sam)
   TID   i, n;                   /* loop variable, number of trans. */
   TRACT *t;                     /* to traverse the transactions */
   TXAE  *a;                     /* initial transaction array */
+  SAMPAR par;                   /* data for parallel search */
 
   assert(sam);                  /* check the function arguments */
   if (tbg_wgt(sam->tabag) < sam->supp)
@@ -1031,7 +1349,9 @@ int sam_ins (SAM *sam)
   a[n].items = NULL;            /* store a sentinel at the end */
   sam->buf   = a+n+1;           /* use rest of array as a buffer */
   sam->base  = tbg_base(sam->tabag);/* note underlying item base */
-  r = rec_ins(sam, a, n, k);    /* execute split and merge recursion */
+  r = par_init(&par, sam, sizeof(TXAE));
+  if (r >= 0)                   /* execute split and merge recursion */
+    r = par_exit(sam, rec_ins(sam, a, n, k));
   free(a);                      /* deallocate the transaction array */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(sam->report);/* report the empty item set */
@@ -1175,6 +1495,11 @@ static int rec_lim (SAM *sam, TZAE *a, TID n, ITEM k)
     if ((supp < sam->supp)      /* if the item set support */
     ||  (sum  < sam->isup))     /* or the weight are too low, */
       continue;                 /* skip the recursive processing */
+    if (sam->par) {             /* if on top level of parallel search */
+      r = par_add(sam, k, supp, sum, proj, (TID)(e -proj));
+      if (r < 0) break;         /* collect the projection as a task */
+      continue;                 /* (searched by a worker thread) */
+    }
     r = isr_addwgt(sam->report, k, supp, sum);
     if (r <  0) { free(proj); return r; }
     if (r <= 0) continue;       /* add current item to the reporter */
@@ -1201,6 +1526,7 @@ int sam_lim (SAM *sam)
   TID   i, n;                   /* loop variable, number of trans. */
   TRACT *t;                     /* to traverse the transactions */
   TZAE  *a;                     /* initial transaction array */
+  SAMPAR par;                   /* data for parallel search */
 
   assert(sam);                  /* check the function arguments */
   if (tbg_wgt(sam->tabag) < sam->supp)
@@ -1219,7 +1545,9 @@ int sam_lim (SAM *sam)
   a[n].items = NULL;            /* store a sentinel at the end */
   sam->buf   = a+n+1;           /* use rest of array as a buffer */
   sam->base  = tbg_base(sam->tabag);/* note underlying item base */
-  r = rec_lim(sam, a, n, k);    /* execute split and merge recursion */
+  r = par_init(&par, sam, sizeof(TZAE));
+  if (r >= 0)                   /* execute split and merge recursion */
+    r = par_exit(sam, rec_lim(sam, a, n, k));
   free(a);                      /* deallocate the transaction array */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(sam->report);/* report the empty item set */
@@ -1262,6 +1590,8 @@ SAM* sam_create (int target, double smin, double sins,
   sam->algo   = algo;
   sam->mode   = mode;
   sam->merge  = 0;
+  sam->threads = 1;
+  sam->par    = NULL;
   sam->tabag  = NULL;
   sam->report = NULL;
   sam->mem    = NULL;
@@ -1299,7 +1629,6 @@ int sam_data (SAM *sam, TABAG *tabag, int sort)
   assert(sam && tabag);         /* check the function arguments */
   sam->tabag = tabag;           /* note the transaction bag */
   pack = sam->mode & SAM_FIM16; /* get number of items to pack */
-  if (pack > 16) pack = 16;     /* pack at most 16 items */
   w = tbg_wgt(tabag);           /* compute absolute minimum support */
   smin = ceilsupp((sam->smin < 0) ? -sam->smin
                 : (sam->smin/100.0) *(double)w *(1-DBL_EPSILON));
@@ -1325,8 +1654,9 @@ int sam_data (SAM *sam, TABAG *tabag, int sort)
   tbg_sort  (tabag, -1, 0);     /* sort the trans. lexicographically */
   tbg_reduce(tabag, 0);         /* reduce transactions to unique ones */
   if ((sam->twgt < 0)           /* if insertions are not possible */
-  &&  (pack      > 0))          /* and 16-items machine is used, */
-    tbg_pack(tabag, pack);      /* pack the most frequent items */
+  &&  (pack      > 0))          /* and k-items machine is used, */
+    tbg_pack(tabag, m16_width(tabag, pack));
+                                /* pack the most frequent items */
   #ifndef QUIET                 /* if to print messages */
   n = tbg_cnt(tabag);           /* get the number of transactions */
   w = tbg_wgt(tabag);           /* and the new transaction weight */
@@ -1369,7 +1699,7 @@ int sam_report (SAM *sam, ISREPORT *report)
 
 /*--------------------------------------------------------------------*/
 
-int sam_mine (SAM *sam, TID merge)
+int sam_mine (SAM *sam, TID merge, int threads)
 {                               /* --- SaM algorithm (generic) */
   int     r;                    /* result of function call */
   #ifndef QUIET                 /* if to print messages */
@@ -1379,6 +1709,7 @@ int sam_mine (SAM *sam, TID merge)
   assert(sam);                  /* check the function arguments */
   CLOCK(t);                     /* start timer, print log message */
   XMSG(stderr, "writing %s ... ", isr_name(sam->report));
+  sam->threads = threads;       /* note the number of threads */
   if      (sam->twgt >  0)
     r = sam_lim (sam);          /*   limited item insertions */
   else if (sam->twgt >= 0)
@@ -1538,6 +1869,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     threads  = 1;         /* number of threads to use */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -1592,6 +1924,9 @@ int main (int argc, char *argv[])
                     "(default: prune)\n");
     printf("-l#      number of items for k-items machine      "
                     "(default: %d)\n", pack);
+    printf("-Y#      number of threads to use                 "
+                    "(default: %d)\n", threads);
+    printf("         (a value <= 0 means one thread per cpu)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -1634,7 +1969,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: acjop [A-Z]\[ACFNPRTZ] */
+  /* free option characters: acjop [A-Z]\[ACFNPRTYZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse arguments */
@@ -1658,6 +1993,7 @@ int main (int argc, char *argv[])
           case 'y': merge  = (TID) strtol(s, &s, 0); break;
           case 'x': mode  &= ~SAM_PERFECT;           break;
           case 'l': pack   = (int) strtol(s, &s, 0); break;
+          case 'Y': threads = (int)strtol(s, &s, 0); break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
@@ -1724,7 +2060,7 @@ int main (int argc, char *argv[])
     default : error(E_MEASURE, (char)eval);  break;
   }                             /* (get evaluation measure code) */
   mode = (mode & ~SAM_FIM16)    /* add packed items to search mode */
-       | ((pack <= 0) ? 0 : (pack < 16) ? pack : 16);
+       | ((pack <= 0) ? 0 : (pack < 31) ? pack : 31);
   if (info == dflt)             /* adapt the default info. format */
     info = (smin < 0) ? " (%a)" : " (%S)";
   MSG(stderr, "\n");            /* terminate the startup message */
@@ -1791,7 +2127,7 @@ int main (int argc, char *argv[])
   if (k) error(k, isr_name(report));
   if (isr_setup(report) < 0)    /* open the item set file and */
     error(E_NOMEM);             /* set up the item set reporter */
-  k = sam_mine(sam, merge);     /* find frequent item sets */
+  k = sam_mine(sam, merge, threads);   /* find frequent item sets */
   if (k) error(k);
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
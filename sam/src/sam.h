@@ -7,6 +7,7 @@
             2014.08.28 functions sam_data() and sam_report() added
             2016.11.23 eclat miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 parameter 'threads' added to sam_mine()
 ----------------------------------------------------------------------*/
 #ifndef __SAM__
 #define __SAM__
@@ -69,5 +70,5 @@ extern SAM* sam_create (int target, double smin, double sins,
 extern void sam_delete (SAM *sam, int deldar);
 extern int  sam_data   (SAM *sam, TABAG *tabag, int sort);
 extern int  sam_report (SAM *sam, ISREPORT *report);
-extern int  sam_mine   (SAM *sam, TID merge);
+extern int  sam_mine   (SAM *sam, TID merge, int threads);
 #endif
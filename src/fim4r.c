@@ -11,6 +11,17 @@
             2016.11.15 adapted to modified accretion interface
             2016.11.21 adapted to modified fpgrowth interface
             2017.03.25 adapted to modified carpenter/ista interfaces
+            2026.10.16 parameter 'threads' added to function eclat()
+            2026.10.16 parameter 'threads' added to fim() and fpgrowth()
+            2026.10.16 parameter 'threads' added to function apriori()
+            2026.10.16 parameter 'threads' added to function carpenter()
+            2026.10.16 parameter 'threads' added to sam() and relim()
+            2026.10.17 parameter 'threads' added to function patred()
+            2026.10.17 parameter 'miner' added to function genpsp()
+            2026.10.17 parameter 'cpus' added to function estpsp()
+            2026.10.17 dispatch to variant with wide TID/SUPP types
+            2026.10.17 fpgrowth algorithm variant 'array' added
+            2026.10.17 mode 'c' (compress transactions) added
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -51,6 +62,7 @@
 #include "ista.h"
 #include "accretion.h"
 #include "fpgpsp.h"
+#include "eclpsp.h"
 #include "patred.h"
 #ifdef STORAGE
 #include "storage.h"
@@ -67,6 +79,34 @@
 #define ERR_MEM()       MYERROR("out of memory")
 #define ERR_ABORT()     MYERROR("user abort")
 
+/* --- surrogate data miners --- */
+#define MNR_FPGROWTH    0       /* FP-growth (simple tree nodes) */
+#define MNR_ECLAT       1       /* Eclat (occurrence deliver) */
+
+/* --- wide type variant --- */
+#ifdef F4R_WIDE                 /* if compiled with wide TID/SUPP, */
+#define f4r_fim         f4r_fim_w       /* rename the entry points */
+#define f4r_arules      f4r_arules_w    /* that take transactions, */
+#define f4r_apriori     f4r_apriori_w   /* so that they can be called */
+#define f4r_eclat       f4r_eclat_w     /* from the default version */
+#define f4r_fpgrowth    f4r_fpgrowth_w
+#define f4r_sam         f4r_sam_w
+#define f4r_relim       f4r_relim_w
+#define f4r_carpenter   f4r_carpenter_w
+#define f4r_ista        f4r_ista_w
+#define f4r_apriacc     f4r_apriacc_w
+#define f4r_accretion   f4r_accretion_w
+#define f4r_genpsp      f4r_genpsp_w
+#define f4r_estpsp      f4r_estpsp_w
+#endif
+
+#ifdef F4R_DISPATCH             /* if a wide variant is linked, */
+#define WIDE(call)      return call     /* pass large data sets on */
+#else                           /* otherwise report an error */
+#define WIDE(call)      error("too many transactions or total " \
+                              "transaction weight too large")
+#endif
+
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
@@ -80,6 +120,41 @@ typedef struct {                /* --- item set report data --- */
   int    err;                   /* error flag */
 } REPDATA;                      /* (item set report data) */
 
+/*----------------------------------------------------------------------
+  Wide Type Variant Functions
+----------------------------------------------------------------------*/
+#ifdef F4R_DISPATCH
+extern SEXP f4r_fim_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                       SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_arules_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                          SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_apriori_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                           SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                           SEXP, SEXP, SEXP);
+extern SEXP f4r_eclat_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                         SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                         SEXP);
+extern SEXP f4r_fpgrowth_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                            SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                            SEXP, SEXP, SEXP);
+extern SEXP f4r_sam_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                       SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_relim_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                         SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_carpenter_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                             SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_ista_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                        SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_apriacc_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                           SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_accretion_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                             SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_genpsp_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                          SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP f4r_estpsp_w (SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP,
+                          SEXP, SEXP, SEXP, SEXP, SEXP);
+#endif
+
 /*----------------------------------------------------------------------
   Parameter Functions
 ----------------------------------------------------------------------*/
@@ -395,6 +470,29 @@ static int get_surr (SEXP p)
 
 /*--------------------------------------------------------------------*/
 
+static int get_miner (SEXP p)
+{                               /* --- get surrogate data miner code */
+  CCHAR *s;                     /* miner string */
+
+  assert(p);                    /* check the function argument */
+  if (TYPEOF(p) != STRSXP) return -1;
+  if (length(p) < 1) s = "f";   /* get the miner string */
+  else s = CHAR(STRING_ELT(p, 0));
+  if (s[0] && s[1]) {           /* evaluate textual identifier */
+    if      (strcmp(s, "fpgrowth")  == 0) s = "f";
+    else if (strcmp(s, "eclat")     == 0) s = "e";
+  }
+  if (s[0] && !s[1]) {          /* translate miner string */
+    switch (s[0]) {             /* evaluate the miner code */
+      case 'f': return MNR_FPGROWTH;
+      case 'e': return MNR_ECLAT;
+    }
+  }
+  return -1;                    /* return an error code */
+}  /* get_miner() */
+
+/*--------------------------------------------------------------------*/
+
 static int get_red (SEXP p)
 {                               /* --- get random function code */
   CCHAR *s;                     /* density function string */
@@ -511,10 +609,12 @@ static int chktracts (SEXP tracts, SEXP wgts, SEXP appear)
 {                               /* --- check transaction arguments */
   R_xlen_t i, n;                /* loop variables */
   int      t;                   /* item type (integer or string) */
+  int      *w;                  /* transaction weights */
+  double   sum;                 /* total transaction weight */
 
   assert(tracts);               /* check the function arguments */
   if (TYPEOF(tracts) != VECSXP) return -1;
-  n = length(tracts);           /* check the data type */
+  n = xlength(tracts);          /* check the data type */
   if (n <= 0) return -1;        /* and the list length */
   t = TYPEOF(VECTOR_ELT(tracts, 0));
   if ((t != INTSXP) && (t != STRSXP))
@@ -522,18 +622,24 @@ static int chktracts (SEXP tracts, SEXP wgts, SEXP appear)
   for (i = 1; i < n; i++)       /* check type of transactions */
     if (TYPEOF(VECTOR_ELT(tracts, i)) != t) return -2;
   if ((wgts != R_NilValue)      /* if transaction weights are given */
-  && ((TYPEOF(wgts) != INTSXP) || (length(wgts) != n)))
+  && ((TYPEOF(wgts) != INTSXP) || (xlength(wgts) != n)))
     return -3;                  /* check type/length of weights array */
-  if (appear == R_NilValue)     /* if no item appearances are given, */
-    return 0;                   /* simply abort the function */
-  if ((TYPEOF(appear) != VECSXP) || (length(appear) != 2)
-  ||  ( TYPEOF(VECTOR_ELT(appear, 0)) != t)
-  ||  ((TYPEOF(VECTOR_ELT(appear, 1)) != INTSXP)
-  &&   (TYPEOF(VECTOR_ELT(appear, 1)) != STRSXP))
-  ||  ( length(VECTOR_ELT(appear, 0)) != length(VECTOR_ELT(appear, 1))))
+  if ((appear != R_NilValue)    /* if item appearances are given */
+  &&  ((TYPEOF(appear) != VECSXP) || (length(appear) != 2)
+  ||   ( TYPEOF(VECTOR_ELT(appear, 0)) != t)
+  ||   ((TYPEOF(VECTOR_ELT(appear, 1)) != INTSXP)
+  &&    (TYPEOF(VECTOR_ELT(appear, 1)) != STRSXP))
+  ||   ( length(VECTOR_ELT(appear, 0))
+      != length(VECTOR_ELT(appear, 1)))))
     return -4;                  /* check for proper types and lengths */
-  return 0;                     /* return 'ok' */
-}  /* chktracts() */
+  if ((double)n > (double)TID_MAX)
+    return 1;                   /* check the number of transactions */
+  if (wgts == R_NilValue)       /* if there are no weights, */
+    return ((double)n > (double)SUPP_MAX) ? 1 : 0;
+  w = INTEGER(wgts);            /* sum the transaction weights */
+  for (sum = 0, i = 0; i < n; i++) sum += (double)w[i];
+  return (sum > (double)SUPP_MAX) ? 1 : 0;
+}  /* chktracts() */            /* return whether wide types needed */
 
 /*--------------------------------------------------------------------*/
 
@@ -600,7 +706,7 @@ static TABAG* tbg_fromRObj (SEXP tracts, SEXP wgts, SEXP appear)
     ib_delete(ibase); return NULL; }    /* to the item base */
   tabag = tbg_create(ibase);    /* create a transaction bag */
   if (!tabag) { ib_delete(ibase); return NULL; }
-  m = length(tracts);           /* get the number of transactions */
+  m = (TID)xlength(tracts);     /* get the number of transactions */
   for (k = 0; k < m; k++) {     /* and traverse the transactions */
     ib_clear(ibase);            /* clear the internal transaction */
     p = VECTOR_ELT(tracts, k);  /* get the next R transaction */
@@ -865,7 +971,7 @@ static SEXP psp_toRObj (PATSPEC *psp, double scale, int format)
       for (s = psp_min4sz(psp, z); s <= psp_max4sz(psp, z); s++) {
         k = psp_getfrq(psp,z,s);/* traverse the pattern signatures */
         if (k <= 0) continue;   /* skip empty counters */
-        sizes[i]   = z; supps[i] = s;
+        sizes[i]   = z; supps[i] = (int)s;
         freqs[i++] = (double)k *scale;
       }                         /* store the signature elements */
     }                           /* in the corresponding arrays */
@@ -932,12 +1038,13 @@ static void repfn (long int cnt, void *data)
 
 /*--------------------------------------------------------------------*/
 /* fim (tracts, wgts=NULL, target="s", supp=10.0, zmin=0, zmax=-1,    */
-/*      report="a", eval="x", agg="x", thresh=10.0, border=NULL)      */
+/*      report="a", eval="x", agg="x", thresh=10.0, border=NULL,      */
+/*      threads=1)                                                    */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_fim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
               SEXP pzmin, SEXP pzmax, SEXP preport, SEXP peval,
-              SEXP pagg, SEXP pthresh, SEXP pborder)
+              SEXP pagg, SEXP pthresh, SEXP pborder, SEXP pthreads)
 {                               /* --- frequent item set mining */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -947,6 +1054,7 @@ SEXP f4r_fim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   int      eval    = 'x';       /* evaluation measure */
   int      agg     =  0;        /* aggregation mode */
   double   thresh  = 10;        /* threshold for evaluation measure */
+  int      threads =  1;        /* number of threads to use */
   int      algo    = FPG_SIMPLE;   /* algorithm variant */
   int      mode    = FPG_DEFAULT;  /* operation mode/flags */
   TABAG    *tabag;              /* created transaction bag */
@@ -963,6 +1071,9 @@ SEXP f4r_fim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_fim_w(ptracts, pwgts, ptarget, psupp, pzmin,
+                    pzmax, preport, peval, pagg, pthresh, pborder,
+                    pthreads));
   target = get_target(ptarget, "ascmg");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -982,6 +1093,7 @@ SEXP f4r_fim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   if ((pborder != R_NilValue)   /* check the filtering border */
   &&  (TYPEOF(pborder) != INTSXP) && (TYPEOF(pborder) != REALSXP))
     error("invalid 'border' argument (must be numeric)");
+  threads = get_int(pthreads, threads);
 
   /* --- create transaction bag --- */
   sig_install();                /* install the signal handler */
@@ -1006,7 +1118,7 @@ SEXP f4r_fim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
     fpg_delete(fpgrowth, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
-  r = fpg_mine(fpgrowth, ITEM_MIN, 0);
+  r = fpg_mine(fpgrowth, ITEM_MIN, 0, threads);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1053,6 +1165,8 @@ SEXP f4r_arules (SEXP ptracts, SEXP pwgts, SEXP psupp,   SEXP pconf,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_arules_w(ptracts, pwgts, psupp, pconf, pzmin,
+                    pzmax, preport, peval, pthresh, pmode, pappear));
   supp   = get_dbl(psupp, supp);
   conf   = get_dbl(pconf, conf);
   if (conf   < 0)    error("invalid 'conf' argument (must be >= 0)");
@@ -1091,7 +1205,7 @@ SEXP f4r_arules (SEXP ptracts, SEXP pwgts, SEXP psupp,   SEXP pconf,
     fpg_delete(fpgrowth, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
-  r = fpg_mine(fpgrowth, ITEM_MIN, 0);
+  r = fpg_mine(fpgrowth, ITEM_MIN, 0, 1);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1106,14 +1220,14 @@ SEXP f4r_arules (SEXP ptracts, SEXP pwgts, SEXP psupp,   SEXP pconf,
 /*--------------------------------------------------------------------*/
 /* apriori (tracts, wgts=NULL, target="s", supp=10, zmin=0, zmax=-1,  */
 /*          report="a", eval="x", agg="x", thresh=10.0, prune=NA,     */
-/*          algo="a", mode="", border=NULL, appear=NULL)              */
+/*          algo="a", mode="", border=NULL, appear=NULL, threads=1)   */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                   SEXP psupp, SEXP pconf, SEXP pzmin, SEXP pzmax,
                   SEXP preport, SEXP peval, SEXP pagg, SEXP pthresh,
                   SEXP pprune,  SEXP palgo, SEXP pmode,
-                  SEXP pborder, SEXP pappear)
+                  SEXP pborder, SEXP pappear, SEXP pthreads)
 {                               /* --- frequent item set mining */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -1124,8 +1238,10 @@ SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   int      eval    = 'x';       /* evaluation measure */
   int      agg     =  0;        /* aggregation mode */
   double   thresh  = 10;        /* threshold for evaluation measure */
+  int      threads =  1;        /* number of threads to use */
   int      algo    = APR_AUTO;     /* algorithm variant */
   int      mode    = APR_DEFAULT;  /* operation mode/flags */
+  int      prep    = 0;         /* data preparation mode */
   CCHAR    *s      = "";        /* to access the operation mode/flags */
   long int prune   = LONG_MIN;  /* min. size for evaluation filtering */
   TABAG    *tabag;              /* created transaction bag */
@@ -1144,6 +1260,10 @@ SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_apriori_w(ptracts, pwgts, ptarget, psupp,
+                    pconf, pzmin, pzmax, preport, peval, pagg,
+                    pthresh, pprune, palgo, pmode, pborder, pappear,
+                    pthreads));
   target = get_target(ptarget, "ascmgr");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -1184,6 +1304,7 @@ SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   s = (length(pmode) > 0) ? CHAR(STRING_ELT(pmode, 0)) : "";
   for ( ; *s; s++) {            /* traverse the mode characters */
     if      (*s == 'o') mode |=  APR_ORIGSUPP;
+    else if (*s == 'c') prep |=  APR_COMPRESS;
     else if (*s == 'x') mode &= ~APR_PERFECT;
     else if (*s == 't') mode &= ~APR_TATREE;
     else if (*s == 'T') mode &= ~APR_TATREE;
@@ -1193,6 +1314,7 @@ SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   if ((pborder != R_NilValue)   /* check the filtering border */
   &&  (TYPEOF(pborder) != INTSXP) && (TYPEOF(pborder) != REALSXP))
     error("invalid 'border' argument (must be numeric)");
+  threads = get_int(pthreads, threads);
 
   /* --- get and prepare transactions --- */
   sig_install();                /* install the signal handler */
@@ -1203,7 +1325,7 @@ SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                            (ITEM)zmin, (ITEM)zmax,
                            eval, agg, thresh, algo, mode);
   if (!apriori) { tbg_delete(tabag, 1); ERR_MEM(); }
-  r = apriori_data(apriori, tabag, 0, +2);
+  r = apriori_data(apriori, tabag, prep, +2);
   if (r) apriori_delete(apriori, 1);   /* prepare data for apriori */
   if (r == -1) ERR_MEM();       /* check for an error and no items */
   if (r <   0) { sig_remove(); return allocVector(VECSXP, 0); }
@@ -1220,7 +1342,7 @@ SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   /* --- frequent item set mining --- */
   if (prune < ITEM_MIN) prune = ITEM_MIN;
   if (prune > ITEM_MAX) prune = ITEM_MAX;
-  r = apriori_mine(apriori, (ITEM)prune, 0.01, 0);
+  r = apriori_mine(apriori, (ITEM)prune, 0.01, 0, threads);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1235,14 +1357,14 @@ SEXP f4r_apriori (SEXP ptracts, SEXP pwgts, SEXP ptarget,
 /*--------------------------------------------------------------------*/
 /* eclat (tracts, wgts=NULL, target="s", supp=10, zmin=0, zmax=-1,    */
 /*        report="a", eval="x", agg="x", thresh=10.0, prune=NA,       */
-/*        algo="a", mode="", border=NULL, appear=NULL)                */
+/*        algo="a", mode="", border=NULL, appear=NULL, threads=1)     */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                 SEXP psupp, SEXP pconf, SEXP pzmin, SEXP pzmax,
                 SEXP preport, SEXP peval, SEXP pagg, SEXP pthresh,
                 SEXP pprune,  SEXP palgo, SEXP pmode,
-                SEXP pborder, SEXP pappear)
+                SEXP pborder, SEXP pappear, SEXP pthreads)
 {                               /* --- frequent item set mining */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -1253,8 +1375,10 @@ SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   int      eval    = 'x';       /* evaluation measure */
   int      agg     =  0;        /* aggregation mode */
   double   thresh  = 10;        /* threshold for evaluation measure */
+  int      threads =  1;        /* number of threads to use */
   int      algo    = ECL_OCCDLV;   /* algorithm variant */
   int      mode    = ECL_DEFAULT;  /* operation mode/flags */
+  int      prep    = 0;         /* data preparation mode */
   CCHAR    *s      = "";        /* to access the operation mode/flags */
   long int prune   = LONG_MIN;  /* min. size for evaluation filtering */
   TABAG    *tabag;              /* created transaction bag */
@@ -1273,6 +1397,9 @@ SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_eclat_w(ptracts, pwgts, ptarget, psupp, pconf,
+                    pzmin, pzmax, preport, peval, pagg, pthresh,
+                    pprune, palgo, pmode, pborder, pappear, pthreads));
   target = get_target(ptarget, "ascmgr");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -1327,6 +1454,7 @@ SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   s = (length(pmode) > 0) ? CHAR(STRING_ELT(pmode, 0)) : "";
   for ( ; *s; s++) {            /* traverse the mode characters */
     if      (*s == 'o') mode |=  ECL_ORIGSUPP;
+    else if (*s == 'c') prep |=  ECL_COMPRESS;
     else if (*s == 'l') mode &= ~ECL_FIM16;
     else if (*s == 'x') mode &= ~ECL_PERFECT;
     else if (*s == 'i') mode &= ~ECL_REORDER;
@@ -1338,6 +1466,7 @@ SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   if ((pborder != R_NilValue)   /* check the filtering border */
   &&  (TYPEOF(pborder) != INTSXP) && (TYPEOF(pborder) != REALSXP))
     error("invalid 'border' argument (must be numeric)");
+  threads = get_int(pthreads, threads);
 
   /* --- get and prepare transactions --- */
   sig_install();                /* install the signal handler */
@@ -1348,7 +1477,7 @@ SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                        (ITEM)zmin, (ITEM)zmax,
                        eval, agg, thresh, algo, mode);
   if (!eclat) { tbg_delete(tabag, 1); ERR_MEM(); }
-  r = eclat_data(eclat, tabag, 0, +2);
+  r = eclat_data(eclat, tabag, prep, +2);
   if (r) eclat_delete(eclat, 1);/* prepare data for eclat */
   if (r == -1) ERR_MEM();       /* check for an error and no items */
   if (r <   0) { sig_remove(); return allocVector(VECSXP, 0); }
@@ -1365,7 +1494,7 @@ SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   /* --- frequent item set mining --- */
   if (prune < ITEM_MIN) prune = ITEM_MIN;
   if (prune > ITEM_MAX) prune = ITEM_MAX;
-  r = eclat_mine(eclat, (ITEM)prune, 0);
+  r = eclat_mine(eclat, (ITEM)prune, 0, threads);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1380,14 +1509,14 @@ SEXP f4r_eclat (SEXP ptracts, SEXP pwgts, SEXP ptarget,
 /*--------------------------------------------------------------------*/
 /* fpgrowth (tracts, wgts=NULL, target="s", supp=10, zmin=0, zmax=-1, */
 /*           report="a", eval="x", agg="x", thresh=10.0, prune=NA,    */
-/*           algo="a", mode="", border=NULL, appear=NULL)             */
+/*           algo="a", mode="", border=NULL, appear=NULL, threads=1)  */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                    SEXP psupp, SEXP pconf, SEXP pzmin, SEXP pzmax,
                    SEXP preport, SEXP peval, SEXP pagg, SEXP pthresh,
                    SEXP pprune,  SEXP palgo, SEXP pmode,
-                   SEXP pborder, SEXP pappear)
+                   SEXP pborder, SEXP pappear, SEXP pthreads)
 {                               /* --- frequent item set mining */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -1398,8 +1527,10 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   int      eval    = 'x';       /* evaluation measure */
   int      agg     =  0;        /* aggregation mode */
   double   thresh  = 10;        /* threshold for evaluation measure */
+  int      threads =  1;        /* number of threads to use */
   int      algo    = FPG_SIMPLE;   /* algorithm variant */
   int      mode    = FPG_DEFAULT;  /* operation mode/flags */
+  int      prep    = 0;         /* data preparation mode */
   CCHAR    *s      = "";        /* to access the operation mode/flags */
   long int prune   = LONG_MIN;  /* min. size for evaluation filtering */
   TABAG    *tabag;              /* created transaction bag */
@@ -1418,6 +1549,10 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_fpgrowth_w(ptracts, pwgts, ptarget, psupp,
+                    pconf, pzmin, pzmax, preport, peval, pagg,
+                    pthresh, pprune, palgo, pmode, pborder, pappear,
+                    pthreads));
   target = get_target(ptarget, "ascmgr");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -1446,6 +1581,7 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
     else if (strcmp(s, "complex") == 0) s    = "c";
     else if (strcmp(s, "single")  == 0) s    = "d";
     else if (strcmp(s, "topdown") == 0) s    = "t";
+    else if (strcmp(s, "array")   == 0) s    = "r";
     else                                algo = -1;
   }                             /* translate the algorithm string */
   if (s[0] && !s[1]) {          /* if single character, */
@@ -1455,6 +1591,7 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
       case 'c': algo = FPG_COMPLEX; break;
       case 'd': algo = FPG_SINGLE;  break;
       case 't': algo = FPG_TOPDOWN; break;
+      case 'r': algo = FPG_ARRAY;   break;
       default : algo = -1;          break;
     }                           /* set an error code for all */
   }                             /* other algorithm indicators */
@@ -1463,6 +1600,7 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   s = (length(pmode) > 0) ? CHAR(STRING_ELT(pmode, 0)) : "";
   for ( ; *s; s++) {            /* traverse the mode characters */
     if      (*s == 'o') mode |=  FPG_ORIGSUPP;
+    else if (*s == 'c') prep |=  FPG_COMPRESS;
     else if (*s == 'l') mode &= ~FPG_FIM16;
     else if (*s == 'x') mode &= ~FPG_PERFECT;
     else if (*s == 'i') mode &= ~FPG_REORDER;
@@ -1472,6 +1610,7 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   if ((pborder != R_NilValue)   /* check the filtering border */
   &&  (TYPEOF(pborder) != INTSXP) && (TYPEOF(pborder) != REALSXP))
     error("invalid 'border' argument (must be numeric)");
+  threads = get_int(pthreads, threads);
 
   /* --- create transaction bag --- */
   sig_install();                /* install the signal handler */
@@ -1482,7 +1621,7 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                         (ITEM)zmin, (ITEM)zmax,
                         eval, agg, thresh, algo, mode);
   if (!fpgrowth) { tbg_delete(tabag, 1); ERR_MEM(); }
-  r = fpg_data(fpgrowth, tabag, 0, +2);
+  r = fpg_data(fpgrowth, tabag, prep, +2);
   if (r) fpg_delete(fpgrowth,1);/* prepare data for fpgrowth */
   if (r == -1) ERR_MEM();       /* check for an error and no items */
   if (r <   0) { sig_remove(); return allocVector(VECSXP, 0); }
@@ -1499,7 +1638,7 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   /* --- frequent item set mining --- */
   if (prune < ITEM_MIN) prune = ITEM_MIN;
   if (prune > ITEM_MAX) prune = ITEM_MAX;
-  r = fpg_mine(fpgrowth, (ITEM)prune, 0);
+  r = fpg_mine(fpgrowth, (ITEM)prune, 0, threads);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1514,12 +1653,13 @@ SEXP f4r_fpgrowth (SEXP ptracts, SEXP pwgts, SEXP ptarget,
 /*--------------------------------------------------------------------*/
 /* sam (tracts, wgts=NULL, target="s", supp=10, zmin=0, zmax=-1,      */
 /*      report="a", eval="x", thresh=10.0, algo="a", mode="",         */
-/*      border=NULL)                                                  */
+/*      border=NULL, threads=1)                                       */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_sam (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
               SEXP pzmin,   SEXP pzmax, SEXP preport, SEXP peval,
-              SEXP pthresh, SEXP palgo, SEXP pmode, SEXP pborder)
+              SEXP pthresh, SEXP palgo, SEXP pmode, SEXP pborder,
+              SEXP pthreads)
 {                               /* --- frequent item set mining */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -1528,6 +1668,7 @@ SEXP f4r_sam (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   CCHAR    *report = "a";       /* indicators of values to report */
   int      eval    = 'x';       /* evaluation measure */
   double   thresh  = 10;        /* threshold for evaluation measure */
+  int      threads =  1;        /* number of threads to use */
   int      algo    = SAM_BSEARCH;  /* algorithm variant */
   int      mode    = SAM_DEFAULT;  /* operation mode/flags */
   CCHAR    *s      = "";        /* to access the operation mode/flags */
@@ -1545,6 +1686,9 @@ SEXP f4r_sam (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_sam_w(ptracts, pwgts, ptarget, psupp, pzmin,
+                    pzmax, preport, peval, pthresh, palgo, pmode,
+                    pborder, pthreads));
   target = get_target(ptarget, "ascmgr");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -1590,6 +1734,7 @@ SEXP f4r_sam (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   if ((pborder != R_NilValue)   /* check the filtering border */
   &&  (TYPEOF(pborder) != INTSXP) && (TYPEOF(pborder) != REALSXP))
     error("invalid 'border' argument (must be numeric)");
+  threads = get_int(pthreads, threads);
 
   /* --- create transaction bag --- */
   sig_install();                /* install the signal handler */
@@ -1613,7 +1758,7 @@ SEXP f4r_sam (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
     sam_delete(sam, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
-  r = sam_mine(sam, 8192);
+  r = sam_mine(sam, 8192, threads);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1628,12 +1773,13 @@ SEXP f4r_sam (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
 /*--------------------------------------------------------------------*/
 /* relim (tracts, wgts=NULL, target="s", supp=10, zmin=0, zmax=-1,    */
 /*        report="a", eval="x", thresh=10.0, algo="a", mode="",       */
-/*        border=NULL)                                                */
+/*        border=NULL, threads=1)                                     */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_relim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
                 SEXP pzmin,   SEXP pzmax, SEXP preport, SEXP peval,
-                SEXP pthresh, SEXP palgo, SEXP pmode, SEXP pborder)
+                SEXP pthresh, SEXP palgo, SEXP pmode, SEXP pborder,
+                SEXP pthreads)
 {                               /* --- frequent item set mining */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -1642,6 +1788,7 @@ SEXP f4r_relim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   CCHAR    *report = "a";       /* indicators of values to report */
   int      eval    = 'x';       /* evaluation measure */
   double   thresh  = 10;        /* threshold for evaluation measure */
+  int      threads =  1;        /* number of threads to use */
   int      algo    = REL_BASIC;              /* algorithm variant */
   int      mode    = REL_DEFAULT|REL_FIM16;  /* operation mode/flags */
   CCHAR    *s      = "";        /* to access the operation mode/flags */
@@ -1659,6 +1806,9 @@ SEXP f4r_relim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_relim_w(ptracts, pwgts, ptarget, psupp, pzmin,
+                    pzmax, preport, peval, pthresh, palgo, pmode,
+                    pborder, pthreads));
   target = get_target(ptarget, "ascmgr");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -1698,6 +1848,7 @@ SEXP f4r_relim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   if ((pborder != R_NilValue)   /* check the filtering border */
   &&  (TYPEOF(pborder) != INTSXP) && (TYPEOF(pborder) != REALSXP))
     error("invalid 'border' argument (must be numeric)");
+  threads = get_int(pthreads, threads);
 
   /* --- create transaction bag --- */
   sig_install();                /* install the signal handler */
@@ -1721,7 +1872,7 @@ SEXP f4r_relim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
     relim_delete(relim, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
-  r = relim_mine(relim, 32);
+  r = relim_mine(relim, 32, threads);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1736,12 +1887,13 @@ SEXP f4r_relim (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
 /*--------------------------------------------------------------------*/
 /* carpenter (tracts, wgts=NULL, target="c", supp=10, zmin=0, zmax=-1,*/
 /*            report="a", eval="x", thresh=10.0, algo="a", mode="",   */
-/*            border=NULL)                                            */
+/*            border=NULL, threads=1)                                 */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_carpenter (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
                     SEXP pzmin,   SEXP pzmax, SEXP preport, SEXP peval,
-                    SEXP pthresh, SEXP palgo, SEXP pmode, SEXP pborder)
+                    SEXP pthresh, SEXP palgo, SEXP pmode, SEXP pborder,
+                    SEXP pthreads)
 {                               /* --- frequent item set mining */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -1750,6 +1902,7 @@ SEXP f4r_carpenter (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   CCHAR    *report = "a";       /* indicators of values to report */
   int      eval    = 'x';       /* evaluation measure */
   double   thresh  = 10;        /* threshold for evaluation measure */
+  int      threads =  1;        /* number of threads to use */
   int      algo    = CARP_AUTO;    /* algorithm variant */
   int      mode    = CARP_DEFAULT; /* operation mode/flags */
   CCHAR    *s      = "";        /* to access the operation mode/flags */
@@ -1767,6 +1920,9 @@ SEXP f4r_carpenter (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_carpenter_w(ptracts, pwgts, ptarget, psupp,
+                    pzmin, pzmax, preport, peval, pthresh, palgo,
+                    pmode, pborder, pthreads));
   target = get_target(ptarget, "cm");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -1812,6 +1968,7 @@ SEXP f4r_carpenter (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
   if ((pborder != R_NilValue)   /* check the filtering border */
   &&  (TYPEOF(pborder) != INTSXP) && (TYPEOF(pborder) != REALSXP))
     error("invalid 'border' argument (must be numeric)");
+  threads = get_int(pthreads, threads);
 
   /* --- create transaction bag --- */
   sig_install();                /* install the signal handler */
@@ -1835,7 +1992,7 @@ SEXP f4r_carpenter (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
     carp_delete(carp, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
-  r = carp_mine(carp);
+  r = carp_mine(carp, threads);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1881,6 +2038,9 @@ SEXP f4r_ista (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
                     "(must be list of integer or string arrays)");
   if (r <  0) error("invalid 'tracts' argument "
                     "(must be non-empty list)");
+  if (r >  0) WIDE(f4r_ista_w(ptracts, pwgts, ptarget, psupp, pzmin,
+                    pzmax, preport, peval, pthresh, palgo, pmode,
+                    pborder));
   target = get_target(ptarget, "cm");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -1946,7 +2106,7 @@ SEXP f4r_ista (SEXP ptracts, SEXP pwgts, SEXP ptarget, SEXP psupp,
     ista_delete(ista, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
-  r = ista_mine(ista);
+  r = ista_mine(ista, 1);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -1986,6 +2146,8 @@ SEXP f4r_apriacc (SEXP ptracts, SEXP pwgts, SEXP psupp,
   r = chktracts(ptracts, pwgts, R_NilValue);
   if (r < -1)        error("invalid 'wgts' argument");
   if (r <  0)        error("invalid 'tracts' argument");
+  if (r >  0) WIDE(f4r_apriacc_w(ptracts, pwgts, psupp, pzmin, pzmax,
+                    preport, pstat, psiglvl, pprune, pmode, pborder));
   supp   = get_dbl(psupp, supp);
   zmin   = get_int(pzmin, zmin);
   if (zmin   < 0)    error("invalid 'zmin' argument (must be >= 0)");
@@ -2028,7 +2190,7 @@ SEXP f4r_apriacc (SEXP ptracts, SEXP pwgts, SEXP psupp,
   /* --- frequent item set mining --- */
   if (prune < ITEM_MIN) prune = ITEM_MIN;
   if (prune > ITEM_MAX) prune = ITEM_MAX;
-  r = apriori_mine(apriori, (ITEM)prune, 0.01, 0);
+  r = apriori_mine(apriori, (ITEM)prune, 0.01, 0, 1);
   if (r >= 0) r = repterm(&data, isrep, report);
 
   /* --- clean up --- */
@@ -2068,6 +2230,9 @@ SEXP f4r_accretion (SEXP ptracts, SEXP pwgts, SEXP psupp,
   r = chktracts(ptracts, pwgts, R_NilValue);
   if (r < -1)        error("invalid 'wgts' argument");
   if (r <  0)        error("invalid 'tracts' argument");
+  if (r >  0) WIDE(f4r_accretion_w(ptracts, pwgts, psupp, pzmin,
+                    pzmax, preport, pstat, psiglvl, pmaxext, pmode,
+                    pborder));
   supp   = get_dbl(psupp, supp);
   zmin   = get_int(pzmin, zmin);
   if (zmin   < 0)    error("invalid 'zmin' argument (must be >= 0)");
@@ -2125,12 +2290,13 @@ SEXP f4r_accretion (SEXP ptracts, SEXP pwgts, SEXP psupp,
 /*--------------------------------------------------------------------*/
 /* genpsp (tracts, wgts=NULL, target="s",                             */
 /*         supp=10.0, zmin=0, zmax=-1, report="|",                    */
-/*         cnt=1000, surr="p", seed=0, cpus=0)                        */
+/*         cnt=1000, surr="p", seed=0, cpus=0, miner="f")             */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_genpsp (SEXP ptracts, SEXP pwgts, SEXP ptarget,
                  SEXP psupp,   SEXP pzmin, SEXP pzmax, SEXP preport,
-                 SEXP pcnt,    SEXP psurr, SEXP pseed, SEXP pcpus)
+                 SEXP pcnt,    SEXP psurr, SEXP pseed, SEXP pcpus,
+                 SEXP pminer)
 {                               /* --- generate a pattern spectrum */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -2142,6 +2308,7 @@ SEXP f4r_genpsp (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   int      surr    =  5;        /* surrogate method identifier */
   long int seed    =  0;        /* seed for random number generator */
   int      cpus    =  0;        /* number of cpus */
+  int      mnr     = MNR_FPGROWTH; /* surrogate data miner */
   PATSPEC  *psp    = NULL;      /* created pattern spectrum */
   SEXP     rpsp    = NULL;      /* created R pattern spectrum */
   long int done    = 0;         /* number of completed data sets */
@@ -2153,6 +2320,9 @@ SEXP f4r_genpsp (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   r = chktracts(ptracts, pwgts, R_NilValue);
   if (r < -1) error("invalid 'wgts' argument");
   if (r <  0) error("invalid 'tracts' argument");
+  if (r >  0) WIDE(f4r_genpsp_w(ptracts, pwgts, ptarget, psupp,
+                    pzmin, pzmax, preport, pcnt, psurr, pseed, pcpus,
+                    pminer));
   target = get_target(ptarget, "ascmg");
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -2171,6 +2341,8 @@ SEXP f4r_genpsp (SEXP ptracts, SEXP pwgts, SEXP ptarget,
   if (surr  == 0)    cnt = 1;   /* only one surrogate for identity */
   seed   = get_lng(pseed, seed);
   cpus   = get_int(pcpus, cpus);
+  mnr    = get_miner(pminer);   /* translate the miner string */
+  if (mnr   <  0)    error("invalid 'miner' argument");
 
   /* --- generate pattern spectrum --- */
   sig_install();                /* install the signal handler */
@@ -2180,12 +2352,17 @@ SEXP f4r_genpsp (SEXP ptracts, SEXP pwgts, SEXP ptarget,
     tbg_delete(tabag, 1);       /* if shuffle surrogates requested */
     error("for shuffle surrogates transactions must form a table");
   }                             /* check for table-derived data */
-  wgt  = tbg_wgt(tabag);        /* get the total transaction weight */
+  wgt  = (double)tbg_wgt(tabag);/* get the total transaction weight */
   supp = (supp >= 0) ? supp/100.0 *(double)wgt *(1-DBL_EPSILON) : -supp;
   smin = (SUPP)ceilsupp(supp);  /* compute absolute support value */
-  psp  = fpg_genpsp(tabag, target, (SUPP)smin, (ITEM)zmin, (ITEM)zmax,
-                    FPG_SIMPLE, FPG_DEFAULT, (size_t)cnt, surr, seed,
-                    cpus, repfn, &done);
+  if (mnr == MNR_ECLAT)         /* if to mine with eclat */
+    psp = ecl_genpsp(tabag, target, -(double)smin,
+                     (ITEM)zmin, (ITEM)zmax, ECL_OCCDLV, ECL_DEFAULT,
+                     (size_t)cnt, surr, seed, cpus, repfn, &done);
+  else                          /* if to mine with fpgrowth */
+    psp = fpg_genpsp(tabag, target, -(double)smin,
+                     (ITEM)zmin, (ITEM)zmax, FPG_SIMPLE, FPG_DEFAULT,
+                     (size_t)cnt, surr, seed, cpus, repfn, &done);
   if (psp) { rpsp = psp_toRObj(psp, 1.0/(double)cnt, report[0]);
              psp_delete(psp); } /* generate a pattern spectrum */
   tbg_delete(tabag, 1);         /* delete the transaction bag */
@@ -2199,12 +2376,13 @@ SEXP f4r_genpsp (SEXP ptracts, SEXP pwgts, SEXP ptarget,
 /*--------------------------------------------------------------------*/
 /* estpsp (tracts, wgts=NULL, target="a",                             */
 /*         supp=10.0, zmin=0, zmax=-1, report="|",                    */
-/*         equiv=10000, alpha=0.5, smpls=1000, seed=0)                */
+/*         equiv=10000, alpha=0.5, smpls=1000, seed=0, cpus=0)        */
 /*--------------------------------------------------------------------*/
 
 SEXP f4r_estpsp (SEXP ptracts, SEXP pwgts,   SEXP ptarget,
                  SEXP psupp,   SEXP pzmin,   SEXP pzmax,  SEXP preport,
-                 SEXP pequiv,  SEXP palpha,  SEXP psmpls, SEXP pseed)
+                 SEXP pequiv,  SEXP palpha,  SEXP psmpls, SEXP pseed,
+                 SEXP pcpus)
 {                               /* --- pattern spectrum estimation */
   int      target  = ISR_SETS;  /* target type identifier */
   double   supp    = 10.0;      /* minimum support of an item set */
@@ -2216,6 +2394,7 @@ SEXP f4r_estpsp (SEXP ptracts, SEXP pwgts,   SEXP ptarget,
   double   alpha   =  0.5;      /* probability dispersion factor */
   int      smpls   = 1000;      /* number of samples per set size */
   long int seed    =  0;        /* seed for random number generator */
+  int      cpus    =  0;        /* number of cpus */
   PATSPEC  *psp    = NULL;      /* created pattern spectrum */
   SEXP     rpsp    = NULL;      /* created R pattern spectrum */
   TABAG    *tabag;              /* created transaction bag */
@@ -2226,6 +2405,9 @@ SEXP f4r_estpsp (SEXP ptracts, SEXP pwgts,   SEXP ptarget,
   r = chktracts(ptracts, pwgts, R_NilValue);
   if (r < -1) error("invalid 'wgts' argument");
   if (r <  0) error("invalid 'tracts' argument");
+  if (r >  0) WIDE(f4r_estpsp_w(ptracts, pwgts, ptarget, psupp,
+                    pzmin, pzmax, preport, pequiv, palpha, psmpls,
+                    pseed, pcpus));
   target = get_target(ptarget, "as");  /* translate the target string */
   if (target < 0)    error("invalid 'target' argument");
   supp   = get_dbl(psupp, supp);
@@ -2244,19 +2426,20 @@ SEXP f4r_estpsp (SEXP ptracts, SEXP pwgts,   SEXP ptarget,
   smpls  = get_int(psmpls,  smpls);
   if (smpls <= 0)    error("invalid 'smpls' argument");
   seed   = get_lng(pseed,   seed);
+  cpus   = get_int(pcpus,   cpus);
 
   /* --- estimate pattern spectrum --- */
   sig_install();                /* install the signal handler */
   tabag = tbg_fromRObj(ptracts, pwgts, R_NilValue);
   if (!tabag) ERR_MEM();        /* create a transaction bag and */
-  wgt  = tbg_wgt(tabag);        /* get the total transaction weight */
+  wgt  = (double)tbg_wgt(tabag);/* get the total transaction weight */
   supp = (supp >= 0) ? supp/100.0 *(double)wgt *(1-DBL_EPSILON) : -supp;
   smin = (SUPP)ceilsupp(supp);  /* compute absolute support value */
   if (tbg_recode(tabag, smin, -1, -1, -2) < 0) {
     tbg_delete(tabag, 1); ERR_MEM(); }
   tbg_filter(tabag, (ITEM)zmin, NULL, 0);
-  psp = fpg_estpsp(tabag, target, (SUPP)smin, (ITEM)zmin, (ITEM)zmax,
-                   (size_t)equiv, alpha, (size_t)smpls, seed);
+  psp = fpg_estpsp(tabag, target, -(double)smin, (ITEM)zmin, (ITEM)zmax,
+                   (size_t)equiv, alpha, (size_t)smpls, seed, cpus);
   if (psp) { rpsp = psp_toRObj(psp, 1.0/(double)equiv, report[0]);
              psp_delete(psp); } /* generate a pattern spectrum */
   tbg_delete(tabag, 1);         /* delete the transaction bag */
@@ -2268,13 +2451,15 @@ SEXP f4r_estpsp (SEXP ptracts, SEXP pwgts,   SEXP ptarget,
 }  /* f4r_estpsp() */
 
 /*--------------------------------------------------------------------*/
-/* patred (pats, method="S", border=NULL, addis=TRUE)                 */
+/* patred (pats, method="S", border=NULL, addis=TRUE, threads=1)      */
 /*--------------------------------------------------------------------*/
 
-SEXP f4r_patred (SEXP ppats, SEXP pmethod, SEXP pborder, SEXP paddis)
+SEXP f4r_patred (SEXP ppats, SEXP pmethod, SEXP pborder, SEXP paddis,
+                 SEXP pthreads)
 {                               /* --- pattern set reduction */
   int    method = PSR_COVER1;   /* pattern set reduction method */
   int    addis  = -1;           /* whether to add pairwise isects. */
+  int    threads =  1;          /* number of threads to use */
   IDMAP  *map;                  /* item to identifier map */
   PATSET *patset;               /* internal pattern set */
   size_t i, n;                  /* loop variable, number of patterns */
@@ -2298,6 +2483,7 @@ SEXP f4r_patred (SEXP ppats, SEXP pmethod, SEXP pborder, SEXP paddis)
   method = get_red(pmethod);    /* get and check the reduction method */
   if (method < 0) error("invalid 'method' argument");
   addis = get_lgl(paddis,addis);/* get flag for adding intersections */
+  threads = get_int(pthreads, threads);
   rset = VECTOR_ELT(ppats, 0);  /* get and check first pattern */
   if ((TYPEOF(rset) != VECSXP) || (length(rset) < 2))
     error("invalid 'pats' argument (wrong pattern type)");
@@ -2379,7 +2565,8 @@ SEXP f4r_patred (SEXP ppats, SEXP pmethod, SEXP pborder, SEXP paddis)
   if (sig_aborted()) { sig_abort(0); psr_delete(patset,1); ERR_ABORT();}
 
   /* --- pattern set reduction --- */
-  k     = psr_reduce(patset, method, addis);
+  k     = psr_reduce(patset, method, addis, threads);
+  if (k == SIZE_MAX) { psr_delete(patset, 1); ERR_MEM(); }
   ppats = PROTECT(allocVector(VECSXP, (R_xlen_t)k));
   for (i = k = 0; i < n; i++) { /* traverse the reduced patterns */
     rset = (SEXP)psr_getorig(patset, i);
@@ -18,6 +18,8 @@
             2013.11.12 item selection file changed to option -R#
             2014.08.27 adapted to modified item set reporter interface
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.17 highest bit map filled with its flag set last
+            2026.10.17 wide transactions (up to 31 items) added
 ------------------------------------------------------------------------
   Reference for the basic scheme of the 16 items machine:
     T. Uno, M. Kiyomi, and H. Arimura.
@@ -86,6 +88,9 @@
 
 #define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
 
+#define MAXITEMS    31          /* maximal number of (packed) items */
+#define BLKSIZE   1024          /* block size for wide trans. array */
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -129,7 +134,7 @@ static FIM16    *fim16  = NULL; /* freq. item set mining object */
 static unsigned char hibit[1 << 16] = { 1 };
 /* map from bit representation of a transaction to highest set bit */
 
-static const BITTA prjms[16] = {/* bit masks for trans. projection */
+static const BITLO prjms[16] = {/* bit masks for trans. projection */
   0x0000, 0x0001, 0x0003, 0x0007,
   0x000f, 0x001f, 0x003f, 0x007f,
   0x00ff, 0x01ff, 0x03ff, 0x07ff,
@@ -148,7 +153,7 @@ static void indent (int k)
 static void show (const char *text, FIM16 *fim, int ind)
 {                               /* --- show a 16 items machine */
   ITEM  i;                      /* loop variable (item) */
-  BITTA *t, *e;                 /* to traverse the transactions */
+  BITLO *t, *e;                 /* to traverse the transactions */
 
   assert(fim);                  /* check the function arguments */
   if (text && *text) {          /* print the given text */
@@ -177,15 +182,19 @@ FIM16* m16_create (int dir, SUPP supp, ISREPORT *report)
 {                               /* --- create a 16 items machine */
   int   i, k, n, s;             /* loop variables, buffers */
   FIM16 *fim, *cur;             /* created 16 items machine */
-  BITTA *p;                     /* to organize the memory */
-
-  if (hibit[0] != 0)            /* init. highest bit map if necessary */
-    for (k = i = 0; k < 16; k++)/* traverse all possible transactions */
-      while (i < (1 << (k+1))) hibit[i++] = (unsigned char)k;
+  BITLO *p;                     /* to organize the memory */
+
+  if (hibit[0] != 0) {          /* init. highest bit map if necessary */
+    for (k = 16, i = 1 << 16; --k > 0; )   /* traverse transactions */
+      while (i > (1 << k)) hibit[--i] = (unsigned char)k;
+    hibit[1] = hibit[0] = 0;    /* clear the initialization flag */
+  }                             /* only after all other entries, */
+                                /* so that concurrent calls never */
+                                /* see an incomplete map */
   n   = (dir > 0) ? 1 : 16;     /* get the number of sub-machines */
   fim = (FIM16*)calloc((size_t)n, sizeof(FIM16));
   if (!fim) return NULL;        /* allocate the base structure */
-  fim->map = (ITEM*)malloc(16*sizeof(ITEM));
+  fim->map = (ITEM*)malloc(MAXITEMS*sizeof(ITEM));
   if (!fim->map) { free(fim); return NULL; }
   m16_clrmap(fim);              /* create an item identifier map */
   for (cur = fim, s = 16; --n >= 0; cur++, s--) {
@@ -196,12 +205,12 @@ FIM16* m16_create (int dir, SUPP supp, ISREPORT *report)
     cur->wgts   = (SUPP*)calloc(((size_t)1) << s, sizeof(SUPP));
     if (!cur->wgts) { m16_delete(cur); return NULL; }
     k = (s > 10) ? 10 : s;      /* allocate the trans. weight array */
-    p = (BITTA*)malloc((((size_t)1) << k) *sizeof(BITTA));
+    p = (BITLO*)malloc((((size_t)1) << k) *sizeof(BITLO));
     if (!p) { m16_delete(fim); return NULL; }
     for (i = 0; i < k; i++) {   /* allocate one block for short lists */
       cur->ends[i] = cur->btas[i] = p; p += (i > 1) ? 1 << i : 2; }
     for ( ; i < s; i++) {       /* individual blocks for the rest */
-      p = (BITTA*)malloc((((size_t)1) << i) *sizeof(BITTA));
+      p = (BITLO*)malloc((((size_t)1) << i) *sizeof(BITLO));
       if (!p) { m16_delete(fim); return NULL; }
       cur->ends[i] = cur->btas[i] = p;
     } /* This allocation scheme looks certainly weird, but showed the */
@@ -225,25 +234,48 @@ void m16_delete (FIM16 *fim)
     if (cur->btas[0]) free(cur->btas[0]);
     free(cur->wgts);            /* delete the transaction arrays */
   }                             /* and the transaction weight array */
-  free(fim->map);               /* delete the item identifier map */
-  free(fim);                    /* delete the base structure */
+  if (fim->wtas) free(fim->wtas);
+  free(fim->map);               /* delete the wide transactions */
+  free(fim);                    /* and the item identifier map */
 }  /* m16_delete() */
 
 /*--------------------------------------------------------------------*/
 
 void m16_clrmap (FIM16 *fim)
 {                               /* --- clear item identifier map */
-  fim->map[ 0] =  0; fim->map[ 1] =  1; fim->map[ 2] =  2;
-  fim->map[ 3] =  3; fim->map[ 4] =  4; fim->map[ 5] =  5;
-  fim->map[ 6] =  6; fim->map[ 7] =  7; fim->map[ 8] =  8;
-  fim->map[ 9] =  9; fim->map[10] = 10; fim->map[11] = 11;
-  fim->map[12] = 12; fim->map[13] = 13; fim->map[14] = 14;
-  fim->map[15] = 15;            /* set item map to identity */
+  ITEM i;                       /* loop variable */
+
+  for (i = 0; i < MAXITEMS; i++)
+    fim->map[i] = i;            /* set item map to identity */
 }  /* m16_clrmap() */
 
 /*--------------------------------------------------------------------*/
 
-void m16_add (FIM16 *fim, BITTA tract, SUPP wgt)
+int m16_width (TABAG *tabag, int max)
+{                               /* --- choose number of packed items */
+  ITEM       i, n;              /* loop variable, number of items */
+  const SUPP *frqs;             /* item frequencies (weights) */
+
+  assert(tabag);                /* check the function arguments */
+  if (max > MAXITEMS) max = MAXITEMS;
+  if (max <= 16) return max;    /* at most 16 items need no choice */
+  frqs = tbg_ifrqs(tabag, 1);   /* get the item frequencies */
+  if (!frqs) return 16;         /* (fall back to 16 items) */
+  n = ib_cnt(tbg_base(tabag));  /* get the number of items */
+  if (n > (ITEM)max) n = (ITEM)max;
+  for (i = 16; i < n; i++)      /* find the first sparse item */
+    if (frqs[i] < tbg_wgt(tabag)/2) break;
+  return (int)i;                /* return the number of items */
+}  /* m16_width() */
+
+/* Only items that occur in at least half of the transactions are    */
+/* added beyond the first 16, because items above 16 are processed   */
+/* by recursive elimination on transaction lists (see wide() below), */
+/* which pays off only if the transactions share many of them.       */
+
+/*--------------------------------------------------------------------*/
+
+static void add16 (FIM16 *fim, BITLO tract, SUPP wgt)
 {                               /* --- add a transaction in bit rep. */
   assert(fim);                  /* check the function arguments */
   fim->ttw += wgt;              /* sum the transaction weight */
@@ -251,6 +283,37 @@ void m16_add (FIM16 *fim, BITTA tract, SUPP wgt)
   fim->tor |= tract;            /* combine for single trans. check */
   if ((fim->wgts[tract] += wgt) <= wgt)  /* update trans. weight and */
     *fim->ends[hibit[tract]]++ = tract;  /* add it to its hibit list */
+}  /* add16() */
+
+/*--------------------------------------------------------------------*/
+
+static int addw (FIM16 *fim, BITTA tract, SUPP wgt)
+{                               /* --- add a wide transaction */
+  size_t n;                     /* new size of transaction array */
+  WIDETA *p;                    /* new wide transaction array */
+
+  assert(fim);                  /* check the function arguments */
+  n = fim->wsize;               /* get the transaction array size */
+  if (fim->wcnt >= n) {         /* if the transaction array is full */
+    n += (n > BLKSIZE) ? n >> 1 : BLKSIZE;
+    p  = (WIDETA*)realloc(fim->wtas, n *sizeof(WIDETA));
+    if (!p) return fim->err = -1; /* enlarge the transaction array */
+    fim->wtas = p; fim->wsize = n;
+  }                             /* set the new array and its size */
+  p = fim->wtas +fim->wcnt++;   /* store the wide transaction */
+  p->bits = tract; p->wgt = wgt;
+  return 0;                     /* return 'ok' */
+}  /* addw() */
+
+/*--------------------------------------------------------------------*/
+
+void m16_add (FIM16 *fim, BITTA tract, SUPP wgt)
+{                               /* --- add a transaction in bit rep. */
+  assert(fim);                  /* check the function arguments */
+  if (tract <= 0xffff)          /* add transactions on the 16 low */
+    add16(fim, (BITLO)tract, wgt);   /* items to the machine, */
+  else {                        /* but collect wide transactions */
+    fim->ttw += wgt; addw(fim, tract, wgt); }
 }  /* m16_add() */
 
 /*--------------------------------------------------------------------*/
@@ -261,8 +324,8 @@ void m16_addx (FIM16 *fim, const ITEM *items, ITEM n, SUPP wgt)
 
   assert(fim && (items || (n <= 0))); /* check function arguments */
   for (tract = 0; --n >= 0; items++) {
-    if      (*items <  0) tract = (BITTA)(tract | (BITTA)*items);
-    else if (*items < 16) tract = (BITTA)(tract | (BITTA)(1 << *items));
+    if      (*items < 0)        tract |= (BITTA)(*items & ~TA_END);
+    else if (*items < MAXITEMS) tract |= (BITTA)1 << *items;
   }                             /* set the corresponding bits */
   m16_add(fim, tract, wgt);     /* add the constructed bit rep. */
 }  /* m16_addx() */
@@ -275,8 +338,8 @@ void m16_adds (FIM16 *fim, const ITEM *items, SUPP wgt)
 
   assert(fim && items);         /* check the function arguments */
   for (tract = 0; *items > TA_END; items++) {
-    if      (*items <  0) tract = (BITTA)(tract | (BITTA)*items);
-    else if (*items < 16) tract = (BITTA)(tract | (BITTA)(1 << *items));
+    if      (*items < 0)        tract |= (BITTA)(*items & ~TA_END);
+    else if (*items < MAXITEMS) tract |= (BITTA)1 << *items;
   }                             /* set the corresponding bits */
   m16_add(fim, tract, wgt);     /* add the constructed bit rep. */
 }  /* m16_adds() */
@@ -297,10 +360,10 @@ void m16_addtbg (FIM16 *fim, TABAG *tabag)
 
 /*--------------------------------------------------------------------*/
 
-static void project (FIM16 *fim, ITEM item, BITTA mask, FIM16 *dst)
+static void project (FIM16 *fim, ITEM item, BITLO mask, FIM16 *dst)
 {                               /* --- project trans. to an item */
-  BITTA *t, *e;                 /* to traverse the transactions */
-  BITTA p;                      /* projected trans. (item removed) */
+  BITLO *t, *e;                 /* to traverse the transactions */
+  BITLO p;                      /* projected trans. (item removed) */
   SUPP  *w;                     /* (location of) transaction weight */
 
   assert(fim && dst && (item > 0)); /* check the function arguments */
@@ -330,8 +393,8 @@ static void project (FIM16 *fim, ITEM item, BITTA mask, FIM16 *dst)
 
 static void count (FIM16 *fim, int n)
 {                               /* --- count support of all items */
-  BITTA *t, *e;                 /* to traverse the transactions */
-  BITTA p;                      /* projected trans. (item removed) */
+  BITLO *t, *e;                 /* to traverse the transactions */
+  BITLO p;                      /* projected trans. (item removed) */
   SUPP  w, s;                   /* trans. weight and item support */
 
   assert(fim && (n > 0));       /* check the function arguments */
@@ -354,7 +417,7 @@ static void count (FIM16 *fim, int n)
 
 static void clear (FIM16 *fim, int item)
 {                               /* --- clear a transaction list */
-  BITTA *t, *e;                 /* to traverse the transactions */
+  BITLO *t, *e;                 /* to traverse the transactions */
 
   assert(fim && (item >= 0));   /* check the function arguments */
   fim->supps[item] = 0;         /* clear the item support (reinit.) */
@@ -365,9 +428,9 @@ static void clear (FIM16 *fim, int item)
 
 /*--------------------------------------------------------------------*/
 
-static BITTA filter (FIM16 *fim, int n, SUPP pex)
+static BITLO filter (FIM16 *fim, int n, SUPP pex)
 {                               /* --- filter items from projection */
-  BITTA mask;                   /* item mask for needed items */
+  BITLO mask;                   /* item mask for needed items */
 
   assert(fim && (pex > 0));     /* check the function arguments */
   for (mask = 0; --n >= 0; ) {  /* traverse the items */
@@ -376,18 +439,18 @@ static BITTA filter (FIM16 *fim, int n, SUPP pex)
     else if (fim->supps[n] >= pex) {
       clear(fim, n);            /* collect perfect extensions */
       isr_addpex(fim->report, fim->map[n]); }
-    else mask = (BITTA)(mask | (1 << n));
+    else mask = (BITLO)(mask | (1 << n));
   }                             /* if item is frequent, set bit mask */
   return mask;                  /* return the item mask */
 }  /* filter() */
 
 /*--------------------------------------------------------------------*/
 
-static int rec_pos (FIM16 *fim, int n, BITTA mask)
+static int rec_pos (FIM16 *fim, int n, BITLO mask)
 {                               /* --- find frequent item sets */
   int   i, r;                   /* loop variable, error status */
   SUPP  s;                      /* item support */
-  BITTA m;                      /* filtering mask */
+  BITLO m;                      /* filtering mask */
 
   assert(fim && (n >= 0));      /* check the function arguments */
   /* The item mask needs to be checked, because items 0,1,2 may have  */
@@ -429,7 +492,7 @@ static int rec_pos (FIM16 *fim, int n, BITTA mask)
   if (n <= 2) {                 /* if only two items to process */
     memset(fim->wgts+1, 0, 3*sizeof(SUPP));
     memset(fim->supps,  0, 2*sizeof(SUPP));
-    memcpy(fim->ends, fim->btas, 2*sizeof(BITTA*));
+    memcpy(fim->ends, fim->btas, 2*sizeof(BITLO*));
     return 0;                   /* clear counters for items 0 and 1 */
   }                             /* and clear the transaction lists */
   if ((mask & 4)                /* if item 2 is frequent */
@@ -443,10 +506,10 @@ static int rec_pos (FIM16 *fim, int n, BITTA mask)
       fim->wgts[1]  = fim->wgts[5];
       fim->supps[0] = s = fim->wgts[3] +fim->wgts[1];
       if      (s >= fim->supps[2]) isr_addpex(fim->report, fim->map[0]);
-      else if (s >= fim->smin)     m = (BITTA)(m | (mask & 1));
+      else if (s >= fim->smin)     m = (BITLO)(m | (mask & 1));
       fim->supps[1] = s = fim->wgts[3] +fim->wgts[2];
       if      (s >= fim->supps[2]) isr_addpex(fim->report, fim->map[1]);
-      else if (s >= fim->smin)     m = (BITTA)(m | (mask & 2));
+      else if (s >= fim->smin)     m = (BITLO)(m | (mask & 2));
       r = rec_pos(fim, 2, m);   /* perfect extension items and then */
       if (r < 0) return -1;     /* find freq. item sets recursively */
       if (isr_report(fim->report) < 0)
@@ -457,7 +520,7 @@ static int rec_pos (FIM16 *fim, int n, BITTA mask)
   if (n <= 3) {                 /* if only two items to process */
     memset(fim->wgts+1, 0, 7*sizeof(SUPP));  /* clear weights, */
     memset(fim->supps,  0, 3*sizeof(SUPP));  /* support and lists */
-    memcpy(fim->ends, fim->btas, 3*sizeof(BITTA*));
+    memcpy(fim->ends, fim->btas, 3*sizeof(BITLO*));
     return 0;                   /* clear counters for items 0, 1, 2 */
   }                             /* and clear the transaction lists */
   if ((mask & 8)                /* if item 3 is frequent */
@@ -472,14 +535,14 @@ static int rec_pos (FIM16 *fim, int n, BITTA mask)
       fim->wgts[1]  = fim->wgts[ 9] +(fim->wgts[5] = fim->wgts[13]);
       fim->supps[0] = s = fim->wgts[3] +fim->wgts[1];
       if      (s >= fim->supps[3]) isr_addpex(fim->report, fim->map[0]);
-      else if (s >= fim->smin)     m = (BITTA)(m | (mask & 1));
+      else if (s >= fim->smin)     m = (BITLO)(m | (mask & 1));
       fim->supps[1] = s = fim->wgts[3] +fim->wgts[2];
       if      (s >= fim->supps[3]) isr_addpex(fim->report, fim->map[1]);
-      else if (s >= fim->smin)     m = (BITTA)(m | (mask & 2));
+      else if (s >= fim->smin)     m = (BITLO)(m | (mask & 2));
       fim->supps[2] = s = fim->wgts[7] +fim->wgts[6]
                         + fim->wgts[5] +fim->wgts[4];
       if      (s >= fim->supps[3]) isr_addpex(fim->report, fim->map[2]);
-      else if (s >= fim->smin)     m = (BITTA)(m | (mask & 4));
+      else if (s >= fim->smin)     m = (BITLO)(m | (mask & 4));
       r = rec_pos(fim, 3, m);   /* perfect extension items and then */
       if (r < 0) return -1;     /* find freq. item sets recursively */
       if (isr_report(fim->report) < 0)
@@ -489,7 +552,7 @@ static int rec_pos (FIM16 *fim, int n, BITTA mask)
   }
   memset(fim->wgts+1, 0, 15*sizeof(SUPP));  /* clear weights, */
   memset(fim->supps,  0,  4*sizeof(SUPP));  /* support and lists */
-  memcpy(fim->ends, fim->btas, 4*sizeof(BITTA*));
+  memcpy(fim->ends, fim->btas, 4*sizeof(BITLO*));
 
   for (i = 4; i < n; i++) {     /* traverse the (remaining) items */
     s = fim->supps[i];          /* get the support of the item and */
@@ -520,11 +583,11 @@ static int rec_pos (FIM16 *fim, int n, BITTA mask)
 
 /*--------------------------------------------------------------------*/
 
-static int rec_neg (FIM16 *fim, int n, BITTA mask)
+static int rec_neg (FIM16 *fim, int n, BITLO mask)
 {                               /* --- find frequent item sets */
   int   i, r;                   /* loop variable, error status */
   SUPP  s;                      /* item support */
-  BITTA m;                      /* filtering mask */
+  BITLO m;                      /* filtering mask */
 
   assert(fim && (n >= 0));      /* check the function arguments */
   for (i = n; --i >= 2; ) {     /* traverse the remaining items */
@@ -588,7 +651,7 @@ static int rec_neg (FIM16 *fim, int n, BITTA mask)
   }
   memset(fim->wgts+1, 0, 3*sizeof(SUPP));  /* clear weights, */
   memset(fim->supps,  0, 2*sizeof(SUPP));  /* support and lists */
-  memcpy(fim->ends, fim->btas, 2*sizeof(BITTA*));
+  memcpy(fim->ends, fim->btas, 2*sizeof(BITLO*));
   return 0;                     /* return 'ok' */
 }  /* rec_neg() */
 
@@ -599,6 +662,7 @@ void m16_clear (FIM16 *fim)
   int i, n, s;                  /* loop variables */
 
   assert(fim);                  /* check the function argument */
+  fim->wcnt = 0; fim->err = 0;  /* clear the wide transactions */
   n = (fim->dir > 0) ? 1 : 16;  /* get the number of sub-machines */
   for (s = 16; --n >= 0; fim++, s--) {
     if (fim->ttw <= 0) continue;/* skip empty sub-machines */
@@ -610,11 +674,11 @@ void m16_clear (FIM16 *fim)
 
 /*--------------------------------------------------------------------*/
 
-int m16_mine (FIM16 *fim)
+static int mine (FIM16 *fim)
 {                               /* --- find frequent item sets */
   int   r, i;                   /* error status, buffers */
   SUPP  s;                      /* support of current prefix */
-  BITTA m;                      /* mask after item filtering, bit */
+  BITLO m;                      /* mask after item filtering, bit */
 
   assert(fim);                  /* check the function argument */
   if (fim->ttw <= 0) return 0;  /* if the machine is empty, abort */
@@ -635,6 +699,119 @@ int m16_mine (FIM16 *fim)
     ? rec_pos(fim, i, m) : rec_neg(fim, i, m);
   fim->ttw = 0; fim->tor = 0;   /* clear the total transaction weight */
   return (r) ? r : m;           /* return error status or mask */
+}  /* mine() */
+
+/*--------------------------------------------------------------------*/
+
+static int low (FIM16 *fim, WIDETA *tas, WIDETA *end)
+{                               /* --- mine the 16 low items */
+  assert(fim && tas && end);    /* check the function arguments */
+  for ( ; tas < end; tas++)     /* add the (low) transactions */
+    add16(fim, (BITLO)tas->bits, tas->wgt);
+  return mine(fim);             /* mine with the 16 items machine */
+}  /* low() */
+
+/*--------------------------------------------------------------------*/
+
+static int wide (FIM16 *fim, WIDETA *tas, size_t n, int k, BITTA mask)
+{                               /* --- mine with wide transactions */
+  int    i, d, r;               /* loop variables, error status */
+  BITTA  b, m;                  /* bit rep. of a transaction, mask */
+  size_t x;                     /* number of transaction copies */
+  SUPP   s;                     /* minimum support for perf. exts. */
+  WIDETA *buf, *lo, *t, *e, *p; /* to traverse the transactions */
+  WIDETA *lists[MAXITEMS];      /* transaction lists per wide item */
+  WIDETA *ends [MAXITEMS];      /* ends of transaction lists */
+  size_t cnts [MAXITEMS];       /* sizes of transaction lists */
+  SUPP   supps[MAXITEMS];       /* support values of wide items */
+
+  assert(fim && tas && (k >= 16) && (k <= MAXITEMS));
+  mask &= ((BITTA)1 << k) -1;   /* only items below k are needed */
+  memset(cnts,  0, sizeof(cnts));
+  memset(supps, 0, sizeof(supps));
+  for (t = tas, e = t+n; t < e; t++)
+    for (b = (t->bits & mask) >> 16, i = 16; b; b >>= 1, i++)
+      cnts[i] += b & 1;         /* count the wide item occurrences */
+  for (x = n, i = 16; i < k; i++)
+    x += cnts[i];               /* sum the sizes of all lists */
+  buf = (WIDETA*)malloc(x *sizeof(WIDETA));
+  if (!buf) return -1;          /* allocate the transaction lists */
+  for (p = buf+n, i = 16; i < k; i++) {
+    lists[i] = ends[i] = p; p += cnts[i]; }
+  for (lo = buf, t = tas; t < e; t++) {
+    b = t->bits & mask;         /* traverse the transactions */
+    if      (b > 0xffff)        /* and sort them into the list */
+      p = ends[16+hibit[b >> 16]]++;     /* of their highest item */
+    else if (b) p = lo++;       /* or into the list of transactions */
+    else continue;              /* with only low items (if any) */
+    p->bits = b; p->wgt = t->wgt;
+  }                             /* store the masked transaction */
+  for (i = k; --i >= 16; ) {    /* traverse the wide items downward */
+    for (t = lists[i]; t < ends[i]; t++) {
+      supps[i] += t->wgt;       /* sum the support of the item */
+      b = t->bits & ~((BITTA)1 << i);
+      if      (b > 0xffff)      /* eliminate the item and */
+        p = ends[16+hibit[b >> 16]]++;   /* move the transaction */
+      else if (b) p = lo++;     /* into the list of its new */
+      else continue;            /* highest item (like relim) */
+      p->bits = b; p->wgt = t->wgt;
+    }                           /* afterwards list i contains all */
+  }                             /* trans. prefixes that contain i */
+  s = isr_supp(fim->report);    /* get min. support for perfect exts. */
+  for (m = 0, i = 16; i < k; i++) {
+    if      (supps[i] <  fim->smin) continue;
+    else if (supps[i] >= s)     /* skip infrequent items and */
+      isr_addpex(fim->report, fim->map[i]);  /* collect perfect */
+    else m |= (BITTA)1 << i;    /* extension items, but note the */
+  }                             /* other frequent items in a mask */
+  m |= 0xffff;                  /* keep all low items for the child */
+  if (fim->dir > 0) { d = +1; i = 16;  r = low(fim, buf, lo); }
+  else              { d = -1; i = k-1; r = 0; }
+  b = (BITTA)((r > 0) ? r : 0); /* note the mask of the low items */
+  for ( ; (r >= 0) && (i >= 16) && (i < k); i += d) {
+    if (!(m & ((BITTA)1 << i))) continue;
+    r = isr_add(fim->report, fim->map[i], supps[i]);
+    if (r <= 0) continue;       /* add the item to the reporter */
+    r = wide(fim, lists[i], (size_t)(ends[i]-lists[i]), i, m);
+    if (r < 0) break;           /* find freq. item sets recursively */
+    r = isr_report(fim->report);/* report the current item set */
+    isr_remove(fim->report, 1); /* and remove the item again */
+  }
+  if ((r >= 0) && (d < 0)) {    /* mine the low items last */
+    r = low(fim, buf, lo);      /* if downward processing */
+    b = (BITTA)((r > 0) ? r : 0);
+  }                             /* note the mask of the low items */
+  free(buf);                    /* delete the transaction lists */
+  return (r < 0) ? -1 : (int)((m & ~(BITTA)0xffff) | b);
+}  /* wide() */
+
+/* This is the scheme of recursive elimination (RElim): list i holds  */
+/* the transactions that have item i as their highest wide item and  */
+/* after processing item i they are moved to the list of the next    */
+/* highest item (or the list for the 16 low items). Since the lists  */
+/* are never merged, the memory needed for a level is bounded by the */
+/* number of wide item occurrences plus the number of transactions.  */
+
+/*--------------------------------------------------------------------*/
+
+int m16_mine (FIM16 *fim)
+{                               /* --- find frequent item sets */
+  int   i, r;                   /* loop variable, error status */
+  BITLO *t, *e;                 /* to traverse the transactions */
+
+  assert(fim);                  /* check the function argument */
+  if ((fim->wcnt <= 0) && !fim->err)
+    return mine(fim);           /* if only low items, mine directly */
+  for (i = 0; i < 16; i++) {    /* traverse the transaction lists */
+    for (t = fim->btas[i], e = fim->ends[i]; t < e; t++)
+      addw(fim, *t, fim->wgts[*t]);
+    clear(fim, i);              /* move the low transactions to the */
+  }                             /* wide ones and clear the machine */
+  fim->ttw = 0; fim->tor = 0;   /* clear the total transaction weight */
+  r = (fim->err) ? -1 : wide(fim, fim->wtas, fim->wcnt, MAXITEMS,
+                             ~(BITTA)0);
+  fim->wcnt = 0; fim->err = 0;  /* mine with wide transactions and */
+  return r;                     /* clear the wide transactions */
 }  /* m16_mine() */
 
 /*--------------------------------------------------------------------*/
@@ -643,7 +820,7 @@ int m16_mine (FIM16 *fim)
 void m16_show (FIM16 *fim)
 {                               /* --- show 16 items machine */
   int   i;                      /* loop variable, item */
-  BITTA *t, *e;                 /* to traverse the transactions */
+  BITLO *t, *e;                 /* to traverse the transactions */
   SUPP  w, s;                   /* trans. weight and item support */
 
   assert(fim);                  /* check the function arguments */
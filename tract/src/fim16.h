@@ -8,6 +8,7 @@
             2011.09.20 perfect extension support removed from m16_mine()
             2011.09.21 function m16_show() added (for debugging)
             2012.06.19 item identifier map added (e.g. m16_setmap())
+            2026.10.17 wide transactions (up to 31 items) added
  ---------------------------------------------------------------------*/
 #ifndef __FIM16__
 #define __FIM16__
@@ -18,19 +19,29 @@
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
-typedef unsigned short BITTA;   /* --- bit rep. of a transaction --- */
+typedef unsigned int   BITTA;   /* --- bit rep. of a transaction --- */
+typedef unsigned short BITLO;   /* --- bit rep. of the 16 low items */
+
+typedef struct {                /* --- wide transaction --- */
+  BITTA    bits;                /* bit rep. of the items */
+  SUPP     wgt;                 /* weight of the transaction */
+} WIDETA;                       /* (wide transaction) */
 
 typedef struct {                /* --- FIM 16 items machine --- */
   ISREPORT *report;             /* item set reporter */
   int      dir;                 /* processing direction */
+  int      err;                 /* error status (of m16_add()) */
   SUPP     smin;                /* minimum support */
   SUPP     ttw;                 /* total transaction weight */
-  BITTA    tor;                 /* bitwise or of added trans. */
+  BITLO    tor;                 /* bitwise or of added trans. */
   SUPP     *wgts;               /* transaction weights */
   ITEM     *map;                /* item identifier map */
+  size_t   wcnt;                /* number of wide transactions */
+  size_t   wsize;               /* size of wide transaction array */
+  WIDETA   *wtas;               /* transactions with items >= 16 */
   SUPP     supps[16];           /* support values of items */
-  BITTA    *btas[16];           /* array of bit rep. transactions */
-  BITTA    *ends[16];           /* ends of transaction arrays */
+  BITLO    *btas[16];           /* array of bit rep. transactions */
+  BITLO    *ends[16];           /* ends of transaction arrays */
 } FIM16;                        /* (FIM 16 items machine) */
 
 /*----------------------------------------------------------------------
@@ -42,6 +53,7 @@ extern int    m16_dir    (FIM16 *fim);
 extern void   m16_setmap (FIM16 *fim, int i, ITEM id);
 extern ITEM   m16_getmap (FIM16 *fim, int i);
 extern void   m16_clrmap (FIM16 *fim);
+extern int    m16_width  (TABAG *tabag, int max);
 extern void   m16_add    (FIM16 *fim, BITTA tract, SUPP wgt);
 extern void   m16_addx   (FIM16 *fim, const ITEM *items, ITEM n,
                           SUPP wgt);
@@ -4,22 +4,52 @@
   Author  : Christian Borgelt
   History : 2015.08.19 file created
             2015.08.19 bugs in function psr_reduce() fixed
+            2026.10.17 parallel version of psr_reduce() added
+            2026.10.17 border extended by one element (excess items)
+            2026.10.17 inverted item index added to psr_reduce()
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <assert.h>
 #include "arrays.h"
+#include "tpool.h"
 #include "patred.h"
 #ifdef PSR_ABORT
 #include "sigint.h"
 #endif
 
+/*--------------------------------------------------------------------*/
+/* Preprocessor Definitions                                           */
+/*--------------------------------------------------------------------*/
+#define BLKROWS     1024        /* number of rows per block */
+
 /*--------------------------------------------------------------------*/
 /* Type Definitions                                                   */
 /*--------------------------------------------------------------------*/
 typedef int PATCMPFN (const FRQPAT *A,
                       const FRQPAT *B, RSUPP *border);
 
+typedef struct {                /* --- reduction worker --- */
+  FRQPAT   buf;                 /* buffer for pattern intersections */
+  ITEM     *isc;                /* sizes of intersections with row */
+  size_t   *cands;              /* candidate patterns of a row */
+  size_t   *acts;               /* recorded actions of pattern pairs */
+  size_t   size;                /* size of the action buffer */
+  size_t   cnt;                 /* number of used buffer entries */
+} PSRWRK;                       /* (reduction worker) */
+
+typedef struct {                /* --- reduction data --- */
+  PATSET   *psr;                /* pattern set to reduce */
+  PATCMPFN *cmpfn;              /* pattern comparison function */
+  int      addis;               /* whether to add intersections */
+  size_t   *offs;               /* start of pattern list per item */
+  size_t   *pids;               /* pattern indices ordered by item */
+  size_t   beg;                 /* first row of the current block */
+  size_t   *rows;               /* worker and action range per row */
+  PSRWRK   *wrks;               /* reduction workers (one per thread) */
+} PSRDATA;                      /* (reduction data) */
+
 /*--------------------------------------------------------------------*/
 /* Auxiliary Functions                                                */
 /*--------------------------------------------------------------------*/
@@ -215,7 +245,7 @@ PATSET* psr_create (size_t patcnt, ITEM patmax,
   if (!psr) return NULL;        /* create a pattern set */
   psr->map = map;               /* and note the identifier map */
   if (patmax < 2) patmax = 2;   /* create a decision border */
-  psr->border = (RSUPP*)calloc(((size_t)patmax+1), sizeof(RSUPP));
+  psr->border = (RSUPP*)calloc(((size_t)patmax+2), sizeof(RSUPP));
   if (!psr->border) { free(psr); return NULL; }
   psr->border[0] = psr->border[1] = RSUPP_MAX;
   psr->max = patmax;            /* store the size variables */
@@ -315,49 +345,248 @@ void psr_addsupp (PATSET *psr, RSUPP supp)
 
 /*--------------------------------------------------------------------*/
 
-size_t psr_reduce (PATSET *psr, int method, int addis)
-{                               /* --- reduce the pattern set */
-  size_t   i, k, n;             /* loop variables */
+static int record (PSRWRK *w, size_t x)
+{                               /* --- record an action entry */
+  size_t n;                     /* new size of the action buffer */
+  size_t *a;                    /* reallocated action buffer */
+
+  if (w->cnt >= w->size) {      /* if the action buffer is full */
+    n = (w->size > 0) ? w->size +(w->size >> 1) : 1024;
+    a = (size_t*)realloc(w->acts, n *sizeof(size_t));
+    if (!a) return -1;          /* enlarge the action buffer */
+    w->acts = a; w->size = n;   /* and set the new buffer */
+  }
+  w->acts[w->cnt++] = x;        /* store the action entry */
+  return 0;                     /* return 'ok' */
+}  /* record() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t cands (PSRDATA *rd, PSRWRK *w, size_t i)
+{                               /* --- collect candidates of a row */
+  ITEM   x;                     /* loop variable for items */
+  size_t n = 0;                 /* number of candidates */
+  size_t *s, *e;                /* to traverse the pattern lists */
+  FRQPAT *p;                    /* pattern of the row */
+
+  p = rd->psr->pats +i;         /* traverse the items of the row */
+  for (x = 0; x < p->size; x++){/* and their pattern lists */
+    s = rd->pids +rd->offs[p->items[x]];
+    e = rd->pids +rd->offs[p->items[x]+1];
+    for ( ; (s < e) && (*s < i); s++)
+      if (w->isc[*s]++ <= 0) w->cands[n++] = *s;
+  }                             /* count items in the intersections */
+  siz_qsort(w->cands, n, +1);   /* sort the candidates, so that they */
+  return n;                     /* are processed in the serial order */
+}  /* cands() */
+
+/* Only patterns that share at least one item with the pattern of the */
+/* row are candidates, since disjoint pattern pairs are skipped. The  */
+/* pattern lists are ordered by pattern index, so a list can be left  */
+/* as soon as the index of the row is reached. The number of times a  */
+/* candidate is found is the size of its intersection with the row.  */
+
+/*--------------------------------------------------------------------*/
+
+static int row (PSRDATA *rd, PSRWRK *w, size_t i, int rec)
+{                               /* --- process a row of pairs */
+  size_t   j, k, c;             /* loop variables, candidate count */
+  size_t   n, m = 0;            /* pattern index, action counter */
+  size_t   *s, *e;              /* to traverse a pattern list */
+  ITEM     x;                   /* loop variable for items */
+  PATSET   *psr;                /* pattern set to reduce */
   FRQPAT   *p, *b;              /* to access the patterns */
-  PATCMPFN *cmpfn;              /* pattern comparison function */
   int      r;                   /* result of pattern comparison */
+  int      err = 0;             /* error status */
+
+  psr = rd->psr; p = psr->pats; /* get the pattern set and */
+  b   = &w->buf;                /* the intersection buffer */
+  c   = cands(rd, w, i);        /* collect the candidate patterns */
+  for (j = 0; (j < c) && !err; j++) {
+    k = w->cands[j];            /* traverse the candidate patterns */
+    if (!p[i].orig && !p[k].orig)
+      continue;                 /* if both to be discarded, skip */
+    if (w->isc[k] >= p[k].size){/* if pattern k is a subset of i */
+      r = rd->cmpfn(p+i, p+k, psr->border);
+      if (r == 0) continue;     /* compare the two patterns */
+      n = (r > 0) ? k : i;      /* get the disfavored pattern */
+      if (!rec) p[n].orig = NULL;
+      else err = record(w, k) || record(w, 1) || record(w, n);
+      continue;                 /* unmark or record the pattern */
+    }                           /* that is disfavored */
+    isect(p+k, p+i, b);         /* compute the proper intersection */
+    if (!rd->addis              /* if to ignore intersections or */
+    || (b->supp < psr->border[b->size]))
+      continue;                 /* if filtered out by border, skip */
+    n = obj_bisect(b, p, psr->cnt, sizeof(FRQPAT), patcmp, NULL);
+    if ((n < psr->cnt) && (patcmp(b, p+n, NULL) == 0))
+      continue;                 /* check whether intersection exists */
+    n = SIZE_MAX;               /* find the shortest pattern list */
+    for (s = e = NULL, x = 0; x < b->size; x++) {
+      if (rd->offs[b->items[x]+1] -rd->offs[b->items[x]] >= n)
+        continue;               /* skip lists that are not shorter */
+      s = rd->pids +rd->offs[b->items[x]];
+      e = rd->pids +rd->offs[b->items[x]+1];
+      n = (size_t)(e-s);        /* note the shortest list, which */
+    }                           /* contains all superset-patterns */
+    if (rec) {                  /* if to record the actions */
+      err = record(w, k) || record(w, 0);
+      m   = w->cnt -1;          /* record the pair and */
+    }                           /* a counter for the actions */
+    for ( ; (s < e) && !err; s++) {
+      if (!p[*s].orig || !subset(b, p+*s)
+      ||  (rd->cmpfn(p+*s, b, psr->border) >= 0))
+        continue;               /* skip favored or non-supersets */
+      if (!rec) p[*s].orig = NULL;
+      else if (!(err = record(w, *s))) w->acts[m] += 1;
+    }                           /* filter superset-patterns */
+    if (rec && !err && (w->acts[m] <= 0))
+      w->cnt -= 2;              /* remove a pair without actions */
+  }
+  for (j = 0; j < c; j++)       /* clear the intersection sizes */
+    w->isc[w->cands[j]] = 0;    /* for the next row */
+  return -err;                  /* return the error status */
+}  /* row() */
+
+/*--------------------------------------------------------------------*/
+
+static int rec_row (void *data, int thread, long task)
+{                               /* --- record actions of a row */
+  PSRDATA *rd = (PSRDATA*)data; /* type the data pointer */
+  PSRWRK  *w;                   /* worker of the executing thread */
+  size_t  *r;                   /* action range of the row */
+
+  w = rd->wrks +thread;         /* get the worker of the thread */
+  r = rd->rows +3*(size_t)task; /* and the action range of the row */
+  r[0] = (size_t)thread; r[1] = w->cnt;
+  if (row(rd, w, rd->beg +(size_t)task, 1) != 0) return -1;
+  r[2] = w->cnt;                /* record the actions of the row */
+  return 0;                     /* return 'ok' */
+}  /* rec_row() */
+
+/* The marks of the patterns are only read while the rows of a block */
+/* are processed in parallel, so that the recorded actions cannot    */
+/* depend on the order in which the threads process the rows. A pair */
+/* that is skipped because both patterns are already discarded would */
+/* also be skipped by the serial version, since marks are only ever  */
+/* cleared. Whether the other recorded pairs are skipped is decided  */
+/* when the actions are applied in the order of the serial version.  */
+
+/*--------------------------------------------------------------------*/
+
+static void apply (PSRDATA *rd, size_t cnt)
+{                               /* --- apply recorded actions */
+  size_t i, k, m, x;            /* loop variables */
+  FRQPAT *p;                    /* to access the patterns */
+  size_t *a, *e, *r;            /* to traverse the actions */
+
+  p = rd->psr->pats;            /* get the (sorted) patterns */
+  for (x = 0; x < cnt; x++) {   /* traverse the rows of the block */
+    i = rd->beg +x;             /* get the row index */
+    r = rd->rows +3*x;          /* and the action range of the row */
+    a = rd->wrks[r[0]].acts;
+    e = a +r[2]; a += r[1];
+    while (a < e) {             /* traverse the recorded pairs */
+      k = *a++; m = *a++;       /* get the pair and the action size */
+      if (!p[i].orig && !p[k].orig) { a += m; continue; }
+      while (m-- > 0) p[*a++].orig = NULL;
+    }                           /* if not both to be discarded, */
+  }                             /* unmark the disfavored patterns */
+}  /* apply() */
+
+/*--------------------------------------------------------------------*/
+
+static void cleanup (PSRDATA *rd, int cnt)
+{                               /* --- clean up the reduction data */
+  PSRWRK *w;                    /* to traverse the workers */
+
+  if (rd->wrks) {               /* if there are workers */
+    for (w = rd->wrks +cnt; --w >= rd->wrks; ) {
+      if (w->acts)      free(w->acts);
+      if (w->cands)     free(w->cands);
+      if (w->isc)       free(w->isc);
+      if (w->buf.items) free(w->buf.items);
+    }                           /* delete the worker buffers */
+    free(rd->wrks);             /* and the worker array */
+  }
+  if (rd->rows) free(rd->rows); /* delete the row ranges */
+  if (rd->pids) free(rd->pids); /* and the inverted index */
+  if (rd->offs) free(rd->offs);
+}  /* cleanup() */
+
+/*--------------------------------------------------------------------*/
+
+size_t psr_reduce (PATSET *psr, int method, int addis, int threads)
+{                               /* --- reduce the pattern set */
+  size_t  i, n, m;              /* loop variables, number of rows */
+  ITEM    x, k;                 /* loop variable, maximal item */
+  FRQPAT  *p;                   /* to access the patterns */
+  PSRDATA rd;                   /* reduction data */
+  PSRWRK  *w;                   /* to traverse the workers */
+  int     t;                    /* loop variable for workers */
 
   assert(psr                    /* check the function arguments */
   && (method >= PSR_NONE) && (method <= PSR_STRICT1));
   if (method <= PSR_NONE) return psr->cnt;
-  cmpfn = psr_tab[method];      /* get the preference function */
-  b     = &psr->buf;            /* and the pattern buffer */
-  p     = psr->pats;            /* sort the patterns by size */
+  p = psr->pats;                /* sort the patterns by size */
   obj_qsort(p, psr->cnt, sizeof(FRQPAT), +1, patcmp, NULL);
-  for (i = 1; i < psr->cnt; i++) {
-    for (k = 0; k < i; k++) {   /* traverse the pattern pairs */
-      if (!p[i].orig && !p[k].orig)
-        continue;               /* if both to be discarded, skip */
-      if (isect(p+k, p+i, b) <= 0)
-        continue;               /* if patterns are disjoint, skip */
-      if (b->size < p[k].size){ /* if proper intersection exists */
-        if (!addis              /* if to ignore intersections or */
-        || (b->supp < psr->border[b->size]))
-          continue;             /* if filtered out by border, skip */
-        n = obj_bisect(b, p, psr->cnt, sizeof(FRQPAT), patcmp, NULL);
-        if (patcmp(b, p+n, NULL) == 0)
-          continue;             /* check whether intersection exists */
-        for ( ; n < psr->cnt; n++) {
-          if (subset(b, p+n) && (cmpfn(p+n, b, psr->border) < 0))
-            p[n].orig = NULL;   /* filter superset-patterns */
-        } }                     /* with pattern intersection */
-      else {                    /* if pattern k is a subset of i */
-        r = cmpfn(p+i, p+k, psr->border);
-        if      (r > 0) p[k].orig = NULL;
-        else if (r < 0) p[i].orig = NULL;
-      }                         /* compare the two patterns and */
-    }                           /* unmark the disfavored pattern */
+  if (threads <= 0) threads = tp_cpucnt();
+  if (threads <= 0) threads = 1;/* get the number of threads */
+  rd.psr  = psr; rd.cmpfn = psr_tab[method]; rd.addis = addis;
+  rd.offs = NULL; rd.pids = NULL; rd.rows = NULL;
+
+  /* --- build inverted item index --- */
+  for (k = -1, i = n = 0; i < psr->cnt; i++) {
+    for (x = 0; x < p[i].size; x++)
+      if (p[i].items[x] > k) k = p[i].items[x];
+    n += (size_t)p[i].size;     /* determine the maximal item */
+  }                             /* and the pattern extent */
+  rd.wrks = (PSRWRK*)calloc((size_t)threads, sizeof(PSRWRK));
+  rd.offs = (size_t*)calloc((size_t)k+2, sizeof(size_t));
+  rd.pids = (size_t*)malloc((n > 0 ? n : 1) *sizeof(size_t));
+  if ((threads > 1) && (psr->cnt > 2))  /* create row range buffer */
+    rd.rows = (size_t*)malloc(3*BLKROWS *sizeof(size_t));
+  else threads = 1;             /* (only needed for several threads) */
+  if (!rd.wrks || !rd.offs || !rd.pids || ((threads > 1) && !rd.rows)){
+    cleanup(&rd, 0); return SIZE_MAX; }
+  for (i = 0; i < psr->cnt; i++)/* count the patterns per item */
+    for (x = 0; x < p[i].size; x++) rd.offs[p[i].items[x]] += 1;
+  for (x = 0, n = 0; x <= k; x++) {
+    n += rd.offs[x]; rd.offs[x] = n; }
+  rd.offs[k+1] = n;             /* compute the list end offsets */
+  for (i = psr->cnt; i-- > 0; ) /* fill the pattern lists backwards, */
+    for (x = 0; x < p[i].size; x++)  /* so that they are sorted */
+      rd.pids[--rd.offs[p[i].items[x]]] = i;
+
+  /* --- create workers --- */
+  for (t = 0; t < threads; t++){/* traverse the workers */
+    w = rd.wrks +t;             /* create the intersection buffer */
+    w->buf.items = (ITEM*)  malloc((size_t)psr->max *sizeof(ITEM));
+    w->isc       = (ITEM*)  calloc(psr->cnt, sizeof(ITEM));
+    w->cands     = (size_t*)malloc(psr->cnt *sizeof(size_t));
+    if (!w->buf.items || !w->isc || !w->cands) {
+      cleanup(&rd, threads); return SIZE_MAX; }
+  }                             /* create the row buffers */
+
+  /* --- reduce the pattern set --- */
+  for (i = 1; i < psr->cnt; i += m) {
+    m = psr->cnt -i;            /* get the number of rows */
+    if (m > BLKROWS) m = BLKROWS;   /* in the next block */
+    rd.beg = i;                 /* and note the first row */
+    for (t = 0; t < threads; t++) rd.wrks[t].cnt = 0;
+    if ((threads > 1) && (m > 1)/* record the actions in parallel */
+    &&  (tp_exec(threads, (long)m, rec_row, &rd) == 0))
+      apply(&rd, m);            /* and apply them in serial order */
+    else {                      /* if to process rows directly */
+      for (n = 0; n < m; n++)   /* (single thread or failure) */
+        row(&rd, rd.wrks, i+n, 0);
+    }                           /* process the rows of the block */
     #ifdef PSR_ABORT
     if (sig_aborted()) break;   /* check for user abort */
     #endif
   }
+  cleanup(&rd, threads);        /* clean up the reduction data */
   for (i = n = 0; i < psr->cnt; i++)
     if (p[i].orig) n++;         /* count the marked patterns */
   return n;                     /* return the number of patterns */
 }  /* psr_reduce() */
-
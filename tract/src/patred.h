@@ -3,6 +3,7 @@
   Contents: pattern set reduction
   Author  : Christian Borgelt
   History : 2015.08.19 file created
+            2026.10.17 parameter threads added to psr_reduce()
 ----------------------------------------------------------------------*/
 #ifndef __PATRED__
 #define __PATRED__
@@ -66,7 +67,8 @@ extern void    psr_addsupp (PATSET *psr, RSUPP supp);
 
 extern size_t  psr_curcnt  (PATSET *psr);
 
-extern size_t  psr_reduce  (PATSET *psr, int method, int addis);
+extern size_t  psr_reduce  (PATSET *psr, int method, int addis,
+                            int threads);
 
 extern void*   psr_getorig (PATSET *psr, size_t i);
 
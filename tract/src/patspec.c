@@ -13,6 +13,10 @@
             2014.07.25 spectrum estimation for item sequences added
             2014.10.24 treatment of non-integer support type corrected
             2016.10.05 slot counting with and without duplicate check
+            2026.10.17 multi-threaded sampling in function cplxest()
+            2026.10.17 concurrent mode with dense counters added
+            2026.10.17 last row included in psp_delete()/psp_clear()
+            2026.10.17 counter-based random number streams for sampling
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -22,6 +26,9 @@
 #include <math.h>
 #include <time.h>
 #include <assert.h>
+#ifdef _MSC_VER
+#include <windows.h>
+#endif
 #ifdef PSP_MAIN
 #ifndef PSP_REPORT
 #define PSP_REPORT
@@ -31,6 +38,7 @@
 #ifdef PSP_ESTIM
 #include "gamma.h"
 #include "random.h"
+#include "tpool.h"
 #endif
 #ifdef PSP_MAIN
 #include "error.h"
@@ -66,8 +74,22 @@
 #undef ptrdiff_t
 #undef double
 
+/*--------------------------------------------------------------------*/
+#ifdef _MSC_VER                 /* if Microsoft Visual C */
+#ifdef _WIN64                   /* if 64 bit Windows system */
+#define ATOMIC_ADD(p,v) ((size_t)InterlockedExchangeAdd64( \
+                          (LONG64 volatile*)(p), (LONG64)(v)))
+#else                           /* if 32 bit Windows system */
+#define ATOMIC_ADD(p,v) ((size_t)InterlockedExchangeAdd( \
+                          (LONG volatile*)(p), (LONG)(v)))
+#endif
+#else                           /* if GNU C compatible compiler */
+#define ATOMIC_ADD(p,v) __atomic_fetch_add(p, v, __ATOMIC_RELAXED)
+#endif                          /* (returns the old counter value) */
+
 /*--------------------------------------------------------------------*/
 #define BLKSIZE      32         /* block size for enlarging arrays */
+#define SMPLPART     64         /* number of sample partitions */
 
 #ifdef PSP_MAIN
 /* --- error codes --- */
@@ -104,6 +126,33 @@ typedef struct {                /* --- point process element */
 } PPELEM;                       /* (point process element) */
 
 #endif  /* #if defined PSP_TRAIN && defined PSP_ESTIM */
+#ifdef PSP_ESTIM
+
+typedef struct {                /* --- sampling worker */
+  RNG          *rng;            /* random number generator */
+  double       *probs;          /* item probabilities (own order) */
+} ESTWRK;                       /* (sampling worker) */
+
+typedef struct {                /* --- sample partition */
+  double       *dist;           /* partial probability distribution */
+  size_t       size;            /* size of the distribution array */
+  RSUPP        max;             /* maximum coincidence count +1 */
+} ESTPART;                      /* (sample partition) */
+
+typedef struct {                /* --- sampling data */
+  const double *probs;          /* item occurrence probabilities */
+  ITEM         n;               /* number of items */
+  ITEM         z;               /* current pattern size */
+  RSUPP        smax;            /* maximum support (coincidences) */
+  double       lcnt;            /* logarithm of slot count */
+  double       thresh;          /* threshold for distribution */
+  size_t       smpls;           /* total number of samples */
+  unsigned int seed;            /* seed for random number generator */
+  ESTWRK       *wrks;           /* sampling workers (one per thread) */
+  ESTPART      parts[SMPLPART]; /* sample partitions */
+} ESTDATA;                      /* (sampling data) */
+
+#endif  /* #ifdef PSP_ESTIM */
 /*----------------------------------------------------------------------
   Global Variables
 ----------------------------------------------------------------------*/
@@ -156,6 +205,7 @@ PATSPEC* psp_create (ITEM  minsize, ITEM  maxsize,
   psp->total   = psp->sigcnt = 0;
   psp->cur     = psp->max    = minsize -1;
   psp->err     = 0;
+  psp->conc    = 0;
   psp->rows    = NULL;
   return psp;                   /* return created pattern spectrum */
 }  /* psp_create() */
@@ -168,7 +218,7 @@ void psp_delete (PATSPEC *psp)
   if (psp->rows) {              /* if there are pattern spectrum rows */
     #if INTSUPP                 /* if integer support type */
     ITEM size;                  /* loop variable */
-    for (size = psp->minsize; size < psp->max; size++)
+    for (size = psp->minsize; size <= psp->max; size++)
       if (psp->rows[size].frqs) free(psp->rows[size].frqs);
     #endif                      /* delete the counter arrays */
     free(psp->rows);            /* delete the row array */
@@ -180,24 +230,101 @@ void psp_delete (PATSPEC *psp)
 
 void psp_clear (PATSPEC *psp)
 {                               /* --- clear pattern spectrum */
-  ITEM size;                    /* loop variable */
+  ITEM   size;                  /* loop variable */
+  PSPROW *row;                  /* to traverse the rows */
 
   assert(psp);                  /* check the function argument */
   if (psp->rows) {              /* if there are pattern spectrum rows */
-    for (size = psp->minsize; size < psp->max; size++) {
+    for (size = psp->minsize; size <= psp->max; size++) {
+      row = psp->rows +size;    /* traverse the rows (sizes) */
       #if INTSUPP               /* if integer support type */
-      if (psp->rows[size].frqs) free(psp->rows[size].frqs);
+      if (psp->conc) {          /* if in concurrent mode, */
+        memset(row->frqs, 0, (size_t)(row->max -row->min +1)
+                            *sizeof(size_t));
+        row->cur = RSUPP_MIN;   /* only clear the counters */
+        row->sum = 0; continue; /* and keep the dense arrays */
+      }
+      if (row->frqs) free(row->frqs);
       #endif                    /* delete the counter arrays */
-      psp->rows[size] = empty;  /* reinitialize the rows */
+      *row = empty;             /* reinitialize the rows */
     }                           /* (also needed for RSUPP==double) */
   }
   psp->total = psp->sigcnt = 0; /* clear total and signature counter */
-  psp->cur   = psp->max    = psp->minsize-1;
+  psp->cur   = psp->minsize-1;  /* and the maximum used size */
+  if (!psp->conc) psp->max = psp->minsize-1;
   psp->err   = 0;               /* clear the maximum size */
 }  /* psp_clear() */            /* and the error status */
 
 /*--------------------------------------------------------------------*/
 
+int psp_concur (PATSPEC *psp, int conc)
+{                               /* --- set/clear concurrent mode */
+  #if INTSUPP                   /* if integer support type */
+  ITEM   size;                  /* loop variable for sizes */
+  RSUPP  supp;                  /* loop variable for supports */
+  PSPROW *row;                  /* to traverse the rows */
+  size_t n, *p;                 /* size of and new counter array */
+
+  assert(psp);                  /* check the function argument */
+  if (!conc) {                  /* if to leave concurrent mode */
+    if (!psp->conc) return 0;   /* if not in concurrent mode, abort */
+    for (size = psp->minsize; size <= psp->max; size++) {
+      row = psp->rows +size;    /* traverse the rows (sizes) */
+      if (row->sum <= 0) continue;
+      if (size > psp->cur) psp->cur = size;
+      for (supp = row->max; supp > row->cur; supp--)
+        if (row->frqs[supp -row->min] > 0) break;
+      row->cur = supp;          /* determine the maximum size and */
+    }                           /* the maximum support per size, */
+    psp->conc = 0;              /* which are not maintained */
+    return 0;                   /* by concurrent updates */
+  }
+  if (psp->conc) return 0;      /* if in concurrent mode, abort */
+  if ((psp->maxsize >= ITEM_MAX-1) || (psp->maxsupp >= RSUPP_MAX-1))
+    return -1;                  /* dense counters need finite ranges */
+  if (psp->max < psp->maxsize){ /* if not all rows exist */
+    row = (PSPROW*)realloc(psp->rows,
+                           (size_t)(psp->maxsize+1) *sizeof(PSPROW));
+    if (!row) return -1;        /* enlarge the row array */
+    for (size = psp->max; ++size <= psp->maxsize; )
+      row[size] = empty;        /* initialize the new elements */
+    psp->rows = row;            /* set the new array */
+    psp->max  = psp->maxsize;   /* and its size */
+  }
+  n = (size_t)(psp->maxsupp -psp->minsupp) +1;
+  for (size = psp->minsize; size <= psp->max; size++) {
+    row = psp->rows +size;      /* traverse the rows (sizes) */
+    if (row->frqs && (row->min <= psp->minsupp)
+    &&               (row->max >= psp->maxsupp))
+      continue;                 /* skip rows that are already full */
+    p = (size_t*)calloc(n, sizeof(size_t));
+    if (!p) return -1;          /* create a full counter array */
+    if (row->frqs) {            /* copy the existing counters */
+      memcpy(p +(row->min -psp->minsupp), row->frqs,
+             (size_t)(row->max -row->min +1) *sizeof(size_t));
+      free(row->frqs);          /* and delete the old array */
+    }
+    row->frqs = p;              /* set the new counter array */
+    row->min  = psp->minsupp;   /* and its support range */
+    row->max  = psp->maxsupp;
+  }
+  psp->conc = 1;                /* set the concurrent mode flag */
+  return 0;                     /* return 'ok' */
+  #else                         /* if double support type */
+  assert(psp);                  /* check the function argument */
+  return (conc) ? -1 : 0;       /* concurrent mode needs counters */
+  #endif
+}  /* psp_concur() */
+
+/* In concurrent mode the counters for all sizes and all supports in  */
+/* the ranges given to psp_create() are allocated in advance, so that */
+/* psp_incfrq() needs only atomic additions and several threads can   */
+/* update the same pattern spectrum. The maximum size and the maximum */
+/* support per size are not maintained in this mode, so the spectrum  */
+/* must be switched back with psp_concur(psp, 0) before it is used.   */
+
+/*--------------------------------------------------------------------*/
+
 size_t psp_getfrq (PATSPEC *psp, ITEM size, RSUPP supp)
 {                               /* --- get a counter value */
   PSPROW *row;                  /* to access the table row */
@@ -318,6 +445,17 @@ int psp_incfrq (PATSPEC *psp, ITEM size, RSUPP supp, size_t frq)
   if ((size < psp->minsize) || (size > psp->maxsize)
   ||  (supp < psp->minsupp) || (supp > psp->maxsupp))
     return 0;                   /* ignore values outside range */
+  #if INTSUPP                   /* if integer support type */
+  if (psp->conc) {              /* if in concurrent mode */
+    row = psp->rows +size;      /* get the indexed row */
+    if ((ATOMIC_ADD(row->frqs +(supp -row->min), frq) <= 0)
+    &&  (frq > 0))              /* update the signature frequency */
+      ATOMIC_ADD(&psp->sigcnt, 1);   /* and count a new signature */
+    ATOMIC_ADD(&row->sum,   frq);    /* update the sum for the size */
+    ATOMIC_ADD(&psp->total, frq);    /* and the total frequency */
+    return 0;                   /* return 'ok' */
+  }                             /* (all counters exist already) */
+  #endif
   if (resize(psp, size, supp) < 0)
     return psp->err = -1;       /* enlarge table if necessary */
   if (size > psp->cur)          /* update the maximum size */
@@ -401,7 +539,23 @@ static double dchoose (ITEM n, ITEM k)
 
 /*--------------------------------------------------------------------*/
 
-static double samplelp (double *probs, ITEM n, ITEM k)
+static void rselect (double *probs, size_t n, size_t k, RNG *rng)
+{                               /* --- select k random elements */
+  size_t i;                     /* array index */
+  double t;                     /* exchange buffer */
+
+  assert(probs && (n >= k));    /* check the function arguments */
+  k = (k < n) ? k+1 : n;        /* adapt the number of selections */
+  while (--k > 0) {             /* shuffle loop (k selections) */
+    i = (size_t)(rng_dbl(rng) *(double)n);
+    if (i > --n) i = n;         /* compute a random index and */
+    t = probs[i]; probs[i] = *probs; *probs++ = t;
+  }                             /* exchange the array elements */
+}  /* rselect() */
+
+/*--------------------------------------------------------------------*/
+
+static double samplelp (double *probs, ITEM n, ITEM k, RNG *rng)
 {                               /* --- get log. prob. of item sample */
   int    i;                     /* loop variable */
   ITEM   l;                     /* loop variable */
@@ -411,7 +565,7 @@ static double samplelp (double *probs, ITEM n, ITEM k)
   assert(probs);                /* check the function arguments */
   if (k <= 0) return 0.0;       /* check for an empty sample */
   if (k >  n) k = n;            /* ensure that sampling is possible */
-  dbl_select(probs, (size_t)n, (size_t)k, drand);
+  rselect(probs, (size_t)n, (size_t)k, rng);
   if (k <= 1) return log(probs[0]);
   if (k <= 2) {                 /* handle trivial cases directly */
     p1 = probs[0]; p2 = probs[1]; p = p1*p2;
@@ -445,7 +599,7 @@ static double samplelp (double *probs, ITEM n, ITEM k)
   p = 0.0;                      /* initialize average probability */
   for (i = 0; i < 8; i++) {     /* draw 8/16 samples (permutations) */
     if (i <= 0) dbl_qsort  (probs, (size_t)k, +1);
-    else        dbl_shuffle(probs, (size_t)k, drand);
+    else        rselect(probs, (size_t)k, (size_t)k-1, rng);
     t = r = 1.0;                /* init. the probabilities */
     for (l = 0; l < k; l++) { t *= n *probs[l] /r; r -= probs[l]; }
     p += t;                     /* sum the permutation probability */
@@ -653,7 +807,7 @@ static int simpest (PATSPEC *psp, size_t *cnts, ITEM n,
     l = log((double)cnts[z])-y; /* compute distribution parameter */
     x = y -exp(l);              /* and start of Poisson distribution */
     for (c = 1; c <= smax; c++) {
-      x += y = l -log(c);       /* compute next distribution value */
+      x += y = l -log((double)c);/* compute next distribution value */
       frq = (size_t)(exp(x) *(double)equiv +0.5);
       if (frq <= 0) {           /* check value against threshold */
         if (y > 0) continue; else break; }
@@ -666,38 +820,101 @@ static int simpest (PATSPEC *psp, size_t *cnts, ITEM n,
 
 /*--------------------------------------------------------------------*/
 
+static int sample (void *data, int thread, long task)
+{                               /* --- draw the samples of a part. */
+  ESTDATA *ed = (ESTDATA*)data; /* type the data pointer */
+  ESTWRK  *w;                   /* sampling worker of the thread */
+  ESTPART *p;                   /* sample partition to process */
+  RSUPP   c;                    /* loop variable (coincidences) */
+  size_t  i, k;                 /* loop variable, number of samples */
+  size_t  z;                    /* new size of distribution array */
+  double  *d;                   /* reallocated distribution array */
+  double  l, x, y;              /* buffers for various purposes */
+
+  w = ed->wrks  +thread;        /* get the worker of the thread */
+  p = ed->parts +task;          /* and the partition to process */
+  k = ed->smpls /SMPLPART;      /* get the number of samples */
+  if ((size_t)task < ed->smpls %SMPLPART) k += 1;
+  p->max = 0;                   /* clear the partial distribution */
+  if (p->dist) memset(p->dist, 0, p->size *sizeof(double));
+  memcpy(w->probs, ed->probs, (size_t)ed->n *sizeof(double));
+  rng_stream(w->rng, ed->seed, (size_t)ed->z *SMPLPART +(size_t)task);
+  for (i = 0; i < k; i++) {     /* draw the samples of the partition */
+    l = ed->lcnt +samplelp(w->probs, ed->n, ed->z, w->rng);
+    x = -exp(l);                /* compute distribution parameter */
+    for (c = 0; c <= ed->smax; c++) {
+      if (c > 0) {              /* traverse the coincidences */
+        x += y = l -log((double)c);
+        if (x < ed->thresh) {   /* if below the threshold, */
+          if (y <= 0) break;    /* skip the coincidence count */
+          continue;             /* or abort if the distribution */
+        }                       /* is already decreasing */
+      }                         /* compute next distribution value */
+      if ((size_t)c >= p->size){/* if the distribution is too small */
+        z = p->size +((p->size > BLKSIZE) ? p->size >> 1 : BLKSIZE);
+        if (z <= (size_t)c) z = (size_t)c+1;
+        d = (double*)realloc(p->dist, z *sizeof(double));
+        if (!d) return -1;      /* enlarge the distribution array */
+        memset(d +p->size, 0, (z -p->size) *sizeof(double));
+        p->dist = d; p->size = z;
+      }                         /* clear the new array elements */
+      p->dist[(size_t)c] += exp(x);
+    }                           /* update probability distribution */
+    if (c > p->max) p->max = c; /* update maximum coincidence count */
+  }                             /* (for combining the partitions) */
+  return 0;                     /* return 'ok' */
+}  /* sample() */
+
+/*--------------------------------------------------------------------*/
+
 static int cplxest (PATSPEC *psp, size_t *cnts, double *probs, ITEM n,
-                    RSUPP smax, size_t equiv, size_t smpls, int seq)
+                    RSUPP smax, size_t equiv, size_t smpls,
+                    unsigned int seed, int threads, int seq)
 {                               /* --- complex est. (diff. probs.) */
-  ITEM   z;                     /* loop variable, number of items */
-  RSUPP  c, s;                  /* loop variables (coin./support) */
-  size_t i;                     /* loop variable (samples) */
-  size_t frq;                   /* frequency of a signature */
-  double *dist;                 /* probability distribution */
-  double t, l, x, y, q;         /* buffers for various purposes */
+  ITEM    z;                    /* loop variable, number of items */
+  RSUPP   c, s;                 /* loop variables (coin./support) */
+  int     i;                    /* loop variable (workers/parts.) */
+  int     r = 0;                /* result of function call */
+  size_t  frq;                  /* frequency of a signature */
+  double  *dist;                /* probability distribution */
+  double  x, y, q;              /* buffers for various purposes */
+  ESTDATA ed;                   /* sampling data */
+  ESTPART *p;                   /* to traverse the partitions */
 
   assert(psp && cnts && probs   /* check the function arguments */
   &&    (n > 0) && (smax > 0) && (equiv > 0) && (smpls > 0));
+  if (threads <= 0) threads = tp_cpucnt();
+  if (threads <= 0) threads = 1;/* get the number of threads */
+  if (threads > SMPLPART) threads = SMPLPART;
+  if ((size_t)threads > smpls) threads = (int)smpls;
+  memset(&ed, 0, sizeof(ed));   /* initialize the sampling data */
+  ed.probs = probs; ed.n = n; ed.smax = smax;
+  ed.smpls = smpls; ed.seed = seed;
+  ed.wrks  = (ESTWRK*)calloc((size_t)threads, sizeof(ESTWRK));
+  if (!ed.wrks) return -1;      /* create the sampling workers */
+  for (i = 0; i < threads; i++) {
+    ed.wrks[i].rng   = rng_create(seed);
+    ed.wrks[i].probs = (double*)malloc((size_t)n *sizeof(double));
+    if (!ed.wrks[i].rng || !ed.wrks[i].probs) { r = -1; break; }
+  }                             /* each with its own generator */
   dist = probs +n;              /* get probability distribution */
-  s    = smax+1;                /* clear fully on first loop */
-  for (z = psp->minsize; z < n; z++) { /* traverse pattern sizes */
+  for (z = psp->minsize; (r == 0) && (z < n); z++) {
     if (cnts[z] <= 0) continue; /* if there are no slots, skip size */
-    memset(dist, 0, (size_t)s *sizeof(double));
-    s = 0;                      /* clear distrib. and get threshold */
     q = (seq) ? logGamma(z+1) : 0;
     y = logGamma(n+1) -q -logGamma(n-z+1);
-    t = -log((double)equiv) -y -9;   /* compute threshold for dist. */
-    for (i = 0; i < smpls; i++){/* draw a certain number of samples */
-      l = log((double)cnts[z]) +samplelp(probs, n, z) -q;
-      x = -exp(l);              /* compute distribution parameter */
-      dist[0] += exp(x);        /* store for distribution value */
-      for (c = 1; c <= smax; c++) {
-        x += y = l -log((double)c);  /* traverse the coincidences */
-        if      (x >= t) dist[(size_t)c] += exp(x);
-        else if (y <= 0) break; /* compute next distribution value */
-      }                         /* update probability distribution */
-      if (c > s) s = c;         /* update maximum coincidence count */
-    }                           /* (for clearing the distribution) */
+    ed.z      = z;              /* note the pattern size */
+    ed.lcnt   = log((double)cnts[z]) -q;
+    ed.thresh = -log((double)equiv) -y -9;
+    r = tp_exec(threads, SMPLPART, sample, &ed);
+    if (r < 0) break;           /* draw the samples in partitions */
+    for (s = 0, i = 0; i < SMPLPART; i++)
+      if (ed.parts[i].max > s) s = ed.parts[i].max;
+    memset(dist, 0, (size_t)s *sizeof(double));
+    for (i = 0; i < SMPLPART; i++) {
+      p = ed.parts +i;          /* traverse the partitions */
+      for (c = 0; ((size_t)c < p->size) && (c < s); c++)
+        dist[(size_t)c] += p->dist[(size_t)c];
+    }                           /* combine the partial distributions */
     x = dchoose(n,z) /(double)smpls;
     y = 0.0;                    /* compute the scaling factor */
     for (c = 0; c < s; c++) {   /* traverse the distribution */
@@ -709,16 +926,30 @@ static int cplxest (PATSPEC *psp, size_t *cnts, double *probs, ITEM n,
       dist[(size_t)c] *= x;     /* normalize the number of slots */
       frq = (size_t)(dist[(size_t)c] *(double)equiv +0.5);
       if (frq <= 0) continue;   /* compute equivalent frequency */
-      if (psp_incfrq(psp, z, c, frq) != 0) return -1;
+      if (psp_incfrq(psp, z, c, frq) != 0) { r = -1; break; }
     }                           /* add computed signature frequency */
   }                             /* to the pattern spectrum */
-  return 0;                     /* return 'ok' */
+  for (i = 0; i < SMPLPART; i++)
+    if (ed.parts[i].dist) free(ed.parts[i].dist);
+  for (i = threads; --i >= 0; ) {
+    if (ed.wrks[i].probs) free(ed.wrks[i].probs);
+    if (ed.wrks[i].rng)   rng_delete(ed.wrks[i].rng);
+  }                             /* delete the sampling workers */
+  free(ed.wrks);                /* and the partition distributions */
+  return (r < 0) ? -1 : 0;      /* return the error status */
 }  /* cplxest() */
 
+/* The samples are split into a fixed number of partitions, each  */
+/* drawn from the random number stream that is indexed by pattern  */
+/* size and partition, and the partial distributions are combined  */
+/* in partition order. Hence the estimate does not depend on the   */
+/* number of threads that draw the samples.                        */
+
 /*--------------------------------------------------------------------*/
 
 int psp_tbgest (TABAG *tabag, PATSPEC *psp, size_t equiv,
-                double alpha, size_t smpls)
+                double alpha, size_t smpls, unsigned int seed,
+                int threads)
 {                               /* --- estimate a pattern spectrum */
   int      r;                   /* result of function call */
   ITEM     z, n;                /* loop variable, number of items */
@@ -749,7 +980,8 @@ int psp_tbgest (TABAG *tabag, PATSPEC *psp, size_t equiv,
     for (z = 0; z < n; z++)     /* and multiply deviation with alpha */
       probs[z] = (probs[z]-x) *alpha +x;
   }                             /* estimate the pattern spectrum */
-  r = cplxest(psp, cnts, probs, n, smax, equiv, smpls, 0);
+  r = cplxest(psp, cnts, probs, n, smax, equiv, smpls,
+              seed, threads, 0);
   free(probs); free(cnts);      /* delete the working memory */
   return r;                     /* return the error status */
 }  /* psp_tbgest() */
@@ -758,7 +990,8 @@ int psp_tbgest (TABAG *tabag, PATSPEC *psp, size_t equiv,
 #ifdef PSP_TRAIN
 
 int psp_tnsest (TRAINSET *tns, PATSPEC *psp, size_t equiv,
-                double width, double alpha, size_t smpls, int target)
+                double width, double alpha, size_t smpls, int target,
+                unsigned int seed, int threads)
 {                               /* --- estimate a pattern spectrum */
   int    r;                     /* result of function call */
   ITEM   z, n;                  /* loop variable, number of items */
@@ -789,7 +1022,7 @@ int psp_tnsest (TRAINSET *tns, PATSPEC *psp, size_t equiv,
       probs[z] = (probs[z]-x) *alpha +x;
   }                             /* estimate the pattern spectrum */
   r = cplxest(psp, cnts, probs, n, smax, equiv, smpls,
-              (target > PSP_ITEMSET));
+              seed, threads, (target > PSP_ITEMSET));
   free(probs); free(cnts);      /* delete the working memory */
   return r;                     /* return the error status */
 }  /* psp_tnsest() */
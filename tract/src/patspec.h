@@ -8,6 +8,8 @@
             2013.10.15 functions psp_error() and psp_clear() added
             2014.02.28 optional function psp_estim() added (PSP_ESTIM)
             2014.07.25 spectrum estimation for item sequences added
+            2026.10.17 seed and number of threads added to estimation
+            2026.10.17 concurrent mode with dense counters added
 ----------------------------------------------------------------------*/
 #ifndef __PATSPEC__
 #define __PATSPEC__
@@ -133,6 +135,7 @@ typedef struct {                /* --- pattern spectrum --- */
   ITEM   max;                   /* number of pattern spectrum rows */
   ITEM   cur;                   /* current maximum used size/row */
   int    err;                   /* error status */
+  int    conc;                  /* flag for concurrent updates */
   PSPROW *rows;                 /* pattern spectrum rows (by size) */
 } PATSPEC;                      /* (pattern spectrum) */
 
@@ -143,6 +146,8 @@ extern PATSPEC* psp_create  (ITEM  minsize, ITEM  maxsize,
                              RSUPP minsupp, RSUPP maxsupp);
 extern void     psp_delete  (PATSPEC *psp);
 extern void     psp_clear   (PATSPEC *psp);
+extern int      psp_concur  (PATSPEC *psp, int conc);
+extern int      psp_isconc  (PATSPEC *psp);
 extern ITEM     psp_minsize (PATSPEC *psp);
 extern ITEM     psp_maxsize (PATSPEC *psp);
 extern ITEM     psp_min     (PATSPEC *psp);
@@ -162,11 +167,12 @@ extern int      psp_incfrq  (PATSPEC *psp, ITEM size, RSUPP supp,
 extern int      psp_addpsp  (PATSPEC *dst, PATSPEC *src);
 #ifdef PSP_ESTIM
 extern int      psp_tbgest  (TABAG *tabag, PATSPEC *psp, size_t eqsur,
-                             double alpha, size_t smpls);
+                             double alpha, size_t smpls,
+                             unsigned int seed, int threads);
 #ifdef PSP_TRAIN
 extern int      psp_tnsest  (TRAINSET *tns, PATSPEC *psp, size_t eqsur,
                              double width, double alpha, size_t smpls,
-                             int seq);
+                             int seq, unsigned int seed, int threads);
 #endif
 #endif
 #ifdef PSP_REPORT
@@ -189,6 +195,7 @@ extern void     psp_show    (PATSPEC *psp);
 #define psp_max4sz(p,s)     ((p)->rows[s].cur)
 #define psp_sum4sz(p,s)     ((p)->rows[s].sum)
 #define psp_error(p)        ((p)->err)
+#define psp_isconc(p)       ((p)->conc)
 #define psp_sigcnt(p)       ((p)->sigcnt)
 #define psp_total(p)        ((p)->total)
 
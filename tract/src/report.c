@@ -74,6 +74,10 @@
             2016.10.14 function isr_size() added (item array size)
             2016.10.14 bugs in array/memory sizes for sequences fixed
             2017.05.30 optional compression with zlib library added
+            2026.10.16 functions isr_clone() and isr_merge() added
+            2026.10.17 clones share border, names and formats
+            2026.10.17 functions isr_task() and isr_mergex() added
+            2026.10.17 clones share a concurrent pattern spectrum
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -102,11 +106,15 @@
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
 #define BS_BORDER      32       /* block size for filtering border */
+#define BS_RECORD    1024       /* block size for recorded item sets */
+#define BS_SEGMENT     64       /* block size for task segments */
 #define BS_WRITE    (64*1024)   /* size of internal write buffer */
 #define BS_INT         48       /* buffer size for integer output */
 #define BS_FLOAT       96       /* buffer size for float   output */
 #define LN_2        0.69314718055994530942  /* ln(2) */
 
+#define SHAREDPSP(r)  ((r)->orig && ((r)->psp == (r)->orig->psp))
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -127,6 +135,7 @@ static void fastchk (ISREPORT *rep)
   if (rep->border               /* if there is a filtering border */
   ||  rep->repofn               /* or a report function */
   ||  rep->evalfn               /* or an evaluation function */
+  ||  rep->rec                  /* or item sets are to be recorded */
   ||  rep->tidfile)             /* or trans ids. are to be written, */
     rep->fast =  0;             /* standard output has to be used */
   else if (!rep->file)          /* if no output (and no filtering), */
@@ -659,6 +668,8 @@ ISREPORT* isr_createx (ITEMBASE *base, ITEM max)
   rep->nmax    = rep->nsum = 0; /* clear maximum/sum of name lengths */
   rep->repcnt  = 0;             /* init. the item set counter */
   rep->psp     = NULL;          /* clear pattern spectrum variable */
+  rep->rec     = NULL;          /* clear the item set recorder */
+  rep->orig    = NULL;          /* (a new reporter is no clone) */
   rep->ints    = NULL;          /* clear pre-formatted integers */
   rep->imax    = -1;
   rep->file    = NULL;          /* clear the output file and its name */
@@ -732,19 +743,27 @@ int isr_delete (ISREPORT *rep, int delis)
   if (rep->gentab) st_delete(rep->gentab);
   #endif                        /* delete the closed/maximal filter */
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
-  if (rep->psp)    psp_delete(rep->psp);
+  if (rep->psp && !SHAREDPSP(rep)) psp_delete(rep->psp);
   #endif                        /* delete the pattern spectrum */
-  if (rep->str)    free((void*)rep->str);
-  if (rep->border) free(rep->border);
-  #ifndef ISR_NONAMES
-  { ITEM i;                     /* loop variable */
-    for (i = 0; rep->inames[i]; i++) {
-      if (rep->inames[i] != ib_name(rep->base, i))
-        free((void*)rep->inames[i]);
-    }                           /* delete existing item names */
-  }                             /* delete all other arrays */
-  #endif
-  if (rep->ints)   free(rep->ints);
+  if (rep->rec) {               /* if there are recorded item sets */
+    if (rep->rec->segs)  free(rep->rec->segs);
+    if (rep->rec->vals)  free(rep->rec->vals);
+    if (rep->rec->items) free(rep->rec->items);
+    free(rep->rec);             /* delete the recording buffers */
+  }                             /* and the recorder itself */
+  if (!rep->orig) {             /* if not shared with the original */
+    if (rep->str)    free((void*)rep->str);
+    if (rep->border) free(rep->border);
+    #ifndef ISR_NONAMES
+    { ITEM i;                   /* loop variable */
+      for (i = 0; rep->inames[i]; i++) {
+        if (rep->inames[i] != ib_name(rep->base, i))
+          free((void*)rep->inames[i]);
+      }                         /* delete existing item names */
+    }                           /* delete all other arrays */
+    #endif
+    if (rep->ints)   free(rep->ints);
+  }                             /* (a clone only references them) */
   if (rep->stats)  free(rep->stats);
   if (rep->wgts)   free(rep->wgts);
   if (rep->supps)  free(rep->supps);
@@ -764,6 +783,84 @@ int isr_delete (ISREPORT *rep, int delis)
 
 /*--------------------------------------------------------------------*/
 
+ISREPORT* isr_clone (ISREPORT *rep)
+{                               /* --- clone an item set reporter */
+  ISREPORT *dst;                /* created clone of reporter */
+  ITEM     i, n;                /* loop variable, number of items */
+
+  assert(rep);                  /* check the function argument */
+  if (!isr_clonable(rep))       /* repositories and trans. id files */
+    return NULL;                /* cannot be shared with a clone */
+  dst = isr_createx(rep->base, rep->size);
+  if (!dst) return NULL;        /* create a new item set reporter */
+  dst->target  = rep->target;   /* copy the target type, */
+  dst->mode    = rep->mode;     /* the reporting mode, */
+  dst->zmin    = rep->zmin;     /* the size range */
+  dst->zmax    = rep->zmax;     /* and the support range */
+  dst->xmax    = rep->xmax;
+  dst->smin    = rep->smin;
+  dst->smax    = rep->smax;
+  n = ib_cnt(rep->base);        /* get the number of items */
+  for (i = 0; dst->inames[i]; i++) {
+    if (dst->inames[i] != ib_name(dst->base, i))
+      free((void*)dst->inames[i]);
+  }                             /* delete the names of the clone */
+  memcpy((void*)dst->inames, rep->inames, (size_t)(n+1) *sizeof(char*));
+  dst->nmax    = rep->nmax;     /* share the (formatted) item names */
+  dst->nsum    = rep->nsum;     /* and their maximum and total size */
+  dst->orig    = rep;           /* note the original reporter */
+  dst->border  = rep->border;   /* share the filtering border */
+  dst->bdrsize = rep->bdrsize;  /* and its parameters */
+  dst->bdrcnt  = rep->bdrcnt;
+  dst->scan    = rep->scan;     /* share the format strings */
+  dst->str     = rep->str;
+  dst->hdr     = rep->hdr;  dst->sep  = rep->sep;
+  dst->imp     = rep->imp;  dst->iwf  = rep->iwf;
+  dst->info    = rep->info;
+  dst->ints    = rep->ints;     /* share the pre-formatted integers */
+  dst->imin    = rep->imin;
+  dst->imax    = rep->imax;
+  dst->evalfn  = rep->evalfn;   /* copy the evaluation function */
+  dst->evaldat = rep->evaldat;  /* and its parameters */
+  dst->evaldir = rep->evaldir;
+  dst->evalthh = rep->evalthh;
+                                /* copy the item flags, the perfect */
+  memcpy(dst->pxpp, rep->pxpp, (size_t)(n+1) *sizeof(ITEM));
+  n = (ITEM)(rep->items -rep->pexs);
+  dst->pexs = dst->items -n;    /* extensions and the current items */
+  memcpy(dst->pexs, rep->pexs, (size_t)(n+rep->cnt) *sizeof(ITEM));
+  memcpy(dst->supps, rep->supps, (size_t)(rep->cnt+1) *sizeof(RSUPP));
+  memcpy(dst->wgts,  rep->wgts,  (size_t)(rep->cnt+1) *sizeof(double));
+  dst->cnt = rep->cnt;          /* copy the support values/weights */
+  dst->pfx = 0;                 /* and invalidate the output prefix */
+  #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
+  if (rep->psp && psp_isconc(rep->psp))
+    dst->psp = rep->psp;        /* share a concurrent spectrum */
+  else if (rep->psp && (isr_addpsp(dst, NULL) < 0)) {
+    isr_delete(dst, 0); return NULL; }
+  #endif                        /* or create a pattern spectrum */
+  if (rep->repofn || rep->file) {
+    dst->rec = (ISRREC*)calloc(1, sizeof(ISRREC));
+    if (!dst->rec) { isr_delete(dst, 0); return NULL; }
+  }                             /* if needed, create a set recorder */
+  fastchk(dst);                 /* check for fast output */
+  return dst;                   /* return the created clone */
+}  /* isr_clone() */
+
+/* A clone shares the item base (and thus the item names) with the    */
+/* original reporter and starts with the same current item set (incl. */
+/* perfect extensions), so that it can be used to search a subtree of */
+/* the search tree in a separate thread. Item sets that would have to */
+/* be written or passed to a report function are only recorded; they  */
+/* are output with isr_merge() (in the thread of the original). The   */
+/* filtering border, the item names and the format strings are only   */
+/* referenced, so the original must not be changed or deleted while   */
+/* clones exist. Recorded item sets can be grouped by isr_task().     */
+/* If the pattern spectrum of the original is in concurrent mode (see */
+/* psp_concur()), the clones update it directly instead of their own. */
+
+/*--------------------------------------------------------------------*/
+
 int isr_settarg (ISREPORT *rep, int target, int mode, int dir)
 {                               /* --- set target and operation mode */
   assert(rep);                  /* check the function arguments */
@@ -1330,31 +1427,52 @@ static void fastout (ISREPORT *rep, ITEM n)
 
 /*--------------------------------------------------------------------*/
 
-static void output (ISREPORT *rep)
-{                               /* --- output an item set */
+static void record (ISREPORT *rep)
+{                               /* --- record an item set */
+  ISRREC *rec;                  /* item set recorder */
+  size_t n, z;                  /* new array sizes */
+  ITEM   *items;                /* buffer for reallocation */
+  double *vals;                 /* ditto */
+
+  assert(rep && rep->rec);      /* check the function argument */
+  rec = rep->rec;               /* get the item set recorder */
+  if (rec->err) return;         /* if an error occurred, abort */
+  z = rec->icnt +(size_t)rep->cnt +1;
+  if (z > rec->isize) {         /* if the item array is full */
+    n  = rec->isize;            /* compute the new array size */
+    n += (n > BS_RECORD) ? n >> 1 : BS_RECORD;
+    if (n < z) n = z;           /* enlarge the item array */
+    items = (ITEM*)realloc(rec->items, n *sizeof(ITEM));
+    if (!items) { rec->err = -1; return; }
+    rec->items = items; rec->isize = n;
+  }                             /* set the new array and its size */
+  if (3*rec->cnt +3 > rec->size) {
+    n  = rec->size;             /* if the value array is full */
+    n += (n > 3*BS_RECORD) ? n >> 1 : 3*BS_RECORD;
+    vals = (double*)realloc(rec->vals, n *sizeof(double));
+    if (!vals)  { rec->err = -1; return; }
+    rec->vals = vals; rec->size = n;
+  }                             /* set the new array and its size */
+  items = rec->items +rec->icnt;/* store the item set size */
+  *items++ = rep->cnt;          /* and the items of the set */
+  memcpy(items, rep->items, (size_t)rep->cnt *sizeof(ITEM));
+  rec->icnt = z;                /* update the number of items */
+  vals = rec->vals +3*rec->cnt++;
+  vals[0] = (double)rep->supps[rep->cnt];
+  vals[1] = rep->wgts[rep->cnt];/* store support, weight */
+  vals[2] = rep->eval;          /* and evaluation of the item set */
+}  /* record() */
+
+/*--------------------------------------------------------------------*/
+
+static void setout (ISREPORT *rep)
+{                               /* --- output a counted item set */
   TID        k;                 /* loop variable */
   ITEM       min;               /* minimum number of items */
   char       *s;                /* to traverse the output buffer */
   const char *name;             /* to traverse the item names */
 
-  assert(rep                    /* check the function arguments */
-  &&    (rep->cnt >= rep->zmin)
-  &&    (rep->cnt <= rep->zmax));
-  if (rep->border               /* if there is a filtering border */
-  && (rep->cnt < rep->bdrcnt)   /* and the set size is in its range */
-  && (rep->supps[rep->cnt] < rep->border[rep->cnt]))
-    return;                     /* check the item set signature */
-  if (rep->evalfn) {            /* if an evaluation function is given */
-    rep->eval = rep->evalfn(rep, rep->evaldat);
-    if (rep->evaldir *rep->eval < rep->evalthh)
-      return;                   /* if the item set does not qualify, */
-  }                             /* abort the output function */
-  rep->stats[rep->cnt] += 1;    /* count the reported item set */
-  rep->repcnt          += 1;    /* (for its size and overall) */
-  #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
-  if (rep->psp)                 /* count item set in pattern spectrum */
-    psp_incfrq(rep->psp, rep->cnt, rep->supps[rep->cnt], 1);
-  #endif
+  assert(rep);                  /* check the function argument */
   if (rep->repofn)              /* call reporting function if given */
     rep->repofn(rep, rep->repodat);
   if (!rep->file) return;       /* check for an output file */
@@ -1395,6 +1513,32 @@ static void output (ISREPORT *rep)
     }                           /* print number of contained items */
   }
   isr_tidputc(rep, '\n');       /* terminate the transaction id list */
+}  /* setout() */
+
+/*--------------------------------------------------------------------*/
+
+static void output (ISREPORT *rep)
+{                               /* --- output an item set */
+  assert(rep                    /* check the function arguments */
+  &&    (rep->cnt >= rep->zmin)
+  &&    (rep->cnt <= rep->zmax));
+  if (rep->border               /* if there is a filtering border */
+  && (rep->cnt < rep->bdrcnt)   /* and the set size is in its range */
+  && (rep->supps[rep->cnt] < rep->border[rep->cnt]))
+    return;                     /* check the item set signature */
+  if (rep->evalfn) {            /* if an evaluation function is given */
+    rep->eval = rep->evalfn(rep, rep->evaldat);
+    if (rep->evaldir *rep->eval < rep->evalthh)
+      return;                   /* if the item set does not qualify, */
+  }                             /* abort the output function */
+  rep->stats[rep->cnt] += 1;    /* count the reported item set */
+  rep->repcnt          += 1;    /* (for its size and overall) */
+  #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
+  if (rep->psp)                 /* count item set in pattern spectrum */
+    psp_incfrq(rep->psp, rep->cnt, rep->supps[rep->cnt], 1);
+  #endif
+  if (rep->rec) record(rep);    /* record the item set for merging */
+  else          setout(rep);    /* or write it to the output */
 }  /* output() */
 
 /*--------------------------------------------------------------------*/
@@ -1507,6 +1651,8 @@ int isr_report (ISREPORT *rep)
     if (rep->fast) fastout(rep, 0); /* report the expanded set */
     else           output (rep);    /* (fast or normal output) */
     rep->cnt -= n;              /* remove the perfect extensions */
+    if (rep->rec && rep->rec->err)
+      return -1;                /* check for a recording error */
     #ifndef NDEBUG              /* in debug mode */
     isr_flush(rep);             /* flush the output buffer */
     #endif                      /* after every item set */
@@ -1525,6 +1671,8 @@ int isr_report (ISREPORT *rep)
   if (rep->psp && psp_error(rep->psp))
     return -1;                  /* check whether updating the */
   #endif                        /* pattern spectrum failed */
+  if (rep->rec && rep->rec->err)
+    return -1;                  /* check for a recording error */
   #ifndef NDEBUG                /* in debug mode */
   isr_flush(rep);               /* flush the output buffer */
   #endif                        /* after every item set */
@@ -1827,6 +1975,150 @@ int isr_extrule (ISREPORT *rep, const ITEM *items, ITEM n,
 
 /*--------------------------------------------------------------------*/
 
+int isr_task (ISREPORT *rep, long task)
+{                               /* --- start recording for a task */
+  ISRREC *rec;                  /* item set recorder */
+  ISRSEG *seg;                  /* new task segment */
+  size_t n;                     /* new segment array size */
+
+  assert(rep);                  /* check the function argument */
+  rec = rep->rec;               /* get the item set recorder */
+  if (!rec)     return  0;      /* if nothing is recorded, abort */
+  if (rec->err) return -1;      /* check for a recording error */
+  if (rec->scnt > 0) {          /* if there is a previous segment */
+    seg = rec->segs +rec->scnt-1;
+    if (seg->beg >= rec->cnt) { seg->task = task; return 0; }
+    seg->end = rec->cnt;        /* reuse an empty segment, */
+  }                             /* otherwise note the segment end */
+  if (rec->scnt >= rec->ssize){ /* if the segment array is full */
+    n  = rec->ssize;            /* compute the new array size */
+    n += (n > BS_SEGMENT) ? n >> 1 : BS_SEGMENT;
+    seg = (ISRSEG*)realloc(rec->segs, n *sizeof(ISRSEG));
+    if (!seg) { rec->err = -1; return -1; }
+    rec->segs = seg; rec->ssize = n;
+  }                             /* set the new array and its size */
+  seg = rec->segs +rec->scnt++; /* get the next task segment */
+  seg->task = task;             /* note the task identifier */
+  seg->beg  = seg->end = rec->cnt; /* and the start of the segment */
+  seg->ioff = rec->icnt;        /* in the recording arrays */
+  return 0;                     /* return 'ok' */
+}  /* isr_task() */
+
+/* Item sets that a clone records after a call of isr_task() are      */
+/* associated with the given task (until the next call). With work    */
+/* stealing the tasks of a clone need not be consecutive or even      */
+/* ascending, so isr_mergex() sorts the segments of each clone and    */
+/* then merges them across the clones. If the task identifiers follow */
+/* the serial search, the item sets are thus output in the order in   */
+/* which a single thread would have produced them.                    */
+
+/*--------------------------------------------------------------------*/
+
+static void replay (ISREPORT *dst, ISRREC *rec,
+                    size_t beg, size_t end, size_t ioff)
+{                               /* --- output recorded item sets */
+  ITEM   n;                     /* number of items */
+  ITEM   *p;                    /* to traverse the recorded items */
+  double *v;                    /* to traverse the recorded values */
+
+  assert(dst && rec && (beg <= end) && (end <= rec->cnt));
+  p = rec->items +ioff; v = rec->vals +3*beg;
+  for ( ; beg < end; beg++) {   /* traverse the recorded item sets */
+    n = *p++;                   /* get the size of the item set */
+    memcpy(dst->items, p, (size_t)n *sizeof(ITEM));
+    p += n;                     /* copy the items of the set */
+    dst->cnt = n; dst->pfx = 0;
+    dst->supps[n] = (RSUPP)*v++;
+    dst->wgts [n] = *v++;       /* set support, weight */
+    dst->eval     = *v++;       /* and evaluation and */
+    setout(dst);                /* output the item set */
+  }
+}  /* replay() */
+
+/*--------------------------------------------------------------------*/
+
+static int segcmp (const void *p1, const void *p2, void *data)
+{                               /* --- compare two task segments */
+  long a = ((const ISRSEG*)p1)->task;
+  long b = ((const ISRSEG*)p2)->task;
+  return (a < b) ? -1 : (a > b) ? +1 : 0;
+}  /* segcmp() */
+
+/*--------------------------------------------------------------------*/
+
+int isr_mergex (ISREPORT *dst, ISREPORT **srcs, int n)
+{                               /* --- merge clones into a reporter */
+  int    i, b;                  /* loop variable, best clone */
+  ITEM   k;                     /* loop variable for set sizes */
+  ISRREC *rec;                  /* item set recorder of a clone */
+  ISRSEG *seg;                  /* next task segment to output */
+  size_t *nxt;                  /* next task segment per clone */
+  RSUPP  supp;                  /* buffer for empty set support */
+  double wgt, eval;             /* buffer for empty set weight/eval. */
+
+  assert(dst && (srcs || (n <= 0)) && (dst->cnt == 0));
+  for (i = 0; i < n; i++) {     /* traverse the clones */
+    assert(srcs[i] && (srcs[i]->base == dst->base));
+    if (srcs[i]->rec && srcs[i]->rec->err)
+      return -1;                /* check for a recording error */
+    for (k = 0; k <= dst->size; k++)
+      dst->stats[k] += srcs[i]->stats[k];
+    dst->repcnt += srcs[i]->repcnt;
+    #ifdef ISR_PATSPEC          /* sum the item set counters */
+    if (dst->psp && srcs[i]->psp/* and add the pattern spectrum */
+    && (srcs[i]->psp != dst->psp)
+    && (psp_addpsp(dst->psp, srcs[i]->psp) < 0))
+      return -1;                /* of the clone to the one */
+    #endif                      /* of the destination reporter */
+  }
+  nxt = (size_t*)calloc((size_t)((n > 0) ? n : 1), sizeof(size_t));
+  if (!nxt) return -1;          /* create the segment cursors */
+  supp = dst->supps[0];         /* note the empty set support, */
+  wgt  = dst->wgts[0];          /* weight and evaluation */
+  eval = dst->eval;             /* (to restore them afterwards) */
+  for (i = 0; i < n; i++) {     /* traverse the clones */
+    if (!(rec = srcs[i]->rec)) continue;
+    if (rec->scnt <= 0) {       /* if there are no task segments, */
+      replay(dst, rec, 0, rec->cnt, 0);    /* output all sets */
+      continue;                 /* and continue with the next clone */
+    }                           /* otherwise output the sets */
+    replay(dst, rec, 0, rec->segs[0].beg, 0);  /* before the tasks, */
+    rec->segs[rec->scnt-1].end = rec->cnt;  /* close the last segment */
+    obj_qsort(rec->segs, rec->scnt, sizeof(ISRSEG), +1, segcmp, NULL);
+  }                             /* and sort the segments by task */
+  while (1) {                   /* task segment output loop */
+    for (b = -1, i = 0; i < n; i++) {
+      rec = srcs[i]->rec;       /* traverse the clones */
+      if (!rec || (nxt[i] >= rec->scnt)) continue;
+      if ((b < 0) || (rec->segs[nxt[i]].task
+                   <  srcs[b]->rec->segs[nxt[b]].task))
+        b = i;                  /* find the clone with the segment */
+    }                           /* with the smallest task identifier */
+    if (b < 0) break;           /* if all segments are done, abort */
+    rec = srcs[b]->rec;         /* get the next segment to output */
+    seg = rec->segs +nxt[b]++;  /* and output its item sets */
+    replay(dst, rec, seg->beg, seg->end, seg->ioff);
+  }                             /* output the item sets of the task */
+  free(nxt);                    /* delete the segment cursors */
+  dst->cnt = dst->pfx = 0;      /* restore the empty set */
+  dst->supps[0] = supp; dst->wgts[0] = wgt; dst->eval = eval;
+  for (i = 0; i < n; i++) {     /* traverse the clones again */
+    if ((rec = srcs[i]->rec) != NULL)
+      rec->cnt = rec->icnt = rec->scnt = 0;
+    isr_reset(srcs[i]);         /* clear the recorded item sets */
+  }                             /* and the counters of the clones */
+  return 0;                     /* return 'ok' */
+}  /* isr_mergex() */
+
+/*--------------------------------------------------------------------*/
+
+int isr_merge (ISREPORT *dst, ISREPORT *src)
+{                               /* --- merge a clone into a reporter */
+  return isr_mergex(dst, &src, 1);
+}  /* isr_merge() */
+
+/*--------------------------------------------------------------------*/
+
 void isr_reset (ISREPORT *rep)
 {                               /* --- reset the output counters */
   ITEM n;                       /* number of items */
@@ -1836,7 +2128,7 @@ void isr_reset (ISREPORT *rep)
   n = ib_cnt(rep->base);        /* clear the statistics array */
   memset(rep->stats, 0, (size_t)(n+1) *sizeof(size_t));
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
-  if (rep->psp) psp_clear(rep->psp);
+  if (rep->psp && !SHAREDPSP(rep)) psp_clear(rep->psp);
   #endif                        /* clear the pattern spectrum */
 }  /* isr_reset() */
 
@@ -44,6 +44,8 @@
             2016.09.29 function isr_sxrule() added (explicit head item)
             2016.10.14 function isr_size() added (item array size)
             2017.05.30 optional compression with zlib library added
+            2026.10.16 functions isr_clone() and isr_merge() added
+            2026.10.17 functions isr_task() and isr_mergex() added
 ----------------------------------------------------------------------*/
 #ifndef __REPORT__
 #define __REPORT__
@@ -179,6 +181,26 @@
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
+typedef struct {                /* --- task of recorded item sets --- */
+  long       task;              /* task identifier (merge order) */
+  size_t     beg;               /* index of first recorded item set */
+  size_t     end;               /* index after last recorded set */
+  size_t     ioff;              /* offset in the item array */
+} ISRSEG;                       /* (segment of recorded item sets) */
+
+typedef struct {                /* --- recorded item sets --- */
+  size_t     cnt;               /* number of recorded item sets */
+  size_t     size;              /* size of the value array */
+  size_t     icnt;              /* number of used item array elements */
+  size_t     isize;             /* size of the item array */
+  ITEM       *items;            /* item set sizes and items */
+  double     *vals;             /* support, weight and evaluation */
+  size_t     scnt;              /* number of task segments */
+  size_t     ssize;             /* size of the segment array */
+  ISRSEG     *segs;             /* task segments of recorded sets */
+  int        err;               /* error flag (memory allocation) */
+} ISRREC;                       /* (recorded item sets) */
+
 struct isreport;                /* --- an item set eval. function --- */
 typedef double ISEVALFN (struct isreport *rep, void *data);
 typedef void   ISREPOFN (struct isreport *rep, void *data);
@@ -242,6 +264,8 @@ typedef struct isreport {       /* --- an item set reporter --- */
   #else                         /* if no pattern spectrum support */
   void       *psp;              /* placeholder (for fixed offsets) */
   #endif
+  ISRREC     *rec;              /* recorded item sets (for merging) */
+  struct isreport *orig;        /* reporter a clone was created from */
   char       **ints;            /* preformatted integer numbers */
   TID        imin;              /* smallest pre-formatted integer */
   TID        imax;              /* largest  pre-formatted integer */
@@ -278,6 +302,10 @@ typedef struct isreport {       /* --- an item set reporter --- */
 extern ISREPORT* isr_create   (ITEMBASE *base);
 extern ISREPORT* isr_createx  (ITEMBASE *base, ITEM max);
 extern int       isr_delete   (ISREPORT *rep, int delis);
+extern ISREPORT* isr_clone    (ISREPORT *rep);
+extern int       isr_merge    (ISREPORT *dst, ISREPORT *src);
+extern int       isr_mergex   (ISREPORT *dst, ISREPORT **srcs, int n);
+extern int       isr_task     (ISREPORT *rep, long task);
 extern ITEMBASE* isr_base     (ISREPORT *rep);
 extern ITEM      isr_size     (ISREPORT *rep);
 
@@ -446,6 +474,7 @@ extern int       isr_tail     (ISREPORT *rep, const ITEM *items,ITEM n);
 #define isr_name(r)       ((r)->name)
 #define isr_tidfile(r)    ((r)->tidfile)
 #define isr_tidname(r)    ((r)->tidname)
+#define isr_clonable(r)   (!(r)->clomax && !(r)->gentab && !(r)->tidfile)
 
 #define isr_uses(r,i)     ((r)->pxpp[i] < 0)
 #define isr_xable(r,n)    ((r)->cnt+(n) <= (r)->xmax)
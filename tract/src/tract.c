@@ -90,7 +90,12 @@
             2014.10.17 function ib_clear() made a proper function
             2014.10.24 changed from LGPL license to MIT license
             2015.02.27 more item appearance indicator strings added
+            2026.10.17 surrogate functions draw random numbers in blocks
+            2026.10.17 item counters deleted on packing and unpacking
+            2026.10.17 function tbg_flatten() added (contiguous memory)
+            2026.10.17 compressed transaction bags and cursors added
 ----------------------------------------------------------------------*/
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -143,6 +148,8 @@
 
 #define BLKSIZE      1024       /* block size for enlarging arrays */
 #define TH_INSERT       8       /* threshold for insertion sort */
+#define RNDBLK         64       /* block size for random numbers */
+#define ZBLKSIZE       64       /* trans. per block of compr. data */
 #define TS_PRIMES    (sizeof(primes)/sizeof(*primes))
 
 #ifndef QUIET                   /* if not quiet version, */
@@ -168,6 +175,8 @@ typedef struct {                /* --- item frequency --- */
   SUPP dif;                     /* difference to original */
 } ITEMFRQ;                      /* (item frequency) */
 
+typedef unsigned long long ZVAL;/* value of a variable length code */
+
 typedef ITEM SUBFN  (const TRACT  *t1, const TRACT  *t2, ITEM off);
 typedef ITEM SUBWFN (const WTRACT *t1, const WTRACT *t2, ITEM off);
 
@@ -1004,7 +1013,7 @@ int ta_bitmark (TRACT *t)
     if      (*s <  0) mark |= *s & ~TA_END;
     else if (*s < 32) mark |= 1 << *s;
   }                             /* set bits for items 0 to 31 */
-  return t->mark = mark;        /* store and return the item bits */
+  t->mark = mark; return mark;  /* store and return the item bits */
 }  /* ta_bitmark() */
 
 /*--------------------------------------------------------------------*/
@@ -1626,6 +1635,25 @@ void wta_show (WTRACT *t, ITEMBASE *base)
   Transaction Bag/Multiset Functions
 ----------------------------------------------------------------------*/
 
+static size_t tasize (const TABAG *bag, const void *t)
+{                               /* --- size of a transaction record */
+  if (bag->mode & IB_WEIGHTS)   /* if trans. with weighted items */
+    return offsetof(WTRACT, items)
+         + (size_t)(((const WTRACT*)t)->size+1) *sizeof(WITEM);
+  return   offsetof(TRACT,  items)
+         + (size_t)(((const TRACT*) t)->size+1) *sizeof(ITEM);
+}  /* tasize() */               /* (items plus sentinel) */
+
+/*--------------------------------------------------------------------*/
+
+static void tafree (TABAG *bag, void *t)
+{                               /* --- delete a transaction */
+  if ((size_t)t -(size_t)bag->mem >= bag->msize)
+    free(t);                    /* delete the transaction only */
+}  /* tafree() */               /* if it is not in the memory block */
+
+/*--------------------------------------------------------------------*/
+
 TABAG* tbg_create (ITEMBASE *base)
 {                               /* --- create a transaction bag */
   TABAG *bag;                   /* created transaction bag */
@@ -1640,6 +1668,8 @@ TABAG* tbg_create (ITEMBASE *base)
   bag->extent = 0; bag->wgt = 0; bag->max = 0;
   bag->cnt    = bag->size = 0;
   bag->tracts = NULL;           /* there are no transactions yet */
+  bag->mem    = NULL; bag->msize = 0;
+  bag->zoff   = NULL; bag->zdat  = NULL;
   bag->icnts  = NULL;
   bag->ifrqs  = NULL;
   bag->buf    = NULL;
@@ -1654,9 +1684,11 @@ void tbg_delete (TABAG *bag, int delib)
   if (bag->buf) free(bag->buf); /* delete buffer for surrogates */
   if (bag->tracts) {            /* if there are transactions */
     while (bag->cnt > 0)        /* traverse the transaction array */
-      free(bag->tracts[--bag->cnt]);
+      tafree(bag, bag->tracts[--bag->cnt]);
     free(bag->tracts);          /* delete all transactions */
   }                             /* and the transaction array */
+  if (bag->mem)   free(bag->mem);
+  if (bag->zoff)  free(bag->zoff);
   if (bag->icnts) free(bag->icnts);
   if (delib) ib_delete(bag->base);
   free(bag);                    /* delete the item base and */
@@ -1668,23 +1700,31 @@ static TABAG* clone (TABAG *bag)
 {                               /* --- clone memory structure */
   TID    i;                     /* loop variable */
   ITEM   n;                     /* number of items */
+  size_t z;                     /* size of the memory block */
+  char   *p;                    /* to traverse the memory block */
   TABAG  *dst;                  /* created clone of the trans. bag */
   TRACT  *t;                    /* to traverse the transactions */
   WTRACT *x;                    /* to traverse the transactions */
 
   assert(bag);                  /* check the function argument */
   dst = tbg_create(bag->base);  /* create an empty transaction bag */
+  if (!dst) return NULL;        /* and a transaction array */
   dst->tracts = (void**)malloc((size_t)bag->cnt *sizeof(TRACT*));
-  if (!dst->tracts) { return NULL; }
-  dst->max    = bag->max;       /* create a transaction array */
+  if (!dst->tracts) { tbg_delete(dst, 0); return NULL; }
+  for (z = 0, i = 0; i < bag->cnt; i++)
+    z += (tasize(bag, bag->tracts[i]) +7) & ~(size_t)7;
+  dst->mem = p = (char*)malloc((z > 0) ? z : 1);
+  if (!p) { tbg_delete(dst, 0); return NULL; }
+  dst->msize  = z;              /* allocate one memory block */
+  dst->max    = bag->max;       /* for all transactions and */
   dst->wgt    = bag->wgt;       /* copy maximum transaction size, */
   dst->extent = bag->extent;    /* total transaction weight and */
   dst->size   = bag->cnt;       /* transaction array size and extent */
   if (bag->mode & IB_WEIGHTS) { /* if trans. with weighted items */
     for (i = 0; i < bag->cnt; i++) { /* traverse the transactions */
       n = ((WTRACT*)bag->tracts[i])->size;
-      x = (WTRACT*)malloc(sizeof(TRACT) +(size_t)(n+1) *sizeof(ITEM));
-      if (!x) { tbg_delete(dst, 0); return NULL; }
+      x = (WTRACT*)p;           /* get the next transaction record */
+      p += (tasize(bag, bag->tracts[i]) +7) & ~(size_t)7;
       x->wgt  = 1;              /* create and init. the transaction */
       x->size = n; x->mark = 0; x->items[n] = WTA_END;
       dst->tracts[dst->cnt++] = x;
@@ -1692,8 +1732,8 @@ static TABAG* clone (TABAG *bag)
   else {                        /* if simple transactions */
     for (i = 0; i < bag->cnt; i++) { /* traverse the transactions */
       n = ((TRACT*)bag->tracts[i])->size;
-      t = (TRACT*)malloc(sizeof(TRACT) +(size_t)(n+1) *sizeof(ITEM));
-      if (!t) { tbg_delete(dst, 0); return NULL; }
+      t = (TRACT*)p;            /* get the next transaction record */
+      p += (tasize(bag, bag->tracts[i]) +7) & ~(size_t)7;
       t->wgt  = 1;              /* create and init. the transaction */
       t->size = n; t->mark = 0; t->items[n] = TA_END;
       dst->tracts[dst->cnt++] = t;
@@ -1742,6 +1782,8 @@ static int tbg_count (TABAG *bag)
   WITEM  *p;                    /* to traverse the transaction items */
   TID    *z;                    /* to reallocate counter arrays */
 
+  if (bag->zoff)                /* the counters of a compressed bag */
+    return (bag->icnts) ? 0 : -1; /* are fixed on compression */
   i = ib_cnt(bag->base);        /* get the number of items */
   z = (TID*)realloc(bag->icnts, (size_t)i *(sizeof(TID)+sizeof(SUPP)));
   if (!z) return -1;            /* allocate the counter arrays */
@@ -2335,22 +2377,131 @@ TID tbg_reduce (TABAG *bag, int keep0)
                                    :  ta_cmp(*s, *d, NULL);
     if (c == 0) {               /* if the transactions are equal */
       (*d)->wgt += (*s)->wgt;   /* combine the transactions */
-      free(*s); }               /* by summing their weights */
+      tafree(bag, *s); }        /* by summing their weights */
     else {                      /* if transactions are not equal */
       if (keep0 || ((*d)->wgt != 0))
         bag->extent += (size_t)(*d++)->size;
-      else free(*d);            /* check weight of old transaction */
+      else tafree(bag, *d);     /* check weight of old transaction */
       *d = *s;                  /* copy the new transaction */
     }                           /* to close a possible gap */
   }                             /* (collect unique transactions) */
   if (keep0 || ((*d)->wgt != 0))
     bag->extent += (size_t)(*d++)->size;
-  else free(*d);                /* check weight of last transaction */
+  else tafree(bag, *d);         /* check weight of last transaction */
   return bag->cnt = (TID)(d -(TRACT**)bag->tracts);
 }  /* tbg_reduce() */           /* return new number of transactions */
 
 /*--------------------------------------------------------------------*/
 
+int tbg_flatten (TABAG *bag)
+{                               /* --- store trans. contiguously */
+  TID    i;                     /* loop variable */
+  size_t z, k;                  /* size of memory block and record */
+  char   *mem, *p;              /* new memory block, record pointer */
+  void   *t;                    /* to traverse the transactions */
+
+  assert(bag);                  /* check the function argument */
+  for (z = 0, i = 0; i < bag->cnt; i++)
+    z += (tasize(bag, bag->tracts[i]) +7) & ~(size_t)7;
+  if (z <= 0) return 0;         /* compute size of the memory block */
+  p = mem = (char*)malloc(z);   /* allocate a new memory block */
+  if (!mem) return -1;          /* for all transactions */
+  for (i = 0; i < bag->cnt; i++) {
+    t = bag->tracts[i];         /* traverse the transactions */
+    k = tasize(bag, t);         /* and copy them to the new block */
+    memcpy(p, t, k); tafree(bag, t);
+    bag->tracts[i] = p;         /* (in their current order, so that */
+    p += (k +7) & ~(size_t)7;   /* traversals access the memory */
+  }                             /* sequentially afterwards) */
+  if (bag->mem) free(bag->mem); /* delete the old memory block */
+  bag->mem = mem; bag->msize = z;
+  return 0;                     /* return 'ok' */
+}  /* tbg_flatten() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t zput (unsigned char *p, ZVAL v)
+{                               /* --- store a variable length code */
+  size_t n = 1;                 /* number of bytes */
+
+  for ( ; v >= 0x80; v >>= 7, n++)
+    if (p) *p++ = (unsigned char)(v | 0x80);
+  if (p) *p = (unsigned char)v; /* store 7 bits per byte and flag */
+  return n;                     /* whether more bytes follow; */
+}  /* zput() */                 /* return the number of bytes */
+
+/*--------------------------------------------------------------------*/
+
+static const unsigned char* zget (const unsigned char *p, ZVAL *v)
+{                               /* --- read a variable length code */
+  ZVAL x = 0;                   /* decoded value */
+  int  s = 0;                   /* shift for next 7 bits */
+
+  do { x |= (ZVAL)(*p & 0x7f) << s; s += 7; } while (*p++ & 0x80);
+  *v = x;                       /* combine the bytes of the code */
+  return p;                     /* and return the next position */
+}  /* zget() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t zrec (unsigned char *p, const TRACT *t)
+{                               /* --- encode a transaction */
+  size_t     n;                 /* number of bytes */
+  ITEM       k;                 /* number of items */
+  ZVAL       x, y;              /* previous item, item difference */
+  const ITEM *s;                /* to traverse the items */
+
+  for (k = 0, s = t->items; *s > TA_END; s++) k++;
+  n  = zput(p, (ZVAL)t->wgt);   /* count the items (the size may */
+  n += zput(p ? p+n : p, (ZVAL)k); /* be too large if packed) and */
+  for (x = 0, s = t->items; *s > TA_END; s++) {  /* store weight */
+    y = (ZVAL)*s -x; x = (ZVAL)*s;  /* and size, then the items */
+    y = (y << 1) ^ (0 -(y >> (sizeof(ZVAL)*CHAR_BIT-1)));
+    n += zput(p ? p+n : p, y);  /* as (zigzag coded) differences */
+  }                             /* to their predecessors */
+  return n;                     /* return the number of bytes */
+}  /* zrec() */
+
+/*--------------------------------------------------------------------*/
+
+int tbg_compress (TABAG *bag)
+{                               /* --- compress the transactions */
+  TID    i, r;                  /* loop variable, record index */
+  size_t z, n;                  /* size of compressed data, blocks */
+  size_t *off;                  /* offsets of the blocks */
+  unsigned char *p;             /* compressed transactions */
+  TRACT  *t;                    /* to traverse the transactions */
+
+  assert(bag);                  /* check the function argument */
+  if (bag->zoff) return 0;      /* check for a compressed bag */
+  if ((bag->mode & IB_WEIGHTS)  /* items with weights and real-valued */
+  ||  ((SUPP)1/(SUPP)2 != 0))   /* transaction weights are not */
+    return 1;                   /* supported by the code */
+  if (tbg_count(bag) < 0) return -1;  /* fix the item counters */
+  n = (size_t)(bag->cnt +ZBLKSIZE-1) /ZBLKSIZE;
+  for (z = 0, i = 0; i < bag->cnt; i++) {
+    t = (TRACT*)bag->tracts[i]; /* traverse the transactions */
+    if (t->size > bag->max) bag->max = t->size;
+    z += zrec(NULL, t);         /* determine the size */
+  }                             /* of the compressed data */
+  off = (size_t*)malloc(n *sizeof(size_t) +z +1);
+  if (!off) return -1;          /* allocate the compressed data */
+  p = (unsigned char*)(off+n);  /* and the block offsets */
+  for (z = 0, r = 0, i = bag->cnt; --i >= 0; r++) {
+    if (r % ZBLKSIZE == 0)      /* traverse the transactions */
+      off[r /ZBLKSIZE] = z;     /* backwards and note the offsets */
+    z += zrec(p+z, (TRACT*)bag->tracts[i]);
+  }                             /* (mining functions traverse the */
+  for (i = 0; i < bag->cnt; i++)/* transactions in this order) */
+    tafree(bag, bag->tracts[i]);
+  free(bag->tracts); bag->tracts = NULL; bag->size = 0;
+  if (bag->mem) { free(bag->mem); bag->mem = NULL; bag->msize = 0; }
+  bag->zoff = off; bag->zdat = p;
+  return 0;                     /* delete the transactions and */
+}  /* tbg_compress() */          /* return 'ok' */
+
+/*--------------------------------------------------------------------*/
+
 void tbg_setmark (TABAG *bag, int mark)
 {                               /* --- set marks of all transactions */
   TID i;                        /* loop variable */
@@ -2378,6 +2529,8 @@ void tbg_pack (TABAG *bag, int n)
   assert(bag                    /* check the function arguments */
   &&   !(bag->mode & IB_WEIGHTS));
   if (n <= 0) return;           /* if no items to pack, abort */
+  if (bag->icnts) {             /* delete the item-specific counters */
+    free(bag->icnts); bag->icnts = NULL; bag->ifrqs = NULL; }
   for (i = 0; i < bag->cnt; i++)/* pack items in all transactions */
     ta_pack((TRACT*)bag->tracts[i], n);
   bag->mode |= n & TA_PACKED;   /* set flag for packed transactions */
@@ -2391,6 +2544,8 @@ void tbg_unpack (TABAG *bag, int dir)
 
   assert(bag                    /* check the function arguments */
   &&   !(bag->mode & IB_WEIGHTS));
+  if (bag->icnts) {             /* delete the item-specific counters */
+    free(bag->icnts); bag->icnts = NULL; bag->ifrqs = NULL; }
   for (i = 0; i < bag->cnt; i++)/* pack items in all transactions */
     ta_unpack((TRACT*)bag->tracts[i], dir);
   bag->mode &= ~TA_PACKED;      /* clear flag for packed transactions */
@@ -2586,6 +2741,71 @@ void tbg_show (TABAG *bag)
 }  /* tbg_show() */             /* and total transaction weight */
 
 #endif
+/*----------------------------------------------------------------------
+  Transaction Bag Cursor Functions
+----------------------------------------------------------------------*/
+
+TBGCUR* tbc_create (const TABAG *bag)
+{                               /* --- create a transaction cursor */
+  TBGCUR *cur;                  /* created cursor */
+
+  assert(bag);                  /* check the function argument */
+  cur = (TBGCUR*)malloc(sizeof(TBGCUR) +((bag->zoff)
+                      ? (size_t)bag->max *sizeof(ITEM) : 0));
+  if (!cur) return NULL;        /* allocate a buffer for decoding */
+  cur->bag = bag;               /* note the transaction bag and */
+  cur->pos = NULL;              /* start after the last transaction */
+  tbc_seek(cur, bag->cnt);      /* (transactions are traversed */
+  return cur;                   /* in descending index order) */
+}  /* tbc_create() */
+
+/*--------------------------------------------------------------------*/
+
+void tbc_seek (TBGCUR *cur, TID index)
+{                               /* --- set the cursor position */
+  TID  r;                       /* index of compressed record */
+  ITEM n;                       /* number of items */
+  ZVAL x;                       /* buffer for a code value */
+  const unsigned char *p;       /* to traverse the compressed data */
+
+  assert(cur && (index >= 0) && (index <= cur->bag->cnt));
+  cur->index = index;           /* tbc_next() returns trans. index-1 */
+  if (!cur->bag->zoff || (index <= 0)) return;
+  r = cur->bag->cnt -index;     /* get the index of the record */
+  p = cur->bag->zdat +cur->bag->zoff[r /ZBLKSIZE];
+  for (r %= ZBLKSIZE; --r >= 0; ) {  /* skip records in the block */
+    p = zget(p, &x); p = zget(p, &x);
+    for (n = (ITEM)x; --n >= 0; ) while (*p++ & 0x80);
+  }                             /* skip weight, size and items */
+  cur->pos = p;                 /* note the read position */
+}  /* tbc_seek() */
+
+/*--------------------------------------------------------------------*/
+
+TRACT* tbc_next (TBGCUR *cur)
+{                               /* --- get the next transaction */
+  ITEM n;                       /* number of items */
+  ZVAL x, y;                    /* current item, item difference */
+  ITEM *d;                      /* to store the decoded items */
+  const unsigned char *p;       /* to traverse the compressed data */
+
+  assert(cur);                  /* check the function argument */
+  if (cur->index <= 0) return NULL;   /* check for more trans. */
+  if (!cur->bag->zoff)          /* return plain trans. directly */
+    return (TRACT*)cur->bag->tracts[--cur->index];
+  cur->index -= 1;              /* go to the next transaction */
+  p = zget(cur->pos, &x); cur->tract.wgt  = (SUPP)x;
+  p = zget(p,        &x); cur->tract.size = n = (ITEM)x;
+  cur->tract.mark = 0;          /* decode weight and size */
+  for (d = cur->tract.items, x = 0; --n >= 0; ) {
+    p = zget(p, &y);            /* traverse and decode the items */
+    x += (y >> 1) ^ (0 -(y & 1)); *d++ = (ITEM)x;
+  }                             /* (undo zigzag and differences) */
+  *d = TA_END;                  /* store a sentinel at the end */
+  cur->pos = p;                 /* note the new read position */
+  return &cur->tract;           /* return the decoded transaction */
+}  /* tbc_next() */
+
 /*----------------------------------------------------------------------
   Surrogate Generation Functions
 ----------------------------------------------------------------------*/
@@ -2650,6 +2870,7 @@ TABAG* tbg_random (TABAG *src, RNG *rng, TABAG *dst)
   TRACT   *t;                   /* to traverse transactions */
   ITEM    *s, *d;               /* to traverse transaction items */
   ITEMFRQ *ifrq, f;             /* item frequencies, swap buffer */
+  double  rnd[RNDBLK];          /* buffer for random numbers */
 
   assert(src && rng             /* check the function arguments */
   &&   !(src->mode & (TA_PACKED|IB_WEIGHTS)));
@@ -2675,7 +2896,10 @@ TABAG* tbg_random (TABAG *src, RNG *rng, TABAG *dst)
     z = *(size_t*)(ifrq+n);     /* get number of item instances */
     m = n;                      /* traverse items in transaction */
     for (i = 0; i < t->size; i++) {
-      x = (size_t)(rng_dbl(rng) *(double)z);
+      if (i % RNDBLK == 0)      /* draw a block of random numbers */
+        rng_dbls(rng, rnd, (size_t)((t->size -i < RNDBLK)
+                                   ? t->size -i : RNDBLK));
+      x = (size_t)(rnd[i % RNDBLK] *(double)z);
       for (j = 0; j < m; j++) { /* choose a random number */
         if  (x <  (size_t)ifrq[j].frq) break;
         else x -= (size_t)ifrq[j].frq;
@@ -2733,6 +2957,8 @@ TABAG* tbg_swap (TABAG *src, RNG *rng, TABAG *dst)
   ITEM   n;                     /* number of items */
   TID    i, j;                  /* random transaction indices */
   ITEM   *flags;                /* item flag array */
+  int    r;                     /* index of next random number */
+  double rnd[RNDBLK];           /* buffer for random numbers */
 
   assert(src && rng             /* check the function arguments */
   &&   !(src->mode & (TA_PACKED|IB_WEIGHTS)));
@@ -2748,11 +2974,14 @@ TABAG* tbg_swap (TABAG *src, RNG *rng, TABAG *dst)
     first = -1;                 /* clear the item flags and */
   }                             /* set the first run flag */
   flags = dst->buf;             /* get the item flag array */
+  r = RNDBLK;                   /* random number buffer is empty */
   for (z = (first) ? dst->extent << 1 : dst->extent >> 1; z > 0; z--) {
-    i = (int)(rng_dbl(rng) *(double)dst->cnt);
+    if (r >= RNDBLK) {          /* draw a block of random numbers */
+      rng_dbls(rng, rnd, RNDBLK); r = 0; }
+    i = (int)(rnd[r++] *(double)dst->cnt);
     if (i >= dst->cnt) i = dst->cnt-1;
     if (i <  0)        i = 0;   /* generate first transaction index */
-    j = (int)(rng_dbl(rng) *(double)dst->cnt);
+    j = (int)(rnd[r++] *(double)dst->cnt);
     if (j >= dst->cnt) j = dst->cnt-1;
     if (j <  0)        j = 0;   /* generate second transaction index */
     if (i == j) continue;       /* transactions must be different */
@@ -2768,6 +2997,7 @@ TABAG* tbg_shuffle (TABAG *src, RNG *rng, TABAG *dst)
   ITEM  i, n, x;                /* loop variables for items, buffer */
   TID   j, k;                   /* loop variables for transactions */
   TRACT **t;                    /* to access the transactions */
+  double rnd[RNDBLK];           /* buffer for random numbers */
 
   assert(src && rng             /* check the function arguments */
   &&   !(src->mode & (TA_PACKED|IB_WEIGHTS)) && tbg_istab(src));
@@ -2779,7 +3009,9 @@ TABAG* tbg_shuffle (TABAG *src, RNG *rng, TABAG *dst)
   n = ((TRACT*)t[0])->size;     /* and the transaction size */
   for (k = dst->cnt; --k > 0;){ /* traverse the transactions */
     for (i = 0; i < n; i++) {   /* traverse the items/columns */
-      j = (TID)(rng_dbl(rng) *(double)(k+1));
+      if (i % RNDBLK == 0)      /* draw a block of random numbers */
+        rng_dbls(rng, rnd, (size_t)((n-i < RNDBLK) ? n-i : RNDBLK));
+      j = (TID)(rnd[i % RNDBLK] *(double)(k+1));
       if      (j > k) j = k;    /* compute a random transaction index */
       else if (j < 0) j = 0;    /* and clamp it to the proper range */
       x              = t[j]->items[i];
@@ -53,6 +53,8 @@
             2014.09.08 transaction marker functions added (ta_..mark())
             2014.09.09 function ib_frqcnt() added (num. of freq. items)
             2014.10.17 function ib_clear() made a proper function
+            2026.10.17 function tbg_flatten() added (contiguous memory)
+            2026.10.17 compressed transaction bags and cursors added
 ----------------------------------------------------------------------*/
 #ifndef __TRACT__
 #define __TRACT__
@@ -527,11 +529,22 @@ typedef struct {                /* --- transaction bag/multiset --- */
   TID      size;                /* size of the transaction array */
   TID      cnt;                 /* number of transactions */
   void     **tracts;            /* array  of transactions */
+  void     *mem;                /* contiguous memory for trans. */
+  size_t   msize;               /* size of this memory block */
+  size_t   *zoff;               /* offsets of compressed blocks */
+  unsigned char *zdat;          /* compressed transactions */
   TID      *icnts;              /* number of transactions per item */
   SUPP     *ifrqs;              /* frequency of the items (weight) */
   void     *buf;                /* buffer for surrogate generation */
 } TABAG;                        /* (transaction bag/multiset) */
 
+typedef struct {                /* --- transaction bag cursor --- */
+  const TABAG *bag;             /* underlying transaction bag */
+  TID      index;               /* index of current transaction */
+  const unsigned char *pos;     /* read position in compressed data */
+  TRACT    tract;               /* buffer for decoded transaction */
+} TBGCUR;                       /* (transaction bag cursor) */
+
 #ifdef TATREEFN
 #ifdef TATCOMPACT
 
@@ -762,6 +775,9 @@ extern void         tbg_sort    (TABAG *bag, int dir, int heap);
 extern void         tbg_sortsz  (TABAG *bag, int dir, int heap);
 extern void         tbg_reverse (TABAG *bag);
 extern TID          tbg_reduce  (TABAG *bag, int keep0);
+extern int          tbg_flatten (TABAG *bag);
+extern int          tbg_compress(TABAG *bag);
+extern int          tbg_iscomp  (const TABAG *bag);
 extern void         tbg_setmark (TABAG *bag, int mark);
 extern void         tbg_bitmark (TABAG *bag);
 extern void         tbg_pack    (TABAG *bag, int n);
@@ -774,6 +790,15 @@ extern int          tbg_ipwgt   (TABAG *bag, int mode);
 extern void         tbg_show    (TABAG *bag);
 #endif
 
+/*----------------------------------------------------------------------
+  Transaction Bag Cursor Functions
+----------------------------------------------------------------------*/
+extern TBGCUR*      tbc_create  (const TABAG *bag);
+extern void         tbc_delete  (TBGCUR *cur);
+extern void         tbc_seek    (TBGCUR *cur, TID index);
+extern TRACT*       tbc_next    (TBGCUR *cur);
+extern TID          tbc_index   (const TBGCUR *cur);
+
 /*----------------------------------------------------------------------
   Surrogate Generation Functions
 ----------------------------------------------------------------------*/
@@ -898,6 +923,11 @@ extern void         tat_show    (TATREE *tree);
 #define tbg_errmsg(b,s,n) ib_errmsg((b)->base, s, n)
 #define tbg_reverse(b)    ptr_reverse((b)->tracts, (b)->cnt)
 #define tbg_packcnt(b)    ((b)->mode & TA_PACKED)
+#define tbg_iscomp(b)     ((b)->zoff != NULL)
+
+/*--------------------------------------------------------------------*/
+#define tbc_delete(c)     free(c)
+#define tbc_index(c)      ((c)->index)
 
 /*--------------------------------------------------------------------*/
 
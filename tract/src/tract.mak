@@ -187,14 +187,15 @@ pspdbl.obj:   patspec.h patspec.c tract.mak
 
 pspest.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
               $(UTILDIR)\symtab.h   $(UTILDIR)\random.h \
-              $(UTILDIR)\tabwrite.h
+              $(UTILDIR)\tabwrite.h $(UTILDIR)\tpool.h
 pspest.obj:   patspec.h patspec.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D PSP_REPORT /D PSP_ESTIM \
 	      patspec.c /Fo$@
 
 pspetr.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
               $(UTILDIR)\symtab.h   $(UTILDIR)\random.h \
-              $(UTILDIR)\tabwrite.h $(MATHDIR)\gamma.h
+              $(UTILDIR)\tabwrite.h $(MATHDIR)\gamma.h \
+              $(UTILDIR)\tpool.h
 pspetr.obj:   patspec.h patspec.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D PSP_REPORT /D PSP_ESTIM /D PSP_TRAIN \
               patspec.c /Fo$@
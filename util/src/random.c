@@ -11,6 +11,8 @@
             2013.09.12 optional fallback to functions from stdlib added
             2013.12.01 symmetric random number functions added
             2013.12.04 data type RNG added (random generator object)
+            2026.10.17 counter-based streams (Philox4x32-10) added
+            2026.10.17 functions rng_uints() and rng_dbls() added
 ----------------------------------------------------------------------*/
 #include <limits.h>
 #include <float.h>
@@ -25,6 +27,13 @@
 ----------------------------------------------------------------------*/
 #define RNORM       (1.0 /((double)UINT_MAX +1.0))
 
+#define PHILOX_M0   0xd2511f53u /* multipliers of Philox rounds */
+#define PHILOX_M1   0xcd9e8d57u
+#define PHILOX_W0   0x9e3779b9u /* key increments (Weyl sequence) */
+#define PHILOX_W1   0xbb67ae85u
+#define PHILOX_RDS  10          /* number of Philox rounds */
+#define BLKSIZE     64          /* block size for batch draws */
+
 #ifdef _MSC_VER
 #ifndef isnan
 #define isnan(x)    _isnan(x)
@@ -214,6 +223,7 @@ void rng_seed (RNG *rng, unsigned int seed)
   rng->state[2] = seed = 69069 *seed +362437;
   rng->state[3] = seed = 69069 *seed +362437;
   rng->state[4] = seed = 69069 *seed +362437;
+  rng->pos = -1;                /* use the xorshift generator */
   rng_uint(rng); rng_uint(rng); rng_uint(rng);
   rng_uint(rng); rng_uint(rng); /* skip some initial values */
   rng->b = NAN;                 /* invalidate the buffer */
@@ -227,14 +237,70 @@ void rng_seedx (RNG *rng,       unsigned int a,
 {                               /* -- init. random number generator */
   rng->state[0] = a; rng->state[1] = b; rng->state[2] = c;
   rng->state[3] = d; rng->state[4] = e;/* store init. values */
+  rng->pos = -1;                /* use the xorshift generator */
   rng->b = NAN;                 /* and invalidate the buffer */
 }  /* rng_seed() */
 
 /*--------------------------------------------------------------------*/
 
+void rng_stream (RNG *rng, unsigned int seed, size_t stream)
+{                               /* --- select a counter-based stream */
+  rng->key[0] = seed;           /* the seed is the key and */
+  rng->key[1] = 0;              /* the stream index is the upper */
+  rng->ctr[0] = rng->ctr[1] = 0;/* half of the block counter */
+  rng->ctr[2] = (unsigned int)stream;
+  rng->ctr[3] = (unsigned int)((stream >> 16) >> 16);
+  rng->pos = 4;                 /* mark the output block as used */
+  rng->b   = NAN;               /* and invalidate the buffer */
+}  /* rng_stream() */
+
+/* A counter-based generator computes the i-th number of a stream    */
+/* directly from the key and the counter value (Philox4x32-10, see   */
+/* J.K. Salmon et al., Parallel Random Numbers: As Easy as 1, 2, 3,  */
+/* Proc. Int. Conf. High Performance Computing (SC'11), ACM 2011).   */
+/* Therefore streams with different indices are independent and a    */
+/* stream yields the same numbers on all platforms, no matter which  */
+/* thread draws from it (as long as unsigned int has 32 bits).       */
+
+/*--------------------------------------------------------------------*/
+
+static void philox (RNG *rng)
+{                               /* --- compute next block of numbers */
+  int                i;         /* loop variable for rounds */
+  unsigned int       c0, c1, c2, c3, k0, k1;  /* counter and key */
+  unsigned long long p0, p1;    /* products of multiplications */
+
+  c0 = rng->ctr[0]; c1 = rng->ctr[1];
+  c2 = rng->ctr[2]; c3 = rng->ctr[3];
+  k0 = rng->key[0]; k1 = rng->key[1];
+  for (i = 0; i < PHILOX_RDS; i++) {
+    p0 = (unsigned long long)PHILOX_M0 *c0;
+    p1 = (unsigned long long)PHILOX_M1 *c2;
+    c0 = (unsigned int)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (unsigned int) p1;     /* multiply, mix the high parts */
+    c2 = (unsigned int)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (unsigned int) p0;     /* with counter and key and */
+    k0 += PHILOX_W0;            /* permute the counter words, */
+    k1 += PHILOX_W1;            /* then increment the key */
+  }
+  rng->out[0] = c0; rng->out[1] = c1;
+  rng->out[2] = c2; rng->out[3] = c3;
+  rng->pos = 0;                 /* store the generated numbers */
+  if (++rng->ctr[0] == 0)       /* and increment the block counter */
+    ++rng->ctr[1];              /* (lower half, with carry) */
+}  /* philox() */
+
+/*--------------------------------------------------------------------*/
+
 unsigned int rng_uint (RNG *rng)
 {                               /* --- generate random unsigned int */
-  unsigned int t = (rng->state[0] ^ (rng->state[0] >> 7));
+  unsigned int t;               /* buffer for xorshift computation */
+
+  if (rng->pos >= 0) {          /* if counter-based stream */
+    if (rng->pos >= 4) philox(rng);
+    return rng->out[rng->pos++];/* compute a new block if needed */
+  }                             /* and return its next number */
+  t = (rng->state[0] ^ (rng->state[0] >> 7));
   rng->state[0] = rng->state[1]; rng->state[1] = rng->state[2];
   rng->state[2] = rng->state[3]; rng->state[3] = rng->state[4];
   rng->state[4] = (rng->state[4] ^ (rng->state[4] << 6))
@@ -244,11 +310,43 @@ unsigned int rng_uint (RNG *rng)
 
 /*--------------------------------------------------------------------*/
 
+void rng_uints (RNG *rng, unsigned int *buf, size_t n)
+{                               /* --- generate several unsigned ints */
+  if (rng->pos >= 0) {          /* if counter-based stream */
+    for ( ; (n > 0) && (rng->pos < 4); n--)
+      *buf++ = rng->out[rng->pos++];
+    for ( ; n >= 4; n -= 4) {   /* use up the current block, */
+      philox(rng);              /* then copy full blocks */
+      *buf++ = rng->out[0]; *buf++ = rng->out[1];
+      *buf++ = rng->out[2]; *buf++ = rng->out[3];
+      rng->pos = 4;             /* mark the block as used */
+    }
+  }                             /* generate the remaining numbers */
+  while (n-- > 0) *buf++ = rng_uint(rng);
+}  /* rng_uints() */
+
+/*--------------------------------------------------------------------*/
+
 double rng_dbl (RNG *rng)
 { return rng_uint(rng) *RNORM; }
 
 /*--------------------------------------------------------------------*/
 
+void rng_dbls (RNG *rng, double *buf, size_t n)
+{                               /* --- generate several doubles */
+  size_t       i, k;            /* loop variable, size of batch */
+  unsigned int u[BLKSIZE];      /* buffer for unsigned integers */
+
+  for ( ; n > 0; n -= k) {      /* draw numbers in batches */
+    k = (n < BLKSIZE) ? n : BLKSIZE;
+    rng_uints(rng, u, k);       /* generate unsigned integers */
+    for (i = 0; i < k; i++)     /* and scale them to [0,1) */
+      *buf++ = u[i] *RNORM;     /* (same numbers as a sequence */
+  }                             /* of calls of rng_dbl()) */
+}  /* rng_dbls() */
+
+/*--------------------------------------------------------------------*/
+
 double rng_dblx (RNG *rng)
 {                               /* --- random double with full prec. */
   double x;                     /* buffer for random number */
@@ -7,6 +7,7 @@
             2012.01.10 function randn() added (normal distribution)
             2013.12.01 symmetric random number functions added
             2013.12.04 data type RNG added (random generator object)
+            2026.10.17 counter-based streams and batch draws added
 ----------------------------------------------------------------------*/
 #ifndef __RANDOM__
 #define __RANDOM__
@@ -26,6 +27,10 @@
 ----------------------------------------------------------------------*/
 typedef struct {                /* --- random number generator --- */
   unsigned int state[5];        /* registers for generator state */
+  unsigned int ctr[4];          /* counter (counter-based stream) */
+  unsigned int key[2];          /* key     (counter-based stream) */
+  unsigned int out[4];          /* block of generated numbers */
+  int          pos;             /* next number in block (-1: none) */
   double       b;               /* buffer for Box-Muller transform */
   int          type;            /* density type (e.g. RNG_RECT) */
   double       sigma;           /* std. dev. or width parameter */
@@ -54,8 +59,12 @@ extern void         rng_seed    (RNG *rng, unsigned int seed);
 extern void         rng_seedx   (RNG *rng,       unsigned int a,
                                  unsigned int b, unsigned int c,
                                  unsigned int d, unsigned int e);
+extern void         rng_stream  (RNG *rng, unsigned int seed,
+                                 size_t stream);
 extern unsigned int rng_uint    (RNG *rng);
+extern void         rng_uints   (RNG *rng, unsigned int *buf, size_t n);
 extern double       rng_dbl     (RNG *rng);
+extern void         rng_dbls    (RNG *rng, double *buf, size_t n);
 extern double       rng_dblx    (RNG *rng);
 extern int          rng_bit     (RNG *rng);
 extern double       rng_norm    (RNG *rng);
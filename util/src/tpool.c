@@ -0,0 +1,281 @@
+/*----------------------------------------------------------------------
+  File    : tpool.c
+  Contents: thread pool for independent tasks (with work stealing)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+            2026.10.17 task size hints and abort check added
+            2026.10.17 error status protected by a lock
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <assert.h>
+#ifdef _WIN32                   /* if Microsoft Windows system */
+#include <windows.h>
+#else                           /* if Linux/Unix system */
+#include <unistd.h>
+#include <pthread.h>
+#endif
+#include "arrays.h"
+#include "tpool.h"
+#ifdef TP_ABORT
+#include "sigint.h"
+#endif
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#ifdef _WIN32                   /* if Microsoft Windows system */
+#define THREAD       HANDLE     /* threads identified by handles */
+#define THREAD_OK    0          /* return value is DWORD */
+#define WORKERDEF(n,p)  DWORD WINAPI n (LPVOID p)
+#define MUTEX        CRITICAL_SECTION
+#define MTX_INIT(m)  InitializeCriticalSection(m)
+#define MTX_EXIT(m)  DeleteCriticalSection(m)
+#define MTX_LOCK(m)  EnterCriticalSection(m)
+#define MTX_FREE(m)  LeaveCriticalSection(m)
+#else                           /* if Linux/Unix system */
+#define THREAD       pthread_t  /* use the POSIX thread type */
+#define THREAD_OK    NULL       /* return value is void* */
+#define WORKERDEF(n,p)  void*        n (void* p)
+#define MUTEX        pthread_mutex_t
+#define MTX_INIT(m)  pthread_mutex_init(m, NULL)
+#define MTX_EXIT(m)  pthread_mutex_destroy(m)
+#define MTX_LOCK(m)  pthread_mutex_lock(m)
+#define MTX_FREE(m)  pthread_mutex_unlock(m)
+#endif                          /* definition of a worker function */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+struct tpool;                   /* --- thread pool (forward decl.) */
+
+typedef struct {                /* --- worker (task queue) --- */
+  struct tpool *pool;           /* the thread pool of the worker */
+  int      id;                  /* identifier of the worker thread */
+  MUTEX    lock;                /* lock for accessing the task range */
+  long     head;                /* next task to execute by the owner */
+  long     tail;                /* end of the task range (for thieves) */
+} TPWORKER;                     /* (worker) */
+
+typedef struct tpool {          /* --- thread pool --- */
+  int      cnt;                 /* number of worker threads */
+  TPWORKFN *work;               /* task execution function */
+  void     *data;               /* data for the execution function */
+  long     *order;              /* order of the tasks (or NULL) */
+  MUTEX    lock;                /* lock for accessing error status */
+  int      err;                 /* error status of task execution */
+  TPWORKER workers[1];          /* task queues of the workers */
+} TPOOL;                        /* (thread pool) */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+int tp_cpucnt (void)
+{                               /* --- get the number of processors */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  SYSTEM_INFO sysinfo;          /* system information structure */
+  GetSystemInfo(&sysinfo);      /* get system information */
+  return (int)sysinfo.dwNumberOfProcessors;
+  #elif defined _SC_NPROCESSORS_ONLN
+  return (int)sysconf(_SC_NPROCESSORS_ONLN);
+  #else                         /* if no direct function available */
+  static int cpuinfo[5] = { 0, 0, 0, 0, 0 };
+  if (!cpuinfo[4]) {            /* if cpu info. not yet retrieved */
+    __asm__ __volatile__ (      /* execute cpuid instruction */
+      "cpuid": "=a" (cpuinfo[0]), "=b" (cpuinfo[1]),
+               "=c" (cpuinfo[2]), "=d" (cpuinfo[3]) : "a" (1) );
+    cpuinfo[4] = -1;            /* execute cpuid instruction */
+  }                             /* and set initialization flag */
+  return (cpuinfo[1] >> 16) & 0xff;  /* get the number of */
+  #endif                        /* addressable processors */
+}  /* tp_cpucnt() */
+
+/*--------------------------------------------------------------------*/
+
+static int geterr (TPOOL *pool)
+{                               /* --- get the error status */
+  int r;                        /* error status */
+
+  assert(pool);                 /* check the function argument */
+  MTX_LOCK(&pool->lock);        /* read the error status */
+  r = pool->err;                /* while holding the lock */
+  MTX_FREE(&pool->lock);        /* (it may be set by other workers) */
+  return r;                     /* return the error status */
+}  /* geterr() */
+
+/*--------------------------------------------------------------------*/
+
+static void seterr (TPOOL *pool, int err)
+{                               /* --- set the error status */
+  assert(pool && (err < 0));    /* check the function arguments */
+  MTX_LOCK(&pool->lock);        /* keep the first error status */
+  if (!pool->err) pool->err = err;
+  MTX_FREE(&pool->lock);        /* that is reported by a worker */
+}  /* seterr() */
+
+/*--------------------------------------------------------------------*/
+
+static long next (TPOOL *pool, int id)
+{                               /* --- get the next task to execute */
+  int      i;                   /* loop variable for workers */
+  long     task = -1;           /* task to execute */
+  TPWORKER *w;                  /* to traverse the workers */
+
+  assert(pool && (id >= 0) && (id < pool->cnt));
+  w = pool->workers +id;        /* get the own task queue */
+  MTX_LOCK(&w->lock);           /* take a task from the front */
+  if (w->head < w->tail) task = w->head++;
+  MTX_FREE(&w->lock);           /* of the own task range */
+  for (i = 1; (task < 0) && (i < pool->cnt); i++) {
+    w = pool->workers +(id+i) % pool->cnt;
+    MTX_LOCK(&w->lock);         /* traverse the other workers and */
+    if (w->head < w->tail) task = --w->tail;
+    MTX_FREE(&w->lock);         /* steal a task from the back */
+  }                             /* of their task ranges */
+  if (pool->order && (task >= 0))
+    task = pool->order[task];   /* map the queue position to a task */
+  return task;                  /* return the task to execute */
+}  /* next() */
+
+/* Since all tasks are known in advance and no new tasks are created, */
+/* a worker that finds all task queues empty can terminate, because   */
+/* there is nothing left that it could steal later on.                */
+
+/*--------------------------------------------------------------------*/
+
+static WORKERDEF(worker, p)
+{                               /* --- worker function for a thread */
+  TPWORKER *w = p;              /* type the argument pointer */
+  TPOOL    *pool;               /* thread pool of the worker */
+  long     task;                /* task to execute */
+  int      r;                   /* result of task execution */
+
+  assert(p);                    /* check the function argument */
+  pool = w->pool;               /* get the thread pool */
+  while (!geterr(pool)) {       /* while no task failed */
+    #ifdef TP_ABORT             /* if to check for interrupt */
+    if (sig_aborted()) { seterr(pool, -1); break; }
+    #endif                      /* abort if execution was aborted */
+    task = next(pool, w->id);   /* get the next task to execute */
+    if (task < 0) break;        /* if there is none, abort */
+    r = pool->work(pool->data, w->id, task);
+    if (r < 0) { seterr(pool, r); break; }
+  }                             /* execute the task and */
+  return THREAD_OK;             /* check for an error */
+}  /* worker() */
+
+/*--------------------------------------------------------------------*/
+
+static long* deal (long cnt, int threads, const double *wgts)
+{                               /* --- deal tasks by size hints */
+  long *order, *idx;            /* order of tasks, sorted indices */
+  long k, m;                    /* loop variables for tasks */
+  int  i;                       /* loop variable for workers */
+
+  assert((cnt > 0) && (threads > 0) && wgts);
+  order = (long*)malloc((size_t)(cnt+cnt) *sizeof(long));
+  if (!order) return NULL;      /* create an order array */
+  idx = order +cnt;             /* and an index array */
+  for (k = 0; k < cnt; k++) idx[k] = k;
+  l2d_qsort(idx, (size_t)cnt, -1, wgts);
+  for (m = i = 0; i < threads; i++)   /* sort tasks by their size */
+    for (k = i; k < cnt; k += threads)
+      order[m++] = idx[k];      /* deal the tasks round robin */
+  return order;                 /* (largest tasks at the front) */
+}  /* deal() */
+
+/* Without size hints the tasks are distributed in consecutive       */
+/* blocks, which places the largest subtrees of a search (which are  */
+/* usually adjacent) into the same task range. With size hints every */
+/* worker starts with one of the largest tasks, while the smallest   */
+/* tasks, which are stolen last, fill the gaps towards the end.      */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+int tp_exec (int threads, long cnt, TPWORKFN *work, void *data)
+{                               /* --- execute tasks in parallel */
+  return tp_execx(threads, cnt, work, data, NULL);
+}  /* tp_exec() */
+
+/*--------------------------------------------------------------------*/
+
+int tp_execx (int threads, long cnt, TPWORKFN *work, void *data,
+              const double *wgts)
+{                               /* --- execute tasks in parallel */
+  int      i, n;                /* loop variables for threads */
+  int      r;                   /* error status */
+  long     k, m;                /* loop variable for tasks */
+  TPOOL    *pool;               /* created thread pool */
+  THREAD   *thds;               /* thread handles */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  DWORD    thid;                /* dummy for storing the thread id */
+  #endif                        /* (not really needed here) */
+
+  assert(work && (cnt >= 0));   /* check the function arguments */
+  if (threads <= 0) threads = tp_cpucnt();
+  if (threads > cnt) threads = (int)cnt;
+  if (threads <= 1) {           /* if to use only one thread */
+    for (k = 0; k < cnt; k++) { /* traverse the tasks */
+      #ifdef TP_ABORT           /* if to check for interrupt */
+      if (sig_aborted()) return -1;
+      #endif                    /* abort if execution was aborted */
+      r = work(data, 0, k);     /* and execute them */
+      if (r < 0) return r;      /* in the calling thread */
+    }                           /* (avoid thread overhead) */
+    return 0;                   /* return 'ok' */
+  }
+  pool = (TPOOL*)malloc(sizeof(TPOOL)
+                      +(size_t)(threads-1) *sizeof(TPWORKER));
+  if (!pool) return -1;         /* create a thread pool */
+  thds = (THREAD*)malloc((size_t)threads *sizeof(THREAD));
+  if (!thds) { free(pool); return -1; }
+  pool->order = NULL;           /* if there are task size hints, */
+  if (wgts && !(pool->order = deal(cnt, threads, wgts))) {
+    free(thds); free(pool); return -1; }  /* order the tasks */
+  pool->cnt  = threads;         /* note the number of threads, */
+  pool->work = work;            /* the task execution function */
+  pool->data = data;            /* and its data */
+  pool->err  = 0;               /* clear the error status */
+  MTX_INIT(&pool->lock);        /* and init. the lock protecting it */
+  for (m = i = 0; i < threads; i++) {
+    pool->workers[i].pool = pool;
+    pool->workers[i].id   = i;  /* traverse the workers */
+    pool->workers[i].head = m;  /* and distribute the tasks */
+    m = (wgts)                  /* (round robin sizes or blocks) */
+      ? m +cnt /threads +((i < cnt %threads) ? 1 : 0)
+      : (long)(((i+1)*(double)cnt) /threads);
+    pool->workers[i].tail = m;  /* set the end of the task range */
+    MTX_INIT(&pool->workers[i].lock);
+  }                             /* initialize the task queue locks */
+  for (n = 1; n < threads; n++) {
+    #ifdef _WIN32               /* if Microsoft Windows system */
+    thds[n] = CreateThread(NULL, 0, worker, pool->workers+n, 0, &thid);
+    if (!thds[n]) { seterr(pool, -1); break; }
+    #else                       /* if Linux/Unix system */
+    if (pthread_create(thds+n, NULL, worker, pool->workers+n) != 0) {
+      seterr(pool,-1); break; } /* create a thread for each worker */
+    #endif                      /* (except the first one, which is */
+  }                             /* executed in the calling thread) */
+  worker(pool->workers);        /* execute the first worker */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  if (n > 1) WaitForMultipleObjects((DWORD)(n-1), thds+1,
+                                    TRUE, INFINITE);
+  for (i = n; --i > 0; )        /* wait for threads to finish, */
+    CloseHandle(thds[i]);       /* then close all thread handles */
+  #else                         /* if Linux/Unix system */
+  for (i = n; --i > 0; )        /* wait for threads to finish */
+    pthread_join(thds[i], NULL);
+  #endif                        /* (join threads with this one) */
+  for (i = threads; --i >= 0; ) /* destroy the task queue locks */
+    MTX_EXIT(&pool->workers[i].lock);
+  MTX_EXIT(&pool->lock);        /* destroy the error status lock */
+  r = pool->err;                /* and get the error status */
+  if (pool->order) free(pool->order);
+  free(thds); free(pool);       /* delete the thread pool */
+  return r;                     /* return the error status */
+}  /* tp_execx() */
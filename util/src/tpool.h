@@ -0,0 +1,24 @@
+/*----------------------------------------------------------------------
+  File    : tpool.h
+  Contents: thread pool for independent tasks (with work stealing)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+            2026.10.17 function tp_execx() added (task size hints)
+----------------------------------------------------------------------*/
+#ifndef __TPOOL__
+#define __TPOOL__
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef int TPWORKFN (void *data, int thread, long task);
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern int tp_cpucnt (void);
+extern int tp_exec   (int threads, long cnt, TPWORKFN *work, void *data);
+extern int tp_execx  (int threads, long cnt, TPWORKFN *work, void *data,
+                      const double *wgts);
+
+#endif
@@ -11,6 +11,7 @@
 #           2008.08.18 adapted to main functions of arrays and lists
 #           2008.08.22 module escape added, test program tsctest added
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 module tpool added
 #-----------------------------------------------------------------------
 THISDIR = ../../util/src
 
@@ -128,6 +129,12 @@ params.obj:   params.h params.c util.mak
 sigint.obj:   sigint.h sigint.c util.mak
 	$(CC) $(CFLAGS) sigint.c /Fo$@
 
+#-----------------------------------------------------------------------
+# Thread Pool (with Work Stealing)
+#-----------------------------------------------------------------------
+tpool.obj:    tpool.h arrays.h fntypes.h tpool.c util.mak
+	$(CC) $(CFLAGS) tpool.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Clean up
 #-----------------------------------------------------------------------